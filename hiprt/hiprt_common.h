@@ -173,8 +173,12 @@ constexpr int	IntMax = 2147483647;
 constexpr uint32_t InvalidValue				 = ~0u;
 constexpr uint32_t FullRayMask				 = ~0u;
 constexpr uint32_t MaxBatchBuildMaxPrimCount = 512u;
+constexpr uint32_t MaxCustomLeafPrimCount	 = 16u;
+constexpr uint32_t MaxTimeSegmentCount		 = 16u;
 constexpr uint32_t MaxInstanceLevels		 = 4u;
 constexpr uint32_t BranchingFactor			 = 4u;
+constexpr uint32_t MaxBuildProfilePhases	 = 16u;
+constexpr uint32_t TraversalHistogramSize	 = 64u;
 constexpr uint32_t DefaultAlignment			 = 64u;
 
 #ifdef __KERNELCC__
@@ -409,16 +413,26 @@ class hiprtPimpl
 	}
 };
 
+// the statistics counters are placed in front of the traversal members, so they grow by a fixed size
+#if defined( HIPRT_TRAVERSAL_STATISTICS )
+#if defined( HIPRT_BITCODE_LINKING )
+#error "The traversal statistics need the kernels compiled from source, the precompiled bitcode is built without them"
+#endif
+constexpr uint32_t SizeTraversalStatistics = 32u;
+#else
+constexpr uint32_t SizeTraversalStatistics = 0u;
+#endif
+
 enum TraversalObjSize
 {
 	SizePrivateStack			   = 260,
 	SizeGlobalStack				   = 48,
 	SizePrivateInstanceStack	   = 160,
 	SizeGlobalInstanceStack		   = 48,
-	SizeGeomTraversalCustomStack   = 128,
-	SizeSceneTraversalCustomStack  = 176,
-	SizeGeomTraversalPrivateStack  = 400,
-	SizeSceneTraversalPrivateStack = 608,
+	SizeGeomTraversalCustomStack   = 128 + SizeTraversalStatistics,
+	SizeSceneTraversalCustomStack  = 176 + SizeTraversalStatistics,
+	SizeGeomTraversalPrivateStack  = 400 + SizeTraversalStatistics,
+	SizeSceneTraversalPrivateStack = 608 + SizeTraversalStatistics,
 };
 
 enum TraversalObjAlignment
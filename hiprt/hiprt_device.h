@@ -189,8 +189,9 @@ class hiprtGeomTraversalClosest
 		void*			   payload	 = nullptr,
 		hiprtFuncTable	   funcTable = nullptr,
 		uint32_t		   rayType	 = 0 );
-	HIPRT_DEVICE hiprtHit			 getNextHit();
-	HIPRT_DEVICE hiprtTraversalState getCurrentState();
+	HIPRT_DEVICE hiprtHit				  getNextHit();
+	HIPRT_DEVICE hiprtTraversalState	  getCurrentState();
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics();
 
   private:
 	hiprtPimpl<
@@ -214,8 +215,9 @@ class hiprtGeomTraversalAnyHit
 		void*			   payload	 = nullptr,
 		hiprtFuncTable	   funcTable = nullptr,
 		uint32_t		   rayType	 = 0 );
-	HIPRT_DEVICE hiprtHit			 getNextHit();
-	HIPRT_DEVICE hiprtTraversalState getCurrentState();
+	HIPRT_DEVICE hiprtHit				  getNextHit();
+	HIPRT_DEVICE hiprtTraversalState	  getCurrentState();
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics();
 
   private:
 	hiprtPimpl<
@@ -239,8 +241,9 @@ class hiprtGeomCustomTraversalClosest
 		void*			   payload	 = nullptr,
 		hiprtFuncTable	   funcTable = nullptr,
 		uint32_t		   rayType	 = 0 );
-	HIPRT_DEVICE hiprtHit			 getNextHit();
-	HIPRT_DEVICE hiprtTraversalState getCurrentState();
+	HIPRT_DEVICE hiprtHit				  getNextHit();
+	HIPRT_DEVICE hiprtTraversalState	  getCurrentState();
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics();
 
   private:
 	hiprtPimpl<
@@ -264,8 +267,9 @@ class hiprtGeomCustomTraversalAnyHit
 		void*			   payload	 = nullptr,
 		hiprtFuncTable	   funcTable = nullptr,
 		uint32_t		   rayType	 = 0 );
-	HIPRT_DEVICE hiprtHit			 getNextHit();
-	HIPRT_DEVICE hiprtTraversalState getCurrentState();
+	HIPRT_DEVICE hiprtHit				  getNextHit();
+	HIPRT_DEVICE hiprtTraversalState	  getCurrentState();
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics();
 
   private:
 	hiprtPimpl<
@@ -294,8 +298,9 @@ class hiprtSceneTraversalClosest
 		hiprtFuncTable	   funcTable = nullptr,
 		uint32_t		   rayType	 = 0,
 		float			   time		 = 0.0f );
-	HIPRT_DEVICE hiprtHit			 getNextHit();
-	HIPRT_DEVICE hiprtTraversalState getCurrentState();
+	HIPRT_DEVICE hiprtHit				  getNextHit();
+	HIPRT_DEVICE hiprtTraversalState	  getCurrentState();
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics();
 
   private:
 	hiprtPimpl<
@@ -321,8 +326,9 @@ class hiprtSceneTraversalAnyHit
 		hiprtFuncTable	   funcTable = nullptr,
 		uint32_t		   rayType	 = 0,
 		float			   time		 = 0.0f );
-	HIPRT_DEVICE hiprtHit			 getNextHit();
-	HIPRT_DEVICE hiprtTraversalState getCurrentState();
+	HIPRT_DEVICE hiprtHit				  getNextHit();
+	HIPRT_DEVICE hiprtTraversalState	  getCurrentState();
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics();
 
   private:
 	hiprtPimpl<
@@ -351,8 +357,9 @@ class hiprtGeomTraversalClosestCustomStack
 		void*			   payload	 = nullptr,
 		hiprtFuncTable	   funcTable = nullptr,
 		uint32_t		   rayType	 = 0 );
-	HIPRT_DEVICE hiprtHit			 getNextHit();
-	HIPRT_DEVICE hiprtTraversalState getCurrentState();
+	HIPRT_DEVICE hiprtHit				  getNextHit();
+	HIPRT_DEVICE hiprtTraversalState	  getCurrentState();
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics();
 
   private:
 	hiprtPimpl<
@@ -378,8 +385,9 @@ class hiprtGeomTraversalAnyHitCustomStack
 		void*			   payload	 = nullptr,
 		hiprtFuncTable	   funcTable = nullptr,
 		uint32_t		   rayType	 = 0 );
-	HIPRT_DEVICE hiprtHit			 getNextHit();
-	HIPRT_DEVICE hiprtTraversalState getCurrentState();
+	HIPRT_DEVICE hiprtHit				  getNextHit();
+	HIPRT_DEVICE hiprtTraversalState	  getCurrentState();
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics();
 
   private:
 	hiprtPimpl<
@@ -405,8 +413,9 @@ class hiprtGeomCustomTraversalClosestCustomStack
 		void*			   payload	 = nullptr,
 		hiprtFuncTable	   funcTable = nullptr,
 		uint32_t		   rayType	 = 0 );
-	HIPRT_DEVICE hiprtHit			 getNextHit();
-	HIPRT_DEVICE hiprtTraversalState getCurrentState();
+	HIPRT_DEVICE hiprtHit				  getNextHit();
+	HIPRT_DEVICE hiprtTraversalState	  getCurrentState();
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics();
 
   private:
 	hiprtPimpl<
@@ -432,8 +441,9 @@ class hiprtGeomCustomTraversalAnyHitCustomStack
 		void*			   payload	 = nullptr,
 		hiprtFuncTable	   funcTable = nullptr,
 		uint32_t		   rayType	 = 0 );
-	HIPRT_DEVICE hiprtHit			 getNextHit();
-	HIPRT_DEVICE hiprtTraversalState getCurrentState();
+	HIPRT_DEVICE hiprtHit				  getNextHit();
+	HIPRT_DEVICE hiprtTraversalState	  getCurrentState();
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics();
 
   private:
 	hiprtPimpl<
@@ -465,8 +475,9 @@ class hiprtSceneTraversalClosestCustomStack
 		hiprtFuncTable		funcTable = nullptr,
 		uint32_t			rayType	  = 0,
 		float				time	  = 0.0f );
-	HIPRT_DEVICE hiprtHit			 getNextHit();
-	HIPRT_DEVICE hiprtTraversalState getCurrentState();
+	HIPRT_DEVICE hiprtHit				  getNextHit();
+	HIPRT_DEVICE hiprtTraversalState	  getCurrentState();
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics();
 
   private:
 	hiprtPimpl<
@@ -495,8 +506,9 @@ class hiprtSceneTraversalAnyHitCustomStack
 		hiprtFuncTable		funcTable = nullptr,
 		uint32_t			rayType	  = 0,
 		float				time	  = 0.0f );
-	HIPRT_DEVICE hiprtHit			 getNextHit();
-	HIPRT_DEVICE hiprtTraversalState getCurrentState();
+	HIPRT_DEVICE hiprtHit				  getNextHit();
+	HIPRT_DEVICE hiprtTraversalState	  getCurrentState();
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics();
 
   private:
 	hiprtPimpl<
@@ -34,15 +34,17 @@ struct _hiprtGeometry;
 struct _hiprtScene;
 struct _hiprtContext;
 struct _hiprtFuncTable;
-
-typedef void*			 hiprtDevicePtr;
-typedef _hiprtGeometry*	 hiprtGeometry;
-typedef _hiprtScene*	 hiprtScene;
-typedef _hiprtContext*	 hiprtContext;
-typedef _hiprtFuncTable* hiprtFuncTable;
-typedef uint32_t		 hiprtLogLevel;
-typedef uint32_t		 hiprtBuildFlags;
-typedef uint32_t		 hiprtRayMask;
+struct _hiprtCompileTask;
+
+typedef void*			   hiprtDevicePtr;
+typedef _hiprtGeometry*	   hiprtGeometry;
+typedef _hiprtScene*	   hiprtScene;
+typedef _hiprtContext*	   hiprtContext;
+typedef _hiprtFuncTable*   hiprtFuncTable;
+typedef _hiprtCompileTask* hiprtCompileTask;
+typedef uint32_t		   hiprtLogLevel;
+typedef uint32_t		   hiprtBuildFlags;
+typedef uint32_t		   hiprtRayMask;
 
 typedef int	  hiprtApiDevice;	// hipDevice, cuDevice
 typedef void* hiprtApiCtx;		// hipCtx, cuCtx
@@ -94,8 +96,12 @@ enum : uint32_t
 	hiprtInvalidValue			   = hiprt::InvalidValue,
 	hiprtFullRayMask			   = hiprt::FullRayMask,
 	hiprtMaxBatchBuildMaxPrimCount = hiprt::MaxBatchBuildMaxPrimCount,
+	hiprtMaxCustomLeafPrimCount	   = hiprt::MaxCustomLeafPrimCount,
+	hiprtMaxTimeSegmentCount	   = hiprt::MaxTimeSegmentCount,
 	hiprtMaxInstanceLevels		   = hiprt::MaxInstanceLevels,
-	hiprtBranchingFactor		   = hiprt::BranchingFactor
+	hiprtBranchingFactor		   = hiprt::BranchingFactor,
+	hiprtMaxBuildProfilePhases	   = hiprt::MaxBuildProfilePhases,
+	hiprtTraversalHistogramSize	   = hiprt::TraversalHistogramSize
 };
 
 /** \brief Error codes.
@@ -123,6 +129,23 @@ enum hiprtLogLevelBits
 	hiprtLogLevelError = 1 << 2
 };
 
+/** \brief Formats of the log file.
+ *
+ */
+enum hiprtLogFormat
+{
+	/*!< One line of text per message */
+	hiprtLogFormatText = 0,
+	/*!< One JSON object per line */
+	hiprtLogFormatJson = 1
+};
+
+/** \brief Receives the log messages.
+ *
+ * The message has no trailing newline.
+ */
+typedef void ( *hiprtLogCallback )( hiprtLogLevel level, const char* message, void* userData );
+
 /** \brief Type of geometry/scene build operation.
  *
  * hiprtBuildGeometry/hiprtBuildScene can either build or update
@@ -138,6 +161,14 @@ enum hiprtBuildOperation
  *
  * hiprtBuildGeometry/hiprtBuildScene use these flags to choose
  * an appropriate build format/algorithm.
+ * With hiprtBuildFlagBitDeterministic, repeated builds of the same input
+ * produce bit-identical hierarchies regardless of the thread scheduling
+ * (not supported with hiprtBuildFlagBitPreferHighQualityBuild).
+ * hiprtBuildFlagBitGlobalTrianglePairing pairs the triangles by a matching
+ * over the whole mesh instead of within a warp. The matching runs on the host:
+ * the build synchronizes the stream and copies the mesh from the device, so it
+ * suits offline builds rather than per-frame rebuilds. Triangle meshes built
+ * with this flag are never batch built.
  */
 enum hiprtBuildFlagBits
 {
@@ -146,7 +177,9 @@ enum hiprtBuildFlagBits
 	hiprtBuildFlagBitPreferHighQualityBuild = 2,
 	hiprtBuildFlagBitCustomBvhImport		= 3,
 	hiprtBuildFlagBitDisableSpatialSplits	= 1 << 2,
-	hiprtBuildFlagBitDisableTrianglePairing = 1 << 3
+	hiprtBuildFlagBitDisableTrianglePairing = 1 << 3,
+	hiprtBuildFlagBitGlobalTrianglePairing	= 1 << 4,
+	hiprtBuildFlagBitDeterministic			= 1 << 5
 };
 
 /** \brief Geometric primitive type.
@@ -261,6 +294,30 @@ struct alignas( 16 ) hiprtHit
 };
 HIPRT_STATIC_ASSERT( sizeof( hiprtHit ) == 48 );
 
+/** \brief Per-ray traversal statistics.
+ *
+ * The counters are only gathered if the kernel is compiled with
+ * HIPRT_TRAVERSAL_STATISTICS defined, otherwise they stay zero. The counters of a
+ * traversal object accumulate over its getNextHit calls.
+ */
+struct hiprtTraversalStatistics
+{
+	/*!< Number of box nodes tested */
+	uint32_t internalNodeCount = 0;
+	/*!< Number of leaf nodes tested */
+	uint32_t leafNodeCount = 0;
+	/*!< Number of ray-triangle tests */
+	uint32_t triangleTestCount = 0;
+	/*!< Number of custom intersection function calls */
+	uint32_t customIntersectionCount = 0;
+	/*!< Number of transitions into an instance */
+	uint32_t instanceCount = 0;
+	/*!< Maximum number of traversal stack entries in use */
+	uint32_t maxStackDepth = 0;
+	/*!< Number of times the traversal stopped on a full stack */
+	uint32_t stackOverflowCount = 0;
+};
+
 /** \brief Set of device data pointers for custom functions.
  *
  */
@@ -343,6 +400,14 @@ struct hiprtBuildOptions
 	hiprtBuildFlags buildFlags;
 	/*!< Batch build max prim count (if 0 then batch build is not used) */
 	uint32_t batchBuildMaxPrimCount = 0u;
+	/*!< Max number of custom primitives per leaf (if 0 or 1 then each leaf holds a single primitive; clamped to
+	 * hiprtMaxCustomLeafPrimCount). Whether a subtree is collapsed into a leaf is decided by SAH. */
+	uint32_t customLeafMaxPrimCount = 1u;
+	/*!< Number of time segments of a scene with transform headers and more than one frame (if 0 or 1 then a single
+	 * hierarchy bounding the whole motion is built; clamped to hiprtMaxTimeSegmentCount). The time range [0, 1] is split
+	 * uniformly and each segment gets its own hierarchy bounding the instances only within its time interval; traversal
+	 * selects the segment by the ray time. */
+	uint32_t timeSegmentCount = 1u;
 };
 
 /** \brief Triangle mesh primitive.
@@ -385,7 +450,7 @@ struct hiprtAABBListPrimitive
 {
 	/*!< Device pointer to AABB data */
 	hiprtDevicePtr aabbs;
-	/*!< Number of AABBs in the array */
+	/*!< Number of AABBs in the array, less than 2^31 (the last bit of a primitive index is used by the Bvh) */
 	uint32_t aabbCount;
 	/*!< Stride in bytes between two AABBs (2 * sizeof(float3) or 2 * sizeof(float4)) */
 	uint32_t aabbStride;
@@ -567,3 +632,124 @@ struct alignas( 8 ) hiprtTransformHeader
 	uint32_t frameCount;
 };
 HIPRT_STATIC_ASSERT( sizeof( hiprtTransformHeader ) == 8 );
+
+/** \brief Kernel cache statistics.
+ *
+ * Stale binaries were built for the device of the context with another
+ * HIPRT or driver version and are removed by trimming the cache.
+ */
+struct hiprtCacheStatistics
+{
+	/*!< Number of cached binaries */
+	uint32_t entryCount = 0;
+	/*!< Number of stale cached binaries */
+	uint32_t staleEntryCount = 0;
+	/*!< Size of the cached binaries in bytes */
+	size_t size = 0;
+	/*!< Size of the stale cached binaries in bytes */
+	size_t staleSize = 0;
+	/*!< Size of the cache files in bytes, including replaced binaries */
+	size_t fileSize = 0;
+};
+
+/** \brief Device of an offline kernel compilation.
+ *
+ * The device and driver names are part of the cache keys, they must match the
+ * values reported on the target machine for the binaries to be found there.
+ */
+struct hiprtCompileTarget
+{
+	/*!< Device name as reported by the driver, e.g. "AMD Radeon RX 7900 XTX" */
+	const char* deviceName = nullptr;
+	/*!< Architecture, e.g. "gfx1100" or "sm_86" */
+	const char* archName = nullptr;
+	/*!< Driver version of the target machine, the local one if nullptr */
+	const char* driverVersion = nullptr;
+};
+
+/** \brief Per-phase timings of a bvh build.
+ *
+ * The phases are the device passes of the builder, e.g. binning, splitting and
+ * collapse for the high quality builder. The total time is the host time spent
+ * in the build call, including the kernel compilation.
+ */
+struct hiprtBuildProfile
+{
+	/*!< Name of the builder */
+	const char* builder = nullptr;
+	/*!< Number of phases */
+	uint32_t phaseCount = 0;
+	/*!< Names of the phases */
+	const char* phaseNames[hiprtMaxBuildProfilePhases] = {};
+	/*!< Device times of the phases in milliseconds, summed over repeated passes */
+	float phaseTimes[hiprtMaxBuildProfilePhases] = {};
+	/*!< Host time of the build in milliseconds */
+	float totalTime = 0.0f;
+};
+
+/** \brief Traversal statistics aggregated over rays.
+ *
+ * Bucket i > 0 of the internal node histogram counts the rays that tested
+ * [2^(i-1), 2^i) box nodes, bucket 0 the rays that tested none. The stack depth
+ * histogram is indexed by the maximum stack depth of a ray, its last bucket also
+ * counts the deeper rays.
+ */
+struct hiprtTraversalStatisticsSummary
+{
+	/*!< Number of rays */
+	uint32_t rayCount = 0;
+	/*!< Number of rays that overflowed the stack */
+	uint32_t stackOverflowRayCount = 0;
+	/*!< Maximum number of box nodes tested by a ray */
+	uint32_t maxInternalNodeCount = 0;
+	/*!< Maximum stack depth of a ray */
+	uint32_t maxStackDepth = 0;
+	/*!< Number of box nodes tested by all rays */
+	uint64_t internalNodeCount = 0;
+	/*!< Number of leaf nodes tested by all rays */
+	uint64_t leafNodeCount = 0;
+	/*!< Number of ray-triangle tests of all rays */
+	uint64_t triangleTestCount = 0;
+	/*!< Number of custom intersection function calls of all rays */
+	uint64_t customIntersectionCount = 0;
+	/*!< Number of transitions into an instance of all rays */
+	uint64_t instanceCount = 0;
+	/*!< Number of rays per box node count bucket */
+	uint32_t internalNodeHistogram[hiprtTraversalHistogramSize] = {};
+	/*!< Number of rays per maximum stack depth */
+	uint32_t stackDepthHistogram[hiprtTraversalHistogramSize] = {};
+};
+
+/** \brief Bvh quality statistics.
+ *
+ * Gathered by walking the box node hierarchy from the root. The SAH cost is
+ * normalized by the root surface area. The child count histogram is indexed
+ * by the number of children of a box node.
+ */
+struct hiprtBvhStatistics
+{
+	/*!< SAH cost of the hierarchy */
+	float sahCost = 0.0f;
+	/*!< Average depth of the leaves */
+	float averageLeafDepth = 0.0f;
+	/*!< Sum of sibling overlap areas relative to the sum of child areas */
+	float siblingOverlapRatio = 0.0f;
+	/*!< Number of primitive references per unique primitive (> 1 with spatial splits) */
+	float referenceDuplicationFactor = 0.0f;
+	/*!< Maximum depth of the leaves (root has depth 0) */
+	uint32_t maxDepth = 0;
+	/*!< Number of reachable box nodes */
+	uint32_t boxNodeCount = 0;
+	/*!< Number of reachable leaf nodes */
+	uint32_t leafNodeCount = 0;
+	/*!< Number of primitive references in the leaves */
+	uint32_t primReferenceCount = 0;
+	/*!< Number of unique primitives */
+	uint32_t primCount = 0;
+	/*!< Fraction of triangles stored in paired triangle nodes (0 for non-triangle geometries) */
+	float pairedTriangleRatio = 0.0f;
+	/*!< Size of the device buffer of the geometry or scene in bytes */
+	uint64_t memorySize = 0;
+	/*!< Number of box nodes per child count */
+	uint32_t childCountHistogram[hiprtBranchingFactor + 1] = {};
+};
@@ -52,6 +52,9 @@ class BatchBuilder
 		BatchBuildTime
 	};
 
+	// indexed by the times
+	static constexpr const char* TimeNames[] = { "BatchBuild" };
+
 	BatchBuilder()								   = delete;
 	BatchBuilder& operator=( const BatchBuilder& ) = delete;
 
@@ -85,6 +88,9 @@ void BatchBuilder::build(
 	oroStream					   stream,
 	std::vector<hiprtDevicePtr>&   buffers )
 {
+	Tracer::Span span( context.getTracer(), "Batch", "builder" );
+	span.arg( "buildCount", buildInputs.size() );
+
 	const auto	tempSize = getTemporaryBufferSize( buildInputs, buildOptions );
 	MemoryArena temporaryMemoryArena( temporaryBuffer, tempSize, DefaultAlignment );
 
@@ -100,13 +106,13 @@ void BatchBuilder::build(
 	checkOro(
 		oroMemcpyHtoDAsync( (oroDeviceptr)buffersDev, buffers.data(), buffers.size() * sizeof( hiprtDevicePtr ), stream ) );
 
-	Timer timer;
+	Timer timer = context.getBuildProfiler().createTimer( stream, &context.getTracer(), TimeNames );
 
 	Compiler&				 compiler = context.getCompiler();
 	std::vector<const char*> opts;
 	// opts.push_back("-G");
 
-	std::string buildInputParam = Compiler::kernelNameSufix( Traits<BuildInput>::TYPE_NAME );
+	static const std::string buildInputParam = Compiler::kernelNameSufix( Traits<BuildInput>::TYPE_NAME );
 
 	uint32_t gridSize  = context.getMaxGridSize();
 	uint32_t gridSizeY = std::max( 1u, DivideRoundUp( static_cast<uint32_t>( buildInputs.size() ), gridSize ) );
@@ -116,16 +122,13 @@ void BatchBuilder::build(
 	while ( blockSize < buildOptions.batchBuildMaxPrimCount )
 		blockSize *= 2;
 
-	Kernel batchBuildKernel = compiler.getKernel(
-		context,
-		Utility::getRootDir() / "hiprt/impl/BatchBuilderKernels.h",
-		"BatchBuild_" + buildInputParam,
-		opts,
-		GET_ARG_LIST( BatchBuilderKernels ) );
+	static const Compiler::KernelKey batchBuildKey(
+		Utility::getRootDir() / "hiprt/impl/BatchBuilderKernels.h", "BatchBuild_" + buildInputParam );
+	Kernel							 batchBuildKernel =
+		compiler.getKernel( context, batchBuildKey, opts, GET_ARG_LIST( BatchBuilderKernels ) );
 	batchBuildKernel.setArgs( { buildInputs.size(), buildInputsDev, buffersDev } );
 	timer.measure( BatchBuildTime, [&]() { batchBuildKernel.launch( gridSizeX, gridSizeY, 1, blockSize, 1, 1, 0, stream ); } );
 
-	if constexpr ( Timer::EnableTimer )
-		std::cout << "Batch construction time: " << timer.getTimeRecord( BatchBuildTime ) << " ms" << std::endl;
+	context.getBuildProfiler().record( "Batch", TimeNames, std::size( TimeNames ), std::move( timer ) );
 }
 } // namespace hiprt
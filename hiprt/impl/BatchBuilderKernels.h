@@ -176,7 +176,7 @@ build( PrimitiveContainer& primitives, uint32_t geomType, MemoryArena& storageMe
 	uint32_t* taskCounter = &updateCounters[0];
 	*taskCounter		  = 1;
 	__syncthreads();
-	Collapse( index, primCount, header, scratchNodes, references, boxNodes, primNodes, primitives, taskCounter, taskQueue );
+	Collapse( index, primCount, header, scratchNodes, references, boxNodes, primNodes, primitives, taskCounter, taskQueue, 1u );
 }
 
 extern "C" __global__ void
@@ -0,0 +1,88 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <hiprt/impl/BuildProfiler.h>
+#include <algorithm>
+
+namespace hiprt
+{
+void BuildProfiler::setEnabled( bool enabled )
+{
+	m_enabled = enabled;
+	if ( !enabled )
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		m_entries.clear();
+	}
+}
+
+void BuildProfiler::record( const char* builder, const char* const* phaseNames, size_t phaseCount, Timer&& timer )
+{
+	if ( !timer.isEnabled() ) return;
+
+	const float					totalTime = timer.getElapsedTime();
+	const uint32_t				count	  = static_cast<uint32_t>( std::min( phaseCount, size_t{ MaxBuildProfilePhases } ) );
+	std::lock_guard<std::mutex> lock( m_mutex );
+	resolvePending( false );
+	m_entries.push_front( Entry{ builder, phaseNames, count, {}, totalTime, std::move( timer ) } );
+	if ( m_entries.size() > HistorySize ) m_entries.pop_back();
+}
+
+void BuildProfiler::resolvePending( bool wait )
+{
+	for ( Entry& entry : m_entries )
+	{
+		if ( !entry.timer.isEnabled() || ( !wait && !entry.timer.isReady() ) ) continue;
+
+		for ( uint32_t i = 0; i < entry.phaseCount; ++i )
+			entry.phaseTimes[i] = entry.timer.getTimeRecord( i );
+		entry.timer = Timer();
+	}
+}
+
+uint32_t BuildProfiler::getProfiles( uint32_t count, hiprtBuildProfile* profilesOut )
+{
+	std::lock_guard<std::mutex> lock( m_mutex );
+	if ( profilesOut == nullptr ) return static_cast<uint32_t>( m_entries.size() );
+	resolvePending( true );
+
+	count = std::min( count, static_cast<uint32_t>( m_entries.size() ) );
+	for ( uint32_t i = 0; i < count; ++i )
+	{
+		Entry&			   entry   = m_entries[i];
+		hiprtBuildProfile& profile = profilesOut[i];
+		profile					   = hiprtBuildProfile{};
+		profile.builder			   = entry.builder;
+		profile.phaseCount		   = entry.phaseCount;
+		profile.totalTime		   = entry.totalTime;
+		for ( uint32_t j = 0; j < profile.phaseCount; ++j )
+		{
+			profile.phaseNames[j] = entry.phaseNames[j];
+			profile.phaseTimes[j] = entry.phaseTimes[j];
+		}
+	}
+	return count;
+}
+} // namespace hiprt
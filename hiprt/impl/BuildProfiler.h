@@ -0,0 +1,82 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <hiprt/hiprt_types.h>
+#include <hiprt/impl/Timer.h>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+namespace hiprt
+{
+// Opt-in per-phase timings of the last builds of a context. The device phases are timed
+// with pooled events that are read once they completed when the next build is recorded
+// and only waited for when the profiles are read, so the builds are not synchronized by the profiling.
+class BuildProfiler
+{
+  public:
+	static constexpr size_t HistorySize = 64u;
+
+	void setEnabled( bool enabled );
+	bool isEnabled() const { return m_enabled; }
+
+	// measures only while enabled, with the events of the profiler
+	Timer createTimer( oroStream stream, Tracer* tracer, const char* const* names )
+	{
+		return Timer( isEnabled(), stream, tracer, names, &m_eventPool );
+	}
+
+	// the phase times are the time records of the timer, indexed by the phase,
+	// the names are expected to be string literals
+	void record( const char* builder, const char* const* phaseNames, size_t phaseCount, Timer&& timer );
+
+	// the most recent profile first, returns the number of profiles written
+	// or the number of recorded profiles if the output is null
+	uint32_t getProfiles( uint32_t count, hiprtBuildProfile* profilesOut );
+
+  private:
+	struct Entry
+	{
+		const char*								 builder;
+		const char* const*						 phaseNames;
+		uint32_t								 phaseCount;
+		std::array<float, MaxBuildProfilePhases> phaseTimes;
+		float									 totalTime;
+		// pending until the device phases are read, the events then go back to the pool
+		Timer									 timer;
+	};
+
+	// reads the phase times of the entries whose device work completed, or waits for all of them,
+	// the caller holds the mutex
+	void resolvePending( bool wait );
+
+	std::atomic<bool> m_enabled = false;
+	std::mutex		  m_mutex;
+	Timer::EventPool  m_eventPool;
+	std::deque<Entry> m_entries;
+};
+} // namespace hiprt
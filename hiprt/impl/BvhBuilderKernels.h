@@ -62,9 +62,20 @@ getNodeBox( uint32_t nodeIndex, PrimitiveContainer& primitives, BoxNode* boxNode
 	if ( getNodeType( nodeIndex ) != BoxType )
 	{
 		if constexpr ( is_same<PrimitiveNode, TriangleNode>::value )
+		{
 			return primNodes[nodeAddr].aabb();
+		}
+		else if constexpr ( is_same<PrimitiveNode, CustomNode>::value )
+		{
+			Aabb box = primitives.fetchAabb( primNodes[nodeAddr].getPrimIndex() );
+			while ( primNodes[nodeAddr].hasNext() )
+				box.grow( primitives.fetchAabb( primNodes[++nodeAddr].getPrimIndex() ) );
+			return box;
+		}
 		else
+		{
 			return primitives.fetchAabb( primNodes[nodeAddr].m_primIndex );
+		}
 	}
 	else
 	{
@@ -138,6 +149,10 @@ __device__ void InitSceneData(
 		sceneHeader->m_primNodeCount = instanceList.getCount() == 1 ? 1 : 0;
 		sceneHeader->m_boxNodeCount	 = 1;
 		sceneHeader->m_frameCount	 = instanceList.getFrameCount();
+
+		// the first segment is the entry point of time-segmented scenes
+		sceneHeader->m_timeSegmentCount	 = instanceList.getTimeSegmentIndex() == 0 ? instanceList.getTimeSegmentCount() : 1;
+		sceneHeader->m_timeSegmentStride = size;
 	}
 }
 
@@ -252,9 +267,10 @@ extern "C" __global__ void SingletonConstruction_InstanceList_MatrixFrame_Instan
 	SingletonConstruction<InstanceList<MatrixFrame>, InstanceNode>( index, primitives, boxNodes, primNodes );
 }
 
-extern "C" __global__ void PairTriangles( TriangleMesh mesh, uint2* pairIndices, uint32_t* pairCounter )
+// Pairs triangles within a warp; returns the index of the paired triangle, the triangle itself if it stays unpaired,
+// or an invalid value if it was paired with a triangle of a lower lane
+HIPRT_DEVICE HIPRT_INLINE uint32_t findTrianglePair( TriangleMesh& mesh, uint32_t index )
 {
-	const uint32_t index	 = blockIdx.x * blockDim.x + threadIdx.x;
 	const uint32_t laneIndex = threadIdx.x & ( WarpSize - 1 );
 
 	bool	 valid		 = index < mesh.getCount();
@@ -298,11 +314,53 @@ extern "C" __global__ void PairTriangles( TriangleMesh mesh, uint2* pairIndices,
 		}
 	}
 
+	return pairedIndex;
+}
+
+extern "C" __global__ void PairTriangles( TriangleMesh mesh, uint2* pairIndices, uint32_t* pairCounter )
+{
+	const uint32_t index	   = blockIdx.x * blockDim.x + threadIdx.x;
+	const uint32_t pairedIndex = findTrianglePair( mesh, index );
+
 	bool	 pairing   = index < mesh.getCount() && pairedIndex != InvalidValue;
 	uint32_t pairIndex = warpOffset( pairing, pairCounter );
 	if ( pairing ) pairIndices[pairIndex] = make_uint2( index, pairedIndex );
 }
 
+// Deterministic pairing: pairs are stored at the index of their first triangle and compacted by a single block
+extern "C" __global__ void MarkTrianglePairs( TriangleMesh mesh, uint2* pairIndices )
+{
+	const uint32_t index	   = blockIdx.x * blockDim.x + threadIdx.x;
+	const uint32_t pairedIndex = findTrianglePair( mesh, index );
+
+	if ( index < mesh.getCount() )
+		pairIndices[index] = pairedIndex != InvalidValue ? make_uint2( index, pairedIndex ) : make_uint2( InvalidValue );
+}
+
+extern "C" __global__ void CompactTrianglePairs( uint32_t triangleCount, uint2* pairIndices, uint32_t* pairCounter )
+{
+	constexpr uint32_t	WarpsPerBlock = DivideRoundUp( BvhBuilderReductionBlockSize, WarpSize );
+	__shared__ uint32_t pairCache[WarpsPerBlock];
+	__shared__ uint32_t blockTotal;
+
+	uint32_t pairTotal = 0;
+	for ( uint32_t blockOffset = 0; blockOffset < triangleCount; blockOffset += blockDim.x )
+	{
+		const uint32_t index   = blockOffset + threadIdx.x;
+		const uint2	   pair	   = index < triangleCount ? pairIndices[index] : make_uint2( InvalidValue );
+		const bool	   pairing = pair.x != InvalidValue;
+		const uint32_t pairSum = blockScan<uint32_t>( pairing, pairCache );
+		// pairs only move to lower indices, all reads of the block are done in the scan
+		if ( pairing ) pairIndices[pairTotal + pairSum - 1] = pair;
+		if ( threadIdx.x == blockDim.x - 1 ) blockTotal = pairSum;
+		__syncthreads();
+		pairTotal += blockTotal;
+		__syncthreads();
+	}
+
+	if ( threadIdx.x == 0 ) *pairCounter = pairTotal;
+}
+
 template <typename PrimitiveContainer>
 __device__ void ComputeCentroidBox( PrimitiveContainer& primitives, Aabb* centroidBox )
 {
@@ -548,6 +606,180 @@ extern "C" __global__ void FitBounds_InstanceList_MatrixFrame_InstanceNode(
 	FitBounds<InstanceList<MatrixFrame>, InstanceNode>( header, primitives, boxNodes, primNodes );
 }
 
+// marks a task slot of a reference that was already written to a multi-primitive leaf
+static constexpr uint32_t CollapsedTaskIndex = InvalidValue - 1;
+
+// Gathers the leaves of a binary subtree if it has at most maxLeafPrimCount leaves and a single leaf containing
+// all of them is not more expensive than the subtree in terms of SAH; returns the number of leaves or zero otherwise
+HIPRT_DEVICE HIPRT_INLINE uint32_t gatherLeafReferences(
+	uint32_t			 nodeIndex,
+	const ScratchNode*	 scratchNodes,
+	const ReferenceNode* references,
+	uint32_t			 maxLeafPrimCount,
+	uint32_t*			 leafIndices )
+{
+	uint32_t stack[MaxCustomLeafPrimCount];
+	uint32_t stackSize = 0;
+	stack[stackSize++] = nodeIndex;
+
+	uint32_t leafCount = 0;
+	float	 cost	   = 0.0f;
+	while ( stackSize > 0 )
+	{
+		const uint32_t index = stack[--stackSize];
+		const float	   area	 = getNodeBox( index, scratchNodes, references ).area();
+		if ( isInternalNode( index ) )
+		{
+			// each subtree on the stack contains at least one leaf
+			if ( leafCount + stackSize + 2 > maxLeafPrimCount ) return 0;
+			const ScratchNode scratchNode = scratchNodes[getNodeAddr( index )];
+			stack[stackSize++]			  = scratchNode.m_childIndex1;
+			stack[stackSize++]			  = scratchNode.m_childIndex0;
+			cost += Ct * area;
+		}
+		else
+		{
+			leafIndices[leafCount++] = index;
+			cost += Ci * area;
+		}
+	}
+
+	const float leafCost = Ci * leafCount * getNodeBox( nodeIndex, scratchNodes, references ).area();
+	return leafCost <= cost ? leafCount : 0;
+}
+
+// Expands a binary node to a wide node, some of whose small internal children may be collapsed to multi-primitive
+// leaves; leafPrimCounts holds the number of primitives per child (zero means a box node)
+HIPRT_DEVICE HIPRT_INLINE void collapseNode(
+	uint32_t			 nodeIndex,
+	const ScratchNode*	 scratchNodes,
+	const ReferenceNode* references,
+	uint32_t			 maxLeafPrimCount,
+	BoxNode&			 boxNode,
+	uint32_t*			 leafPrimCounts,
+	uint32_t&			 internalCount,
+	uint32_t&			 leafPrimCount )
+{
+	Aabb*	  childBoxes   = &boxNode.m_box0;
+	uint32_t* childIndices = &boxNode.m_childIndex0;
+
+	ScratchNode scratchNode = scratchNodes[getNodeAddr( nodeIndex )];
+	childIndices[0]			= scratchNode.m_childIndex0;
+	childIndices[1]			= scratchNode.m_childIndex1;
+	childBoxes[0]			= getNodeBox( scratchNode.m_childIndex0, scratchNodes, references );
+	childBoxes[1]			= getNodeBox( scratchNode.m_childIndex1, scratchNodes, references );
+
+	for ( uint32_t i = 0; i < BranchingFactor - 2; ++i )
+	{
+		float	 maxArea  = 0.0f;
+		uint32_t maxIndex = InvalidValue;
+		for ( uint32_t j = 0; j < boxNode.m_childCount; ++j )
+		{
+			if ( boxNode.getChildType( j ) == BoxType )
+			{
+				float area = childBoxes[j].area();
+				if ( area > maxArea )
+				{
+					maxArea	 = area;
+					maxIndex = j;
+				}
+			}
+		}
+
+		if ( maxIndex == InvalidValue ) break;
+
+		ScratchNode scratchChild		   = scratchNodes[getNodeAddr( childIndices[maxIndex] )];
+		childIndices[maxIndex]			   = scratchChild.m_childIndex0;
+		childIndices[boxNode.m_childCount] = scratchChild.m_childIndex1;
+		childBoxes[maxIndex]			   = getNodeBox( scratchChild.m_childIndex0, scratchNodes, references );
+		childBoxes[boxNode.m_childCount]   = getNodeBox( scratchChild.m_childIndex1, scratchNodes, references );
+		++boxNode.m_childCount;
+	}
+
+	internalCount = 0;
+	leafPrimCount = 0;
+	for ( uint32_t i = 0; i < boxNode.m_childCount; ++i )
+	{
+		leafPrimCounts[i] = 1;
+		if ( isInternalNode( childIndices[i] ) )
+		{
+			leafPrimCounts[i] = 0;
+			if ( maxLeafPrimCount > 1 )
+			{
+				uint32_t leafIndices[MaxCustomLeafPrimCount];
+				leafPrimCounts[i] =
+					gatherLeafReferences( childIndices[i], scratchNodes, references, maxLeafPrimCount, leafIndices );
+			}
+			if ( leafPrimCounts[i] == 0 ) ++internalCount;
+		}
+		leafPrimCount += leafPrimCounts[i];
+	}
+}
+
+template <typename PrimitiveContainer, typename PrimitiveNode>
+HIPRT_DEVICE HIPRT_INLINE void
+writePrimNode( uint32_t nodeAddr, const ReferenceNode& reference, PrimitiveNode* primNodes, PrimitiveContainer& primitives )
+{
+	if constexpr ( is_same<PrimitiveNode, TriangleNode>::value )
+	{
+		primNodes[nodeAddr] = primitives.fetchTriangleNode( reference.m_primIndex );
+	}
+	else if constexpr ( is_same<PrimitiveNode, CustomNode>::value )
+	{
+		primNodes[nodeAddr].m_primIndex = reference.m_primIndex;
+	}
+	else if constexpr ( is_same<PrimitiveNode, InstanceNode>::value )
+	{
+		hiprtInstance		 instance	= primitives.fetchInstance( reference.m_primIndex );
+		hiprtTransformHeader transform	= primitives.fetchTransformHeader( reference.m_primIndex );
+		primNodes[nodeAddr].m_primIndex = reference.m_primIndex;
+		primNodes[nodeAddr].m_mask		= primitives.fetchMask( reference.m_primIndex );
+		primNodes[nodeAddr].m_type		= instance.type;
+		primNodes[nodeAddr].m_static	= transform.frameCount == 1 ? 1 : 0;
+
+		if ( instance.type == hiprtInstanceTypeScene )
+			primNodes[nodeAddr].m_scene = reinterpret_cast<SceneHeader*>( instance.scene );
+		else
+			primNodes[nodeAddr].m_geometry = reinterpret_cast<GeomHeader*>( instance.geometry );
+
+		if ( transform.frameCount == 1 )
+		{
+			primNodes[nodeAddr].m_identity =
+				primitives.copyInvTransformMatrix( transform.frameIndex, primNodes[nodeAddr].m_matrix ) ? 1 : 0;
+		}
+		else
+		{
+			primNodes[nodeAddr].m_transform = transform;
+			primNodes[nodeAddr].m_identity	= 0;
+		}
+	}
+}
+
+// Writes the references of a collapsed child to consecutive primitive nodes starting at leafAddr and returns its index
+template <typename PrimitiveNode>
+HIPRT_DEVICE HIPRT_INLINE uint32_t writeLeafReferences(
+	uint32_t			 childIndex,
+	uint32_t			 leafAddr,
+	uint32_t			 leafPrimCount,
+	const ScratchNode*	 scratchNodes,
+	const ReferenceNode* references,
+	PrimitiveNode*		 primNodes,
+	uint32_t			 maxLeafPrimCount )
+{
+	uint32_t leafIndices[MaxCustomLeafPrimCount];
+	gatherLeafReferences( childIndex, scratchNodes, references, maxLeafPrimCount, leafIndices );
+	if constexpr ( is_same<PrimitiveNode, CustomNode>::value )
+	{
+		for ( uint32_t j = 0; j < leafPrimCount; ++j )
+		{
+			uint32_t primIndex = references[getNodeAddr( leafIndices[j] )].m_primIndex;
+			if ( j + 1 < leafPrimCount ) primIndex |= CustomNode::NextBit;
+			primNodes[leafAddr + j].m_primIndex = primIndex;
+		}
+	}
+	return encodeNodeIndex( leafAddr, getNodeType( leafIndices[0] ) );
+}
+
 template <typename PrimitiveContainer, typename PrimitiveNode, typename Header>
 __device__ void Collapse(
 	uint32_t			index,
@@ -559,8 +791,12 @@ __device__ void Collapse(
 	PrimitiveNode*		primNodes,
 	PrimitiveContainer& primitives,
 	uint32_t*			taskCounter,
-	uint3*				taskQueue )
+	uint3*				taskQueue,
+	uint32_t			maxLeafPrimCount )
 {
+	if constexpr ( !is_same<PrimitiveNode, CustomNode>::value ) maxLeafPrimCount = 1;
+	maxLeafPrimCount = min( maxLeafPrimCount, MaxCustomLeafPrimCount );
+
 	bool done = index >= leafCount;
 	while ( __any( !done ) )
 	{
@@ -576,66 +812,58 @@ __device__ void Collapse(
 		// we need to check all three values
 		if ( nodeIndex != InvalidValue && nodeAddr != InvalidValue && parentAddr != InvalidValue )
 		{
-			if ( isInternalNode( nodeIndex ) )
+			if ( nodeIndex == CollapsedTaskIndex )
+			{
+				done = true;
+			}
+			else if ( isInternalNode( nodeIndex ) )
 			{
 				if ( nodeAddr == 0 ) parentAddr = InvalidValue;
 
 				BoxNode boxNode;
 				boxNode.m_parentAddr = parentAddr;
 
-				Aabb*	  childBoxes   = &boxNode.m_box0;
-				uint32_t* childIndices = &boxNode.m_childIndex0;
-
-				ScratchNode scratchNode = scratchNodes[getNodeAddr( nodeIndex )];
-				childIndices[0]			= scratchNode.m_childIndex0;
-				childIndices[1]			= scratchNode.m_childIndex1;
-				childBoxes[0]			= getNodeBox( scratchNode.m_childIndex0, scratchNodes, references );
-				childBoxes[1]			= getNodeBox( scratchNode.m_childIndex1, scratchNodes, references );
-
-				for ( uint32_t i = 0; i < BranchingFactor - 2; ++i )
+				uint32_t leafPrimCounts[BranchingFactor];
+				uint32_t internalCount;
+				uint32_t leafPrimCount;
+				collapseNode(
+					nodeIndex,
+					scratchNodes,
+					references,
+					maxLeafPrimCount,
+					boxNode,
+					leafPrimCounts,
+					internalCount,
+					leafPrimCount );
+
+				// each reference occupies one task slot, thus threads of collapsed references are released by empty tasks
+				uint32_t* childIndices	 = &boxNode.m_childIndex0;
+				uint32_t  taskOffset	 = atomicAdd( taskCounter, internalCount + leafPrimCount - 1 );
+				uint32_t  internalOffset = atomicAdd( &header->m_boxNodeCount, internalCount );
+				uint32_t  leafOffset	 = atomicAdd( &header->m_primNodeCount, leafPrimCount );
+				uint32_t  taskAddr		 = index;
+				for ( uint32_t i = 0; i < boxNode.m_childCount; ++i )
 				{
-					float	 maxArea  = 0.0f;
-					uint32_t maxIndex = InvalidValue;
-					for ( uint32_t j = 0; j < boxNode.m_childCount; ++j )
+					uint32_t childIndex = childIndices[i];
+					if ( isInternalNode( childIndex ) && leafPrimCounts[i] > 0 )
 					{
-						if ( boxNode.getChildType( j ) == BoxType )
+						uint32_t childAddr = leafOffset;
+						childIndices[i]	   = writeLeafReferences(
+							   childIndex, childAddr, leafPrimCounts[i], scratchNodes, references, primNodes, maxLeafPrimCount );
+						leafOffset += leafPrimCounts[i];
+						for ( uint32_t j = 0; j < leafPrimCounts[i]; ++j )
 						{
-							float area = childBoxes[j].area();
-							if ( area > maxArea )
-							{
-								maxArea	 = area;
-								maxIndex = j;
-							}
+							taskQueue[taskAddr] = make_uint3( CollapsedTaskIndex, childAddr, nodeAddr );
+							taskAddr			= taskOffset++;
 						}
 					}
-
-					if ( maxIndex == InvalidValue ) break;
-
-					ScratchNode scratchChild		   = scratchNodes[getNodeAddr( childIndices[maxIndex] )];
-					childIndices[maxIndex]			   = scratchChild.m_childIndex0;
-					childIndices[boxNode.m_childCount] = scratchChild.m_childIndex1;
-					childBoxes[maxIndex]			   = getNodeBox( scratchChild.m_childIndex0, scratchNodes, references );
-					childBoxes[boxNode.m_childCount]   = getNodeBox( scratchChild.m_childIndex1, scratchNodes, references );
-					++boxNode.m_childCount;
-				}
-
-				uint32_t internalCount = 0;
-				for ( uint32_t i = 0; i < boxNode.m_childCount; ++i )
-				{
-					if ( isInternalNode( childIndices[i] ) ) ++internalCount;
-				}
-
-				uint32_t taskOffset		= atomicAdd( taskCounter, boxNode.m_childCount - 1 );
-				uint32_t internalOffset = atomicAdd( &header->m_boxNodeCount, internalCount );
-				uint32_t leafOffset		= atomicAdd( &header->m_primNodeCount, boxNode.m_childCount - internalCount );
-				for ( uint32_t i = 0; i < boxNode.m_childCount; ++i )
-				{
-					uint32_t childIndex = childIndices[i];
-					uint32_t childAddr	= isInternalNode( childIndices[i] ) ? internalOffset++ : leafOffset++;
-					childIndices[i]		= encodeNodeIndex( childAddr, getNodeType( childIndex ) );
-
-					uint32_t taskAddr	= i == 0 ? index : taskOffset++;
-					taskQueue[taskAddr] = make_uint3( childIndex, childAddr, nodeAddr );
+					else
+					{
+						uint32_t childAddr	= isInternalNode( childIndex ) ? internalOffset++ : leafOffset++;
+						childIndices[i]		= encodeNodeIndex( childAddr, getNodeType( childIndex ) );
+						taskQueue[taskAddr] = make_uint3( childIndex, childAddr, nodeAddr );
+						taskAddr			= taskOffset++;
+					}
 					__threadfence();
 				}
 
@@ -643,40 +871,7 @@ __device__ void Collapse(
 			}
 			else
 			{
-				const ReferenceNode reference = references[getNodeAddr( nodeIndex )];
-				if constexpr ( is_same<PrimitiveNode, TriangleNode>::value )
-				{
-					primNodes[nodeAddr] = primitives.fetchTriangleNode( reference.m_primIndex );
-				}
-				else if constexpr ( is_same<PrimitiveNode, CustomNode>::value )
-				{
-					primNodes[nodeAddr].m_primIndex = reference.m_primIndex;
-				}
-				else if constexpr ( is_same<PrimitiveNode, InstanceNode>::value )
-				{
-					hiprtInstance		 instance	= primitives.fetchInstance( reference.m_primIndex );
-					hiprtTransformHeader transform	= primitives.fetchTransformHeader( reference.m_primIndex );
-					primNodes[nodeAddr].m_primIndex = reference.m_primIndex;
-					primNodes[nodeAddr].m_mask		= primitives.fetchMask( reference.m_primIndex );
-					primNodes[nodeAddr].m_type		= instance.type;
-					primNodes[nodeAddr].m_static	= transform.frameCount == 1 ? 1 : 0;
-
-					if ( instance.type == hiprtInstanceTypeScene )
-						primNodes[nodeAddr].m_scene = reinterpret_cast<SceneHeader*>( instance.scene );
-					else
-						primNodes[nodeAddr].m_geometry = reinterpret_cast<GeomHeader*>( instance.geometry );
-
-					if ( transform.frameCount == 1 )
-					{
-						primNodes[nodeAddr].m_identity =
-							primitives.copyInvTransformMatrix( transform.frameIndex, primNodes[nodeAddr].m_matrix ) ? 1 : 0;
-					}
-					else
-					{
-						primNodes[nodeAddr].m_transform = transform;
-						primNodes[nodeAddr].m_identity	= 0;
-					}
-				}
+				writePrimNode( nodeAddr, references[getNodeAddr( nodeIndex )], primNodes, primitives );
 				done = true;
 			}
 		}
@@ -685,6 +880,131 @@ __device__ void Collapse(
 	}
 }
 
+// Deterministic collapse: the wide hierarchy is emitted level by level, and nodes of each level are allocated in the
+// order of their parents by prefix sums instead of atomics; leaves are written directly by their parents
+template <typename PrimitiveContainer, typename PrimitiveNode>
+__device__ void CountCollapsedChildren(
+	uint32_t	   index,
+	uint32_t	   taskCount,
+	ScratchNode*   scratchNodes,
+	ReferenceNode* references,
+	uint3*		   taskQueue,
+	uint32_t*	   boxCounts,
+	uint32_t*	   primCounts,
+	uint32_t	   maxLeafPrimCount )
+{
+	if constexpr ( !is_same<PrimitiveNode, CustomNode>::value ) maxLeafPrimCount = 1;
+	maxLeafPrimCount = min( maxLeafPrimCount, MaxCustomLeafPrimCount );
+
+	if ( index >= taskCount ) return;
+
+	BoxNode	 boxNode;
+	uint32_t leafPrimCounts[BranchingFactor];
+	uint32_t internalCount;
+	uint32_t leafPrimCount;
+	collapseNode(
+		taskQueue[index].x, scratchNodes, references, maxLeafPrimCount, boxNode, leafPrimCounts, internalCount, leafPrimCount );
+	boxCounts[index]  = internalCount;
+	primCounts[index] = leafPrimCount;
+}
+
+template <typename PrimitiveContainer, typename PrimitiveNode>
+__device__ void CollapseLevel(
+	uint32_t			index,
+	uint32_t			taskCount,
+	uint32_t			boxNodeBase,
+	uint32_t			primNodeBase,
+	ScratchNode*		scratchNodes,
+	ReferenceNode*		references,
+	BoxNode*			boxNodes,
+	PrimitiveNode*		primNodes,
+	PrimitiveContainer& primitives,
+	uint3*				taskQueue,
+	uint3*				nextTaskQueue,
+	uint32_t*			boxOffsets,
+	uint32_t*			primOffsets,
+	uint32_t			maxLeafPrimCount )
+{
+	if constexpr ( !is_same<PrimitiveNode, CustomNode>::value ) maxLeafPrimCount = 1;
+	maxLeafPrimCount = min( maxLeafPrimCount, MaxCustomLeafPrimCount );
+
+	if ( index >= taskCount ) return;
+
+	const uint3	   task		= taskQueue[index];
+	const uint32_t nodeAddr = task.y;
+
+	BoxNode boxNode;
+	boxNode.m_parentAddr = nodeAddr == 0 ? InvalidValue : task.z;
+
+	uint32_t leafPrimCounts[BranchingFactor];
+	uint32_t internalCount;
+	uint32_t leafPrimCount;
+	collapseNode( task.x, scratchNodes, references, maxLeafPrimCount, boxNode, leafPrimCounts, internalCount, leafPrimCount );
+
+	uint32_t* childIndices = &boxNode.m_childIndex0;
+	uint32_t  taskOffset   = boxOffsets[index];
+	uint32_t  leafOffset   = primNodeBase + primOffsets[index];
+	for ( uint32_t i = 0; i < boxNode.m_childCount; ++i )
+	{
+		uint32_t childIndex = childIndices[i];
+		if ( isInternalNode( childIndex ) && leafPrimCounts[i] > 0 )
+		{
+			childIndices[i] = writeLeafReferences(
+				childIndex, leafOffset, leafPrimCounts[i], scratchNodes, references, primNodes, maxLeafPrimCount );
+			leafOffset += leafPrimCounts[i];
+		}
+		else if ( isInternalNode( childIndex ) )
+		{
+			uint32_t childAddr			= boxNodeBase + taskOffset;
+			childIndices[i]				= encodeNodeIndex( childAddr, BoxType );
+			nextTaskQueue[taskOffset++] = make_uint3( childIndex, childAddr, nodeAddr );
+		}
+		else
+		{
+			writePrimNode( leafOffset, references[getNodeAddr( childIndex )], primNodes, primitives );
+			childIndices[i] = encodeNodeIndex( leafOffset++, getNodeType( childIndex ) );
+		}
+	}
+
+	boxNodes[nodeAddr] = boxNode;
+}
+
+// Exclusive prefix sums of the per-task node counts of a level, performed by a single block
+extern "C" __global__ void ScanCollapsedChildren( uint32_t taskCount, uint32_t* boxCounts, uint32_t* primCounts, uint2* totals )
+{
+	constexpr uint32_t	WarpsPerBlock = DivideRoundUp( BvhBuilderReductionBlockSize, WarpSize );
+	__shared__ uint32_t boxCache[WarpsPerBlock];
+	__shared__ uint32_t primCache[WarpsPerBlock];
+	__shared__ uint32_t blockTotals[2];
+
+	uint32_t boxTotal  = 0;
+	uint32_t primTotal = 0;
+	for ( uint32_t blockOffset = 0; blockOffset < taskCount; blockOffset += blockDim.x )
+	{
+		const uint32_t index	 = blockOffset + threadIdx.x;
+		const uint32_t boxCount	 = index < taskCount ? boxCounts[index] : 0u;
+		const uint32_t primCount = index < taskCount ? primCounts[index] : 0u;
+		const uint32_t boxSum	 = blockScan( boxCount, boxCache );
+		const uint32_t primSum	 = blockScan( primCount, primCache );
+		if ( index < taskCount )
+		{
+			boxCounts[index]  = boxTotal + boxSum - boxCount;
+			primCounts[index] = primTotal + primSum - primCount;
+		}
+		if ( threadIdx.x == blockDim.x - 1 )
+		{
+			blockTotals[0] = boxSum;
+			blockTotals[1] = primSum;
+		}
+		__syncthreads();
+		boxTotal += blockTotals[0];
+		primTotal += blockTotals[1];
+		__syncthreads();
+	}
+
+	if ( threadIdx.x == 0 ) *totals = make_uint2( boxTotal, primTotal );
+}
+
 extern "C" __global__ void Collapse_TriangleMesh_TriangleNode(
 	uint32_t	   leafCount,
 	GeomHeader*	   header,
@@ -694,11 +1014,22 @@ extern "C" __global__ void Collapse_TriangleMesh_TriangleNode(
 	TriangleNode*  primNodes,
 	TriangleMesh   primitives,
 	uint32_t*	   taskCounter,
-	uint3*		   taskQueue )
+	uint3*		   taskQueue,
+	uint32_t	   maxLeafPrimCount )
 {
 	uint32_t index = threadIdx.x + blockIdx.x * blockDim.x;
 	Collapse<TriangleMesh, TriangleNode>(
-		index, leafCount, header, scratchNodes, references, boxNodes, primNodes, primitives, taskCounter, taskQueue );
+		index,
+		leafCount,
+		header,
+		scratchNodes,
+		references,
+		boxNodes,
+		primNodes,
+		primitives,
+		taskCounter,
+		taskQueue,
+		maxLeafPrimCount );
 }
 
 extern "C" __global__ void Collapse_AabbList_CustomNode(
@@ -710,11 +1041,22 @@ extern "C" __global__ void Collapse_AabbList_CustomNode(
 	CustomNode*	   primNodes,
 	AabbList	   primitives,
 	uint32_t*	   taskCounter,
-	uint3*		   taskQueue )
+	uint3*		   taskQueue,
+	uint32_t	   maxLeafPrimCount )
 {
 	uint32_t index = threadIdx.x + blockIdx.x * blockDim.x;
 	Collapse<AabbList, CustomNode>(
-		index, leafCount, header, scratchNodes, references, boxNodes, primNodes, primitives, taskCounter, taskQueue );
+		index,
+		leafCount,
+		header,
+		scratchNodes,
+		references,
+		boxNodes,
+		primNodes,
+		primitives,
+		taskCounter,
+		taskQueue,
+		maxLeafPrimCount );
 }
 
 extern "C" __global__ void Collapse_InstanceList_SRTFrame_InstanceNode(
@@ -726,11 +1068,22 @@ extern "C" __global__ void Collapse_InstanceList_SRTFrame_InstanceNode(
 	InstanceNode*		   primNodes,
 	InstanceList<SRTFrame> primitives,
 	uint32_t*			   taskCounter,
-	uint3*				   taskQueue )
+	uint3*				   taskQueue,
+	uint32_t			   maxLeafPrimCount )
 {
 	uint32_t index = threadIdx.x + blockIdx.x * blockDim.x;
 	Collapse<InstanceList<SRTFrame>, InstanceNode>(
-		index, leafCount, header, scratchNodes, references, boxNodes, primNodes, primitives, taskCounter, taskQueue );
+		index,
+		leafCount,
+		header,
+		scratchNodes,
+		references,
+		boxNodes,
+		primNodes,
+		primitives,
+		taskCounter,
+		taskQueue,
+		maxLeafPrimCount );
 }
 
 extern "C" __global__ void Collapse_InstanceList_MatrixFrame_InstanceNode(
@@ -742,11 +1095,210 @@ extern "C" __global__ void Collapse_InstanceList_MatrixFrame_InstanceNode(
 	InstanceNode*			  primNodes,
 	InstanceList<MatrixFrame> primitives,
 	uint32_t*				  taskCounter,
-	uint3*					  taskQueue )
+	uint3*					  taskQueue,
+	uint32_t				  maxLeafPrimCount )
 {
 	uint32_t index = threadIdx.x + blockIdx.x * blockDim.x;
 	Collapse<InstanceList<MatrixFrame>, InstanceNode>(
-		index, leafCount, header, scratchNodes, references, boxNodes, primNodes, primitives, taskCounter, taskQueue );
+		index,
+		leafCount,
+		header,
+		scratchNodes,
+		references,
+		boxNodes,
+		primNodes,
+		primitives,
+		taskCounter,
+		taskQueue,
+		maxLeafPrimCount );
+}
+
+extern "C" __global__ void CountCollapsedChildren_TriangleMesh_TriangleNode(
+	uint32_t	   taskCount,
+	ScratchNode*   scratchNodes,
+	ReferenceNode* references,
+	uint3*		   taskQueue,
+	uint32_t*	   boxCounts,
+	uint32_t*	   primCounts,
+	uint32_t	   maxLeafPrimCount )
+{
+	uint32_t index = threadIdx.x + blockIdx.x * blockDim.x;
+	CountCollapsedChildren<TriangleMesh, TriangleNode>(
+		index, taskCount, scratchNodes, references, taskQueue, boxCounts, primCounts, maxLeafPrimCount );
+}
+
+extern "C" __global__ void CountCollapsedChildren_AabbList_CustomNode(
+	uint32_t	   taskCount,
+	ScratchNode*   scratchNodes,
+	ReferenceNode* references,
+	uint3*		   taskQueue,
+	uint32_t*	   boxCounts,
+	uint32_t*	   primCounts,
+	uint32_t	   maxLeafPrimCount )
+{
+	uint32_t index = threadIdx.x + blockIdx.x * blockDim.x;
+	CountCollapsedChildren<AabbList, CustomNode>(
+		index, taskCount, scratchNodes, references, taskQueue, boxCounts, primCounts, maxLeafPrimCount );
+}
+
+extern "C" __global__ void CountCollapsedChildren_InstanceList_SRTFrame_InstanceNode(
+	uint32_t	   taskCount,
+	ScratchNode*   scratchNodes,
+	ReferenceNode* references,
+	uint3*		   taskQueue,
+	uint32_t*	   boxCounts,
+	uint32_t*	   primCounts,
+	uint32_t	   maxLeafPrimCount )
+{
+	uint32_t index = threadIdx.x + blockIdx.x * blockDim.x;
+	CountCollapsedChildren<InstanceList<SRTFrame>, InstanceNode>(
+		index, taskCount, scratchNodes, references, taskQueue, boxCounts, primCounts, maxLeafPrimCount );
+}
+
+extern "C" __global__ void CountCollapsedChildren_InstanceList_MatrixFrame_InstanceNode(
+	uint32_t	   taskCount,
+	ScratchNode*   scratchNodes,
+	ReferenceNode* references,
+	uint3*		   taskQueue,
+	uint32_t*	   boxCounts,
+	uint32_t*	   primCounts,
+	uint32_t	   maxLeafPrimCount )
+{
+	uint32_t index = threadIdx.x + blockIdx.x * blockDim.x;
+	CountCollapsedChildren<InstanceList<MatrixFrame>, InstanceNode>(
+		index, taskCount, scratchNodes, references, taskQueue, boxCounts, primCounts, maxLeafPrimCount );
+}
+
+extern "C" __global__ void CollapseLevel_TriangleMesh_TriangleNode(
+	uint32_t	   taskCount,
+	uint32_t	   boxNodeBase,
+	uint32_t	   primNodeBase,
+	ScratchNode*   scratchNodes,
+	ReferenceNode* references,
+	BoxNode*	   boxNodes,
+	TriangleNode*  primNodes,
+	TriangleMesh   primitives,
+	uint3*		   taskQueue,
+	uint3*		   nextTaskQueue,
+	uint32_t*	   boxOffsets,
+	uint32_t*	   primOffsets,
+	uint32_t	   maxLeafPrimCount )
+{
+	uint32_t index = threadIdx.x + blockIdx.x * blockDim.x;
+	CollapseLevel<TriangleMesh, TriangleNode>(
+		index,
+		taskCount,
+		boxNodeBase,
+		primNodeBase,
+		scratchNodes,
+		references,
+		boxNodes,
+		primNodes,
+		primitives,
+		taskQueue,
+		nextTaskQueue,
+		boxOffsets,
+		primOffsets,
+		maxLeafPrimCount );
+}
+
+extern "C" __global__ void CollapseLevel_AabbList_CustomNode(
+	uint32_t	   taskCount,
+	uint32_t	   boxNodeBase,
+	uint32_t	   primNodeBase,
+	ScratchNode*   scratchNodes,
+	ReferenceNode* references,
+	BoxNode*	   boxNodes,
+	CustomNode*	   primNodes,
+	AabbList	   primitives,
+	uint3*		   taskQueue,
+	uint3*		   nextTaskQueue,
+	uint32_t*	   boxOffsets,
+	uint32_t*	   primOffsets,
+	uint32_t	   maxLeafPrimCount )
+{
+	uint32_t index = threadIdx.x + blockIdx.x * blockDim.x;
+	CollapseLevel<AabbList, CustomNode>(
+		index,
+		taskCount,
+		boxNodeBase,
+		primNodeBase,
+		scratchNodes,
+		references,
+		boxNodes,
+		primNodes,
+		primitives,
+		taskQueue,
+		nextTaskQueue,
+		boxOffsets,
+		primOffsets,
+		maxLeafPrimCount );
+}
+
+extern "C" __global__ void CollapseLevel_InstanceList_SRTFrame_InstanceNode(
+	uint32_t			   taskCount,
+	uint32_t			   boxNodeBase,
+	uint32_t			   primNodeBase,
+	ScratchNode*		   scratchNodes,
+	ReferenceNode*		   references,
+	BoxNode*			   boxNodes,
+	InstanceNode*		   primNodes,
+	InstanceList<SRTFrame> primitives,
+	uint3*				   taskQueue,
+	uint3*				   nextTaskQueue,
+	uint32_t*			   boxOffsets,
+	uint32_t*			   primOffsets,
+	uint32_t			   maxLeafPrimCount )
+{
+	uint32_t index = threadIdx.x + blockIdx.x * blockDim.x;
+	CollapseLevel<InstanceList<SRTFrame>, InstanceNode>(
+		index,
+		taskCount,
+		boxNodeBase,
+		primNodeBase,
+		scratchNodes,
+		references,
+		boxNodes,
+		primNodes,
+		primitives,
+		taskQueue,
+		nextTaskQueue,
+		boxOffsets,
+		primOffsets,
+		maxLeafPrimCount );
+}
+
+extern "C" __global__ void CollapseLevel_InstanceList_MatrixFrame_InstanceNode(
+	uint32_t				  taskCount,
+	uint32_t				  boxNodeBase,
+	uint32_t				  primNodeBase,
+	ScratchNode*			  scratchNodes,
+	ReferenceNode*			  references,
+	BoxNode*				  boxNodes,
+	InstanceNode*			  primNodes,
+	InstanceList<MatrixFrame> primitives,
+	uint3*					  taskQueue,
+	uint3*					  nextTaskQueue,
+	uint32_t*				  boxOffsets,
+	uint32_t*				  primOffsets,
+	uint32_t				  maxLeafPrimCount )
+{
+	uint32_t index = threadIdx.x + blockIdx.x * blockDim.x;
+	CollapseLevel<InstanceList<MatrixFrame>, InstanceNode>(
+		index,
+		taskCount,
+		boxNodeBase,
+		primNodeBase,
+		scratchNodes,
+		references,
+		boxNodes,
+		primNodes,
+		primitives,
+		taskQueue,
+		nextTaskQueue,
+		boxOffsets,
+		primOffsets,
+		maxLeafPrimCount );
 }
 
 extern "C" __global__ void ComputeCost( uint32_t nodeCount, BoxNode* boxNodes, float* costCounter )
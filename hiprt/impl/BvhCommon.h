@@ -89,16 +89,39 @@ HIPRT_INLINE HIPRT_HOST_DEVICE size_t getSceneStorageBufferSize(
 		   RoundUp( frameCount * sizeof( Frame ), DefaultAlignment );
 }
 
+// the level-by-level collapse of deterministic builds needs a second task queue and per-task node counts
+HIPRT_INLINE HIPRT_HOST_DEVICE size_t getDeterministicCollapseBufferSize( const size_t count )
+{
+	return RoundUp( count * sizeof( uint3 ), DefaultAlignment ) + 2 * RoundUp( count * sizeof( uint32_t ), DefaultAlignment ) +
+		   RoundUp( sizeof( uint2 ), DefaultAlignment );
+}
+
+HIPRT_INLINE HIPRT_HOST_DEVICE uint32_t
+getTimeSegmentCount( const hiprtSceneBuildInput& buildInput, const hiprtBuildOptions buildOptions )
+{
+	// only scenes with several frames are split in time (static instances just share the segments' frames)
+	if ( buildInput.instanceTransformHeaders == nullptr || buildInput.frameCount <= 1 ||
+		 ( buildOptions.buildFlags & 7 ) == hiprtBuildFlagBitCustomBvhImport || buildOptions.timeSegmentCount <= 1 )
+		return 1u;
+	return buildOptions.timeSegmentCount < MaxTimeSegmentCount ? buildOptions.timeSegmentCount : MaxTimeSegmentCount;
+}
+
 HIPRT_INLINE HIPRT_HOST_DEVICE bool
 batchBuild( const hiprtGeometryBuildInput& buildInput, const hiprtBuildOptions buildOptions )
 {
+	// the batch kernel does not pair triangles, the global pairing needs the regular builders
 	return getPrimCount( buildInput ) <= buildOptions.batchBuildMaxPrimCount &&
-		   ( buildOptions.buildFlags & 7 ) != hiprtBuildFlagBitCustomBvhImport;
+		   ( buildOptions.buildFlags & 7 ) != hiprtBuildFlagBitCustomBvhImport &&
+		   !( buildOptions.buildFlags & hiprtBuildFlagBitDeterministic ) &&
+		   !( buildInput.type == hiprtPrimitiveTypeTriangleMesh &&
+			  ( buildOptions.buildFlags & hiprtBuildFlagBitGlobalTrianglePairing ) );
 }
 
 HIPRT_INLINE HIPRT_HOST_DEVICE bool batchBuild( const hiprtSceneBuildInput& buildInput, const hiprtBuildOptions buildOptions )
 {
 	return buildInput.instanceCount <= buildOptions.batchBuildMaxPrimCount &&
-		   ( buildOptions.buildFlags & 7 ) != hiprtBuildFlagBitCustomBvhImport;
+		   ( buildOptions.buildFlags & 7 ) != hiprtBuildFlagBitCustomBvhImport &&
+		   !( buildOptions.buildFlags & hiprtBuildFlagBitDeterministic ) &&
+		   getTimeSegmentCount( buildInput, buildOptions ) == 1;
 }
 } // namespace hiprt
@@ -130,9 +130,9 @@ void BvhImporter::build(
 	std::vector<const char*> opts;
 	// opts.push_back("-G");
 
-	std::string containerParam	   = Compiler::kernelNameSufix( Traits<PrimitiveContainer>::TYPE_NAME );
-	std::string nodeParam		   = Compiler::kernelNameSufix( Traits<PrimitiveNode>::TYPE_NAME );
-	std::string containerNodeParam = containerParam + "_" + nodeParam;
+	static const std::string containerParam		= Compiler::kernelNameSufix( Traits<PrimitiveContainer>::TYPE_NAME );
+	static const std::string nodeParam			= Compiler::kernelNameSufix( Traits<PrimitiveNode>::TYPE_NAME );
+	static const std::string containerNodeParam	= containerParam + "_" + nodeParam;
 
 	// STEP 0: Init data
 	if constexpr ( std::is_same<Header, SceneHeader>::value )
@@ -141,12 +141,10 @@ void BvhImporter::build(
 		Frame*	  frames	= storageMemoryArena.allocate<Frame>( primitives.getFrameCount() );
 
 		primitives.setFrames( frames );
-		Kernel initDataKernel = compiler.getKernel(
-			context,
-			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-			"InitSceneData_" + containerParam,
-			opts,
-			GET_ARG_LIST( BvhBuilderKernels ) );
+		static const Compiler::KernelKey initDataKey(
+			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "InitSceneData_" + containerParam );
+		Kernel							 initDataKernel =
+			compiler.getKernel( context, initDataKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 		initDataKernel.setArgs(
 			{ storageMemoryArena.getStorageSize(), primitives, boxNodes, primNodes, instances, frames, header } );
 		initDataKernel.launch( std::max( primitives.getFrameCount(), primitives.getCount() ), stream );
@@ -155,12 +153,10 @@ void BvhImporter::build(
 	{
 		geomType <<= 1;
 		if constexpr ( std::is_same<PrimitiveNode, TriangleNode>::value ) geomType |= 1;
-		Kernel initDataKernel = compiler.getKernel(
-			context,
-			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-			"InitGeomData",
-			opts,
-			GET_ARG_LIST( BvhBuilderKernels ) );
+		static const Compiler::KernelKey initDataKey(
+			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "InitGeomData" );
+		Kernel							 initDataKernel =
+			compiler.getKernel( context, initDataKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 		initDataKernel.setArgs(
 			{ storageMemoryArena.getStorageSize(), primitives.getCount(), boxNodes, primNodes, geomType, header } );
 		initDataKernel.launch( 1, stream );
@@ -169,34 +165,28 @@ void BvhImporter::build(
 	// A single primitive => special case
 	if ( primitives.getCount() == 1 )
 	{
-		Kernel singletonConstructionKernel = compiler.getKernel(
-			context,
-			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-			"SingletonConstruction_" + containerNodeParam,
-			opts,
-			GET_ARG_LIST( BvhBuilderKernels ) );
+		static const Compiler::KernelKey singletonConstructionKey(
+			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "SingletonConstruction_" + containerNodeParam );
+		Kernel							 singletonConstructionKernel =
+			compiler.getKernel( context, singletonConstructionKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 		singletonConstructionKernel.setArgs( { primitives, boxNodes, primNodes } );
 		singletonConstructionKernel.launch( 1, stream );
 		return;
 	}
 
 	// STEP 1: Setup leaves
-	Kernel setupLeavesKernel = compiler.getKernel(
-		context,
-		Utility::getRootDir() / "hiprt/impl/BvhImporterKernels.h",
-		"SetupLeaves_" + containerNodeParam,
-		opts,
-		GET_ARG_LIST( BvhImporterKernels ) );
+	static const Compiler::KernelKey setupLeavesKey(
+		Utility::getRootDir() / "hiprt/impl/BvhImporterKernels.h", "SetupLeaves_" + containerNodeParam );
+	Kernel							 setupLeavesKernel =
+		compiler.getKernel( context, setupLeavesKey, opts, GET_ARG_LIST( BvhImporterKernels ) );
 	setupLeavesKernel.setArgs( { primitives, primNodes } );
 	setupLeavesKernel.launch( primitives.getCount(), stream );
 
 	// STEP 2: Convert to internal format
-	Kernel convertKernel = compiler.getKernel(
-		context,
-		Utility::getRootDir() / "hiprt/impl/BvhImporterKernels.h",
-		"Convert_" + containerNodeParam,
-		opts,
-		GET_ARG_LIST( BvhImporterKernels ) );
+	static const Compiler::KernelKey convertKey(
+		Utility::getRootDir() / "hiprt/impl/BvhImporterKernels.h", "Convert_" + containerNodeParam );
+	Kernel							 convertKernel =
+		compiler.getKernel( context, convertKey, opts, GET_ARG_LIST( BvhImporterKernels ) );
 	convertKernel.setArgs( { primitives, nodes, boxNodes, primNodes } );
 	convertKernel.launch( nodes.getCount(), stream );
 
@@ -206,12 +196,10 @@ void BvhImporter::build(
 		float*	 costCounter = nullptr;
 		checkOro( oroMalloc( reinterpret_cast<oroDeviceptr*>( &costCounter ), sizeof( float ) ) );
 		checkOro( oroMemsetD8Async( reinterpret_cast<oroDeviceptr>( costCounter ), 0, sizeof( float ), stream ) );
-		Kernel computeCostKernel = compiler.getKernel(
-			context,
-			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-			"ComputeCost",
-			opts,
-			GET_ARG_LIST( BvhBuilderKernels ) );
+		static const Compiler::KernelKey computeCostKey(
+			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "ComputeCost" );
+		Kernel							 computeCostKernel =
+			compiler.getKernel( context, computeCostKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 		computeCostKernel.setArgs( { nodeCount, boxNodes, costCounter } );
 		computeCostKernel.launch( nodeCount, ReductionBlockSize, stream );
 
@@ -157,9 +157,16 @@ struct alignas( DefaultAlignment ) TriangleNode
 };
 HIPRT_STATIC_ASSERT( sizeof( TriangleNode ) == 64 );
 
-// 8B
+// 4B
+// A leaf may span several consecutive custom nodes; all but the last one have the next bit set
 struct alignas( 4 ) CustomNode
 {
+	static constexpr uint32_t NextBit = 1u << 31;
+
+	HIPRT_HOST_DEVICE uint32_t getPrimIndex() const { return m_primIndex & ~NextBit; }
+
+	HIPRT_HOST_DEVICE bool hasNext() const { return m_primIndex != InvalidValue && ( m_primIndex & NextBit ) != 0; }
+
 	uint32_t m_primIndex = InvalidValue;
 };
 HIPRT_STATIC_ASSERT( sizeof( CustomNode ) == 4 );
@@ -0,0 +1,102 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <hiprt/impl/BvhStatistics.h>
+#include <algorithm>
+
+namespace hiprt
+{
+hiprtBvhStatistics BvhStatistics::compute(
+	const std::vector<BoxNode>& boxNodes, const std::function<void( uint32_t, std::vector<uint32_t>& )>& getLeafPrimIndices )
+{
+	hiprtBvhStatistics stats;
+	if ( boxNodes.empty() ) return stats;
+
+	const float rootArea	= boxNodes[0].area();
+	const float rootAreaInv = rootArea > 0.0f ? 1.0f / rootArea : 0.0f;
+
+	std::vector<uint32_t> primIndices;
+	uint64_t			  leafDepthSum = 0;
+	float				  overlapArea  = 0.0f;
+	float				  childArea	   = 0.0f;
+
+	std::vector<std::pair<uint32_t, uint32_t>> stack;
+	stack.push_back( { 0u, 0u } );
+	stats.sahCost = Ct;
+	while ( !stack.empty() )
+	{
+		const auto [nodeAddr, depth] = stack.back();
+		stack.pop_back();
+		if ( nodeAddr >= boxNodes.size() ) throw std::runtime_error( "Invalid box node address" );
+
+		const BoxNode& node = boxNodes[nodeAddr];
+		stats.boxNodeCount++;
+		stats.childCountHistogram[std::min( node.m_childCount, BranchingFactor )]++;
+
+		for ( uint32_t i = 0; i < BranchingFactor; ++i )
+		{
+			const uint32_t childIndex = ( &node.m_childIndex0 )[i];
+			if ( childIndex == InvalidValue ) continue;
+
+			const Aabb& box = ( &node.m_box0 )[i];
+			childArea += box.area();
+			for ( uint32_t j = i + 1; j < BranchingFactor; ++j )
+			{
+				if ( ( &node.m_childIndex0 )[j] == InvalidValue ) continue;
+				Aabb overlap = box;
+				overlap.intersect( ( &node.m_box0 )[j] );
+				if ( overlap.valid() ) overlapArea += overlap.area();
+			}
+
+			if ( isInternalNode( childIndex ) )
+			{
+				stats.sahCost += Ct * box.area() * rootAreaInv;
+				stack.push_back( { getNodeAddr( childIndex ), depth + 1 } );
+			}
+			else
+			{
+				stats.sahCost += Ci * box.area() * rootAreaInv;
+				stats.leafNodeCount++;
+				stats.maxDepth = std::max( stats.maxDepth, depth + 1 );
+				leafDepthSum += depth + 1;
+				getLeafPrimIndices( childIndex, primIndices );
+			}
+		}
+	}
+
+	stats.primReferenceCount = static_cast<uint32_t>( primIndices.size() );
+	std::sort( primIndices.begin(), primIndices.end() );
+	stats.primCount = static_cast<uint32_t>( std::unique( primIndices.begin(), primIndices.end() ) - primIndices.begin() );
+
+	if ( stats.leafNodeCount > 0 )
+		stats.averageLeafDepth = static_cast<float>( leafDepthSum ) / static_cast<float>( stats.leafNodeCount );
+	if ( childArea > 0.0f ) stats.siblingOverlapRatio = overlapArea / childArea;
+	if ( stats.primCount > 0 )
+		stats.referenceDuplicationFactor =
+			static_cast<float>( stats.primReferenceCount ) / static_cast<float>( stats.primCount );
+
+	return stats;
+}
+} // namespace hiprt
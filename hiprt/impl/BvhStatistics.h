@@ -0,0 +1,48 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <hiprt/hiprt_types.h>
+#include <hiprt/impl/BvhNode.h>
+#include <functional>
+#include <vector>
+
+namespace hiprt
+{
+class BvhStatistics
+{
+  public:
+	BvhStatistics()									 = delete;
+	BvhStatistics& operator=( const BvhStatistics& ) = delete;
+
+	/// @brief Walks the box nodes from the root and gathers the statistics
+	/// @param boxNodes The box nodes copied to the host
+	/// @param getLeafPrimIndices Appends the primitive indices referenced by a leaf node
+	/// @return The Bvh statistics
+	static hiprtBvhStatistics compute(
+		const std::vector<BoxNode>&									  boxNodes,
+		const std::function<void( uint32_t, std::vector<uint32_t>& )>& getLeafPrimIndices );
+};
+} // namespace hiprt
@@ -0,0 +1,729 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <hiprt/impl/CachePack.h>
+#include <hiprt/impl/Logger.h>
+#include <hiprt/impl/Utility.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+
+#if defined( _WIN32 )
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+using hiprt::CachePack;
+
+constexpr size_t EntryHeaderSize  = 4u * sizeof( uint64_t ) + 3u * sizeof( uint32_t );
+constexpr size_t AccessRecordSize = sizeof( uint64_t ) + sizeof( int64_t );
+
+// the offset of an index entry removing the binary of its key
+constexpr uint64_t RemovedOffset = ~0ull;
+
+template <typename T>
+T readValue( const char* data )
+{
+	T value;
+	std::memcpy( &value, data, sizeof( T ) );
+	return value;
+}
+
+template <typename T>
+void appendValue( std::string& buffer, const T value )
+{
+	buffer.append( reinterpret_cast<const char*>( &value ), sizeof( T ) );
+}
+
+std::string makeHeader( uint32_t magic, uint64_t generation )
+{
+	std::string header;
+	appendValue( header, magic );
+	appendValue( header, CachePack::PackVersion );
+	appendValue( header, generation );
+	return header;
+}
+
+bool readHeader( const char* data, size_t size, uint32_t magic, uint64_t& generation )
+{
+	if ( size < CachePack::HeaderSize ) return false;
+	if ( readValue<uint32_t>( data ) != magic || readValue<uint32_t>( data + sizeof( uint32_t ) ) != CachePack::PackVersion )
+		return false;
+	generation = readValue<uint64_t>( data + 2u * sizeof( uint32_t ) );
+	return true;
+}
+
+std::string serializeEntry( const std::string& key, const CachePack::Entry& entry )
+{
+	std::string record;
+	appendValue( record, entry.offset );
+	appendValue( record, entry.size );
+	appendValue( record, entry.checksum );
+	appendValue( record, entry.timestamp );
+	appendValue( record, static_cast<uint32_t>( key.size() ) );
+	appendValue( record, static_cast<uint32_t>( entry.device.size() ) );
+	appendValue( record, static_cast<uint32_t>( entry.version.size() ) );
+	record += key + entry.device + entry.version;
+	return record;
+}
+
+uint64_t hashKey( const std::string& key ) { return hiprt::Utility::hash64( key.data(), key.size() ); }
+
+uint64_t getFileSize( const std::filesystem::path& path )
+{
+	std::error_code error;
+	uint64_t		size = std::filesystem::file_size( path, error );
+	return error ? 0u : size;
+}
+
+// the data reaches the disk before another file refers to it
+void syncFile( const std::filesystem::path& path )
+{
+#if defined( _WIN32 )
+	HANDLE file = CreateFileW(
+		path.c_str(),
+		GENERIC_WRITE,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL,
+		nullptr );
+	const bool synced = file != INVALID_HANDLE_VALUE && FlushFileBuffers( file );
+	if ( file != INVALID_HANDLE_VALUE ) CloseHandle( file );
+#else
+	int		   file	  = ::open( path.c_str(), O_WRONLY );
+	const bool synced = file >= 0 && fsync( file ) == 0;
+	if ( file >= 0 ) ::close( file );
+#endif
+	if ( !synced )
+	{
+		std::string msg = hiprt::Utility::format( "Unable to sync '%s'", path.string().c_str() );
+		throw std::runtime_error( msg );
+	}
+}
+
+void writeFile( const std::filesystem::path& path, const std::string& data, std::ios::openmode mode )
+{
+	{
+		std::ofstream file( path, std::ios::out | std::ios::binary | mode );
+		if ( !file.is_open() )
+		{
+			std::string msg = hiprt::Utility::format( "Unable to open '%s'", path.string().c_str() );
+			throw std::runtime_error( msg );
+		}
+		file.write( data.data(), data.size() );
+		file.close();
+		if ( !file.good() )
+		{
+			std::string msg = hiprt::Utility::format( "Unable to write '%s'", path.string().c_str() );
+			throw std::runtime_error( msg );
+		}
+	}
+	syncFile( path );
+}
+
+// the caller holds the lock of the pack, a failed append is cut off so that the next one starts after complete data
+void appendFile( const std::filesystem::path& path, const std::string& data )
+{
+	const uint64_t size = getFileSize( path );
+	try
+	{
+		writeFile( path, data, std::ios::app );
+	}
+	catch ( std::exception& )
+	{
+		std::error_code error;
+		std::filesystem::resize_file( path, size, error );
+		throw;
+	}
+}
+
+// readers still mapping the old file are not affected by the atomic rename
+void publishFile( const std::filesystem::path& path, const std::string& data )
+{
+	std::filesystem::path tmpPath = path;
+	tmpPath += ".tmp";
+	writeFile( tmpPath, data, std::ios::trunc );
+	std::filesystem::rename( tmpPath, path );
+}
+
+uint64_t newGeneration()
+{
+	std::random_device device;
+	return ( static_cast<uint64_t>( device() ) << 32u ) ^ device() ^
+		   static_cast<uint64_t>( std::chrono::steady_clock::now().time_since_epoch().count() );
+}
+
+int64_t now() { return std::filesystem::file_time_type::clock::now().time_since_epoch().count(); }
+} // namespace
+
+namespace hiprt
+{
+MappedFile::~MappedFile() { close(); }
+
+bool MappedFile::open( const std::filesystem::path& path )
+{
+	close();
+#if defined( _WIN32 )
+	HANDLE file = CreateFileW(
+		path.c_str(),
+		GENERIC_READ,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL,
+		nullptr );
+	if ( file == INVALID_HANDLE_VALUE ) return false;
+
+	LARGE_INTEGER size;
+	if ( !GetFileSizeEx( file, &size ) )
+	{
+		CloseHandle( file );
+		return false;
+	}
+	m_file = file;
+	if ( size.QuadPart == 0 ) return true;
+
+	m_mapping = CreateFileMappingW( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+	if ( m_mapping == nullptr )
+	{
+		close();
+		return false;
+	}
+
+	m_data = reinterpret_cast<const char*>( MapViewOfFile( m_mapping, FILE_MAP_READ, 0, 0, 0 ) );
+	if ( m_data == nullptr )
+	{
+		close();
+		return false;
+	}
+	m_size = static_cast<size_t>( size.QuadPart );
+#else
+	int file = ::open( path.c_str(), O_RDONLY );
+	if ( file < 0 ) return false;
+
+	struct stat info;
+	if ( fstat( file, &info ) != 0 )
+	{
+		::close( file );
+		return false;
+	}
+
+	if ( info.st_size > 0 )
+	{
+		void* data = mmap( nullptr, static_cast<size_t>( info.st_size ), PROT_READ, MAP_SHARED, file, 0 );
+		if ( data != MAP_FAILED )
+		{
+			m_data = reinterpret_cast<const char*>( data );
+			m_size = static_cast<size_t>( info.st_size );
+		}
+	}
+	::close( file );
+	if ( info.st_size > 0 && m_data == nullptr ) return false;
+#endif
+	return true;
+}
+
+void MappedFile::close()
+{
+#if defined( _WIN32 )
+	if ( m_data != nullptr ) UnmapViewOfFile( m_data );
+	if ( m_mapping != nullptr ) CloseHandle( m_mapping );
+	if ( m_file != nullptr ) CloseHandle( m_file );
+	m_mapping = nullptr;
+	m_file	  = nullptr;
+#else
+	if ( m_data != nullptr ) munmap( const_cast<char*>( m_data ), m_size );
+#endif
+	m_data = nullptr;
+	m_size = 0u;
+}
+
+FileLock::FileLock( const std::filesystem::path& path )
+{
+	// file locks do not exclude the threads of one process from each other on every platform
+	static std::mutex registryMutex;
+
+	static std::unordered_map<std::string, std::unique_ptr<std::mutex>> registry;
+	{
+		std::lock_guard<std::mutex> lock( registryMutex );
+		auto&						mutex = registry[std::filesystem::absolute( path ).string()];
+		if ( !mutex ) mutex = std::make_unique<std::mutex>();
+		m_threadLock = std::unique_lock<std::mutex>( *mutex );
+	}
+
+#if defined( _WIN32 )
+	HANDLE file = CreateFileW(
+		path.c_str(),
+		GENERIC_READ | GENERIC_WRITE,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr,
+		OPEN_ALWAYS,
+		FILE_ATTRIBUTE_NORMAL,
+		nullptr );
+	if ( file == INVALID_HANDLE_VALUE )
+	{
+		std::string msg = Utility::format( "Unable to open '%s'", path.string().c_str() );
+		throw std::runtime_error( msg );
+	}
+
+	OVERLAPPED overlapped{};
+	if ( !LockFileEx( file, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped ) )
+	{
+		CloseHandle( file );
+		std::string msg = Utility::format( "Unable to lock '%s'", path.string().c_str() );
+		throw std::runtime_error( msg );
+	}
+	m_file = file;
+#else
+	m_file = ::open( path.c_str(), O_RDWR | O_CREAT, 0666 );
+	if ( m_file < 0 )
+	{
+		std::string msg = Utility::format( "Unable to open '%s'", path.string().c_str() );
+		throw std::runtime_error( msg );
+	}
+
+	struct flock lock{};
+	lock.l_type	  = F_WRLCK;
+	lock.l_whence = SEEK_SET;
+	int result;
+	do
+	{
+		result = fcntl( m_file, F_SETLKW, &lock );
+	} while ( result != 0 && errno == EINTR );
+	if ( result != 0 )
+	{
+		::close( m_file );
+		std::string msg = Utility::format( "Unable to lock '%s'", path.string().c_str() );
+		throw std::runtime_error( msg );
+	}
+#endif
+}
+
+FileLock::~FileLock()
+{
+#if defined( _WIN32 )
+	OVERLAPPED overlapped{};
+	UnlockFileEx( m_file, 0, MAXDWORD, MAXDWORD, &overlapped );
+	CloseHandle( m_file );
+#else
+	// closing the descriptor releases the lock
+	::close( m_file );
+#endif
+}
+
+CachePack::~CachePack()
+{
+	try
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		flushAccessTimes();
+	}
+	catch ( std::exception& e )
+	{
+		logWarn( "%s\n", e.what() );
+	}
+}
+
+void CachePack::setDirectory( const std::filesystem::path& directory )
+{
+	std::lock_guard<std::mutex> lock( m_mutex );
+	if ( directory == m_directory ) return;
+
+	flushAccessTimes();
+	m_directory	 = directory;
+	m_opened	 = false;
+	m_indexSize	 = 0u;
+	m_generation = 0u;
+	m_entries.clear();
+	m_pack.close();
+}
+
+void CachePack::setSizeLimit( size_t sizeLimit )
+{
+	std::lock_guard<std::mutex> lock( m_mutex );
+	m_sizeLimit = sizeLimit;
+}
+
+void CachePack::setReadOnly( bool readOnly )
+{
+	std::lock_guard<std::mutex> lock( m_mutex );
+	m_readOnly = readOnly;
+}
+
+std::optional<CachePack::Entry> CachePack::find( const std::string& key )
+{
+	std::lock_guard<std::mutex> lock( m_mutex );
+	open();
+
+	auto entry = m_entries.find( key );
+	if ( entry == m_entries.end() )
+	{
+		// other processes may have added it since the index was read
+		readIndex();
+		entry = m_entries.find( key );
+		if ( entry == m_entries.end() ) return std::nullopt;
+	}
+	return entry->second;
+}
+
+std::optional<std::string> CachePack::load( const std::string& key )
+{
+	std::lock_guard<std::mutex> lock( m_mutex );
+	open();
+
+	auto it = m_entries.find( key );
+	if ( it == m_entries.end() ) return std::nullopt;
+
+	if ( !mapPack( it->second.offset + it->second.size ) )
+	{
+		// the pack was trimmed by another process, the lock guarantees a consistent pack and index
+		FileLock fileLock( lockPath() );
+		readIndex();
+		it = m_entries.find( key );
+		if ( it == m_entries.end() || !mapPack( it->second.offset + it->second.size ) ) return std::nullopt;
+	}
+
+	const Entry entry = it->second;
+	std::string binary( m_pack.data() + entry.offset, entry.size );
+	uint64_t	hash = Utility::hash64( binary.data(), binary.size() );
+	if ( hash != entry.checksum )
+	{
+		logWarn(
+			"Checksum doesn't match %llx : %llx, '%s' is removed from the cache\n",
+			static_cast<unsigned long long>( hash ),
+			static_cast<unsigned long long>( entry.checksum ),
+			key.c_str() );
+		removeCorrupted( key, entry );
+		return std::nullopt;
+	}
+
+	m_accessTimes[key] = now();
+	return binary;
+}
+
+void CachePack::store( const std::string& key, const std::string& binary, const std::string& device, const std::string& version )
+{
+	if ( key.size() > MaxKeyLength ) throw std::runtime_error( "Cache key is too long" );
+
+	std::lock_guard<std::mutex> lock( m_mutex );
+	FileLock					fileLock( lockPath() );
+	open();
+
+	// pick up the entries appended by other processes, the offsets below are only valid under the lock
+	readIndex();
+
+	MappedFile index;
+	uint64_t   generation;
+	if ( !index.open( indexPath() ) || !readHeader( index.data(), index.size(), IndexMagic, generation ) ) resetFiles();
+	index.close();
+
+	// drop a partially written entry of a crashed writer so that the following ones stay reachable
+	if ( m_indexSize < getFileSize( indexPath() ) ) std::filesystem::resize_file( indexPath(), m_indexSize );
+
+	Entry entry;
+	entry.offset	= getFileSize( packPath() );
+	entry.size		= binary.size();
+	entry.checksum	= Utility::hash64( binary.data(), binary.size() );
+	entry.timestamp = now();
+	entry.device	= device;
+	entry.version	= version;
+
+	// the binary is on the disk before the index refers to it, and the index before the entry is used
+	appendFile( packPath(), binary );
+
+	const std::string record = serializeEntry( key, entry );
+	appendFile( indexPath(), record );
+	m_indexSize += record.size();
+	m_entries[key] = entry;
+
+	if ( m_sizeLimit > 0u && getFileSize( packPath() ) > m_sizeLimit )
+		trimLocked( m_sizeLimit / 10u * 9u, device, version );
+}
+
+std::filesystem::path CachePack::getKeyLockPath( const std::string& key )
+{
+	// a fixed set of lock files shared by the keys keeps the directory bounded
+	std::filesystem::path lockDir = m_directory / LockDirname;
+	std::error_code		  error;
+	std::filesystem::create_directories( lockDir, error );
+	return lockDir / Utility::format( "%02x.lock", static_cast<uint32_t>( hashKey( key ) % KeyLockCount ) );
+}
+
+void CachePack::trim( size_t maxSize, const std::string& device, const std::string& version )
+{
+	std::lock_guard<std::mutex> lock( m_mutex );
+	FileLock					fileLock( lockPath() );
+	open();
+	readIndex();
+	trimLocked( maxSize, device, version );
+}
+
+hiprtCacheStatistics CachePack::getStatistics( const std::string& device, const std::string& version )
+{
+	std::lock_guard<std::mutex> lock( m_mutex );
+	open();
+	readIndex();
+
+	hiprtCacheStatistics statistics;
+	for ( const auto& [key, entry] : m_entries )
+	{
+		if ( entry.device == device && entry.version != version )
+		{
+			statistics.staleEntryCount++;
+			statistics.staleSize += entry.size;
+		}
+		statistics.entryCount++;
+		statistics.size += entry.size;
+	}
+	statistics.fileSize = getFileSize( packPath() ) + getFileSize( indexPath() ) + getFileSize( accessPath() );
+	return statistics;
+}
+
+void CachePack::open()
+{
+	if ( m_opened ) return;
+	m_opened = true;
+	readIndex();
+}
+
+void CachePack::readIndex()
+{
+	MappedFile index;
+	if ( !index.open( indexPath() ) ) return;
+
+	// an incompatible index is replaced by the next store
+	const char*	 data = index.data();
+	const size_t size = index.size();
+	uint64_t	 generation;
+	if ( !readHeader( data, size, IndexMagic, generation ) ) return;
+
+	// a trimmed pack is a new generation, the offsets of the old one are not valid anymore
+	if ( generation != m_generation )
+	{
+		m_entries.clear();
+		m_pack.close();
+		m_indexSize	 = 0u;
+		m_generation = generation;
+	}
+
+	// the index is append-only, continue after the entries read before
+	uint64_t pos = std::max<uint64_t>( m_indexSize, HeaderSize );
+	while ( pos + EntryHeaderSize <= size )
+	{
+		const char*	   record		 = data + pos;
+		const uint32_t keyLength	 = readValue<uint32_t>( record + 4u * sizeof( uint64_t ) );
+		const uint32_t deviceLength	 = readValue<uint32_t>( record + 4u * sizeof( uint64_t ) + sizeof( uint32_t ) );
+		const uint32_t versionLength = readValue<uint32_t>( record + 4u * sizeof( uint64_t ) + 2u * sizeof( uint32_t ) );
+		const uint64_t recordSize	 = EntryHeaderSize + keyLength + deviceLength + versionLength;
+		if ( keyLength > MaxKeyLength || deviceLength > MaxKeyLength || versionLength > MaxKeyLength ) break;
+		if ( pos + recordSize > size ) break;
+
+		Entry entry;
+		entry.offset	= readValue<uint64_t>( record );
+		entry.size		= readValue<uint64_t>( record + sizeof( uint64_t ) );
+		entry.checksum	= readValue<uint64_t>( record + 2u * sizeof( uint64_t ) );
+		entry.timestamp = readValue<int64_t>( record + 3u * sizeof( uint64_t ) );
+		entry.device	= std::string( record + EntryHeaderSize + keyLength, deviceLength );
+		entry.version	= std::string( record + EntryHeaderSize + keyLength + deviceLength, versionLength );
+
+		// later entries override earlier ones with the same key
+		std::string key( record + EntryHeaderSize, keyLength );
+		if ( entry.offset == RemovedOffset )
+			m_entries.erase( key );
+		else
+			m_entries[key] = entry;
+		pos += recordSize;
+	}
+	m_indexSize = pos;
+}
+
+void CachePack::removeCorrupted( const std::string& key, const Entry& entry )
+{
+	const uint64_t generation = m_generation;
+	m_entries.erase( key );
+	if ( m_readOnly ) return;
+
+	FileLock fileLock( lockPath() );
+	readIndex();
+
+	// another process may have stored the binary again or trimmed the pack meanwhile
+	if ( generation != m_generation || m_entries.find( key ) != m_entries.end() ) return;
+
+	MappedFile index;
+	uint64_t   indexGeneration;
+	if ( !index.open( indexPath() ) || !readHeader( index.data(), index.size(), IndexMagic, indexGeneration ) ) return;
+	index.close();
+
+	if ( m_indexSize < getFileSize( indexPath() ) ) std::filesystem::resize_file( indexPath(), m_indexSize );
+
+	Entry removed  = entry;
+	removed.offset = RemovedOffset;
+	const std::string record = serializeEntry( key, removed );
+	appendFile( indexPath(), record );
+	m_indexSize += record.size();
+}
+
+void CachePack::resetFiles()
+{
+	const uint64_t generation = newGeneration();
+	m_pack.close();
+	publishFile( packPath(), makeHeader( PackMagic, generation ) );
+	publishFile( accessPath(), makeHeader( AccessMagic, generation ) );
+	publishFile( indexPath(), makeHeader( IndexMagic, generation ) );
+	m_entries.clear();
+	m_indexSize	 = HeaderSize;
+	m_generation = generation;
+}
+
+bool CachePack::mapPack( uint64_t requiredSize )
+{
+	if ( m_pack.size() >= requiredSize ) return true;
+	if ( !m_pack.open( packPath() ) ) return false;
+
+	uint64_t generation;
+	if ( !readHeader( m_pack.data(), m_pack.size(), PackMagic, generation ) || generation != m_generation )
+	{
+		m_pack.close();
+		return false;
+	}
+	return m_pack.size() >= requiredSize;
+}
+
+void CachePack::flushAccessTimes()
+{
+	if ( m_accessTimes.empty() ) return;
+
+	FileLock fileLock( lockPath() );
+	flushAccessTimesLocked();
+}
+
+void CachePack::flushAccessTimesLocked()
+{
+	if ( m_accessTimes.empty() ) return;
+
+	std::string records;
+	for ( const auto& [key, time] : m_accessTimes )
+	{
+		appendValue( records, hashKey( key ) );
+		appendValue( records, time );
+	}
+	m_accessTimes.clear();
+
+	// the access times of an older generation are dropped with it
+	MappedFile access;
+	uint64_t   generation;
+	if ( !access.open( accessPath() ) || !readHeader( access.data(), access.size(), AccessMagic, generation ) ||
+		 generation != m_generation )
+		return;
+	access.close();
+
+	appendFile( accessPath(), records );
+}
+
+void CachePack::trimLocked( size_t maxSize, const std::string& device, const std::string& version )
+{
+	flushAccessTimesLocked();
+
+	// last use of every entry, either its creation or the latest recorded access
+	std::unordered_map<uint64_t, int64_t> lastUses;
+	for ( const auto& [key, entry] : m_entries )
+		lastUses[hashKey( key )] = entry.timestamp;
+	{
+		MappedFile access;
+		uint64_t   generation;
+		if ( access.open( accessPath() ) && readHeader( access.data(), access.size(), AccessMagic, generation ) &&
+			 generation == m_generation )
+		{
+			for ( size_t pos = HeaderSize; pos + AccessRecordSize <= access.size(); pos += AccessRecordSize )
+			{
+				auto lastUse = lastUses.find( readValue<uint64_t>( access.data() + pos ) );
+				if ( lastUse != lastUses.end() )
+					lastUse->second = std::max( lastUse->second, readValue<int64_t>( access.data() + pos + sizeof( uint64_t ) ) );
+			}
+		}
+	}
+
+	// entries of this device built for another HIPRT or driver version are never used again
+	std::vector<std::pair<int64_t, const std::string*>> candidates;
+	for ( const auto& [key, entry] : m_entries )
+	{
+		if ( entry.device == device && entry.version != version ) continue;
+		candidates.push_back( { lastUses[hashKey( key )], &key } );
+	}
+	std::sort( candidates.begin(), candidates.end(), []( const auto& a, const auto& b ) { return a.first > b.first; } );
+
+	uint64_t packSize = 0u;
+	for ( const auto& [key, entry] : m_entries )
+		packSize = std::max( packSize, entry.offset + entry.size );
+	if ( !m_entries.empty() && !mapPack( packSize ) ) throw std::runtime_error( "Unable to map the kernel cache pack" );
+
+	const uint64_t generation = newGeneration();
+	std::string	   pack		  = makeHeader( PackMagic, generation );
+	std::string	   index	  = makeHeader( IndexMagic, generation );
+	std::string	   access	  = makeHeader( AccessMagic, generation );
+
+	std::unordered_map<std::string, Entry> entries;
+	uint64_t							   size = 0u;
+	for ( const auto& [lastUse, key] : candidates )
+	{
+		Entry entry = m_entries[*key];
+		if ( maxSize > 0u && size + entry.size > maxSize ) continue;
+
+		// corrupted binaries are dropped as well
+		const char* binary = m_pack.data() + entry.offset;
+		if ( Utility::hash64( binary, entry.size ) != entry.checksum ) continue;
+
+		entry.offset = pack.size();
+		pack.append( binary, entry.size );
+		index += serializeEntry( *key, entry );
+		appendValue( access, hashKey( *key ) );
+		appendValue( access, lastUse );
+		entries[*key] = entry;
+		size += entry.size;
+	}
+
+	// the index is published last, readers of the old one retry under the lock
+	m_pack.close();
+	publishFile( packPath(), pack );
+	publishFile( accessPath(), access );
+	publishFile( indexPath(), index );
+
+	m_entries	 = std::move( entries );
+	m_indexSize	 = index.size();
+	m_generation = generation;
+}
+} // namespace hiprt
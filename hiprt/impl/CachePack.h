@@ -0,0 +1,167 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <hiprt/hiprt_types.h>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace hiprt
+{
+class MappedFile
+{
+  public:
+	MappedFile() = default;
+	MappedFile( const MappedFile& ) = delete;
+	MappedFile& operator=( const MappedFile& ) = delete;
+	~MappedFile();
+
+	bool open( const std::filesystem::path& path );
+	void close();
+
+	const char* data() const { return m_data; }
+	size_t		size() const { return m_size; }
+
+  private:
+	const char* m_data = nullptr;
+	size_t		m_size = 0u;
+#if defined( _WIN32 )
+	void* m_file	= nullptr;
+	void* m_mapping = nullptr;
+#endif
+};
+
+// Exclusive lock of a file shared by the threads of this process and by other processes.
+// The constructor blocks until the lock is acquired.
+class FileLock
+{
+  public:
+	explicit FileLock( const std::filesystem::path& path );
+	FileLock( const FileLock& ) = delete;
+	FileLock& operator=( const FileLock& ) = delete;
+	~FileLock();
+
+  private:
+	std::unique_lock<std::mutex> m_threadLock;
+#if defined( _WIN32 )
+	void* m_file = nullptr;
+#else
+	int m_file = -1;
+#endif
+};
+
+// Compiled binaries are appended to a single data file while an index file records the key, offset, size,
+// checksum and timestamp of every binary. The index is read once into a hash map and the data file is memory-mapped,
+// so a lookup does not touch the file system. Writers append under the lock file of the pack and the index entry is
+// written only after its data, so concurrent readers never see a partial binary.
+//
+// Every entry also records the device and the HIPRT/driver version it was built for. Access times are kept in a
+// separate append-only file. Trimming rewrites the pack with the most recently used entries that fit into the size
+// limit, dropping the entries of the same device built for another version, and publishes it under a new generation.
+// A binary failing its checksum is removed by appending an index entry of its key with an invalid offset.
+class CachePack
+{
+  public:
+	static constexpr std::string_view PackFilename	 = "hiprt_kernels.pack";
+	static constexpr std::string_view IndexFilename	 = "hiprt_kernels.idx";
+	static constexpr std::string_view AccessFilename = "hiprt_kernels.access";
+	static constexpr std::string_view LockFilename	 = "hiprt_kernels.lock";
+	static constexpr std::string_view LockDirname	 = "locks";
+
+	static constexpr uint32_t PackMagic	   = 0x4b505248; // HRPK
+	static constexpr uint32_t IndexMagic   = 0x49505248; // HRPI
+	static constexpr uint32_t AccessMagic  = 0x41505248; // HRPA
+	static constexpr uint32_t PackVersion  = 3u;
+	static constexpr uint32_t HeaderSize   = 2u * sizeof( uint32_t ) + sizeof( uint64_t );
+	static constexpr uint32_t MaxKeyLength = 1024u;
+	static constexpr uint32_t KeyLockCount = 256u;
+
+	struct Entry
+	{
+		uint64_t	offset;
+		uint64_t	size;
+		uint64_t	checksum;
+		int64_t		timestamp;
+		std::string device;
+		std::string version;
+	};
+
+	CachePack( const std::filesystem::path& directory ) : m_directory( directory ) {}
+	~CachePack();
+
+	void setDirectory( const std::filesystem::path& directory );
+
+	// a non-zero limit trims the pack whenever a new binary makes it exceed the limit
+	void setSizeLimit( size_t sizeLimit );
+
+	// a read-only pack drops corrupted binaries only from memory
+	void setReadOnly( bool readOnly );
+
+	std::optional<Entry> find( const std::string& key );
+
+	// a binary removed by another process or failing its checksum is not loaded
+	std::optional<std::string> load( const std::string& key );
+
+	void store( const std::string& key, const std::string& binary, const std::string& device, const std::string& version );
+
+	// the lock a compiler holds while it produces the binary of a key missing in the pack
+	std::filesystem::path getKeyLockPath( const std::string& key );
+
+	void trim( size_t maxSize, const std::string& device, const std::string& version );
+
+	hiprtCacheStatistics getStatistics( const std::string& device, const std::string& version );
+
+  private:
+	void open();
+	void readIndex();
+	void resetFiles();
+	bool mapPack( uint64_t requiredSize );
+	void flushAccessTimes();
+	// the caller holds the file lock
+	void flushAccessTimesLocked();
+	void trimLocked( size_t maxSize, const std::string& device, const std::string& version );
+	void removeCorrupted( const std::string& key, const Entry& entry );
+
+	std::filesystem::path packPath() const { return m_directory / PackFilename; }
+	std::filesystem::path indexPath() const { return m_directory / IndexFilename; }
+	std::filesystem::path accessPath() const { return m_directory / AccessFilename; }
+	std::filesystem::path lockPath() const { return m_directory / LockFilename; }
+
+	std::filesystem::path m_directory;
+	bool				  m_opened	   = false;
+	uint64_t			  m_indexSize  = 0u;
+	uint64_t			  m_generation = 0u;
+	size_t				  m_sizeLimit  = 0u;
+	bool				  m_readOnly   = false;
+
+	std::mutex								 m_mutex;
+	std::unordered_map<std::string, Entry>	 m_entries;
+	std::unordered_map<std::string, int64_t> m_accessTimes;
+	MappedFile								 m_pack;
+};
+} // namespace hiprt
@@ -0,0 +1,126 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <hiprt/impl/CompileTelemetry.h>
+#include <hiprt/impl/Utility.h>
+#include <fstream>
+
+namespace
+{
+const char* toString( hiprt::CompileTelemetry::Source source )
+{
+	switch ( source )
+	{
+	case hiprt::CompileTelemetry::Source::Loaded:
+		return "loaded";
+	case hiprt::CompileTelemetry::Source::CacheHit:
+		return "hit";
+	case hiprt::CompileTelemetry::Source::CacheMiss:
+		return "miss";
+	case hiprt::CompileTelemetry::Source::Uncached:
+		return "uncached";
+	case hiprt::CompileTelemetry::Source::Precompiled:
+		return "precompiled";
+	}
+	return "unknown";
+}
+} // namespace
+
+namespace hiprt
+{
+thread_local CompileTelemetry::Record* CompileTelemetry::s_current = nullptr;
+
+CompileTelemetry::Scope::Scope(
+	CompileTelemetry& telemetry, const std::string& module, const std::vector<const char*>& functions )
+	: m_telemetry( telemetry ), m_previous( s_current ), m_exceptions( std::uncaught_exceptions() )
+{
+	if ( !telemetry.isEnabled() ) return;
+	m_record.emplace();
+	m_record->module = module;
+	for ( const char* function : functions )
+		m_record->functions.push_back( function );
+	s_current = &m_record.value();
+}
+
+CompileTelemetry::Scope::~Scope()
+{
+	if ( !m_record ) return;
+	s_current = m_previous;
+	if ( std::uncaught_exceptions() > m_exceptions ) return;
+
+	std::lock_guard<std::mutex> lock( m_telemetry.m_mutex );
+	m_telemetry.m_records.push_back( std::move( m_record.value() ) );
+}
+
+void CompileTelemetry::Scope::setSource( Source source )
+{
+	if ( m_record ) m_record->source = source;
+}
+
+void CompileTelemetry::Scope::setBinarySize( size_t size )
+{
+	if ( m_record ) m_record->binarySize = size;
+}
+
+std::vector<CompileTelemetry::Record> CompileTelemetry::getRecords()
+{
+	std::lock_guard<std::mutex> lock( m_mutex );
+	return m_records;
+}
+
+void CompileTelemetry::exportJson( const std::filesystem::path& path )
+{
+	std::vector<Record> records = getRecords();
+
+	std::ofstream file( path, std::ios::out | std::ios::trunc );
+	if ( !file ) throw std::runtime_error( "Cannot open the telemetry file: " + path.string() );
+
+	file << "{\n\t\"records\": [";
+	for ( size_t i = 0; i < records.size(); ++i )
+	{
+		const Record& record = records[i];
+		file << ( i > 0 ? ",\n" : "\n" ) << "\t\t{\n";
+		file << "\t\t\t\"module\": " << Utility::toJsonString( record.module ) << ",\n";
+		file << "\t\t\t\"functions\": [";
+		for ( size_t j = 0; j < record.functions.size(); ++j )
+			file << ( j > 0 ? ", " : "" ) << Utility::toJsonString( record.functions[j] );
+		file << "],\n";
+		file << "\t\t\t\"source\": \"" << toString( record.source ) << "\",\n";
+		file << "\t\t\t\"hashTime\": " << record.hashTime << ",\n";
+		file << "\t\t\t\"lockWaitTime\": " << record.lockWaitTime << ",\n";
+		file << "\t\t\t\"cacheReadTime\": " << record.cacheReadTime << ",\n";
+		file << "\t\t\t\"decryptTime\": " << record.decryptTime << ",\n";
+		file << "\t\t\t\"compileTime\": " << record.compileTime << ",\n";
+		file << "\t\t\t\"cacheWriteTime\": " << record.cacheWriteTime << ",\n";
+		file << "\t\t\t\"loadTime\": " << record.loadTime << ",\n";
+		file << "\t\t\t\"binarySize\": " << record.binarySize << ",\n";
+		file << "\t\t\t\"cacheReadCount\": " << record.cacheReadCount << ",\n";
+		file << "\t\t\t\"decryptCount\": " << record.decryptCount << "\n";
+		file << "\t\t}";
+	}
+	file << ( records.empty() ? "]\n}\n" : "\n\t]\n}\n" );
+	if ( !file ) throw std::runtime_error( "Cannot write the telemetry file: " + path.string() );
+}
+} // namespace hiprt
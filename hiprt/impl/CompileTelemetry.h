@@ -0,0 +1,144 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace hiprt
+{
+// Opt-in timings of the kernel compilation and loading, one record per module.
+// The record of the module being built is bound to the calling thread, so the helpers
+// deep in the compiler (decryption, cache reads) can add their time to it.
+class CompileTelemetry
+{
+  public:
+	using Clock = std::chrono::steady_clock;
+
+	enum class Source
+	{
+		Loaded,		 // the module was already loaded by the context
+		CacheHit,	 // read from the kernel cache
+		CacheMiss,	 // compiled and stored to the kernel cache
+		Uncached,	 // compiled with the cache disabled
+		Precompiled, // loaded from the precompiled binary
+	};
+
+	// times in milliseconds, the counts stay zero when another context already read or decrypted the data
+	struct Record
+	{
+		std::string				 module;
+		std::vector<std::string> functions;
+		Source					 source			= Source::Loaded;
+		double					 hashTime		= 0.0;
+		double					 lockWaitTime	= 0.0;
+		double					 cacheReadTime	= 0.0;
+		double					 decryptTime	= 0.0;
+		double					 compileTime	= 0.0;
+		double					 cacheWriteTime	= 0.0;
+		double					 loadTime		= 0.0;
+		size_t					 binarySize		= 0u;
+		uint32_t				 cacheReadCount	= 0u;
+		uint32_t				 decryptCount	= 0u;
+	};
+
+	// binds a new record to the calling thread while the telemetry is enabled,
+	// the record is kept unless the scope is left by an exception
+	class Scope
+	{
+	  public:
+		Scope( CompileTelemetry& telemetry, const std::string& module, const std::vector<const char*>& functions );
+		Scope( const Scope& ) = delete;
+		Scope& operator=( const Scope& ) = delete;
+		~Scope();
+
+		void setSource( Source source );
+		void setBinarySize( size_t size );
+
+	  private:
+		CompileTelemetry&	  m_telemetry;
+		std::optional<Record> m_record;
+		Record*				  m_previous;
+		int					  m_exceptions;
+	};
+
+	// adds the time until the end of the scope to the record of the calling thread
+	class Stopwatch
+	{
+	  public:
+		explicit Stopwatch( double Record::*time ) : m_record( s_current ), m_time( time )
+		{
+			if ( m_record != nullptr ) m_start = Clock::now();
+		}
+		~Stopwatch()
+		{
+			if ( m_record != nullptr )
+				m_record->*m_time += std::chrono::duration<double, std::milli>( Clock::now() - m_start ).count();
+		}
+
+	  private:
+		Record*			  m_record;
+		double Record::*  m_time;
+		Clock::time_point m_start;
+	};
+
+	void setEnabled( bool enabled ) { m_enabled = enabled; }
+	bool isEnabled() const { return m_enabled; }
+
+	/// Calls the callable and adds the elapsed time to the record of the calling thread.
+	/// @param[in] time The member of the record to add the time to.
+	/// @param[in] callable The callable object to be called.
+	/// @return The forwarded returned result of the callable.
+	template <typename CallableType>
+	static decltype( auto ) measure( double Record::*time, CallableType&& callable )
+	{
+		Stopwatch stopwatch( time );
+		return callable();
+	}
+
+	/// Increments a counter of the record of the calling thread.
+	/// @param[in] counter The member of the record to increment.
+	static void count( uint32_t Record::*counter )
+	{
+		if ( s_current != nullptr ) ++( s_current->*counter );
+	}
+
+	std::vector<Record> getRecords();
+	void				exportJson( const std::filesystem::path& path );
+
+  private:
+	static thread_local Record* s_current;
+
+	std::atomic<bool>	m_enabled = false;
+	std::mutex			m_mutex;
+	std::vector<Record> m_records;
+};
+} // namespace hiprt
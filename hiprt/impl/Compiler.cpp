@@ -30,7 +30,10 @@
 #if defined( HIPRT_ENCRYPT )
 #include <contrib/easy-encryption/encrypt.h>
 #endif
+#include <future>
 #include <regex>
+#include <set>
+#include <sstream>
 #if defined( HIPRT_BAKE_KERNEL_GENERATED )
 #include <hiprt/cache/Kernels.h>
 #include <hiprt/cache/KernelArgs.h>
@@ -73,6 +76,18 @@ Compiler::~Compiler()
 {
 	for ( auto& module : m_moduleCache )
 		checkOro( oroModuleUnload( module.second ) );
+
+	for ( std::atomic<KernelEntry*>& bucket : m_kernelBuckets )
+	{
+		KernelEntry* entry = bucket.load( std::memory_order_acquire );
+		while ( entry != nullptr )
+			delete std::exchange( entry, entry->next );
+	}
+}
+
+Compiler::KernelKey::KernelKey( const std::filesystem::path& moduleName, const std::string& funcName )
+	: moduleName( moduleName ), funcName( funcName ), hash( getKernelHash( moduleName, funcName ) )
+{
 }
 
 Kernel Compiler::getKernel(
@@ -84,18 +99,38 @@ Kernel Compiler::getKernel(
 	const char**				 headersIn,
 	const char**				 includeNamesIn )
 {
+	return getKernel( context, KernelKey( moduleName, funcName ), options, numHeaders, headersIn, includeNamesIn );
+}
+
+Kernel Compiler::getKernel(
+	Context&				  context,
+	const KernelKey&		  key,
+	std::vector<const char*>& options,
+	uint32_t				  numHeaders,
+	const char**			  headersIn,
+	const char**			  includeNamesIn )
+{
+	const std::filesystem::path& moduleName = key.moduleName;
+	const std::string&			 funcName   = key.funcName;
+	const uint64_t				 hash	   = key.hash;
+	if ( const KernelEntry* entry = findKernel( hash, moduleName, funcName ) ) return entry->kernel;
+
 	std::lock_guard<std::mutex> lock( m_kernelMutex );
+	if ( const KernelEntry* entry = findKernel( hash, moduleName, funcName ) ) return entry->kernel;
 
-	std::string cacheName  = moduleName.string() + funcName;
-	auto		cacheEntry = m_kernelCache.find( cacheName );
-	if ( cacheEntry != m_kernelCache.end() ) return cacheEntry->second;
+	Tracer::Span span( context.getTracer(), "getKernel", "compile" );
+	if ( span.isActive() )
+	{
+		span.arg( "module", moduleName.string() );
+		span.arg( "function", funcName );
+	}
 
 	oroFunction function;
 
 	// if we use the precompiled bitcode as file or baked as binary, we use 'getFunctionFromPrecompiledBinary'
 	if constexpr ( UseBitcode || UseBakedCompiledKernel )
 	{
-		function = getFunctionFromPrecompiledBinary( funcName );
+		function = getFunctionFromPrecompiledBinary( moduleName, funcName );
 	}
 	else
 	{
@@ -155,11 +190,34 @@ Kernel Compiler::getKernel(
 		function = functions.back();
 	}
 
-	Kernel kernel( function );
-	m_kernelCache[cacheName] = kernel;
+	Kernel					   kernel( function );
+	std::atomic<KernelEntry*>& bucket = m_kernelBuckets[hash % KernelBucketCount];
+	bucket.store(
+		new KernelEntry{ hash, moduleName, funcName, kernel, bucket.load( std::memory_order_relaxed ) },
+		std::memory_order_release );
 	return kernel;
 }
 
+uint64_t Compiler::getKernelHash( const std::filesystem::path& moduleName, const std::string& funcName )
+{
+	const std::filesystem::path::string_type& module = moduleName.native();
+
+	const uint64_t hash = Utility::hash64( module.data(), module.size() * sizeof( std::filesystem::path::value_type ) );
+	return Utility::hash64( funcName.data(), funcName.size(), hash );
+}
+
+const Compiler::KernelEntry*
+Compiler::findKernel( uint64_t hash, const std::filesystem::path& moduleName, const std::string& funcName ) const
+{
+	const KernelEntry* entry = m_kernelBuckets[hash % KernelBucketCount].load( std::memory_order_acquire );
+	for ( ; entry != nullptr; entry = entry->next )
+	{
+		if ( entry->hash == hash && entry->funcName == funcName && entry->moduleName.native() == moduleName.native() )
+			return entry;
+	}
+	return nullptr;
+}
+
 void Compiler::buildProgram(
 	Context&							 context,
 	const std::vector<const char*>&		 funcNames,
@@ -173,6 +231,9 @@ void Compiler::buildProgram(
 	const std::vector<hiprtFuncNameSet>& funcNameSets,
 	orortcProgram&						 progOut )
 {
+	CompileTelemetry::Stopwatch stopwatch( &CompileTelemetry::Record::compileTime );
+	Tracer::Span				span( context.getTracer(), "compileProgram", "compile" );
+
 	checkOrortc( orortcCreateProgram(
 		&progOut,
 		src.c_str(),
@@ -219,25 +280,46 @@ void Compiler::buildKernels(
 	if ( !std::filesystem::exists( m_cacheDirectory ) && !std::filesystem::create_directory( m_cacheDirectory ) )
 		throw std::runtime_error( "Cannot create cache directory" );
 
-	std::lock_guard<std::mutex> lock( m_moduleMutex );
-	auto						cacheEntry = m_moduleCache.find( moduleName.string() );
+	CompileTelemetry::Scope		 telemetry( m_telemetry, moduleName.string(), funcNames );
+	Tracer::Span				 span( context.getTracer(), "buildKernels", "compile" );
+	std::unique_lock<std::mutex> lock( m_moduleMutex );
+	auto						 cacheEntry = m_moduleCache.find( moduleName.string() );
 	if ( cacheEntry != m_moduleCache.end() )
 	{
 		module = cacheEntry->second;
 	}
 	else
 	{
-		std::string cacheName = getCacheFilename( context, src, moduleName, options, funcNameSets, numGeomTypes, numRayTypes );
-		bool		upToDate  = isCachedFileUpToDate( m_cacheDirectory / cacheName, moduleName );
+		// extended modules are compiled with the device implementation
+		const std::string keySrc	= extended ? "#include <hiprt/impl/hiprt_device_impl.h>\n" + src : src;
+		std::string		  cacheName = getCacheFilename(
+			  context, keySrc, moduleName, options, funcNameSets, numGeomTypes, numRayTypes, headers, includeNames );
+
+		// independent modules are compiled in parallel, the key lock below serializes the same module
+		lock.unlock();
+		bool cached = isCached( cacheName );
+		if ( m_cacheReadOnly && !( cache && cached ) ) throwNotCached( moduleName, cacheName );
+
+		// only one thread or process compiles a missing binary, the others wait and load it from the cache
+		std::optional<FileLock> cacheLock;
+		if ( cache && !cached )
+		{
+			lockCacheKey( context, cacheName, cacheLock );
+			cached = isCached( cacheName );
+		}
 
-		orortcProgram prog;
-		std::string	  binary;
-		if ( upToDate && cache )
+		orortcProgram			   prog;
+		std::string				   binary;
+		std::optional<std::string> cachedBinary;
+		if ( cached && cache ) cachedBinary = loadCachedBinary( context, moduleName, cacheName, cacheLock );
+		if ( cachedBinary )
 		{
-			binary = loadCacheFileToBinary( cacheName, context.getDeviceName() );
+			telemetry.setSource( CompileTelemetry::Source::CacheHit );
+			binary = std::move( *cachedBinary );
 		}
 		else
 		{
+			telemetry.setSource( cache ? CompileTelemetry::Source::CacheMiss : CompileTelemetry::Source::Uncached );
 			std::vector<std::string> headerData;
 			std::string				 extSrc = src;
 			if ( extended )
@@ -300,12 +382,23 @@ void Compiler::buildKernels(
 			binary.resize( binarySize );
 			checkOrortc( orortcGetCode( prog, binary.data() ) );
 
-			if ( cache ) cacheBinaryToFile( binary, cacheName, context.getDeviceName() );
+			if ( cache ) cacheBinaryToFile( context, binary, cacheName );
 			checkOrortc( orortcDestroyProgram( &prog ) );
 		}
 
-		checkOro( oroModuleLoadData( &module, binary.data() ) );
-		m_moduleCache[moduleName.string()] = module;
+		telemetry.setBinarySize( binary.size() );
+		if ( context.getCompileTarget() )
+		{
+			functions.assign( funcNames.size(), nullptr );
+			return;
+		}
+
+		CompileTelemetry::measure( &CompileTelemetry::Record::loadTime, [&]() {
+			Tracer::Span loadSpan( context.getTracer(), "moduleLoad", "load" );
+			if ( loadSpan.isActive() ) loadSpan.arg( "bytes", binary.size() );
+			checkOro( oroModuleLoadData( &module, binary.data() ) );
+		} );
+		insertModule( moduleName, lock, module );
 	}
 
 	for ( size_t i = 0; i < funcNames.size(); ++i )
@@ -329,37 +422,62 @@ void Compiler::buildKernelsFromBitcode(
 {
 	if constexpr ( UseBitcode )
 	{
+		// the library bitcode is linked for the device of the context
+		if ( context.getCompileTarget() ) throw std::runtime_error( "Bitcode cannot be linked for a compile target" );
+
 		if ( !std::filesystem::exists( m_cacheDirectory ) && !std::filesystem::create_directory( m_cacheDirectory ) )
 			throw std::runtime_error( "Cannot create cache directory" );
 
-		std::lock_guard<std::mutex> lock( m_moduleMutex );
-		auto						cacheEntry = m_moduleCache.find( moduleName.string() );
-		oroModule					module;
+		CompileTelemetry::Scope		 telemetry( m_telemetry, moduleName.string(), funcNames );
+		Tracer::Span				 span( context.getTracer(), "buildKernelsFromBitcode", "compile" );
+		std::unique_lock<std::mutex> lock( m_moduleMutex );
+		auto						 cacheEntry = m_moduleCache.find( moduleName.string() );
+		oroModule					 module;
 		if ( cacheEntry != m_moduleCache.end() )
 		{
 			module = cacheEntry->second;
 		}
 		else
 		{
-			std::string cacheName = getCacheFilename(
-				context,
-				std::to_string( bitcodeBinary.size() ),
-				moduleName,
-				std::nullopt,
-				funcNameSets,
-				numGeomTypes,
-				numRayTypes );
-			bool upToDate = isCachedFileUpToDate( m_cacheDirectory / cacheName, moduleName );
+			// the binary is linked with the precompiled HIPRT library
+			bool				  amd		  = oroGetCurAPI( 0 ) == ORO_API_HIP;
+			std::filesystem::path libraryPath = getBitcodePath( amd );
+			std::string			  keySrc	  = std::string( bitcodeBinary );
+			if ( std::filesystem::exists( libraryPath ) ) keySrc += getSourceFile( libraryPath ).hash;
 
-			std::string binary;
-			if ( upToDate && cache )
+			std::string cacheName =
+				getCacheFilename( context, keySrc, moduleName, std::nullopt, funcNameSets, numGeomTypes, numRayTypes );
+
+			lock.unlock();
+			bool cached = isCached( cacheName );
+			if ( m_cacheReadOnly && !( cache && cached ) ) throwNotCached( moduleName, cacheName );
+
+			std::optional<FileLock> cacheLock;
+			if ( cache && !cached )
+			{
+				lockCacheKey( context, cacheName, cacheLock );
+				cached = isCached( cacheName );
+			}
+
+			std::string				   binary;
+			std::optional<std::string> cachedBinary;
+			if ( cached && cache ) cachedBinary = loadCachedBinary( context, moduleName, cacheName, cacheLock );
+			if ( cachedBinary )
 			{
-				binary = loadCacheFileToBinary( cacheName, context.getDeviceName() );
+				telemetry.setSource( CompileTelemetry::Source::CacheHit );
+				binary = std::move( *cachedBinary );
 			}
 			else
 			{
-				std::string customFuncBitcodeBinary =
-					buildFunctionTableBitcode( context, numGeomTypes, numRayTypes, funcNameSets );
+				telemetry.setSource( cache ? CompileTelemetry::Source::CacheMiss : CompileTelemetry::Source::Uncached );
+
+				std::optional<CompileTelemetry::Stopwatch> compileTime;
+				compileTime.emplace( &CompileTelemetry::Record::compileTime );
+
+				// the function table is compiled while the library bitcode is loaded into the linker
+				std::future<std::string> customFuncBitcode = std::async( std::launch::async, [&]() {
+					return buildFunctionTableBitcode( context, numGeomTypes, numRayTypes, funcNameSets );
+				} );
 
 				const uint32_t	 JITOptCount = 6u;
 				orortcLinkState	 rtcLinkState;
@@ -389,39 +507,44 @@ void Compiler::buildKernelsFromBitcode(
 				options[5]	  = ORORTC_JIT_LOG_VERBOSE;
 				optionVals[5] = reinterpret_cast<void*>( static_cast<uintptr_t>( 1 ) );
 
-				bool					 amd		= oroGetCurAPI( 0 ) == ORO_API_HIP;
-				std::filesystem::path	 bcPath		= getBitcodePath( amd );
 				const orortcJITInputType typeBc		= amd ? ORORTC_JIT_INPUT_LLVM_BUNDLED_BITCODE : ORORTC_JIT_INPUT_FATBINARY;
 				const orortcJITInputType typeUserBc = amd ? ORORTC_JIT_INPUT_LLVM_BITCODE : ORORTC_JIT_INPUT_PTX;
 
 				void* binaryPtr;
 				checkOrortc( orortcLinkCreate( JITOptCount, options, optionVals, &rtcLinkState ) );
 
-				orortcResult res = orortcLinkAddFile( rtcLinkState, typeBc, bcPath.string().c_str(), 0, 0, 0 );
+				orortcResult res = orortcLinkAddFile( rtcLinkState, typeBc, libraryPath.string().c_str(), 0, 0, 0 );
 				if ( res != ORORTC_SUCCESS )
 				{
 					// add some verbose to help debugging missing file.
-					std::cout << "orortcLinkAddFile FAILED (error=" << res << ") loading file: " << bcPath.string().c_str()
+					std::cout << "orortcLinkAddFile FAILED (error=" << res << ") loading file: " << libraryPath.string().c_str()
 							  << std::endl;
 				}
 				checkOrortc( res );
 
 				checkOrortc( orortcLinkAddData(
 					rtcLinkState, typeUserBc, const_cast<char*>( bitcodeBinary.data() ), bitcodeBinary.size(), 0, 0, 0, 0 ) );
+
+				std::string customFuncBitcodeBinary = customFuncBitcode.get();
 				checkOrortc( orortcLinkAddData(
 					rtcLinkState, typeUserBc, customFuncBitcodeBinary.data(), customFuncBitcodeBinary.size(), 0, 0, 0, 0 ) );
 
 				size_t binarySize = 0;
 				checkOrortc( orortcLinkComplete( rtcLinkState, &binaryPtr, &binarySize ) );
 				binary = std::string( reinterpret_cast<char*>( binaryPtr ), binarySize );
-
-				if ( cache ) cacheBinaryToFile( binary, cacheName, context.getDeviceName() );
-
 				checkOrortc( orortcLinkDestroy( rtcLinkState ) );
+				compileTime.reset();
+
+				if ( cache ) cacheBinaryToFile( context, binary, cacheName );
 			}
 
-			checkOro( oroModuleLoadData( &module, binary.data() ) );
-			m_moduleCache[moduleName.string()] = module;
+			telemetry.setBinarySize( binary.size() );
+			CompileTelemetry::measure( &CompileTelemetry::Record::loadTime, [&]() {
+				Tracer::Span loadSpan( context.getTracer(), "moduleLoad", "load" );
+				if ( loadSpan.isActive() ) loadSpan.arg( "bytes", binary.size() );
+				checkOro( oroModuleLoadData( &module, binary.data() ) );
+			} );
+			insertModule( moduleName, lock, module );
 		}
 
 		for ( size_t i = 0; i < funcNames.size(); ++i )
@@ -439,7 +562,30 @@ void Compiler::buildKernelsFromBitcode(
 
 void Compiler::setCacheDir( const std::filesystem::path& cacheDirectory )
 {
-	if ( !cacheDirectory.empty() ) m_cacheDirectory = cacheDirectory;
+	if ( !cacheDirectory.empty() )
+	{
+		m_cacheDirectory = cacheDirectory;
+		m_cachePack.setDirectory( cacheDirectory );
+	}
+}
+
+void Compiler::setCacheSizeLimit( size_t maxSize ) { m_cachePack.setSizeLimit( maxSize ); }
+
+void Compiler::setCacheReadOnly( bool readOnly )
+{
+	m_cacheReadOnly = readOnly;
+	m_cachePack.setReadOnly( readOnly );
+}
+
+void Compiler::trimCache( Context& context, size_t maxSize )
+{
+	if ( !std::filesystem::exists( m_cacheDirectory ) ) return;
+	m_cachePack.trim( maxSize, getCacheDeviceName( context ), getCacheVersion( context ) );
+}
+
+hiprtCacheStatistics Compiler::getCacheStatistics( Context& context )
+{
+	return m_cachePack.getStatistics( getCacheDeviceName( context ), getCacheVersion( context ) );
 }
 
 std::string Compiler::kernelNameSufix( const std::string& traits )
@@ -498,6 +644,9 @@ void Compiler::addCommonOpts( Context& context, std::vector<const char*>& opts )
 
 	if ( context.enableHwi() ) opts.push_back( "-D__USE_HWI__" );
 
+	// the architecture of the current device is used otherwise
+	if ( context.getCompileTarget() ) opts.push_back( context.getCompileTarget()->archOption.c_str() );
+
 	opts.push_back( "-D__USE_HIP__" );
 	opts.push_back( "-std=c++17" );
 }
@@ -574,43 +723,92 @@ std::filesystem::path Compiler::getBitcodePath( bool amd )
 	return Utility::getCurrentDir() / std::filesystem::path( filename );
 }
 
-std::filesystem::path Compiler::getFatbinPath( bool amd )
+std::filesystem::path Compiler::getFatbinPath( bool amd, const std::string& builder )
 {
 	std::string hipSdkVersion = "_" + std::string( HIP_VERSION_STR );
 	std::string filename	  = "hiprt" + std::string( HIPRT_VERSION_STR );
 	if ( amd ) filename += hipSdkVersion;
 
-	if ( amd )
-		filename += "_amd.hipfb";
-	else
-		filename += "_nv.fatbin";
+	filename += amd ? "_amd" : "_nv";
+	if ( !builder.empty() ) filename += "_" + builder;
+	filename += amd ? ".hipfb" : ".fatbin";
 	return Utility::getCurrentDir() / std::filesystem::path( filename );
 }
 
-bool Compiler::isCachedFileUpToDate( const std::filesystem::path& cachedFile, const std::filesystem::path& moduleName )
+void Compiler::insertModule( const std::filesystem::path& moduleName, std::unique_lock<std::mutex>& lock, oroModule& module )
 {
-	if ( !std::filesystem::exists( cachedFile ) ) return false;
-	if ( !std::filesystem::exists( moduleName ) ) return true;
-	return std::filesystem::last_write_time( moduleName ) < std::filesystem::last_write_time( cachedFile );
+	lock.lock();
+	auto [cacheEntry, inserted] = m_moduleCache.emplace( moduleName.string(), module );
+	if ( !inserted )
+	{
+		// another thread loaded the same module meanwhile
+		checkOro( oroModuleUnload( module ) );
+		module = cacheEntry->second;
+	}
+}
+
+bool Compiler::isCached( const std::string& cacheName )
+{
+	CompileTelemetry::Stopwatch stopwatch( &CompileTelemetry::Record::cacheReadTime );
+	return m_cachePack.find( cacheName ).has_value();
+}
+
+void Compiler::throwNotCached( const std::filesystem::path& moduleName, const std::string& cacheName )
+{
+	std::string msg =
+		Utility::format( "'%s' of '%s' is not in the read-only cache", cacheName.c_str(), moduleName.string().c_str() );
+	throw std::runtime_error( msg );
+}
+
+void Compiler::lockCacheKey( Context& context, const std::string& cacheName, std::optional<FileLock>& cacheLock )
+{
+	CompileTelemetry::measure( &CompileTelemetry::Record::lockWaitTime, [&]() {
+		Tracer::Span lockSpan( context.getTracer(), "cacheLockWait", "compile" );
+		cacheLock.emplace( m_cachePack.getKeyLockPath( cacheName ) );
+	} );
+}
+
+std::optional<std::string> Compiler::loadCachedBinary(
+	Context&					 context,
+	const std::filesystem::path& moduleName,
+	const std::string&			 cacheName,
+	std::optional<FileLock>&	 cacheLock )
+{
+	std::optional<std::string> binary;
+	{
+		Tracer::Span readSpan( context.getTracer(), "cacheRead", "io" );
+		binary = loadCacheFileToBinary( cacheName, context.getDeviceName() );
+	}
+	if ( binary ) return binary;
+
+	// the binary was corrupted or trimmed by another process since it was found
+	if ( m_cacheReadOnly ) throwNotCached( moduleName, cacheName );
+	if ( !cacheLock ) lockCacheKey( context, cacheName, cacheLock );
+	return std::nullopt;
 }
 
 std::string Compiler::decryptSourceCode( const std::string& srcIn )
 {
 #if defined( HIPRT_ENCRYPT )
-	std::lock_guard<std::mutex> lock( m_decryptMutex );
-	std::string					src;
-	if ( m_decryptCache.find( srcIn ) != m_decryptCache.end() )
 	{
-		src = m_decryptCache[srcIn];
+		std::lock_guard<std::mutex> lock( m_decryptMutex );
+		auto						cacheEntry = m_decryptCache.find( srcIn );
+		if ( cacheEntry != m_decryptCache.end() ) return *cacheEntry->second;
 	}
-	else
-	{
+
+	// other contexts of the process may have decrypted the source already
+	SharedCache::Entry src = SharedCache::getSources().get( Utility::hashString( srcIn ), [&]() {
 		std::string deryptKeyStr( DecryptKey );
-		src					  = srcIn;
-		src					  = decrypt( src, deryptKeyStr );
-		m_decryptCache[srcIn] = src;
-	}
-	return src;
+		std::string decrypted = srcIn;
+
+		CompileTelemetry::count( &CompileTelemetry::Record::decryptCount );
+		CompileTelemetry::Stopwatch stopwatch( &CompileTelemetry::Record::decryptTime );
+		return decrypt( decrypted, deryptKeyStr );
+	} );
+
+	std::lock_guard<std::mutex> lock( m_decryptMutex );
+	m_decryptCache.emplace( srcIn, src );
+	return *src;
 #else
 	return srcIn;
 #endif
@@ -623,106 +821,164 @@ std::string Compiler::getCacheFilename(
 	std::optional<std::vector<const char*>>		 options,
 	std::optional<std::vector<hiprtFuncNameSet>> funcNameSets,
 	uint32_t									 numGeomTypes,
-	uint32_t									 numRayTypes )
+	uint32_t									 numRayTypes,
+	const std::vector<const char*>&				 headers,
+	const std::vector<const char*>&				 includeNames )
 {
-	std::string driverVersion = context.getDriverVersion();
-	std::string deviceName	  = context.getDeviceName();
-	deviceName				  = deviceName.substr( 0, deviceName.find( ":" ) );
-
-	std::string moduleHash = moduleName.string() + src;
-	moduleHash			   = Utility::format( "%08x", Utility::hashString( moduleHash ) );
+	CompileTelemetry::Stopwatch stopwatch( &CompileTelemetry::Record::hashTime );
+
+	// the key covers everything the binary depends on, a cached binary is valid as long as its key is found
+	std::string key = "hiprt " + std::string( HIPRT_VERSION_STR ) + "\n";
+	key += "hip " + std::string( HIP_VERSION_STR ) + "\n";
+	key += "driver " + context.getDriverVersion() + "\n";
+	key += "device " + getCacheDeviceName( context ) + "\n";
+	key += "hwi " + std::to_string( context.enableHwi() ) + "\n";
+	key += "bits " + std::to_string( 8 * sizeof( void* ) ) + "\n";
+	key += "module " + moduleName.generic_string() + "\n";
+	key += "source " + getSourceHash( src, headers, includeNames ) + "\n";
 
-	std::string optionHash = moduleName.string();
 	if ( funcNameSets )
 	{
+		key += "types " + std::to_string( numGeomTypes ) + " " + std::to_string( numRayTypes ) + "\n";
 		for ( uint32_t i = 0; i < numRayTypes; ++i )
 		{
 			for ( uint32_t j = 0; j < numGeomTypes; ++j )
 			{
 				uint32_t k = numGeomTypes * i + j;
-				if ( funcNameSets.value()[k].intersectFuncName != nullptr )
-					optionHash += funcNameSets.value()[k].intersectFuncName;
-				if ( funcNameSets.value()[k].filterFuncName != nullptr ) optionHash += funcNameSets.value()[k].filterFuncName;
+				key += "funcs ";
+				if ( funcNameSets.value()[k].intersectFuncName != nullptr ) key += funcNameSets.value()[k].intersectFuncName;
+				key += " ";
+				if ( funcNameSets.value()[k].filterFuncName != nullptr ) key += funcNameSets.value()[k].filterFuncName;
+				key += "\n";
 			}
 		}
 	}
 
 	if ( options )
 	{
-		optionHash.append( "\n" );
 		for ( const auto& option : options.value() )
-			optionHash += option + std::string( "\n" );
+			key += "option " + std::string( option ) + "\n";
 	}
-	optionHash = Utility::format( "%08x", Utility::hashString( optionHash ) );
 
-	return moduleHash + "-" + optionHash + ".v." + deviceName + "." + driverVersion + "_" +
-		   std::to_string( 8 * sizeof( void* ) ) + ".bin";
+	return Utility::hashString( key ) + ".bin";
 }
 
-std::string Compiler::loadCacheFileToBinary( const std::string& cacheName, const std::string& deviceName )
+std::vector<std::string> Compiler::getIncludes( const std::string& src )
 {
-	long long checksumValue = 0;
+	std::vector<std::string> includes;
+	std::istringstream		 stream( src );
+	std::string				 line;
+	while ( std::getline( stream, line ) )
 	{
-		std::filesystem::path path = m_cacheDirectory / ( cacheName + ".check" );
-		std::ifstream		  file( path, std::ios::in | std::ios::binary );
-		if ( !file.is_open() )
-		{
-			std::string msg = Utility::format( "Unable to open '%s'", path.string().c_str() );
-			throw std::runtime_error( msg );
-		}
-		file.read( reinterpret_cast<char*>( &checksumValue ), sizeof( long long ) );
+		size_t pos = line.find_first_not_of( " \t" );
+		if ( pos == std::string::npos || line.compare( pos, 8, "#include" ) != 0 ) continue;
+
+		size_t begin = line.find_first_of( "<\"", pos + 8 );
+		if ( begin == std::string::npos ) continue;
+		size_t end = line.find_first_of( ">\"", begin + 1 );
+		if ( end == std::string::npos ) continue;
+		includes.push_back( line.substr( begin + 1, end - begin - 1 ) );
 	}
-	if ( checksumValue == 0 ) throw std::runtime_error( "Checksum is zero" );
+	return includes;
+}
 
-	std::string binary;
+const Compiler::SourceFile& Compiler::getSourceFile( const std::filesystem::path& path )
+{
+	auto sourceFile = m_sourceFileCache.find( path.string() );
+	if ( sourceFile != m_sourceFileCache.end() ) return sourceFile->second;
+
+	std::string src = readSourceCode( path );
+	SourceFile	file;
+	file.hash	  = Utility::hashString( src );
+	file.includes = getIncludes( src );
+	return m_sourceFileCache[path.string()] = std::move( file );
+}
+
+std::string Compiler::getSourceHash(
+	const std::string& src, const std::vector<const char*>& headers, const std::vector<const char*>& includeNames )
+{
+	// the source is hashed with every header it includes, directly or indirectly, that is either given by the caller
+	// or found in the root directory; the other ones are system headers covered by the toolchain version
+	std::string				 hashes = Utility::hashString( src ) + "\n";
+	std::set<std::string>	 visited;
+	std::vector<std::string> pending = getIncludes( src );
+	std::reverse( pending.begin(), pending.end() );
+	while ( !pending.empty() )
 	{
-		std::filesystem::path path = m_cacheDirectory / cacheName;
-		std::ifstream		  file( path, std::ios::in | std::ios::binary | std::ios::ate );
-		if ( !file.is_open() )
+		const std::string name = pending.back();
+		pending.pop_back();
+		if ( !visited.insert( name ).second ) continue;
+
+		std::string				 hash;
+		std::vector<std::string> includes;
+		auto header = std::find_if( includeNames.begin(), includeNames.end(), [&]( const char* includeName ) {
+			return name == includeName;
+		} );
+		if ( header != includeNames.end() )
 		{
-			std::string msg = Utility::format( "Unable to open '%s'", path.string().c_str() );
-			throw std::runtime_error( msg );
+			const std::string headerSrc = headers[header - includeNames.begin()];
+			hash						= Utility::hashString( headerSrc );
+			includes					= getIncludes( headerSrc );
 		}
-		size_t binarySize = file.tellg();
-		file.clear();
-		file.seekg( 0, std::ios::beg );
-		binary.resize( binarySize );
-		file.read( binary.data(), binary.size() );
+		else
+		{
+			const std::filesystem::path path = Utility::getRootDir() / name;
+			if ( !std::filesystem::is_regular_file( path ) ) continue;
+			const SourceFile& file = getSourceFile( path );
+			hash				   = file.hash;
+			includes			   = file.includes;
+		}
+
+		hashes += name + " " + hash + "\n";
+		pending.insert( pending.end(), includes.rbegin(), includes.rend() );
 	}
+	return Utility::hashString( hashes );
+}
 
-	long long hash = Utility::hashString( binary );
-	if ( hash != checksumValue )
+std::optional<std::string> Compiler::loadCacheFileToBinary( const std::string& cacheName, const std::string& deviceName )
+{
 	{
-		std::string msg = Utility::format( "Checksum doesn't match %llx : %llx", hash, checksumValue );
-		throw std::runtime_error( msg );
+		std::lock_guard<std::mutex> lock( m_binMutex );
+		auto						cacheEntry = m_binCache.find( cacheName );
+		if ( cacheEntry != m_binCache.end() ) return *cacheEntry->second;
 	}
 
-	if constexpr ( !UseBitcode )
-	{
-		if ( deviceName.find( "NVIDIA" ) != std::string::npos )
+	// the cache name covers the device and the driver, the binary is shared by the contexts of the same device
+	SharedCache::Entry binary = SharedCache::getBinaries().get( cacheName, [&]() {
+		CompileTelemetry::count( &CompileTelemetry::Record::cacheReadCount );
+		std::optional<std::string> cached = CompileTelemetry::measure(
+			&CompileTelemetry::Record::cacheReadTime, [&]() { return m_cachePack.load( cacheName ); } );
+		// binaries are never empty, an empty entry is a binary missing in the cache
+		if ( !cached ) return std::string();
+
+#if defined( HIPRT_ENCRYPT )
+		if constexpr ( !UseBitcode )
 		{
-			std::lock_guard<std::mutex> lockMutex( m_binMutex );
-			if ( m_binCache.find( cacheName ) != m_binCache.end() )
+			std::string deryptKeyStr( DecryptKey );
+			if ( deviceName.find( "NVIDIA" ) != std::string::npos )
 			{
-				binary = m_binCache[cacheName];
-			}
-			else
-			{
-#if defined( HIPRT_ENCRYPT )
-				std::string deryptKeyStr( DecryptKey );
-				binary = decrypt( binary, deryptKeyStr );
-#endif
-				m_binCache[cacheName] = binary;
+				CompileTelemetry::count( &CompileTelemetry::Record::decryptCount );
+				CompileTelemetry::Stopwatch stopwatch( &CompileTelemetry::Record::decryptTime );
+				*cached = decrypt( *cached, deryptKeyStr );
 			}
 		}
-	}
+#endif
+		return std::move( *cached );
+	} );
+
+	if ( binary->empty() ) return std::nullopt;
 
-	return binary;
+	std::lock_guard<std::mutex> lock( m_binMutex );
+	m_binCache.emplace( cacheName, binary );
+	return *binary;
 }
 
-void Compiler::cacheBinaryToFile( const std::string& binaryIn, const std::string& cacheName, const std::string& deviceName )
+void Compiler::cacheBinaryToFile( Context& context, const std::string& binaryIn, const std::string& cacheName )
 {
-	std::string binary = binaryIn;
+	CompileTelemetry::Stopwatch stopwatch( &CompileTelemetry::Record::cacheWriteTime );
+
+	std::string binary	   = binaryIn;
+	std::string deviceName = context.getDeviceName();
 #if defined( HIPRT_ENCRYPT )
 	if constexpr ( !UseBitcode )
 	{
@@ -731,34 +987,26 @@ void Compiler::cacheBinaryToFile( const std::string& binaryIn, const std::string
 	}
 #endif
 
-	{
-		std::filesystem::path path = m_cacheDirectory / cacheName;
-		std::ofstream		  file( path, std::ios::out | std::ios::binary );
-		if ( !file.is_open() )
-		{
-			std::string msg = Utility::format( "Unable to open '%s'", path.string().c_str() );
-			throw std::runtime_error( msg );
-		}
-		file.write( binary.data(), binary.size() );
-	}
+	m_cachePack.store( cacheName, binary, getCacheDeviceName( context ), getCacheVersion( context ) );
+}
 
-	long long hash = Utility::hashString( binary );
-	{
-		std::filesystem::path path = m_cacheDirectory / ( cacheName + ".check" );
-		std::ofstream		  file( path, std::ios::out | std::ios::binary );
-		if ( !file.is_open() )
-		{
-			std::string msg = Utility::format( "Unable to open '%s'", path.string().c_str() );
-			throw std::runtime_error( msg );
-		}
-		file.write( reinterpret_cast<char*>( &hash ), sizeof( long long ) );
-	}
+std::string Compiler::getCacheDeviceName( Context& context )
+{
+	std::string deviceName = context.getDeviceName();
+	return deviceName.substr( 0, deviceName.find( ":" ) );
 }
 
-oroFunction Compiler::getFunctionFromPrecompiledBinary( const std::string& funcName )
+std::string Compiler::getCacheVersion( Context& context )
 {
-	bool						amd	 = oroGetCurAPI( 0 ) == ORO_API_HIP;
-	const std::filesystem::path path = getFatbinPath( amd );
+	return std::string( HIPRT_VERSION_STR ) + "_" + context.getDriverVersion();
+}
+
+oroFunction Compiler::getFunctionFromPrecompiledBinary( const std::filesystem::path& moduleName, const std::string& funcName )
+{
+	// only the binary of the requested builder is loaded, the full binary is used if it was not split
+	bool				  amd  = oroGetCurAPI( 0 ) == ORO_API_HIP;
+	std::filesystem::path path = getFatbinPath( amd, moduleName.stem().string() );
+	if ( !std::filesystem::exists( path ) ) path = getFatbinPath( amd );
 
 	std::lock_guard<std::mutex> lock( m_moduleMutex );
 	auto						cacheEntry = m_moduleCache.find( path.string() );
@@ -769,13 +1017,16 @@ oroFunction Compiler::getFunctionFromPrecompiledBinary( const std::string& funcN
 	}
 	else
 	{
-		std::ifstream file( path, std::ios::binary | std::ios::in );
-		if ( !file.is_open() )
+		CompileTelemetry::Scope telemetry( m_telemetry, path.string(), { funcName.c_str() } );
+		telemetry.setSource( CompileTelemetry::Source::Precompiled );
+
+		if ( !std::filesystem::exists( path ) )
 		{
 			// Note: even if 'HIPRT_BAKE_COMPILED_KERNEL' is enable, if the file exists, it overrides the embedded precompiled
 			// kernel.
 			if constexpr ( UseBakedCompiledKernel )
 			{
+				CompileTelemetry::Stopwatch stopwatch( &CompileTelemetry::Record::loadTime );
 				checkOro( oroModuleLoadData( &module, &bvh_build_array_h ) );
 			}
 			else
@@ -786,17 +1037,25 @@ oroFunction Compiler::getFunctionFromPrecompiledBinary( const std::string& funcN
 		}
 		else
 		{
+			// the file is read once per process, the module is still loaded per context
+			SharedCache::Entry binary = SharedCache::getBinaries().get( path.string(), [&]() {
+				CompileTelemetry::count( &CompileTelemetry::Record::cacheReadCount );
+				CompileTelemetry::Stopwatch stopwatch( &CompileTelemetry::Record::cacheReadTime );
+				std::ifstream				file( path, std::ios::binary | std::ios::in );
+				if ( !file.is_open() )
+				{
+					std::string msg = Utility::format( "Unable to open '%s'\n", path.string().c_str() );
+					throw std::runtime_error( msg );
+				}
+				return std::string( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+			} );
 
-			size_t sizeFile;
-			file.seekg( 0, std::fstream::end );
-			size_t size = sizeFile = static_cast<size_t>( file.tellg() );
-
-			std::vector<char> binary;
-			binary.resize( size );
-			file.seekg( 0, std::fstream::beg );
-			file.read( binary.data(), size );
+			telemetry.setBinarySize( binary->size() );
+			CompileTelemetry::measure(
+				&CompileTelemetry::Record::loadTime, [&]() { checkOro( oroModuleLoadData( &module, binary->data() ) ); } );
 
-			checkOro( oroModuleLoadData( &module, binary.data() ) );
+			std::lock_guard<std::mutex> lockBin( m_binMutex );
+			m_binCache.emplace( path.string(), binary );
 		}
 
 		m_moduleCache[path.string()] = module;
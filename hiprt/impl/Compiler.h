@@ -24,7 +24,12 @@
 
 #pragma once
 #include <hiprt/hiprt_types.h>
+#include <hiprt/impl/CachePack.h>
+#include <hiprt/impl/CompileTelemetry.h>
 #include <hiprt/impl/Kernel.h>
+#include <hiprt/impl/SharedCache.h>
+#include <array>
+#include <atomic>
 #include <filesystem>
 #include <optional>
 #include <mutex>
@@ -37,6 +42,17 @@ class Compiler
   public:
 	static constexpr std::string_view DecryptKey = "20220318";
 
+	// the module and function of a kernel with the lookup hash computed once,
+	// the builders keep them in function-local statics to avoid building the names per lookup
+	struct KernelKey
+	{
+		KernelKey( const std::filesystem::path& moduleName, const std::string& funcName );
+
+		std::filesystem::path moduleName;
+		std::string			  funcName;
+		uint64_t			  hash;
+	};
+
 	~Compiler();
 
 	Kernel getKernel(
@@ -48,6 +64,14 @@ class Compiler
 		const char**				 headers	  = nullptr,
 		const char**				 includeNames = nullptr );
 
+	Kernel getKernel(
+		Context&				  context,
+		const KernelKey&		  key,
+		std::vector<const char*>& options,
+		uint32_t				  numHeaders   = 0,
+		const char**			  headers	   = nullptr,
+		const char**			  includeNames = nullptr );
+
 	void buildProgram(
 		Context&							 context,
 		const std::vector<const char*>&		 funcNames,
@@ -89,6 +113,13 @@ class Compiler
 		bool								 cache );
 
 	void setCacheDir( const std::filesystem::path& path );
+	void setCacheSizeLimit( size_t maxSize );
+	void setCacheReadOnly( bool readOnly );
+	void trimCache( Context& context, size_t maxSize );
+
+	hiprtCacheStatistics getCacheStatistics( Context& context );
+
+	CompileTelemetry& getTelemetry() { return m_telemetry; }
 
 	static std::string kernelNameSufix( const std::string& traits );
 
@@ -104,9 +135,25 @@ class Compiler
 		uint32_t									 numRayTypes  = 1 );
 
 	static std::filesystem::path getBitcodePath( bool amd );
-	static std::filesystem::path getFatbinPath( bool amd );
+	// the builders are also precompiled separately, 'builder' is the stem of the kernel header
+	static std::filesystem::path getFatbinPath( bool amd, const std::string& builder = {} );
+
+	bool isCached( const std::string& cacheName );
+
+	[[noreturn]] static void throwNotCached( const std::filesystem::path& moduleName, const std::string& cacheName );
+
+	// the lock a compiler holds while it produces a binary missing in the cache
+	void lockCacheKey( Context& context, const std::string& cacheName, std::optional<FileLock>& cacheLock );
+
+	// a binary that cannot be loaded anymore is a miss, the key is locked to compile it again
+	std::optional<std::string> loadCachedBinary(
+		Context&					 context,
+		const std::filesystem::path& moduleName,
+		const std::string&			 cacheName,
+		std::optional<FileLock>&	 cacheLock );
 
-	static bool isCachedFileUpToDate( const std::filesystem::path& cachedFile, const std::filesystem::path& moduleName );
+	// takes the unlocked module lock, keeps the module that was loaded first
+	void insertModule( const std::filesystem::path& moduleName, std::unique_lock<std::mutex>& lock, oroModule& module );
 
 	std::string decryptSourceCode( const std::string& src );
 
@@ -117,29 +164,73 @@ class Compiler
 		std::optional<std::vector<const char*>>		 options	  = std::nullopt,
 		std::optional<std::vector<hiprtFuncNameSet>> funcNameSets = std::nullopt,
 		uint32_t									 numGeomTypes = 0,
-		uint32_t									 numRayTypes  = 1 );
+		uint32_t									 numRayTypes  = 1,
+		const std::vector<const char*>&				 headers	  = {},
+		const std::vector<const char*>&				 includeNames = {} );
+
+	struct SourceFile
+	{
+		std::string				 hash;
+		std::vector<std::string> includes;
+	};
+
+	static std::vector<std::string> getIncludes( const std::string& src );
+
+	const SourceFile& getSourceFile( const std::filesystem::path& path );
+
+	std::string getSourceHash(
+		const std::string& src, const std::vector<const char*>& headers, const std::vector<const char*>& includeNames );
+
+	std::optional<std::string> loadCacheFileToBinary( const std::string& cacheName, const std::string& deviceName );
 
-	std::string loadCacheFileToBinary( const std::string& cacheName, const std::string& deviceName );
+	void cacheBinaryToFile( Context& context, const std::string& binary, const std::string& cacheName );
 
-	void cacheBinaryToFile( const std::string& binary, const std::string& cacheName, const std::string& deviceName );
+	// entries of the same device with another version are stale
+	static std::string getCacheDeviceName( Context& context );
+	static std::string getCacheVersion( Context& context );
 
-	oroFunction getFunctionFromPrecompiledBinary( const std::string& funcName );
+	oroFunction getFunctionFromPrecompiledBinary( const std::filesystem::path& moduleName, const std::string& funcName );
 
 	std::string buildFunctionTableBitcode(
 		Context& context, uint32_t numGeomTypes, uint32_t numRayTypes, const std::vector<hiprtFuncNameSet>& funcNameSets );
 
 	std::filesystem::path m_cacheDirectory = "cache";
+	CachePack			  m_cachePack{ m_cacheDirectory };
+	CompileTelemetry	  m_telemetry;
+	bool				  m_cacheReadOnly = false;
 
-	std::mutex					  m_kernelMutex;
-	std::map<std::string, Kernel> m_kernelCache;
+	// kernels are looked up without locking, the entries are only prepended to the buckets
+	struct KernelEntry
+	{
+		uint64_t			  hash;
+		std::filesystem::path moduleName;
+		std::string			  funcName;
+		Kernel				  kernel;
+		KernelEntry*		  next;
+	};
+
+	static constexpr size_t KernelBucketCount = 256;
+
+	static uint64_t getKernelHash( const std::filesystem::path& moduleName, const std::string& funcName );
+
+	const KernelEntry*
+	findKernel( uint64_t hash, const std::filesystem::path& moduleName, const std::string& funcName ) const;
+
+	// serializes the compilation of missing kernels
+	std::mutex												 m_kernelMutex;
+	std::array<std::atomic<KernelEntry*>, KernelBucketCount> m_kernelBuckets{};
 
 	std::mutex						 m_moduleMutex;
 	std::map<std::string, oroModule> m_moduleCache;
 
-	std::mutex						   m_decryptMutex;
-	std::map<std::string, std::string> m_decryptCache;
+	// references to the process-wide entries, they are released with the context
+	std::mutex								  m_decryptMutex;
+	std::map<std::string, SharedCache::Entry> m_decryptCache;
+
+	std::mutex								  m_binMutex;
+	std::map<std::string, SharedCache::Entry> m_binCache;
 
-	std::mutex						   m_binMutex;
-	std::map<std::string, std::string> m_binCache;
+	// source files read for the cache keys, guarded by the module mutex
+	std::map<std::string, SourceFile> m_sourceFileCache;
 };
 } // namespace hiprt
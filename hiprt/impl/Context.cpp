@@ -24,6 +24,7 @@
 
 #include <hiprt/impl/BvhCommon.h>
 #include <hiprt/impl/BvhImporter.h>
+#include <hiprt/impl/BvhStatistics.h>
 #include <hiprt/impl/BatchBuilder.h>
 #include <hiprt/impl/Context.h>
 #include <hiprt/impl/LbvhBuilder.h>
@@ -31,6 +32,26 @@
 #include <hiprt/impl/PlocBuilder.h>
 #include <hiprt/impl/SbvhBuilder.h>
 #include <hiprt/impl/Transform.h>
+#include <hiprt/impl/TraversalStatistics.h>
+
+namespace
+{
+uint64_t getTotalPrimCount( const std::vector<hiprtGeometryBuildInput>& buildInputs )
+{
+	uint64_t primCount = 0u;
+	for ( const hiprtGeometryBuildInput& buildInput : buildInputs )
+		primCount += hiprt::getPrimCount( buildInput );
+	return primCount;
+}
+
+uint64_t getTotalInstanceCount( const std::vector<hiprtSceneBuildInput>& buildInputs )
+{
+	uint64_t instanceCount = 0u;
+	for ( const hiprtSceneBuildInput& buildInput : buildInputs )
+		instanceCount += buildInput.instanceCount;
+	return instanceCount;
+}
+} // namespace
 
 namespace hiprt
 {
@@ -39,12 +60,17 @@ Context::Context( const hiprtContextCreationInput& input )
 	oroApi api = ( input.deviceType == hiprtDeviceAMD ) ? ORO_API_HIP : ORO_API_CUDA;
 	oroCtxCreateFromRaw( &m_ctxt, api, input.ctxt );
 	m_device = oroSetRawDevice( api, input.device );
+	Logger::getInstance().attach();
 }
 
 Context::~Context()
 {
+	// pending compilations still use the context
+	m_compilePool.reset();
+	m_buildProfiler.setEnabled( false );
 	m_oroutils.unloadKernelCache();
 	oroCtxCreateFromRawDestroy( m_ctxt );
+	Logger::getInstance().detach();
 }
 
 std::vector<hiprtGeometry>
@@ -148,6 +174,11 @@ void Context::buildGeometries(
 {
 	checkOro( oroCtxSetCurrent( m_ctxt ) );
 
+	Tracer::Span span( m_tracer, "buildGeometries", "build" );
+	span.arg( "count", buildInputs.size() );
+	if ( span.isActive() ) span.arg( "primCount", getTotalPrimCount( buildInputs ) );
+	span.stream( stream );
+
 	std::vector<hiprtGeometryBuildInput> batchInputs;
 	std::vector<hiprtDevicePtr>			 batchBuffers;
 	for ( size_t i = 0; i < buildInputs.size(); ++i )
@@ -206,6 +237,12 @@ void Context::updateGeometries(
 	std::vector<hiprtDevicePtr>&				buffers )
 {
 	checkOro( oroCtxSetCurrent( m_ctxt ) );
+
+	Tracer::Span span( m_tracer, "updateGeometries", "build" );
+	span.arg( "count", buildInputs.size() );
+	if ( span.isActive() ) span.arg( "primCount", getTotalPrimCount( buildInputs ) );
+	span.stream( stream );
+
 	for ( size_t i = 0; i < buildInputs.size(); ++i )
 	{
 		if ( ( buildOptions.buildFlags & 3 ) == hiprtBuildFlagBitCustomBvhImport )
@@ -291,6 +328,10 @@ std::vector<hiprtGeometry> Context::compactGeometries( const std::vector<hiprtGe
 {
 	checkOro( oroCtxSetCurrent( m_ctxt ) );
 
+	Tracer::Span span( m_tracer, "compactGeometries", "compaction" );
+	span.arg( "count", geometriesIn.size() );
+	span.stream( stream );
+
 	size_t				size = 0;
 	std::vector<size_t> sizes( geometriesIn.size() );
 	for ( size_t i = 0; i < geometriesIn.size(); ++i )
@@ -306,6 +347,7 @@ std::vector<hiprtGeometry> Context::compactGeometries( const std::vector<hiprtGe
 	}
 
 	oroDeviceptr buffer;
+	span.arg( "bytes", size );
 	checkOro( oroMalloc( &buffer, size ) );
 
 	std::vector<hiprtGeometry> geometriesOut( geometriesIn.size() );
@@ -454,6 +496,11 @@ void Context::buildScenes(
 {
 	checkOro( oroCtxSetCurrent( m_ctxt ) );
 
+	Tracer::Span span( m_tracer, "buildScenes", "build" );
+	span.arg( "count", buildInputs.size() );
+	if ( span.isActive() ) span.arg( "instanceCount", getTotalInstanceCount( buildInputs ) );
+	span.stream( stream );
+
 	std::vector<hiprtSceneBuildInput> batchInputs;
 	std::vector<hiprtDevicePtr>		  batchBuffers;
 	for ( size_t i = 0; i < buildInputs.size(); ++i )
@@ -512,6 +559,12 @@ void Context::updateScenes(
 	std::vector<hiprtDevicePtr>&			 buffers )
 {
 	checkOro( oroCtxSetCurrent( m_ctxt ) );
+
+	Tracer::Span span( m_tracer, "updateScenes", "build" );
+	span.arg( "count", buildInputs.size() );
+	if ( span.isActive() ) span.arg( "instanceCount", getTotalInstanceCount( buildInputs ) );
+	span.stream( stream );
+
 	for ( size_t i = 0; i < buildInputs.size(); ++i )
 	{
 		if ( ( buildOptions.buildFlags & 3 ) == hiprtBuildFlagBitCustomBvhImport )
@@ -598,77 +651,102 @@ std::vector<hiprtScene> Context::compactScenes( const std::vector<hiprtScene>& s
 {
 	checkOro( oroCtxSetCurrent( m_ctxt ) );
 
-	size_t				size = 0;
-	std::vector<size_t> sizes( scenesIn.size() );
+	Tracer::Span span( m_tracer, "compactScenes", "compaction" );
+	span.arg( "count", scenesIn.size() );
+	span.stream( stream );
+
+	// time segments are compacted one by one and stored with a common stride
+	size_t								  size = 0;
+	std::vector<size_t>					  sizes( scenesIn.size() );
+	std::vector<size_t>					  segmentSizes( scenesIn.size() );
+	std::vector<std::vector<SceneHeader>> headers( scenesIn.size() );
 	for ( size_t i = 0; i < scenesIn.size(); ++i )
 	{
 		SceneHeader header;
 		checkOro( oroMemcpyDtoH( &header, reinterpret_cast<oroDeviceptr>( scenesIn[i] ), sizeof( SceneHeader ) ) );
 
-		const size_t primCount	   = header.m_primCount;
-		const size_t primNodeCount = header.m_primNodeCount;
-		const size_t primNodeSize  = sizeof( InstanceNode );
-		const size_t boxNodeCount  = header.m_boxNodeCount;
-		sizes[i]				   = getSceneStorageBufferSize( primCount, primNodeCount, boxNodeCount, primNodeSize );
+		headers[i].resize( std::max( header.m_timeSegmentCount, 1u ) );
+		headers[i][0] = header;
+		for ( uint32_t j = 1; j < headers[i].size(); ++j )
+			checkOro( oroMemcpyDtoH(
+				&headers[i][j],
+				reinterpret_cast<oroDeviceptr>( reinterpret_cast<uint8_t*>( scenesIn[i] ) + j * header.m_timeSegmentStride ),
+				sizeof( SceneHeader ) ) );
+
+		for ( const SceneHeader& segmentHeader : headers[i] )
+		{
+			const size_t primCount	   = segmentHeader.m_primCount;
+			const size_t primNodeCount = segmentHeader.m_primNodeCount;
+			const size_t boxNodeCount  = segmentHeader.m_boxNodeCount;
+			const size_t frameCount	   = segmentHeader.m_frameCount;
+			segmentSizes[i] =
+				std::max( segmentSizes[i], getSceneStorageBufferSize( primCount, primNodeCount, boxNodeCount, frameCount ) );
+		}
+		sizes[i] = segmentSizes[i] * headers[i].size();
 		size += sizes[i];
 	}
 
 	oroDeviceptr buffer;
+	span.arg( "bytes", size );
 	checkOro( oroMalloc( &buffer, size ) );
 
 	std::vector<hiprtScene> scenesOut( scenesIn.size() );
 	for ( size_t i = 0; i < scenesIn.size(); ++i )
 	{
-		SceneHeader header;
-		checkOro( oroMemcpyDtoH( &header, reinterpret_cast<oroDeviceptr>( scenesIn[i] ), sizeof( SceneHeader ) ) );
-
 		scenesOut[i] = reinterpret_cast<hiprtScene>( buffer );
-		MemoryArena storageMemoryArena( scenesOut[i], sizes[i], DefaultAlignment );
-		storageMemoryArena.allocate<SceneHeader>();
-		BoxNode*	  boxNodes	= storageMemoryArena.allocate<BoxNode>( header.m_boxNodeCount );
-		InstanceNode* primNodes = storageMemoryArena.allocate<InstanceNode>( header.m_primNodeCount );
-		Instance*	  instances = storageMemoryArena.allocate<Instance>( header.m_primCount );
-		Frame*		  frames	= storageMemoryArena.allocate<Frame>( header.m_frameCount );
-
-		checkOro( oroMemcpyDtoDAsync(
-			reinterpret_cast<oroDeviceptr>( boxNodes ),
-			reinterpret_cast<oroDeviceptr>( header.m_boxNodes ),
-			sizeof( BoxNode ) * header.m_boxNodeCount,
-			stream ) );
-
-		checkOro( oroMemcpyDtoDAsync(
-			reinterpret_cast<oroDeviceptr>( primNodes ),
-			reinterpret_cast<oroDeviceptr>( header.m_primNodes ),
-			sizeof( InstanceNode ) * header.m_primNodeCount,
-			stream ) );
-
-		checkOro( oroMemcpyDtoDAsync(
-			reinterpret_cast<oroDeviceptr>( instances ),
-			reinterpret_cast<oroDeviceptr>( header.m_instances ),
-			sizeof( hiprtTransformHeader ) * header.m_primCount,
-			stream ) );
-
-		checkOro( oroMemcpyDtoDAsync(
-			reinterpret_cast<oroDeviceptr>( frames ),
-			reinterpret_cast<oroDeviceptr>( header.m_frames ),
-			sizeof( Frame ) * header.m_frameCount,
-			stream ) );
-
-		header.m_boxNodes  = boxNodes;
-		header.m_primNodes = primNodes;
-		header.m_instances = instances;
-		header.m_frames	   = frames;
-		checkOro(
-			oroMemcpyHtoDAsync( reinterpret_cast<oroDeviceptr>( scenesOut[i] ), &header, sizeof( SceneHeader ), stream ) );
-
-		buffer = static_cast<uint8_t*>( buffer ) + sizes[i];
+		for ( SceneHeader& header : headers[i] )
+		{
+			MemoryArena storageMemoryArena( buffer, segmentSizes[i], DefaultAlignment );
+			SceneHeader* sceneHeader = storageMemoryArena.allocate<SceneHeader>();
+			BoxNode*	  boxNodes	  = storageMemoryArena.allocate<BoxNode>( header.m_boxNodeCount );
+			InstanceNode* primNodes	  = storageMemoryArena.allocate<InstanceNode>( header.m_primNodeCount );
+			Instance*	  instances	  = storageMemoryArena.allocate<Instance>( header.m_primCount );
+			Frame*		  frames	  = storageMemoryArena.allocate<Frame>( header.m_frameCount );
+
+			checkOro( oroMemcpyDtoDAsync(
+				reinterpret_cast<oroDeviceptr>( boxNodes ),
+				reinterpret_cast<oroDeviceptr>( header.m_boxNodes ),
+				sizeof( BoxNode ) * header.m_boxNodeCount,
+				stream ) );
+
+			checkOro( oroMemcpyDtoDAsync(
+				reinterpret_cast<oroDeviceptr>( primNodes ),
+				reinterpret_cast<oroDeviceptr>( header.m_primNodes ),
+				sizeof( InstanceNode ) * header.m_primNodeCount,
+				stream ) );
+
+			checkOro( oroMemcpyDtoDAsync(
+				reinterpret_cast<oroDeviceptr>( instances ),
+				reinterpret_cast<oroDeviceptr>( header.m_instances ),
+				sizeof( Instance ) * header.m_primCount,
+				stream ) );
+
+			checkOro( oroMemcpyDtoDAsync(
+				reinterpret_cast<oroDeviceptr>( frames ),
+				reinterpret_cast<oroDeviceptr>( header.m_frames ),
+				sizeof( Frame ) * header.m_frameCount,
+				stream ) );
+
+			header.m_boxNodes		   = boxNodes;
+			header.m_primNodes		   = primNodes;
+			header.m_instances		   = instances;
+			header.m_frames			   = frames;
+			header.m_timeSegmentStride = segmentSizes[i];
+			checkOro( oroMemcpyHtoDAsync(
+				reinterpret_cast<oroDeviceptr>( sceneHeader ), &header, sizeof( SceneHeader ), stream ) );
+
+			buffer = static_cast<uint8_t*>( buffer ) + segmentSizes[i];
+		}
 	}
 
-	std::lock_guard<std::mutex> lockMutex( m_poolMutex );
-	m_poolHeads[{ reinterpret_cast<oroDeviceptr>( scenesOut.front() ), size }] = static_cast<uint32_t>( scenesOut.size() );
+	{
+		std::lock_guard<std::mutex> lockMutex( m_poolMutex );
+		m_poolHeads[{ reinterpret_cast<oroDeviceptr>( scenesOut.front() ), size }] =
+			static_cast<uint32_t>( scenesOut.size() );
+	}
 
 	checkOro( oroStreamSynchronize( stream ) );
-	destroyScenes( scenesOut );
+	destroyScenes( scenesIn );
 
 	return scenesOut;
 }
@@ -750,6 +828,8 @@ void Context::saveGeometry( hiprtGeometry inGeometry, const std::string& filenam
 {
 	checkOro( oroCtxSetCurrent( m_ctxt ) );
 
+	Tracer::Span span( m_tracer, "saveGeometry", "io" );
+
 	size_t size = 0;
 	{
 		GeomHeader header;
@@ -757,6 +837,8 @@ void Context::saveGeometry( hiprtGeometry inGeometry, const std::string& filenam
 		size = header.m_size;
 	}
 
+	span.arg( "bytes", size );
+
 	std::vector<uint8_t> buffer( size );
 	checkOro( oroMemcpyDtoH( buffer.data(), reinterpret_cast<oroDeviceptr>( inGeometry ), size ) );
 
@@ -773,6 +855,7 @@ void Context::saveGeometry( hiprtGeometry inGeometry, const std::string& filenam
 
 hiprtGeometry Context::loadGeometry( const std::string& filename )
 {
+	Tracer::Span span( m_tracer, "loadGeometry", "io" );
 	std::ifstream file( filename, std::ios::in | std::ios::binary );
 
 	size_t size = 0;
@@ -782,6 +865,8 @@ hiprtGeometry Context::loadGeometry( const std::string& filename )
 		size = header.m_size;
 	}
 
+	span.arg( "bytes", size );
+
 	std::vector<uint8_t> buffer( size );
 	file.clear();
 	file.seekg( 0, std::ios::beg );
@@ -832,14 +917,147 @@ void Context::exportSceneAabb( hiprtScene inScene, float3& outAabbMin, float3& o
 	SceneHeader header;
 	checkOro( oroMemcpyDtoH( &header, reinterpret_cast<oroDeviceptr>( inScene ), sizeof( SceneHeader ) ) );
 
-	BoxNode root;
-	checkOro( oroMemcpyDtoH( &root, reinterpret_cast<oroDeviceptr>( header.m_boxNodes ), sizeof( BoxNode ) ) );
+	// the bounding box of a time-segmented scene covers all its segments
+	Aabb box;
+	for ( uint32_t i = 0; i < std::max( header.m_timeSegmentCount, 1u ); ++i )
+	{
+		SceneHeader segmentHeader = header;
+		if ( i > 0 )
+			checkOro( oroMemcpyDtoH(
+				&segmentHeader,
+				reinterpret_cast<oroDeviceptr>( reinterpret_cast<uint8_t*>( inScene ) + i * header.m_timeSegmentStride ),
+				sizeof( SceneHeader ) ) );
+
+		BoxNode root;
+		checkOro( oroMemcpyDtoH( &root, reinterpret_cast<oroDeviceptr>( segmentHeader.m_boxNodes ), sizeof( BoxNode ) ) );
+		box.grow( root.aabb() );
+	}
 
-	Aabb box   = root.aabb();
 	outAabbMin = box.m_min;
 	outAabbMax = box.m_max;
 }
 
+hiprtBvhStatistics Context::getGeometryStatistics( hiprtGeometry inGeometry )
+{
+	checkOro( oroCtxSetCurrent( m_ctxt ) );
+
+	GeomHeader header;
+	checkOro( oroMemcpyDtoH( &header, reinterpret_cast<oroDeviceptr>( inGeometry ), sizeof( GeomHeader ) ) );
+
+	std::vector<BoxNode> boxNodes( header.m_boxNodeCount );
+	checkOro( oroMemcpyDtoH(
+		boxNodes.data(), reinterpret_cast<oroDeviceptr>( header.m_boxNodes ), sizeof( BoxNode ) * header.m_boxNodeCount ) );
+
+	if ( header.m_geomType & 1 )
+	{
+		std::vector<TriangleNode> primNodes( header.m_primNodeCount );
+		checkOro( oroMemcpyDtoH(
+			primNodes.data(),
+			reinterpret_cast<oroDeviceptr>( header.m_primNodes ),
+			sizeof( TriangleNode ) * header.m_primNodeCount ) );
+
+		uint32_t pairedCount = 0;
+
+		auto getLeafPrimIndices = [&]( uint32_t leafIndex, std::vector<uint32_t>& primIndices ) {
+			const TriangleNode& node = primNodes.at( getNodeAddr( leafIndex ) );
+			primIndices.push_back( node.m_primIndex0 );
+			if ( node.m_primIndex0 != node.m_primIndex1 )
+			{
+				primIndices.push_back( node.m_primIndex1 );
+				pairedCount += 2;
+			}
+		};
+
+		hiprtBvhStatistics stats = BvhStatistics::compute( boxNodes, getLeafPrimIndices );
+		if ( stats.primReferenceCount > 0 )
+			stats.pairedTriangleRatio = static_cast<float>( pairedCount ) / static_cast<float>( stats.primReferenceCount );
+		stats.memorySize = header.m_size;
+		return stats;
+	}
+	else
+	{
+		std::vector<CustomNode> primNodes( header.m_primNodeCount );
+		checkOro( oroMemcpyDtoH(
+			primNodes.data(),
+			reinterpret_cast<oroDeviceptr>( header.m_primNodes ),
+			sizeof( CustomNode ) * header.m_primNodeCount ) );
+
+		hiprtBvhStatistics stats =
+			BvhStatistics::compute( boxNodes, [&]( uint32_t leafIndex, std::vector<uint32_t>& primIndices ) {
+				uint32_t leafAddr = getNodeAddr( leafIndex );
+				primIndices.push_back( primNodes.at( leafAddr ).getPrimIndex() );
+				while ( primNodes.at( leafAddr ).hasNext() )
+					primIndices.push_back( primNodes.at( ++leafAddr ).getPrimIndex() );
+			} );
+		stats.memorySize = header.m_size;
+		return stats;
+	}
+}
+
+hiprtBvhStatistics Context::getSceneStatistics( hiprtScene inScene )
+{
+	checkOro( oroCtxSetCurrent( m_ctxt ) );
+
+	SceneHeader header;
+	checkOro( oroMemcpyDtoH( &header, reinterpret_cast<oroDeviceptr>( inScene ), sizeof( SceneHeader ) ) );
+
+	// every time segment has a hierarchy of its own, the segments follow the first one with a fixed stride
+	const uint32_t	   segmentCount = std::max( header.m_timeSegmentCount, 1u );
+	hiprtBvhStatistics stats;
+	for ( uint32_t i = 0; i < segmentCount; ++i )
+	{
+		SceneHeader segment = header;
+		if ( i > 0 )
+			checkOro( oroMemcpyDtoH(
+				&segment,
+				reinterpret_cast<oroDeviceptr>( reinterpret_cast<uint8_t*>( inScene ) + i * header.m_timeSegmentStride ),
+				sizeof( SceneHeader ) ) );
+
+		std::vector<BoxNode> boxNodes( segment.m_boxNodeCount );
+		checkOro( oroMemcpyDtoH(
+			boxNodes.data(),
+			reinterpret_cast<oroDeviceptr>( segment.m_boxNodes ),
+			sizeof( BoxNode ) * segment.m_boxNodeCount ) );
+
+		std::vector<InstanceNode> primNodes( segment.m_primNodeCount );
+		checkOro( oroMemcpyDtoH(
+			primNodes.data(),
+			reinterpret_cast<oroDeviceptr>( segment.m_primNodes ),
+			sizeof( InstanceNode ) * segment.m_primNodeCount ) );
+
+		const hiprtBvhStatistics segmentStats =
+			BvhStatistics::compute( boxNodes, [&]( uint32_t leafIndex, std::vector<uint32_t>& primIndices ) {
+				primIndices.push_back( primNodes.at( getNodeAddr( leafIndex ) ).m_primIndex );
+			} );
+
+		stats.sahCost += segmentStats.sahCost / segmentCount;
+		stats.averageLeafDepth += segmentStats.averageLeafDepth / segmentCount;
+		stats.siblingOverlapRatio += segmentStats.siblingOverlapRatio / segmentCount;
+		stats.referenceDuplicationFactor += segmentStats.referenceDuplicationFactor / segmentCount;
+		stats.maxDepth = std::max( stats.maxDepth, segmentStats.maxDepth );
+		stats.boxNodeCount += segmentStats.boxNodeCount;
+		stats.leafNodeCount += segmentStats.leafNodeCount;
+		stats.primReferenceCount += segmentStats.primReferenceCount;
+		stats.primCount = std::max( stats.primCount, segmentStats.primCount );
+		for ( uint32_t j = 0; j <= hiprtBranchingFactor; ++j )
+			stats.childCountHistogram[j] += segmentStats.childCountHistogram[j];
+	}
+	stats.memorySize = header.m_size;
+	return stats;
+}
+
+hiprtTraversalStatisticsSummary Context::summarizeTraversalStatistics( uint32_t rayCount, hiprtDevicePtr statistics )
+{
+	checkOro( oroCtxSetCurrent( m_ctxt ) );
+
+	std::vector<hiprtTraversalStatistics> rayStats( rayCount );
+	if ( rayCount > 0 )
+		checkOro( oroMemcpyDtoH(
+			rayStats.data(), reinterpret_cast<oroDeviceptr>( statistics ), sizeof( hiprtTraversalStatistics ) * rayCount ) );
+
+	return TraversalStatistics::summarize( rayStats );
+}
+
 void Context::buildKernels(
 	const std::vector<const char*>&		 funcNames,
 	const std::string&					 src,
@@ -887,8 +1105,58 @@ void Context::buildKernelsFromBitcode(
 		*this, funcNames, moduleName, bitcodeBinary, numGeomTypes, numRayTypes, funcNameSets, functions, cache );
 }
 
+ThreadPool& Context::getCompilePool()
+{
+	std::lock_guard<std::mutex> lock( m_compilePoolMutex );
+	if ( !m_compilePool ) m_compilePool = std::make_unique<ThreadPool>();
+	return *m_compilePool;
+}
+
 void Context::setCacheDir( const std::filesystem::path& path ) { m_compiler.setCacheDir( path ); }
 
+void Context::setCacheSizeLimit( size_t maxSize ) { m_compiler.setCacheSizeLimit( maxSize ); }
+
+void Context::setCacheReadOnly( bool readOnly ) { m_compiler.setCacheReadOnly( readOnly ); }
+
+void Context::trimCache( size_t maxSize ) { m_compiler.trimCache( *this, maxSize ); }
+
+hiprtCacheStatistics Context::getCacheStatistics() { return m_compiler.getCacheStatistics( *this ); }
+
+void Context::setCompileTarget( const hiprtCompileTarget* target )
+{
+	if ( target == nullptr )
+	{
+		m_compileTarget.reset();
+		return;
+	}
+
+	CompileTarget compileTarget;
+	compileTarget.deviceName = target->deviceName;
+	compileTarget.archName	 = target->archName;
+	if ( target->driverVersion != nullptr ) compileTarget.driverVersion = target->driverVersion;
+	if ( compileTarget.deviceName.find( "NVIDIA" ) != std::string::npos )
+		compileTarget.archOption = "-arch=" + compileTarget.archName;
+	else
+		compileTarget.archOption = "--offload-arch=" + compileTarget.archName;
+	m_compileTarget = std::move( compileTarget );
+}
+
+void Context::enableCompileTelemetry( bool enable ) { m_compiler.getTelemetry().setEnabled( enable ); }
+
+void Context::exportCompileTelemetry( const std::filesystem::path& path ) { m_compiler.getTelemetry().exportJson( path ); }
+
+void Context::enableBuildProfiler( bool enable ) { m_buildProfiler.setEnabled( enable ); }
+
+uint32_t Context::getBuildProfiles( uint32_t count, hiprtBuildProfile* profilesOut )
+{
+	checkOro( oroCtxSetCurrent( m_ctxt ) );
+	return m_buildProfiler.getProfiles( count, profilesOut );
+}
+
+void Context::enableTracing( bool enable ) { m_tracer.setEnabled( enable ); }
+
+void Context::exportTrace( const std::filesystem::path& path ) { m_tracer.exportJson( path ); }
+
 uint32_t Context::getSMCount() const
 {
 	int smCount;
@@ -915,6 +1183,8 @@ uint32_t Context::getMaxGridSize() const
 
 std::string Context::getDeviceName() const
 {
+	if ( m_compileTarget ) return m_compileTarget->deviceName;
+
 	oroDeviceProp prop;
 	checkOro( oroCtxSetCurrent( m_ctxt ) );
 	checkOro( oroGetDeviceProperties( &prop, m_device ) );
@@ -923,6 +1193,8 @@ std::string Context::getDeviceName() const
 
 std::string Context::getGcnArchName() const
 {
+	if ( m_compileTarget ) return m_compileTarget->archName;
+
 	oroDeviceProp prop;
 	checkOro( oroCtxSetCurrent( m_ctxt ) );
 	checkOro( oroGetDeviceProperties( &prop, m_device ) );
@@ -931,6 +1203,8 @@ std::string Context::getGcnArchName() const
 
 std::string Context::getDriverVersion() const
 {
+	if ( m_compileTarget && !m_compileTarget->driverVersion.empty() ) return m_compileTarget->driverVersion;
+
 	int driverVersion;
 	checkOro( oroCtxSetCurrent( m_ctxt ) );
 	checkOro( oroDriverGetVersion( &driverVersion ) );
@@ -25,9 +25,13 @@
 #pragma once
 #include <Orochi/Orochi.h>
 #include <hiprt/hiprt_types.h>
+#include <hiprt/impl/BuildProfiler.h>
 #include <hiprt/impl/Compiler.h>
 #include <hiprt/impl/Error.h>
+#include <hiprt/impl/ThreadPool.h>
+#include <hiprt/impl/Tracer.h>
 #include <ParallelPrimitives/RadixSort.h>
+#include <optional>
 
 namespace hiprt
 {
@@ -101,6 +105,10 @@ class Context
 	void exportGeometryAabb( hiprtGeometry inGeometry, float3& outAabbMin, float3& outAabbMax );
 	void exportSceneAabb( hiprtScene inScene, float3& outAabbMin, float3& outAabbMax );
 
+	hiprtBvhStatistics				getGeometryStatistics( hiprtGeometry inGeometry );
+	hiprtBvhStatistics				getSceneStatistics( hiprtScene inScene );
+	hiprtTraversalStatisticsSummary	summarizeTraversalStatistics( uint32_t rayCount, hiprtDevicePtr statistics );
+
 	void buildKernels(
 		const std::vector<const char*>&		 funcNames,
 		const std::string&					 src,
@@ -126,6 +134,32 @@ class Context
 		bool								 cache );
 
 	void setCacheDir( const std::filesystem::path& path );
+	void setCacheSizeLimit( size_t maxSize );
+	void setCacheReadOnly( bool readOnly );
+	void trimCache( size_t maxSize );
+
+	hiprtCacheStatistics getCacheStatistics();
+
+	// the device queries of an offline compilation return the target
+	struct CompileTarget
+	{
+		std::string deviceName;
+		std::string archName;
+		std::string driverVersion;
+		std::string archOption;
+	};
+
+	void								setCompileTarget( const hiprtCompileTarget* target );
+	const std::optional<CompileTarget>& getCompileTarget() const noexcept { return m_compileTarget; }
+
+	void enableCompileTelemetry( bool enable );
+	void exportCompileTelemetry( const std::filesystem::path& path );
+
+	void	 enableBuildProfiler( bool enable );
+	uint32_t getBuildProfiles( uint32_t count, hiprtBuildProfile* profilesOut );
+
+	void enableTracing( bool enable );
+	void exportTrace( const std::filesystem::path& path );
 
 	uint32_t	getSMCount() const;
 	uint32_t	getMaxBlockSize() const;
@@ -134,9 +168,12 @@ class Context
 	std::string getGcnArchName() const;
 	std::string getDriverVersion() const;
 
-	oroDevice	 getDevice() const noexcept;
-	OrochiUtils& getOrochiUtils() { return m_oroutils; }
-	Compiler&	 getCompiler() { return m_compiler; }
+	oroDevice	   getDevice() const noexcept;
+	OrochiUtils&   getOrochiUtils() { return m_oroutils; }
+	Compiler&	   getCompiler() { return m_compiler; }
+	BuildProfiler& getBuildProfiler() { return m_buildProfiler; }
+	Tracer&		   getTracer() { return m_tracer; }
+	ThreadPool&	   getCompilePool();
 
 	bool enableHwi() const;
 
@@ -146,6 +183,16 @@ class Context
 	OrochiUtils m_oroutils;
 	Compiler	m_compiler;
 
+	std::optional<CompileTarget> m_compileTarget;
+
+	// holds device events, released before the context
+	BuildProfiler m_buildProfiler;
+	Tracer		  m_tracer;
+
+	// created on the first asynchronous compilation
+	std::mutex					m_compilePoolMutex;
+	std::unique_ptr<ThreadPool> m_compilePool;
+
 	std::mutex											m_poolMutex;
 	std::map<std::pair<oroDeviceptr, size_t>, uint32_t> m_poolHeads;
 };
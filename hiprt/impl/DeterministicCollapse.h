@@ -0,0 +1,139 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <hiprt/hiprt_types.h>
+#include <hiprt/impl/BvhConfig.h>
+#include <hiprt/impl/BvhNode.h>
+#include <hiprt/impl/Context.h>
+#include <hiprt/impl/Kernel.h>
+#include <hiprt/impl/MemoryArena.h>
+#include <hiprt/impl/Timer.h>
+#include <hiprt/impl/Utility.h>
+
+#if defined( HIPRT_LOAD_FROM_STRING )
+#include <hiprt/cache/Kernels.h>
+#include <hiprt/cache/KernelArgs.h>
+#endif
+
+namespace hiprt
+{
+// The collapse of deterministic builds, shared by the LBVH and PLOC builders. The wide hierarchy is
+// emitted level by level from the root task in the task queue, the node counts of a level are
+// prefix-summed by a single block, and the totals are read back to size the next level.
+template <typename Header, typename PrimitiveNode, typename PrimitiveContainer>
+void collapseDeterministic(
+	Context&				  context,
+	PrimitiveContainer&		  primitives,
+	const hiprtBuildOptions	  buildOptions,
+	const std::string&		  containerNodeParam,
+	std::vector<const char*>& opts,
+	Header*					  header,
+	ScratchNode*			  scratchNodes,
+	ReferenceNode*			  references,
+	BoxNode*				  boxNodes,
+	uint32_t				  maxBoxNodeCount,
+	PrimitiveNode*			  primNodes,
+	uint3*					  taskQueue,
+	MemoryArena&			  temporaryMemoryArena,
+	Timer&					  timer,
+	Timer::TokenType		  collapseTime,
+	oroStream				  stream )
+{
+	uint3*	  nextTaskQueue = temporaryMemoryArena.allocate<uint3>( primitives.getCount() );
+	uint32_t* boxCounts		= temporaryMemoryArena.allocate<uint32_t>( primitives.getCount() );
+	uint32_t* primCounts	= temporaryMemoryArena.allocate<uint32_t>( primitives.getCount() );
+	uint2*	  levelTotals	= temporaryMemoryArena.allocate<uint2>();
+
+	// box nodes were used as scratch memory
+	checkOro( oroMemsetD8Async( reinterpret_cast<oroDeviceptr>( boxNodes ), 0, sizeof( BoxNode ) * maxBoxNodeCount, stream ) );
+
+	Compiler& compiler = context.getCompiler();
+
+	static const Compiler::KernelKey countCollapsedChildrenKey(
+		Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "CountCollapsedChildren_" + containerNodeParam );
+	Kernel							 countCollapsedChildrenKernel =
+		compiler.getKernel( context, countCollapsedChildrenKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
+	static const Compiler::KernelKey scanCollapsedChildrenKey(
+		Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "ScanCollapsedChildren" );
+	Kernel							 scanCollapsedChildrenKernel =
+		compiler.getKernel( context, scanCollapsedChildrenKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
+	static const Compiler::KernelKey collapseLevelKey(
+		Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "CollapseLevel_" + containerNodeParam );
+	Kernel							 collapseLevelKernel =
+		compiler.getKernel( context, collapseLevelKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
+
+	uint32_t taskCount	   = 1;
+	uint32_t boxNodeCount  = 1;
+	uint32_t primNodeCount = 0;
+	timer.measure( collapseTime, [&]() {
+		while ( taskCount > 0 )
+		{
+			countCollapsedChildrenKernel.setArgs(
+				{ taskCount,
+				  scratchNodes,
+				  references,
+				  taskQueue,
+				  boxCounts,
+				  primCounts,
+				  buildOptions.customLeafMaxPrimCount } );
+			countCollapsedChildrenKernel.launch( taskCount, stream );
+
+			scanCollapsedChildrenKernel.setArgs( { taskCount, boxCounts, primCounts, levelTotals } );
+			scanCollapsedChildrenKernel.launch( BvhBuilderReductionBlockSize, BvhBuilderReductionBlockSize, stream );
+
+			collapseLevelKernel.setArgs(
+				{ taskCount,
+				  boxNodeCount,
+				  primNodeCount,
+				  scratchNodes,
+				  references,
+				  boxNodes,
+				  primNodes,
+				  primitives,
+				  taskQueue,
+				  nextTaskQueue,
+				  boxCounts,
+				  primCounts,
+				  buildOptions.customLeafMaxPrimCount } );
+			collapseLevelKernel.launch( taskCount, stream );
+
+			uint2 totals;
+			checkOro( oroMemcpyDtoHAsync( &totals, reinterpret_cast<oroDeviceptr>( levelTotals ), sizeof( uint2 ), stream ) );
+			checkOro( oroStreamSynchronize( stream ) );
+			taskCount = totals.x;
+			boxNodeCount += totals.x;
+			primNodeCount += totals.y;
+			std::swap( taskQueue, nextTaskQueue );
+		}
+	} );
+
+	checkOro( oroMemcpyHtoDAsync(
+		reinterpret_cast<oroDeviceptr>( &header->m_boxNodeCount ), &boxNodeCount, sizeof( uint32_t ), stream ) );
+	checkOro( oroMemcpyHtoDAsync(
+		reinterpret_cast<oroDeviceptr>( &header->m_primNodeCount ), &primNodeCount, sizeof( uint32_t ), stream ) );
+	checkOro( oroStreamSynchronize( stream ) );
+}
+} // namespace hiprt
@@ -49,14 +49,76 @@ class InstanceList
 		hiprtTransformHeader header = fetchTransformHeader( index );
 		Transform			 t( m_frames, header.frameIndex, header.frameCount );
 		hiprtInstance		 instance = fetchInstance( index );
-		const BoxNode*		 boxNodes = instance.type == hiprtInstanceTypeScene
-											? reinterpret_cast<SceneHeader*>( instance.scene )->m_boxNodes
-											: reinterpret_cast<GeomHeader*>( instance.geometry )->m_boxNodes;
+		if ( instance.type == hiprtInstanceTypeScene )
+		{
+			// a time-segmented scene is bounded over all its segments
+			SceneHeader* scene = reinterpret_cast<SceneHeader*>( instance.scene );
+			Aabb		 aabb  = fetchAabb( t, scene->m_boxNodes );
+			for ( uint32_t i = 1; i < scene->m_timeSegmentCount; ++i )
+				aabb.grow( fetchAabb( t, scene->getTimeSegmentByIndex( i )->m_boxNodes ) );
+			return aabb;
+		}
+		return fetchAabb( t, reinterpret_cast<GeomHeader*>( instance.geometry )->m_boxNodes );
+	}
+
+	HIPRT_HOST_DEVICE float3 fetchCenter( uint32_t index ) const { return fetchAabb( index ).center(); }
+
+	HIPRT_HOST_DEVICE uint32_t fetchMask( uint32_t index ) const
+	{
+		if ( m_masks == nullptr ) return FullRayMask;
+		return m_masks[index];
+	}
+
+	HIPRT_HOST_DEVICE hiprtInstance fetchInstance( uint32_t index ) const { return m_instances[index]; }
+
+	HIPRT_HOST_DEVICE hiprtTransformHeader fetchTransformHeader( uint32_t index ) const
+	{
+		if ( m_transformHeaders == nullptr ) return hiprtTransformHeader{ index, 1 };
+		return m_transformHeaders[index];
+	}
+
+	HIPRT_HOST_DEVICE Frame fetchFrame( uint32_t index ) const
+	{
+		if ( m_frameCount == 0 || m_apiFrames == nullptr || m_frames == nullptr ) return Frame();
+		return m_frames[index];
+	}
+
+	HIPRT_HOST_DEVICE void convertFrame( uint32_t index )
+	{
+		if ( m_frameCount > 0 && m_apiFrames != nullptr && m_frames != nullptr ) m_frames[index] = m_apiFrames[index].convert();
+	}
 
+	HIPRT_HOST_DEVICE bool copyInvTransformMatrix( uint32_t index, float ( &matrix )[3][4] ) const
+	{
+		Frame		frame		   = fetchFrame( index );
+		MatrixFrame invMatrixFrame = MatrixFrame::getMatrixFrameInv( frame );
+		memcpy( &matrix[0][0], &invMatrixFrame.m_matrix[0][0], sizeof( float ) * 12 );
+		return frame.identity();
+	}
+
+	HIPRT_HOST_DEVICE uint32_t getCount() const { return m_instanceCount; }
+
+	HIPRT_HOST_DEVICE uint32_t getFrameCount() const { return m_frameCount; }
+
+	HIPRT_HOST_DEVICE void setFrames( Frame* frames ) { m_frames = frames; }
+
+	HIPRT_HOST_DEVICE void setTimeSegment( uint32_t index, uint32_t count )
+	{
+		m_timeSegmentIndex = index;
+		m_timeSegmentCount = count;
+	}
+
+	HIPRT_HOST_DEVICE uint32_t getTimeSegmentIndex() const { return m_timeSegmentIndex; }
+
+	HIPRT_HOST_DEVICE uint32_t getTimeSegmentCount() const { return m_timeSegmentCount; }
+
+  private:
+	HIPRT_HOST_DEVICE Aabb fetchAabb( const Transform& t, const BoxNode* boxNodes ) const
+	{
 		if constexpr ( StackSize == 0 )
 		{
 			Aabb aabb = boxNodes->aabb();
-			return t.motionBounds( aabb );
+			return motionBounds( t, aabb );
 		}
 		else
 		{
@@ -75,7 +137,7 @@ class InstanceList
 					if ( stackTop < StackSize && node.getChildType( 0 ) == BoxType )
 						stack[stackTop++] = node.m_childIndex0;
 					else
-						aabb.grow( t.motionBounds( node.m_box0 ) );
+						aabb.grow( motionBounds( t, node.m_box0 ) );
 				}
 
 				if ( node.m_childIndex1 != InvalidValue )
@@ -83,7 +145,7 @@ class InstanceList
 					if ( stackTop < StackSize && node.getChildType( 1 ) == BoxType )
 						stack[stackTop++] = node.m_childIndex1;
 					else
-						aabb.grow( t.motionBounds( node.m_box1 ) );
+						aabb.grow( motionBounds( t, node.m_box1 ) );
 				}
 
 				if ( node.m_childIndex2 != InvalidValue )
@@ -91,7 +153,7 @@ class InstanceList
 					if ( stackTop < StackSize && node.getChildType( 2 ) == BoxType )
 						stack[stackTop++] = node.m_childIndex2;
 					else
-						aabb.grow( t.motionBounds( node.m_box2 ) );
+						aabb.grow( motionBounds( t, node.m_box2 ) );
 				}
 
 				if ( node.m_childIndex3 != InvalidValue )
@@ -99,7 +161,7 @@ class InstanceList
 					if ( stackTop < StackSize && node.getChildType( 3 ) == BoxType )
 						stack[stackTop++] = node.m_childIndex3;
 					else
-						aabb.grow( t.motionBounds( node.m_box3 ) );
+						aabb.grow( motionBounds( t, node.m_box3 ) );
 				}
 			}
 
@@ -107,48 +169,19 @@ class InstanceList
 		}
 	}
 
-	HIPRT_HOST_DEVICE float3 fetchCenter( uint32_t index ) const { return fetchAabb( index ).center(); }
-
-	HIPRT_HOST_DEVICE uint32_t fetchMask( uint32_t index ) const
+	HIPRT_HOST_DEVICE Aabb motionBounds( const Transform& t, const Aabb& aabb ) const
 	{
-		if ( m_masks == nullptr ) return FullRayMask;
-		return m_masks[index];
+		if ( m_timeSegmentCount <= 1 ) return t.motionBounds( aabb );
+
+		// the first and last segments also cover ray times outside of [0, 1]
+		const float timeBegin =
+			m_timeSegmentIndex == 0 ? -FltMax : static_cast<float>( m_timeSegmentIndex ) / m_timeSegmentCount;
+		const float timeEnd = m_timeSegmentIndex + 1 == m_timeSegmentCount
+								  ? FltMax
+								  : static_cast<float>( m_timeSegmentIndex + 1 ) / m_timeSegmentCount;
+		return t.motionBounds( aabb, timeBegin, timeEnd );
 	}
 
-	HIPRT_HOST_DEVICE hiprtInstance fetchInstance( uint32_t index ) const { return m_instances[index]; }
-
-	HIPRT_HOST_DEVICE hiprtTransformHeader fetchTransformHeader( uint32_t index ) const
-	{
-		if ( m_transformHeaders == nullptr ) return hiprtTransformHeader{ index, 1 };
-		return m_transformHeaders[index];
-	}
-
-	HIPRT_HOST_DEVICE Frame fetchFrame( uint32_t index ) const
-	{
-		if ( m_frameCount == 0 || m_apiFrames == nullptr || m_frames == nullptr ) return Frame();
-		return m_frames[index];
-	}
-
-	HIPRT_HOST_DEVICE void convertFrame( uint32_t index )
-	{
-		if ( m_frameCount > 0 && m_apiFrames != nullptr && m_frames != nullptr ) m_frames[index] = m_apiFrames[index].convert();
-	}
-
-	HIPRT_HOST_DEVICE bool copyInvTransformMatrix( uint32_t index, float ( &matrix )[3][4] ) const
-	{
-		Frame		frame		   = fetchFrame( index );
-		MatrixFrame invMatrixFrame = MatrixFrame::getMatrixFrameInv( frame );
-		memcpy( &matrix[0][0], &invMatrixFrame.m_matrix[0][0], sizeof( float ) * 12 );
-		return frame.identity();
-	}
-
-	HIPRT_HOST_DEVICE uint32_t getCount() const { return m_instanceCount; }
-
-	HIPRT_HOST_DEVICE uint32_t getFrameCount() const { return m_frameCount; }
-
-	HIPRT_HOST_DEVICE void setFrames( Frame* frames ) { m_frames = frames; }
-
-  private:
 	hiprtInstance*		  m_instances;
 	hiprtTransformHeader* m_transformHeaders;
 	Frame*				  m_frames = nullptr;
@@ -156,5 +189,7 @@ class InstanceList
 	uint32_t*			  m_masks;
 	uint32_t			  m_instanceCount;
 	uint32_t			  m_frameCount;
+	uint32_t			  m_timeSegmentIndex = 0u;
+	uint32_t			  m_timeSegmentCount = 1u;
 };
 } // namespace hiprt
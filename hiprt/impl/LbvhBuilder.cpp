@@ -53,12 +53,16 @@ size_t LbvhBuilder::getTemporaryBufferSize( const hiprtGeometryBuildInput& build
 		pairTriangles = pairable && !( buildOptions.buildFlags & hiprtBuildFlagBitDisableTrianglePairing );
 		if ( pairTriangles ) size += RoundUp( sizeof( uint2 ) * primCount, DefaultAlignment );
 	}
+	if ( buildOptions.buildFlags & hiprtBuildFlagBitDeterministic ) size += getDeterministicCollapseBufferSize( primCount );
 	return size;
 }
 
 size_t LbvhBuilder::getTemporaryBufferSize( const hiprtSceneBuildInput& buildInput, const hiprtBuildOptions buildOptions )
 {
-	return getTemporaryBufferSize( buildInput.instanceCount );
+	size_t size = getTemporaryBufferSize( buildInput.instanceCount );
+	if ( buildOptions.buildFlags & hiprtBuildFlagBitDeterministic )
+		size += getDeterministicCollapseBufferSize( buildInput.instanceCount );
+	return size;
 }
 
 size_t LbvhBuilder::getStorageBufferSize( const hiprtGeometryBuildInput& buildInput, const hiprtBuildOptions buildOptions )
@@ -74,7 +78,8 @@ size_t LbvhBuilder::getStorageBufferSize( const hiprtSceneBuildInput& buildInput
 	const size_t frameCount	  = buildInput.frameCount;
 	const size_t primCount	  = buildInput.instanceCount;
 	const size_t boxNodeCount = DivideRoundUp( 2 * primCount, 3 );
-	return getSceneStorageBufferSize( primCount, primCount, boxNodeCount, frameCount );
+	return getTimeSegmentCount( buildInput, buildOptions ) *
+		   getSceneStorageBufferSize( primCount, primCount, boxNodeCount, frameCount );
 }
 
 void LbvhBuilder::build(
@@ -116,25 +121,33 @@ void LbvhBuilder::build(
 	oroStream					stream,
 	hiprtDevicePtr				buffer )
 {
-	const size_t storageSize = getStorageBufferSize( buildInput, buildOptions );
-	const auto	 tempSize	 = getTemporaryBufferSize( buildInput, buildOptions );
-	MemoryArena	 storageMemoryArena( buffer, storageSize, DefaultAlignment );
-	MemoryArena	 temporaryMemoryArena( temporaryBuffer, tempSize, DefaultAlignment );
-
-	switch ( buildInput.frameType )
+	const uint32_t timeSegmentCount = getTimeSegmentCount( buildInput, buildOptions );
+	const size_t   storageSize		= getStorageBufferSize( buildInput, buildOptions ) / timeSegmentCount;
+	const size_t   tempSize			= getTemporaryBufferSize( buildInput, buildOptions );
+	for ( uint32_t i = 0; i < timeSegmentCount; ++i )
 	{
-	case hiprtFrameTypeSRT: {
-		InstanceList<SRTFrame> list( buildInput );
-		build<InstanceNode>( context, list, buildOptions, hiprtInvalidValue, temporaryMemoryArena, stream, storageMemoryArena );
-		break;
-	}
-	case hiprtFrameTypeMatrix: {
-		InstanceList<MatrixFrame> list( buildInput );
-		build<InstanceNode>( context, list, buildOptions, hiprtInvalidValue, temporaryMemoryArena, stream, storageMemoryArena );
-		break;
-	}
-	default:
-		throw std::runtime_error( "Not supported" );
+		MemoryArena storageMemoryArena( static_cast<uint8_t*>( buffer ) + i * storageSize, storageSize, DefaultAlignment );
+		MemoryArena temporaryMemoryArena( temporaryBuffer, tempSize, DefaultAlignment );
+
+		switch ( buildInput.frameType )
+		{
+		case hiprtFrameTypeSRT: {
+			InstanceList<SRTFrame> list( buildInput );
+			list.setTimeSegment( i, timeSegmentCount );
+			build<InstanceNode>(
+				context, list, buildOptions, hiprtInvalidValue, temporaryMemoryArena, stream, storageMemoryArena );
+			break;
+		}
+		case hiprtFrameTypeMatrix: {
+			InstanceList<MatrixFrame> list( buildInput );
+			list.setTimeSegment( i, timeSegmentCount );
+			build<InstanceNode>(
+				context, list, buildOptions, hiprtInvalidValue, temporaryMemoryArena, stream, storageMemoryArena );
+			break;
+		}
+		default:
+			throw std::runtime_error( "Not supported" );
+		}
 	}
 }
 
@@ -174,23 +187,29 @@ void LbvhBuilder::update(
 	oroStream					stream,
 	hiprtDevicePtr				buffer )
 {
-	const size_t storageSize = getStorageBufferSize( buildInput, buildOptions );
-	MemoryArena	 storageMemoryArena( buffer, storageSize, DefaultAlignment );
-
-	switch ( buildInput.frameType )
+	const uint32_t timeSegmentCount = getTimeSegmentCount( buildInput, buildOptions );
+	const size_t   storageSize		= getStorageBufferSize( buildInput, buildOptions ) / timeSegmentCount;
+	for ( uint32_t i = 0; i < timeSegmentCount; ++i )
 	{
-	case hiprtFrameTypeSRT: {
-		InstanceList<SRTFrame> list( buildInput );
-		update<InstanceNode>( context, list, buildOptions, stream, storageMemoryArena );
-		break;
-	}
-	case hiprtFrameTypeMatrix: {
-		InstanceList<MatrixFrame> list( buildInput );
-		update<InstanceNode>( context, list, buildOptions, stream, storageMemoryArena );
-		break;
-	}
-	default:
-		throw std::runtime_error( "Not supported" );
+		MemoryArena storageMemoryArena( static_cast<uint8_t*>( buffer ) + i * storageSize, storageSize, DefaultAlignment );
+
+		switch ( buildInput.frameType )
+		{
+		case hiprtFrameTypeSRT: {
+			InstanceList<SRTFrame> list( buildInput );
+			list.setTimeSegment( i, timeSegmentCount );
+			update<InstanceNode>( context, list, buildOptions, stream, storageMemoryArena );
+			break;
+		}
+		case hiprtFrameTypeMatrix: {
+			InstanceList<MatrixFrame> list( buildInput );
+			list.setTimeSegment( i, timeSegmentCount );
+			update<InstanceNode>( context, list, buildOptions, stream, storageMemoryArena );
+			break;
+		}
+		default:
+			throw std::runtime_error( "Not supported" );
+		}
 	}
 }
 } // namespace hiprt
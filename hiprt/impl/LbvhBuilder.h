@@ -27,11 +27,13 @@
 #include <hiprt/impl/Aabb.h>
 #include <hiprt/impl/BvhNode.h>
 #include <hiprt/impl/Context.h>
+#include <hiprt/impl/DeterministicCollapse.h>
 #include <hiprt/impl/Geometry.h>
 #include <hiprt/impl/Kernel.h>
 #include <hiprt/impl/MemoryArena.h>
 #include <hiprt/impl/Scene.h>
 #include <hiprt/impl/Timer.h>
+#include <hiprt/impl/TrianglePairing.h>
 #include <hiprt/impl/RadixSort.h>
 #include <hiprt/impl/Utility.h>
 #include <hiprt/impl/BvhConfig.h>
@@ -59,6 +61,15 @@ class LbvhBuilder
 		CollapseTime
 	};
 
+	// indexed by the times
+	static constexpr const char* TimeNames[] = {
+		"PairTriangles",
+		"ComputeCentroidBox",
+		"ComputeMortonCodes",
+		"Sort",
+		"EmitTopology",
+		"Collapse" };
+
 	LbvhBuilder()								 = delete;
 	LbvhBuilder& operator=( const LbvhBuilder& ) = delete;
 
@@ -135,10 +146,20 @@ void LbvhBuilder::build(
 {
 	typedef typename std::conditional<std::is_same<PrimitiveNode, InstanceNode>::value, SceneHeader, GeomHeader>::type Header;
 
+	Tracer::Span span( context.getTracer(), "Lbvh", "builder" );
+	span.arg( "primCount", primitives.getCount() );
+
+	const uint32_t maxBoxNodeCount = DivideRoundUp( 2 * primitives.getCount(), 3 );
+
 	Header*		   header	 = storageMemoryArena.allocate<Header>();
-	BoxNode*	   boxNodes	 = storageMemoryArena.allocate<BoxNode>( DivideRoundUp( 2 * primitives.getCount(), 3 ) );
+	BoxNode*	   boxNodes	 = storageMemoryArena.allocate<BoxNode>( maxBoxNodeCount );
 	PrimitiveNode* primNodes = storageMemoryArena.allocate<PrimitiveNode>( primitives.getCount() );
 
+	// padding and unused nodes must not keep stale data of the buffer in deterministic builds
+	if ( buildOptions.buildFlags & hiprtBuildFlagBitDeterministic )
+		checkOro( oroMemsetD8Async(
+			reinterpret_cast<oroDeviceptr>( header ), 0, storageMemoryArena.getStorageSize(), stream ) );
+
 	Aabb* centroidBox = temporaryMemoryArena.allocate<Aabb>();
 
 	ScratchNode*   scratchNodes = temporaryMemoryArena.allocate<ScratchNode>( primitives.getCount() );
@@ -156,15 +177,15 @@ void LbvhBuilder::build(
 	uint32_t* updateCounters = reinterpret_cast<uint32_t*>( boxNodes ) + 2 * primitives.getCount();
 
 	RadixSort sort( context.getDevice(), stream, context.getOrochiUtils() );
-	Timer	  timer;
+	Timer	  timer = context.getBuildProfiler().createTimer( stream, &context.getTracer(), TimeNames );
 
 	Compiler&				 compiler = context.getCompiler();
 	std::vector<const char*> opts;
 	// opts.push_back( "-G" );
 
-	std::string containerParam	   = Compiler::kernelNameSufix( Traits<PrimitiveContainer>::TYPE_NAME );
-	std::string nodeParam		   = Compiler::kernelNameSufix( Traits<PrimitiveNode>::TYPE_NAME );
-	std::string containerNodeParam = containerParam + "_" + nodeParam;
+	static const std::string containerParam		= Compiler::kernelNameSufix( Traits<PrimitiveContainer>::TYPE_NAME );
+	static const std::string nodeParam			= Compiler::kernelNameSufix( Traits<PrimitiveNode>::TYPE_NAME );
+	static const std::string containerNodeParam	= containerParam + "_" + nodeParam;
 
 	bool pairTriangles = false;
 	if constexpr ( std::is_same<PrimitiveNode, TriangleNode>::value )
@@ -177,12 +198,10 @@ void LbvhBuilder::build(
 		Frame*	  frames	= storageMemoryArena.allocate<Frame>( primitives.getFrameCount() );
 
 		primitives.setFrames( frames );
-		Kernel initDataKernel = compiler.getKernel(
-			context,
-			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-			"InitSceneData_" + containerParam,
-			opts,
-			GET_ARG_LIST( BvhBuilderKernels ) );
+		static const Compiler::KernelKey initDataKey(
+			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "InitSceneData_" + containerParam );
+		Kernel							 initDataKernel =
+			compiler.getKernel( context, initDataKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 		initDataKernel.setArgs(
 			{ storageMemoryArena.getStorageSize(), primitives, boxNodes, primNodes, instances, frames, header } );
 		initDataKernel.launch( std::max( primitives.getFrameCount(), primitives.getCount() ), stream );
@@ -191,13 +210,12 @@ void LbvhBuilder::build(
 	{
 		geomType <<= 1;
 		if constexpr ( std::is_same<PrimitiveNode, TriangleNode>::value ) geomType |= 1;
-		const uint32_t primCount	  = pairTriangles ? 0u : primitives.getCount();
-		Kernel		   initDataKernel = compiler.getKernel(
-			context,
-			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-			"InitGeomData",
-			opts,
-			GET_ARG_LIST( BvhBuilderKernels ) );
+		const uint32_t primCount = pairTriangles ? 0u : primitives.getCount();
+
+		static const Compiler::KernelKey initDataKey(
+			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "InitGeomData" );
+		Kernel							 initDataKernel =
+			compiler.getKernel( context, initDataKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 		initDataKernel.setArgs( { storageMemoryArena.getStorageSize(), primCount, boxNodes, primNodes, geomType, header } );
 		initDataKernel.launch( 1, stream );
 	}
@@ -205,12 +223,10 @@ void LbvhBuilder::build(
 	// A single primitive => special case
 	if ( primitives.getCount() == 1 )
 	{
-		Kernel singletonConstructionKernel = compiler.getKernel(
-			context,
-			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-			"SingletonConstruction_" + containerNodeParam,
-			opts,
-			GET_ARG_LIST( BvhBuilderKernels ) );
+		static const Compiler::KernelKey singletonConstructionKey(
+			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "SingletonConstruction_" + containerNodeParam );
+		Kernel							 singletonConstructionKernel =
+			compiler.getKernel( context, singletonConstructionKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 		singletonConstructionKernel.setArgs( { primitives, boxNodes, primNodes } );
 		singletonConstructionKernel.launch( 1, stream );
 		return;
@@ -221,22 +237,49 @@ void LbvhBuilder::build(
 	{
 		if ( pairTriangles )
 		{
-			uint2* pairIndices = temporaryMemoryArena.allocate<uint2>( primitives.getCount() );
-			checkOro( oroMemsetD8Async( reinterpret_cast<oroDeviceptr>( taskCounter ), 0, sizeof( uint32_t ), stream ) );
-			Kernel pairTrianglesKernel = compiler.getKernel(
-				context,
-				Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-				"PairTriangles",
-				opts,
-				GET_ARG_LIST( BvhBuilderKernels ) );
-			pairTrianglesKernel.setArgs( { primitives, pairIndices, taskCounter } );
-			timer.measure( PairTrianglesTime, [&]() { pairTrianglesKernel.launch( primitives.getCount(), stream ); } );
-			checkOro( oroStreamSynchronize( stream ) );
-
-			uint32_t pairCount = 0;
-			checkOro(
-				oroMemcpyDtoHAsync( &pairCount, reinterpret_cast<oroDeviceptr>( taskCounter ), sizeof( uint32_t ), stream ) );
-			checkOro( oroStreamSynchronize( stream ) );
+			uint2*	 pairIndices = temporaryMemoryArena.allocate<uint2>( primitives.getCount() );
+			uint32_t pairCount	 = 0;
+			if ( buildOptions.buildFlags & hiprtBuildFlagBitGlobalTrianglePairing )
+			{
+				timer.measure( PairTrianglesTime, [&]() {
+					pairCount = TrianglePairing::pairTriangles( primitives, pairIndices, stream );
+				} );
+			}
+			else if ( buildOptions.buildFlags & hiprtBuildFlagBitDeterministic )
+			{
+				static const Compiler::KernelKey markTrianglePairsKey(
+					Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "MarkTrianglePairs" );
+				Kernel							 markTrianglePairsKernel =
+					compiler.getKernel( context, markTrianglePairsKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
+				markTrianglePairsKernel.setArgs( { primitives, pairIndices } );
+				static const Compiler::KernelKey compactTrianglePairsKey(
+					Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "CompactTrianglePairs" );
+				Kernel							 compactTrianglePairsKernel =
+					compiler.getKernel( context, compactTrianglePairsKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
+				compactTrianglePairsKernel.setArgs( { primitives.getCount(), pairIndices, taskCounter } );
+				timer.measure( PairTrianglesTime, [&]() {
+					markTrianglePairsKernel.launch( primitives.getCount(), stream );
+					compactTrianglePairsKernel.launch( ReductionBlockSize, ReductionBlockSize, stream );
+				} );
+
+				checkOro( oroMemcpyDtoHAsync(
+					&pairCount, reinterpret_cast<oroDeviceptr>( taskCounter ), sizeof( uint32_t ), stream ) );
+				checkOro( oroStreamSynchronize( stream ) );
+			}
+			else
+			{
+				checkOro( oroMemsetD8Async( reinterpret_cast<oroDeviceptr>( taskCounter ), 0, sizeof( uint32_t ), stream ) );
+				static const Compiler::KernelKey pairTrianglesKey(
+					Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "PairTriangles" );
+				Kernel							 pairTrianglesKernel =
+					compiler.getKernel( context, pairTrianglesKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
+				pairTrianglesKernel.setArgs( { primitives, pairIndices, taskCounter } );
+				timer.measure( PairTrianglesTime, [&]() { pairTrianglesKernel.launch( primitives.getCount(), stream ); } );
+
+				checkOro( oroMemcpyDtoHAsync(
+					&pairCount, reinterpret_cast<oroDeviceptr>( taskCounter ), sizeof( uint32_t ), stream ) );
+				checkOro( oroStreamSynchronize( stream ) );
+			}
 			primitives.setPairs( pairCount, pairIndices );
 		}
 	}
@@ -245,24 +288,20 @@ void LbvhBuilder::build(
 	Aabb emptyBox;
 	checkOro( oroMemcpyHtoDAsync( reinterpret_cast<oroDeviceptr>( centroidBox ), &emptyBox, sizeof( Aabb ), stream ) );
 
-	Kernel computeCentroidBoxKernel = compiler.getKernel(
-		context,
-		Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-		"ComputeCentroidBox_" + containerParam,
-		opts,
-		GET_ARG_LIST( BvhBuilderKernels ) );
+	static const Compiler::KernelKey computeCentroidBoxKey(
+		Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "ComputeCentroidBox_" + containerParam );
+	Kernel							 computeCentroidBoxKernel =
+		compiler.getKernel( context, computeCentroidBoxKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 	computeCentroidBoxKernel.setArgs( { primitives, centroidBox } );
 	timer.measure( ComputeCentroidBoxTime, [&]() {
 		computeCentroidBoxKernel.launch( primitives.getCount(), ReductionBlockSize, stream );
 	} );
 
 	// STEP 3: Calculate Morton codes
-	Kernel computeMortonCodesKernel = compiler.getKernel(
-		context,
-		Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-		"ComputeMortonCodes_" + containerParam,
-		opts,
-		GET_ARG_LIST( BvhBuilderKernels ) );
+	static const Compiler::KernelKey computeMortonCodesKey(
+		Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "ComputeMortonCodes_" + containerParam );
+	Kernel							 computeMortonCodesKernel =
+		compiler.getKernel( context, computeMortonCodesKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 	computeMortonCodesKernel.setArgs( { primitives, centroidBox, mortonCodeKeys[0], mortonCodeValues[0] } );
 	timer.measure( ComputeMortonCodesTime, [&]() { computeMortonCodesKernel.launch( primitives.getCount(), stream ); } );
 
@@ -275,12 +314,10 @@ void LbvhBuilder::build(
 	// STEP 5: Emit topology and refit nodes
 	checkOro( oroMemsetD8Async(
 		reinterpret_cast<oroDeviceptr>( updateCounters ), 0xFF, sizeof( uint32_t ) * primitives.getCount(), stream ) );
-	Kernel emitTopologyAndFitBoundsKernel = compiler.getKernel(
-		context,
-		Utility::getRootDir() / "hiprt/impl/LbvhBuilderKernels.h",
-		"EmitTopologyAndFitBounds_" + containerParam,
-		opts,
-		GET_ARG_LIST( LbvhBuilderKernels ) );
+	static const Compiler::KernelKey emitTopologyAndFitBoundsKey(
+		Utility::getRootDir() / "hiprt/impl/LbvhBuilderKernels.h", "EmitTopologyAndFitBounds_" + containerParam );
+	Kernel							 emitTopologyAndFitBoundsKernel =
+		compiler.getKernel( context, emitTopologyAndFitBoundsKey, opts, GET_ARG_LIST( LbvhBuilderKernels ) );
 	emitTopologyAndFitBoundsKernel.setArgs(
 		{ mortonCodeKeys[1], mortonCodeValues[1], updateCounters, primitives, scratchNodes, references } );
 	timer.measure( EmitTopologyTime, [&]() { emitTopologyAndFitBoundsKernel.launch( primitives.getCount(), stream ); } );
@@ -297,15 +334,44 @@ void LbvhBuilder::build(
 		reinterpret_cast<oroDeviceptr>( taskQueue + 1 ), 0xFF, sizeof( uint3 ) * ( primitives.getCount() - 1 ), stream ) );
 	checkOro( oroMemcpyHtoDAsync( reinterpret_cast<oroDeviceptr>( taskCounter ), &one, sizeof( uint32_t ), stream ) );
 
-	Kernel collapseKernel = compiler.getKernel(
-		context,
-		"../hiprt/impl/BvhBuilderKernels.h",
-		"Collapse_" + containerNodeParam,
-		opts,
-		GET_ARG_LIST( BvhBuilderKernels ) );
-	collapseKernel.setArgs(
-		{ primitives.getCount(), header, scratchNodes, references, boxNodes, primNodes, primitives, taskCounter, taskQueue } );
-	timer.measure( CollapseTime, [&]() { collapseKernel.launch( primitives.getCount(), stream ); } );
+	if ( buildOptions.buildFlags & hiprtBuildFlagBitDeterministic )
+	{
+		collapseDeterministic(
+			context,
+			primitives,
+			buildOptions,
+			containerNodeParam,
+			opts,
+			header,
+			scratchNodes,
+			references,
+			boxNodes,
+			maxBoxNodeCount,
+			primNodes,
+			taskQueue,
+			temporaryMemoryArena,
+			timer,
+			CollapseTime,
+			stream );
+	}
+	else
+	{
+		static const Compiler::KernelKey collapseKey( "../hiprt/impl/BvhBuilderKernels.h", "Collapse_" + containerNodeParam );
+		Kernel							 collapseKernel =
+			compiler.getKernel( context, collapseKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
+		collapseKernel.setArgs(
+			{ primitives.getCount(),
+			  header,
+			  scratchNodes,
+			  references,
+			  boxNodes,
+			  primNodes,
+			  primitives,
+			  taskCounter,
+			  taskQueue,
+			  buildOptions.customLeafMaxPrimCount } );
+		timer.measure( CollapseTime, [&]() { collapseKernel.launch( primitives.getCount(), stream ); } );
+	}
 
 	// STEP 7: BVH cost
 	if constexpr ( LogBvhCost )
@@ -315,12 +381,10 @@ void LbvhBuilder::build(
 			&nodeCount, reinterpret_cast<oroDeviceptr>( &header->m_boxNodeCount ), sizeof( uint32_t ), stream ) );
 		checkOro( oroStreamSynchronize( stream ) );
 		checkOro( oroMemsetD8Async( reinterpret_cast<oroDeviceptr>( taskCounter ), 0, sizeof( float ), stream ) );
-		Kernel computeCostKernel = compiler.getKernel(
-			context,
-			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-			"ComputeCost",
-			opts,
-			GET_ARG_LIST( BvhBuilderKernels ) );
+		static const Compiler::KernelKey computeCostKey(
+			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "ComputeCost" );
+		Kernel							 computeCostKernel =
+			compiler.getKernel( context, computeCostKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 		computeCostKernel.setArgs( { nodeCount, boxNodes, taskCounter } );
 		computeCostKernel.launch( nodeCount, ReductionBlockSize, stream );
 
@@ -330,19 +394,7 @@ void LbvhBuilder::build(
 		std::cout << "Bvh cost: " << cost << std::endl;
 	}
 
-	if constexpr ( Timer::EnableTimer )
-	{
-		float time = timer.getTimeRecord( PairTrianglesTime ) + timer.getTimeRecord( ComputeCentroidBoxTime ) +
-					 timer.getTimeRecord( ComputeMortonCodesTime ) + timer.getTimeRecord( SortTime ) +
-					 timer.getTimeRecord( EmitTopologyTime ) + timer.getTimeRecord( CollapseTime );
-		std::cout << "Lbvh total construction time: " << time << " ms" << std::endl;
-		std::cout << "\tpair triangles time: " << timer.getTimeRecord( PairTrianglesTime ) << " ms" << std::endl;
-		std::cout << "\tcompute centroid box time: " << timer.getTimeRecord( ComputeCentroidBoxTime ) << " ms" << std::endl;
-		std::cout << "\tcompute morton codes time: " << timer.getTimeRecord( ComputeMortonCodesTime ) << " ms" << std::endl;
-		std::cout << "\tsort time: " << timer.getTimeRecord( SortTime ) << " ms" << std::endl;
-		std::cout << "\temit topology time: " << timer.getTimeRecord( EmitTopologyTime ) << " ms" << std::endl;
-		std::cout << "\tcollapse time: " << timer.getTimeRecord( CollapseTime ) << " ms" << std::endl;
-	}
+	context.getBuildProfiler().record( "Lbvh", TimeNames, std::size( TimeNames ), std::move( timer ) );
 }
 
 template <typename PrimitiveNode, typename PrimitiveContainer>
@@ -364,8 +416,9 @@ void LbvhBuilder::update(
 	BoxNode*	   boxNodes	 = reinterpret_cast<BoxNode*>( h.m_boxNodes );
 	PrimitiveNode* primNodes = reinterpret_cast<PrimitiveNode*>( h.m_primNodes );
 
-	std::string containerParam		   = Compiler::kernelNameSufix( Traits<PrimitiveContainer>::TYPE_NAME );
-	std::string containerPrimNodeParam = containerParam + "_" + Compiler::kernelNameSufix( Traits<PrimitiveNode>::TYPE_NAME );
+	static const std::string containerParam			= Compiler::kernelNameSufix( Traits<PrimitiveContainer>::TYPE_NAME );
+	static const std::string containerPrimNodeParam	=
+		containerParam + "_" + Compiler::kernelNameSufix( Traits<PrimitiveNode>::TYPE_NAME );
 
 	Compiler&				 compiler = context.getCompiler();
 	std::vector<const char*> opts;
@@ -377,21 +430,17 @@ void LbvhBuilder::update(
 		resetThreadCount = std::max( primitives.getCount(), primitives.getFrameCount() );
 	}
 
-	Kernel resetCountersAndUpdateLeavesKernel = compiler.getKernel(
-		context,
-		Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-		"ResetCountersAndUpdateLeaves_" + containerPrimNodeParam,
-		opts,
-		GET_ARG_LIST( BvhBuilderKernels ) );
+	static const Compiler::KernelKey resetCountersAndUpdateLeavesKey(
+		Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "ResetCountersAndUpdateLeaves_" + containerPrimNodeParam );
+	Kernel							 resetCountersAndUpdateLeavesKernel =
+		compiler.getKernel( context, resetCountersAndUpdateLeavesKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 	resetCountersAndUpdateLeavesKernel.setArgs( { header, primitives, boxNodes, primNodes } );
 	resetCountersAndUpdateLeavesKernel.launch( resetThreadCount, stream );
 
-	Kernel fitBoundsKernel = compiler.getKernel(
-		context,
-		Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-		"FitBounds_" + containerPrimNodeParam,
-		opts,
-		GET_ARG_LIST( BvhBuilderKernels ) );
+	static const Compiler::KernelKey fitBoundsKey(
+		Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "FitBounds_" + containerPrimNodeParam );
+	Kernel							 fitBoundsKernel =
+		compiler.getKernel( context, fitBoundsKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 	fitBoundsKernel.setArgs( { header, primitives, boxNodes, primNodes } );
 	fitBoundsKernel.launch( h.m_boxNodeCount, stream );
 }
@@ -22,9 +22,54 @@
 //
 //////////////////////////////////////////////////////////////////////////////////////////
 
+
 #include <hiprt/impl/Logger.h>
+#include <hiprt/impl/Utility.h>
+#include <algorithm>
 #include <cstdarg>
 #include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+// releases the ring of the thread when it exits, a later thread reuses it
+struct RingOwner
+{
+	~RingOwner()
+	{
+		if ( owned != nullptr ) owned->store( false, std::memory_order_release );
+	}
+
+	void*			   ring	 = nullptr;
+	std::atomic<bool>* owned = nullptr;
+};
+
+thread_local RingOwner ringOwner;
+
+// the sinks may log themselves, the draining thread does not drain recursively
+thread_local bool draining = false;
+
+const char* getLevelName( hiprtLogLevel level )
+{
+	switch ( level )
+	{
+	case hiprtLogLevelInfo:
+		return "info";
+	case hiprtLogLevelWarn:
+		return "warn";
+	default:
+		return "error";
+	}
+}
+
+std::string getTimestamp( hiprt::Logger::Clock::time_point time )
+{
+	const long long microseconds =
+		std::chrono::duration_cast<std::chrono::microseconds>( time.time_since_epoch() ).count();
+	return hiprt::Utility::format( "%lld.%06lld", microseconds / 1000000, microseconds % 1000000 );
+}
+} // namespace
 
 namespace hiprt
 {
@@ -34,12 +79,247 @@ Logger& Logger::getInstance()
 	return s_writer;
 }
 
+Logger::~Logger()
+{
+	{
+		std::lock_guard<std::mutex> lock( m_threadMutex );
+		m_stop = true;
+	}
+	m_wake.notify_one();
+	if ( m_thread.joinable() ) m_thread.join();
+	drain();
+
+	for ( Ring* ring = m_rings.load(); ring != nullptr; )
+	{
+		Ring* next = ring->next;
+		delete ring;
+		ring = next;
+	}
+}
+
 void Logger::print( uint32_t filter, const char* fmt, ... )
 {
-	if ( ( filter & m_level ) == 0 ) return;
-	va_list c;
-	va_start( c, fmt );
-	vprintf( fmt, c );
-	va_end( c );
+	if ( !isEnabled( filter ) ) return;
+
+	const hiprtLogLevel level			= ( filter & hiprtLogLevelError ) != 0u  ? hiprtLogLevelError
+										  : ( filter & hiprtLogLevelWarn ) != 0u ? hiprtLogLevelWarn
+																				 : hiprtLogLevelInfo;
+	uint32_t			suppressedCount = 0u;
+	if ( level == hiprtLogLevelWarn && !rateLimit( fmt, suppressedCount ) ) return;
+
+	Ring&		   ring = getRing();
+	const uint64_t tail = ring.tail.load( std::memory_order_relaxed );
+	if ( tail - ring.head.load( std::memory_order_acquire ) >= RingCapacity )
+	{
+		// the background thread is behind, the caller drains the rings itself, unless it is the one draining
+		drain();
+		if ( tail - ring.head.load( std::memory_order_acquire ) >= RingCapacity )
+		{
+			m_droppedCount.fetch_add( 1u, std::memory_order_relaxed );
+			return;
+		}
+	}
+
+	Record& record			= ring.records[tail % RingCapacity];
+	record.time				= Clock::now();
+	record.level			= level;
+	record.threadId			= ring.threadId;
+	record.suppressedCount	= suppressedCount;
+
+	va_list args;
+	va_start( args, fmt );
+	va_list argsCopy;
+	va_copy( argsCopy, args );
+	const int size = std::vsnprintf( nullptr, 0, fmt, argsCopy );
+	va_end( argsCopy );
+	record.message.resize( std::max( size, 0 ) );
+	if ( size > 0 ) std::vsnprintf( record.message.data(), record.message.size() + 1, fmt, args );
+	va_end( args );
+
+	// the sinks add the line breaks
+	if ( !record.message.empty() && record.message.back() == '\n' ) record.message.pop_back();
+
+	ring.tail.store( tail + 1u );
+
+	if ( level == hiprtLogLevelError || !m_running.load() )
+		drain();
+	else if ( tail + 1u - ring.head.load( std::memory_order_relaxed ) > RingCapacity / 2u )
+		m_wake.notify_one();
+}
+
+void Logger::setCallback( hiprtLogCallback callback, void* userData )
+{
+	flush();
+	std::lock_guard<std::mutex> lock( m_drainMutex );
+	m_callback	   = callback;
+	m_callbackData = userData;
+}
+
+void Logger::setFile( const char* filename, hiprtLogFormat format )
+{
+	flush();
+	std::lock_guard<std::mutex> lock( m_drainMutex );
+	m_file.close();
+	m_fileFormat = format;
+	if ( filename == nullptr ) return;
+
+	m_file.open( filename, std::ios::app );
+	if ( !m_file ) throw std::runtime_error( "Unable to open the log file '" + std::string( filename ) + "'" );
+}
+
+void Logger::flush() { drain(); }
+
+void Logger::attach()
+{
+	std::lock_guard<std::mutex> lock( m_threadMutex );
+	if ( m_attachCount++ > 0u ) return;
+
+	m_stop	 = false;
+	m_thread = std::thread( [this]() { run(); } );
+	m_running.store( true );
+}
+
+void Logger::detach()
+{
+	std::unique_lock<std::mutex> lock( m_threadMutex );
+	if ( m_attachCount == 0u || --m_attachCount > 0u ) return;
+
+	m_running.store( false );
+	m_stop = true;
+	lock.unlock();
+	m_wake.notify_one();
+	m_thread.join();
+	drain();
+}
+
+Logger::Ring& Logger::getRing()
+{
+	if ( ringOwner.ring != nullptr ) return *static_cast<Ring*>( ringOwner.ring );
+
+	Ring* ring = m_rings.load( std::memory_order_acquire );
+	for ( ; ring != nullptr; ring = ring->next )
+	{
+		bool owned = false;
+		if ( ring->owned.compare_exchange_strong( owned, true, std::memory_order_acquire ) ) break;
+	}
+
+	// the rings are only prepended, the drain walks them without locking
+	if ( ring == nullptr )
+	{
+		ring		   = new Ring;
+		ring->threadId = m_ringCount.fetch_add( 1u ) + 1u;
+		ring->next	   = m_rings.load( std::memory_order_relaxed );
+		while ( !m_rings.compare_exchange_weak( ring->next, ring, std::memory_order_release, std::memory_order_relaxed ) )
+			;
+	}
+
+	ringOwner.ring	= ring;
+	ringOwner.owned = &ring->owned;
+	return *ring;
+}
+
+bool Logger::rateLimit( const char* fmt, uint32_t& suppressedCountOut )
+{
+	const int64_t now =
+		std::chrono::duration_cast<std::chrono::milliseconds>( Clock::now().time_since_epoch() ).count();
+	const int64_t interval = std::chrono::duration_cast<std::chrono::milliseconds>( RateLimitInterval ).count();
+
+	// formats built at runtime have no stable address, zero marks a free slot
+	const uint64_t hash = std::max<uint64_t>( Utility::hash64( fmt, std::strlen( fmt ) ), 1u );
+	for ( uint32_t i = 0; i < RateLimitSlotCount; ++i )
+	{
+		RateLimitSlot& slot = m_rateLimitSlots[( hash + i ) % RateLimitSlotCount];
+
+		uint64_t key = slot.key.load( std::memory_order_acquire );
+		if ( key == 0u && !slot.key.compare_exchange_strong( key, hash ) && key != hash ) continue;
+		if ( key != 0u && key != hash ) continue;
+
+		int64_t time = slot.time.load( std::memory_order_relaxed );
+		if ( now - time < interval || !slot.time.compare_exchange_strong( time, now, std::memory_order_relaxed ) )
+		{
+			slot.suppressedCount.fetch_add( 1u, std::memory_order_relaxed );
+			return false;
+		}
+		suppressedCountOut = slot.suppressedCount.exchange( 0u, std::memory_order_relaxed );
+		return true;
+	}
+
+	// the table is full, the warning is not limited
+	return true;
+}
+
+void Logger::drain()
+{
+	if ( draining ) return;
+
+	std::vector<Record> records;
+	{
+		std::lock_guard<std::mutex> lock( m_drainMutex );
+		for ( Ring* ring = m_rings.load( std::memory_order_acquire ); ring != nullptr; ring = ring->next )
+		{
+			const uint64_t head = ring->head.load( std::memory_order_relaxed );
+			const uint64_t tail = ring->tail.load();
+			for ( uint64_t i = head; i < tail; ++i )
+				records.push_back( ring->records[i % RingCapacity] );
+			ring->head.store( tail, std::memory_order_release );
+		}
+
+		const uint64_t droppedCount = m_droppedCount.exchange( 0u, std::memory_order_relaxed );
+		if ( droppedCount > 0u )
+			records.push_back(
+				{ Clock::now(), hiprtLogLevelWarn, 0u, 0u, std::to_string( droppedCount ) + " log messages dropped" } );
+
+		if ( records.empty() ) return;
+
+		// the rings are merged in time order
+		std::stable_sort( records.begin(), records.end(), []( const Record& a, const Record& b ) { return a.time < b.time; } );
+
+		draining = true;
+		write( records );
+		draining = false;
+	}
+}
+
+void Logger::write( const std::vector<Record>& records )
+{
+	for ( const Record& record : records )
+	{
+		std::string message = record.message;
+		if ( record.suppressedCount > 0u )
+			message += " (" + std::to_string( record.suppressedCount ) + " repetitions suppressed)";
+
+		if ( m_callback != nullptr )
+			m_callback( record.level, message.c_str(), m_callbackData );
+		else
+			std::cout << message << '\n';
+
+		if ( !m_file.is_open() ) continue;
+		if ( m_fileFormat == hiprtLogFormatJson )
+		{
+			m_file << "{\"time\": " << getTimestamp( record.time ) << ", \"level\": \"" << getLevelName( record.level )
+				   << "\", \"thread\": " << record.threadId << ", \"message\": " << Utility::toJsonString( record.message )
+				   << ", \"suppressed\": " << record.suppressedCount << "}\n";
+		}
+		else
+		{
+			m_file << getTimestamp( record.time ) << " [" << getLevelName( record.level ) << "] [thread " << record.threadId
+				   << "] " << message << '\n';
+		}
+	}
+
+	if ( m_callback == nullptr ) std::cout.flush();
+	m_file.flush();
+}
+
+void Logger::run()
+{
+	std::unique_lock<std::mutex> lock( m_threadMutex );
+	while ( !m_stop )
+	{
+		m_wake.wait_for( lock, DrainInterval );
+		lock.unlock();
+		drain();
+		lock.lock();
+	}
 }
 }; // namespace hiprt
@@ -22,46 +22,139 @@
 //
 //////////////////////////////////////////////////////////////////////////////////////////
 
+
 #pragma once
 #include <hiprt/hiprt_types.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace hiprt
 {
+// Messages are formatted on the calling thread once they pass the level and the rate limit, and are
+// pushed to a ring of that thread. While a context exists, a background thread drains the rings and
+// writes the records to the sinks, otherwise the caller drains them. Errors are always drained
+// before the call returns.
 class Logger
 {
   public:
+	using Clock = std::chrono::system_clock;
+
+	static constexpr uint32_t RingCapacity		 = 256u;
+	static constexpr uint32_t RateLimitSlotCount = 64u;
+	static constexpr auto	  DrainInterval		 = std::chrono::milliseconds( 20 );
+	static constexpr auto	  RateLimitInterval	 = std::chrono::seconds( 1 );
+
+	struct Record
+	{
+		Clock::time_point time;
+		hiprtLogLevel	  level;
+		uint32_t		  threadId;
+		// repetitions of the warning dropped by the rate limit since it was last written
+		uint32_t	suppressedCount = 0u;
+		std::string message;
+	};
+
 	static Logger& getInstance();
 
-	void setLevel( uint32_t level ) { m_level = level; }
-	int	 getLevel() const { return m_level; }
+	~Logger();
+
+	void setLevel( uint32_t level ) { m_level.store( level, std::memory_order_relaxed ); }
+	int	 getLevel() const { return m_level.load( std::memory_order_relaxed ); }
+
+	bool isEnabled( uint32_t filter ) const { return ( filter & m_level.load( std::memory_order_relaxed ) ) != 0; }
 
 	void print( uint32_t filter, const char* fmt, ... );
 
-  protected:
-	uint32_t m_level = 0;
+	// the callback replaces the standard output, it is called on the draining thread
+	void setCallback( hiprtLogCallback callback, void* userData );
+	void setFile( const char* filename, hiprtLogFormat format );
+
+	// writes the pushed records to the sinks
+	void flush();
+
+	// the contexts keep the background thread running
+	void attach();
+	void detach();
+
+  private:
+	struct Ring
+	{
+		std::array<Record, RingCapacity> records;
+		std::atomic<uint64_t>			 head  = 0u;
+		std::atomic<uint64_t>			 tail  = 0u;
+		std::atomic<bool>				 owned = true;
+		uint32_t						 threadId;
+		Ring*							 next;
+	};
+
+	struct RateLimitSlot
+	{
+		std::atomic<uint64_t>	key				= 0u;
+		std::atomic<int64_t>	time			= 0;
+		std::atomic<uint32_t>	suppressedCount = 0u;
+	};
+
+	Ring& getRing();
+
+	// false if the warning is suppressed, keyed by the text of the format string
+	bool rateLimit( const char* fmt, uint32_t& suppressedCountOut );
+
+	void drain();
+	void write( const std::vector<Record>& records );
+
+	void run();
+
+	std::atomic<uint32_t> m_level		 = 0u;
+	std::atomic<Ring*>	  m_rings		 = nullptr;
+	std::atomic<uint32_t> m_ringCount	 = 0u;
+	std::atomic<uint64_t> m_droppedCount = 0u;
+
+	std::array<RateLimitSlot, RateLimitSlotCount> m_rateLimitSlots;
+
+	// serializes the draining and guards the sinks
+	std::mutex		 m_drainMutex;
+	hiprtLogCallback m_callback		= nullptr;
+	void*			 m_callbackData = nullptr;
+	std::ofstream	 m_file;
+	hiprtLogFormat	 m_fileFormat = hiprtLogFormatText;
+
+	std::mutex				m_threadMutex;
+	std::condition_variable m_wake;
+	std::thread				m_thread;
+	uint32_t				m_attachCount = 0u;
+	bool					m_stop		  = false;
+	std::atomic<bool>		m_running	  = false;
 };
 
 template <typename... Args>
 void log( uint32_t filter, Args... args )
 {
-	Logger::getInstance().print( filter, args... );
+	if ( Logger::getInstance().isEnabled( filter ) ) Logger::getInstance().print( filter, args... );
 }
 
 template <typename... Args>
 void logInfo( Args... args )
 {
-	Logger::getInstance().print( hiprtLogLevelInfo, args... );
+	log( hiprtLogLevelInfo, args... );
 }
 
 template <typename... Args>
 void logWarn( Args... args )
 {
-	Logger::getInstance().print( hiprtLogLevelWarn, args... );
+	log( hiprtLogLevelWarn, args... );
 }
 
 template <typename... Args>
 void logError( Args... args )
 {
-	Logger::getInstance().print( hiprtLogLevelError, args... );
+	log( hiprtLogLevelError, args... );
 }
 }; // namespace hiprt
@@ -82,7 +82,8 @@ size_t SbvhBuilder::getStorageBufferSize( const hiprtSceneBuildInput& buildInput
 	const size_t primCount		   = buildInput.instanceCount;
 	const size_t maxReferenceCount = alpha * primCount;
 	const size_t boxNodeCount	   = DivideRoundUp( 2 * maxReferenceCount, 3 );
-	return getSceneStorageBufferSize( primCount, maxReferenceCount, boxNodeCount, frameCount );
+	return getTimeSegmentCount( buildInput, buildOptions ) *
+		   getSceneStorageBufferSize( primCount, maxReferenceCount, boxNodeCount, frameCount );
 }
 
 void SbvhBuilder::build(
@@ -122,25 +123,33 @@ void SbvhBuilder::build(
 	oroStream					stream,
 	hiprtDevicePtr				buffer )
 {
-	const size_t storageSize = getStorageBufferSize( buildInput, buildOptions );
-	const size_t tempSize	 = getTemporaryBufferSize( buildInput, buildOptions );
-	MemoryArena	 storageMemoryArena( buffer, storageSize, DefaultAlignment );
-	MemoryArena	 temporaryMemoryArena( temporaryBuffer, tempSize, DefaultAlignment );
-
-	switch ( buildInput.frameType )
+	const uint32_t timeSegmentCount = getTimeSegmentCount( buildInput, buildOptions );
+	const size_t   storageSize		= getStorageBufferSize( buildInput, buildOptions ) / timeSegmentCount;
+	const size_t   tempSize			= getTemporaryBufferSize( buildInput, buildOptions );
+	for ( uint32_t i = 0; i < timeSegmentCount; ++i )
 	{
-	case hiprtFrameTypeSRT: {
-		InstanceList<SRTFrame> list( buildInput );
-		build<InstanceNode>( context, list, buildOptions, hiprtInvalidValue, temporaryMemoryArena, stream, storageMemoryArena );
-		break;
-	}
-	case hiprtFrameTypeMatrix: {
-		InstanceList<MatrixFrame> list( buildInput );
-		build<InstanceNode>( context, list, buildOptions, hiprtInvalidValue, temporaryMemoryArena, stream, storageMemoryArena );
-		break;
-	}
-	default:
-		throw std::runtime_error( "Not supported" );
+		MemoryArena storageMemoryArena( static_cast<uint8_t*>( buffer ) + i * storageSize, storageSize, DefaultAlignment );
+		MemoryArena temporaryMemoryArena( temporaryBuffer, tempSize, DefaultAlignment );
+
+		switch ( buildInput.frameType )
+		{
+		case hiprtFrameTypeSRT: {
+			InstanceList<SRTFrame> list( buildInput );
+			list.setTimeSegment( i, timeSegmentCount );
+			build<InstanceNode>(
+				context, list, buildOptions, hiprtInvalidValue, temporaryMemoryArena, stream, storageMemoryArena );
+			break;
+		}
+		case hiprtFrameTypeMatrix: {
+			InstanceList<MatrixFrame> list( buildInput );
+			list.setTimeSegment( i, timeSegmentCount );
+			build<InstanceNode>(
+				context, list, buildOptions, hiprtInvalidValue, temporaryMemoryArena, stream, storageMemoryArena );
+			break;
+		}
+		default:
+			throw std::runtime_error( "Not supported" );
+		}
 	}
 }
 
@@ -178,23 +187,29 @@ void SbvhBuilder::update(
 	oroStream					stream,
 	hiprtDevicePtr				buffer )
 {
-	const size_t storageSize = getStorageBufferSize( buildInput, buildOptions );
-	MemoryArena	 storageMemoryArena( buffer, storageSize, DefaultAlignment );
-
-	switch ( buildInput.frameType )
+	const uint32_t timeSegmentCount = getTimeSegmentCount( buildInput, buildOptions );
+	const size_t   storageSize		= getStorageBufferSize( buildInput, buildOptions ) / timeSegmentCount;
+	for ( uint32_t i = 0; i < timeSegmentCount; ++i )
 	{
-	case hiprtFrameTypeSRT: {
-		InstanceList<SRTFrame> list( buildInput );
-		update<InstanceNode>( context, list, buildOptions, stream, storageMemoryArena );
-		break;
-	}
-	case hiprtFrameTypeMatrix: {
-		InstanceList<MatrixFrame> list( buildInput );
-		update<InstanceNode>( context, list, buildOptions, stream, storageMemoryArena );
-		break;
-	}
-	default:
-		throw std::runtime_error( "Not supported" );
+		MemoryArena storageMemoryArena( static_cast<uint8_t*>( buffer ) + i * storageSize, storageSize, DefaultAlignment );
+
+		switch ( buildInput.frameType )
+		{
+		case hiprtFrameTypeSRT: {
+			InstanceList<SRTFrame> list( buildInput );
+			list.setTimeSegment( i, timeSegmentCount );
+			update<InstanceNode>( context, list, buildOptions, stream, storageMemoryArena );
+			break;
+		}
+		case hiprtFrameTypeMatrix: {
+			InstanceList<MatrixFrame> list( buildInput );
+			list.setTimeSegment( i, timeSegmentCount );
+			update<InstanceNode>( context, list, buildOptions, stream, storageMemoryArena );
+			break;
+		}
+		default:
+			throw std::runtime_error( "Not supported" );
+		}
 	}
 }
 } // namespace hiprt
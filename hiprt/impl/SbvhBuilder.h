@@ -33,6 +33,7 @@
 #include <hiprt/impl/SbvhCommon.h>
 #include <hiprt/impl/Scene.h>
 #include <hiprt/impl/Timer.h>
+#include <hiprt/impl/TrianglePairing.h>
 #include <hiprt/impl/Utility.h>
 #include <hiprt/impl/BvhConfig.h>
 
@@ -68,6 +69,19 @@ class SbvhBuilder
 		CollapseTime
 	};
 
+	// indexed by the times
+	static constexpr const char* TimeNames[] = {
+		"PairTriangles",
+		"ComputeBox",
+		"SetupReferences",
+		"ResetBins",
+		"BinReferencesObject",
+		"FindObjectSplit",
+		"BinReferencesSpatial",
+		"Split",
+		"DistributeReferences",
+		"Collapse" };
+
 	SbvhBuilder()								 = delete;
 	SbvhBuilder& operator=( const SbvhBuilder& ) = delete;
 
@@ -144,6 +158,9 @@ void SbvhBuilder::build(
 {
 	typedef typename std::conditional<std::is_same<PrimitiveNode, InstanceNode>::value, SceneHeader, GeomHeader>::type Header;
 
+	Tracer::Span span( context.getTracer(), "Sbvh", "builder" );
+	span.arg( "primCount", primitives.getCount() );
+
 	bool		   spatialSplits	 = !( buildOptions.buildFlags & hiprtBuildFlagBitDisableSpatialSplits );
 	float		   alpha			 = spatialSplits ? Alpha : 1.0f;
 	size_t		   maxReferenceCount = alpha * primitives.getCount();
@@ -167,14 +184,14 @@ void SbvhBuilder::build(
 	referenceIndices[0] = reinterpret_cast<uint32_t*>( boxNodes ) + 0 * maxReferenceCount;
 	referenceIndices[1] = reinterpret_cast<uint32_t*>( boxNodes ) + 1 * maxReferenceCount;
 
-	Timer					 timer;
+	Timer					 timer    = context.getBuildProfiler().createTimer( stream, &context.getTracer(), TimeNames );
 	Compiler&				 compiler = context.getCompiler();
 	std::vector<const char*> opts;
 	// opts.push_back( "-G" );
 
-	std::string containerParam	   = Compiler::kernelNameSufix( Traits<PrimitiveContainer>::TYPE_NAME );
-	std::string nodeParam		   = Compiler::kernelNameSufix( Traits<PrimitiveNode>::TYPE_NAME );
-	std::string containerNodeParam = containerParam + "_" + nodeParam;
+	static const std::string containerParam		= Compiler::kernelNameSufix( Traits<PrimitiveContainer>::TYPE_NAME );
+	static const std::string nodeParam			= Compiler::kernelNameSufix( Traits<PrimitiveNode>::TYPE_NAME );
+	static const std::string containerNodeParam	= containerParam + "_" + nodeParam;
 
 	bool pairTriangles = false;
 	if constexpr ( std::is_same<PrimitiveNode, TriangleNode>::value )
@@ -187,12 +204,10 @@ void SbvhBuilder::build(
 		Frame*	  frames	= storageMemoryArena.allocate<Frame>( primitives.getFrameCount() );
 
 		primitives.setFrames( frames );
-		Kernel initDataKernel = compiler.getKernel(
-			context,
-			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-			"InitSceneData_" + containerParam,
-			opts,
-			GET_ARG_LIST( BvhBuilderKernels ) );
+		static const Compiler::KernelKey initDataKey(
+			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "InitSceneData_" + containerParam );
+		Kernel							 initDataKernel =
+			compiler.getKernel( context, initDataKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 		initDataKernel.setArgs(
 			{ storageMemoryArena.getStorageSize(), primitives, boxNodes, primNodes, instances, frames, header } );
 		initDataKernel.launch( std::max( primitives.getFrameCount(), primitives.getCount() ), stream );
@@ -201,13 +216,12 @@ void SbvhBuilder::build(
 	{
 		geomType <<= 1;
 		if constexpr ( std::is_same<PrimitiveNode, TriangleNode>::value ) geomType |= 1;
-		const uint32_t primCount	  = pairTriangles ? 0u : primitives.getCount();
-		Kernel		   initDataKernel = compiler.getKernel(
-			context,
-			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-			"InitGeomData",
-			opts,
-			GET_ARG_LIST( BvhBuilderKernels ) );
+		const uint32_t primCount = pairTriangles ? 0u : primitives.getCount();
+
+		static const Compiler::KernelKey initDataKey(
+			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "InitGeomData" );
+		Kernel							 initDataKernel =
+			compiler.getKernel( context, initDataKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 		initDataKernel.setArgs( { storageMemoryArena.getStorageSize(), primCount, boxNodes, primNodes, geomType, header } );
 		initDataKernel.launch( 1, stream );
 	}
@@ -215,12 +229,10 @@ void SbvhBuilder::build(
 	// A single primitive => special case
 	if ( primitives.getCount() == 1 )
 	{
-		Kernel singletonConstructionKernel = compiler.getKernel(
-			context,
-			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-			"SingletonConstruction_" + containerNodeParam,
-			opts,
-			GET_ARG_LIST( BvhBuilderKernels ) );
+		static const Compiler::KernelKey singletonConstructionKey(
+			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "SingletonConstruction_" + containerNodeParam );
+		Kernel							 singletonConstructionKernel =
+			compiler.getKernel( context, singletonConstructionKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 		singletonConstructionKernel.setArgs( { primitives, boxNodes, primNodes } );
 		singletonConstructionKernel.launch( 1, stream );
 		return;
@@ -231,21 +243,28 @@ void SbvhBuilder::build(
 	{
 		if ( pairTriangles )
 		{
-			uint2* pairIndices = temporaryMemoryArena.allocate<uint2>( primitives.getCount() );
-			checkOro( oroMemsetD8Async( reinterpret_cast<oroDeviceptr>( taskCounter ), 0, sizeof( uint32_t ), stream ) );
-			Kernel pairTrianglesKernel = compiler.getKernel(
-				context,
-				Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-				"PairTriangles",
-				opts,
-				GET_ARG_LIST( BvhBuilderKernels ) );
-			pairTrianglesKernel.setArgs( { primitives, pairIndices, taskCounter } );
-			timer.measure( PairTrianglesTime, [&]() { pairTrianglesKernel.launch( primitives.getCount(), stream ); } );
-
-			uint32_t pairCount = 0;
-			checkOro(
-				oroMemcpyDtoHAsync( &pairCount, reinterpret_cast<oroDeviceptr>( taskCounter ), sizeof( uint32_t ), stream ) );
-			checkOro( oroStreamSynchronize( stream ) );
+			uint2*	 pairIndices = temporaryMemoryArena.allocate<uint2>( primitives.getCount() );
+			uint32_t pairCount	 = 0;
+			if ( buildOptions.buildFlags & hiprtBuildFlagBitGlobalTrianglePairing )
+			{
+				timer.measure( PairTrianglesTime, [&]() {
+					pairCount = TrianglePairing::pairTriangles( primitives, pairIndices, stream );
+				} );
+			}
+			else
+			{
+				checkOro( oroMemsetD8Async( reinterpret_cast<oroDeviceptr>( taskCounter ), 0, sizeof( uint32_t ), stream ) );
+				static const Compiler::KernelKey pairTrianglesKey(
+					Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "PairTriangles" );
+				Kernel							 pairTrianglesKernel =
+					compiler.getKernel( context, pairTrianglesKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
+				pairTrianglesKernel.setArgs( { primitives, pairIndices, taskCounter } );
+				timer.measure( PairTrianglesTime, [&]() { pairTrianglesKernel.launch( primitives.getCount(), stream ); } );
+
+				checkOro( oroMemcpyDtoHAsync(
+					&pairCount, reinterpret_cast<oroDeviceptr>( taskCounter ), sizeof( uint32_t ), stream ) );
+				checkOro( oroStreamSynchronize( stream ) );
+			}
 			primitives.setPairs( pairCount, pairIndices );
 		}
 	}
@@ -254,12 +273,10 @@ void SbvhBuilder::build(
 	Aabb emptyBox;
 	checkOro( oroMemcpyHtoDAsync( reinterpret_cast<oroDeviceptr>( box ), &emptyBox, sizeof( Aabb ), stream ) );
 
-	Kernel computeBoxKernel = compiler.getKernel(
-		context,
-		Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-		"ComputeBox_" + containerParam,
-		opts,
-		GET_ARG_LIST( BvhBuilderKernels ) );
+	static const Compiler::KernelKey computeBoxKey(
+		Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "ComputeBox_" + containerParam );
+	Kernel							 computeBoxKernel =
+		compiler.getKernel( context, computeBoxKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 	computeBoxKernel.setArgs( { primitives, box } );
 	timer.measure( ComputeBoxTime, [&]() { computeBoxKernel.launch( primitives.getCount(), ReductionBlockSize, stream ); } );
 
@@ -268,12 +285,10 @@ void SbvhBuilder::build(
 	checkOro( oroStreamSynchronize( stream ) );
 
 	// STEP 3: Setup references
-	Kernel setupReferencesKernel = compiler.getKernel(
-		context,
-		Utility::getRootDir() / "hiprt/impl/SbvhBuilderKernels.h",
-		"SetupLeavesAndReferences_" + containerParam,
-		opts,
-		GET_ARG_LIST( SbvhBuilderKernels ) );
+	static const Compiler::KernelKey setupReferencesKey(
+		Utility::getRootDir() / "hiprt/impl/SbvhBuilderKernels.h", "SetupLeavesAndReferences_" + containerParam );
+	Kernel							 setupReferencesKernel =
+		compiler.getKernel( context, setupReferencesKey, opts, GET_ARG_LIST( SbvhBuilderKernels ) );
 	setupReferencesKernel.setArgs( { primitives, references, taskQueue, box, referenceIndices[0], taskIndices } );
 	timer.measure( SetupReferencesTime, [&]() { setupReferencesKernel.launch( primitives.getCount(), stream ); } );
 
@@ -294,27 +309,20 @@ void SbvhBuilder::build(
 		uint32_t binCount =
 			std::min( MinBinCount * ( static_cast<uint32_t>( maxReferenceCount ) / 2 ) / taskCount, MaxBinCount );
 
-		std::string spatialSplitsString = spatialSplits ? "true" : "false";
-		std::string spatialSplitsContainerParam =
-			spatialSplitsString + "_" + Compiler::kernelNameSufix( Traits<PrimitiveContainer>::TYPE_NAME );
-
-		// Reset bins
-		Kernel resetBinsKernel = compiler.getKernel(
-			context,
-			Utility::getRootDir() / "hiprt/impl/SbvhBuilderKernels.h",
-			"ResetBins_" + spatialSplitsString,
-			opts,
-			GET_ARG_LIST( SbvhBuilderKernels ) );
+		// Reset bins (the keys are indexed by the spatial splits that can be turned off during the build)
+		static const Compiler::KernelKey resetBinsKeys[] = {
+			{ Utility::getRootDir() / "hiprt/impl/SbvhBuilderKernels.h", "ResetBins_false" },
+			{ Utility::getRootDir() / "hiprt/impl/SbvhBuilderKernels.h", "ResetBins_true" } };
+		Kernel							 resetBinsKernel =
+			compiler.getKernel( context, resetBinsKeys[spatialSplits], opts, GET_ARG_LIST( SbvhBuilderKernels ) );
 		resetBinsKernel.setArgs( { taskCount, binCount, objectBins, spatialBins } );
 		timer.measure( ResetBinsTime, [&]() { resetBinsKernel.launch( 3 * binCount * taskCount, stream ); } );
 
 		// Object bin references
-		Kernel binReferencesObjectKernel = compiler.getKernel(
-			context,
-			Utility::getRootDir() / "hiprt/impl/SbvhBuilderKernels.h",
-			"BinReferencesObject",
-			opts,
-			GET_ARG_LIST( SbvhBuilderKernels ) );
+		static const Compiler::KernelKey binReferencesObjectKey(
+			Utility::getRootDir() / "hiprt/impl/SbvhBuilderKernels.h", "BinReferencesObject" );
+		Kernel							 binReferencesObjectKernel =
+			compiler.getKernel( context, binReferencesObjectKey, opts, GET_ARG_LIST( SbvhBuilderKernels ) );
 		binReferencesObjectKernel.setArgs(
 			{ activeRefCount,
 			  binCount,
@@ -328,24 +336,20 @@ void SbvhBuilder::build(
 		timer.measure( BinReferencesObjectTime, [&]() { binReferencesObjectKernel.launch( activeRefCount, stream ); } );
 
 		// Find object split
-		Kernel findObjectSplitKernel = compiler.getKernel(
-			context,
-			Utility::getRootDir() / "hiprt/impl/SbvhBuilderKernels.h",
-			"FindObjectSplit",
-			opts,
-			GET_ARG_LIST( SbvhBuilderKernels ) );
+		static const Compiler::KernelKey findObjectSplitKey(
+			Utility::getRootDir() / "hiprt/impl/SbvhBuilderKernels.h", "FindObjectSplit" );
+		Kernel							 findObjectSplitKernel =
+			compiler.getKernel( context, findObjectSplitKey, opts, GET_ARG_LIST( SbvhBuilderKernels ) );
 		findObjectSplitKernel.setArgs( { taskCount, binCount, nodeCount, objectBins, taskQueue } );
 		timer.measure( FindObjectSplitTime, [&]() { findObjectSplitKernel.launch( taskCount, stream ); } );
 
 		// Spatial bin references
 		if ( spatialSplits )
 		{
-			Kernel binReferencesSpatialKernel = compiler.getKernel(
-				context,
-				Utility::getRootDir() / "hiprt/impl/SbvhBuilderKernels.h",
-				"BinReferencesSpatial_" + containerParam,
-				opts,
-				GET_ARG_LIST( SbvhBuilderKernels ) );
+			static const Compiler::KernelKey binReferencesSpatialKey(
+				Utility::getRootDir() / "hiprt/impl/SbvhBuilderKernels.h", "BinReferencesSpatial_" + containerParam );
+			Kernel							 binReferencesSpatialKernel =
+				compiler.getKernel( context, binReferencesSpatialKey, opts, GET_ARG_LIST( SbvhBuilderKernels ) );
 			binReferencesSpatialKernel.setArgs(
 				{ activeRefCount,
 				  binCount,
@@ -366,12 +370,11 @@ void SbvhBuilder::build(
 		checkOro( oroMemsetD8Async( reinterpret_cast<oroDeviceptr>( taskCounter ), 0, sizeof( uint32_t ), stream ) );
 		checkOro( oroMemsetD8Async( reinterpret_cast<oroDeviceptr>( referenceCounter ), 0, sizeof( uint32_t ), stream ) );
 		checkOro( oroMemsetD8Async( reinterpret_cast<oroDeviceptr>( refOffsetCounter ), 0, sizeof( uint32_t ), stream ) );
-		Kernel splitKernel = compiler.getKernel(
-			context,
-			Utility::getRootDir() / "hiprt/impl/SbvhBuilderKernels.h",
-			"SplitReferences_" + spatialSplitsString,
-			opts,
-			GET_ARG_LIST( SbvhBuilderKernels ) );
+		static const Compiler::KernelKey splitKeys[] = {
+			{ Utility::getRootDir() / "hiprt/impl/SbvhBuilderKernels.h", "SplitReferences_false" },
+			{ Utility::getRootDir() / "hiprt/impl/SbvhBuilderKernels.h", "SplitReferences_true" } };
+		Kernel							 splitKernel =
+			compiler.getKernel( context, splitKeys[spatialSplits], opts, GET_ARG_LIST( SbvhBuilderKernels ) );
 		splitKernel.setArgs(
 			{ taskCount,
 			  binCount,
@@ -395,12 +398,10 @@ void SbvhBuilder::build(
 
 		// Distribute references
 		checkOro( oroMemsetD8Async( reinterpret_cast<oroDeviceptr>( referenceCounter ), 0, sizeof( uint32_t ), stream ) );
-		Kernel distributeReferencesKernel = compiler.getKernel(
-			context,
-			Utility::getRootDir() / "hiprt/impl/SbvhBuilderKernels.h",
-			"DistributeReferences_" + containerParam,
-			opts,
-			GET_ARG_LIST( SbvhBuilderKernels ) );
+		static const Compiler::KernelKey distributeReferencesKey(
+			Utility::getRootDir() / "hiprt/impl/SbvhBuilderKernels.h", "DistributeReferences_" + containerParam );
+		Kernel							 distributeReferencesKernel =
+			compiler.getKernel( context, distributeReferencesKey, opts, GET_ARG_LIST( SbvhBuilderKernels ) );
 		distributeReferencesKernel.setArgs(
 			{ activeRefCount,
 			  referenceCount,
@@ -447,14 +448,20 @@ void SbvhBuilder::build(
 		stream ) );
 	checkOro( oroMemcpyHtoDAsync( reinterpret_cast<oroDeviceptr>( taskCounter ), &one, sizeof( uint32_t ), stream ) );
 
-	Kernel collapseKernel = compiler.getKernel(
-		context,
-		"../hiprt/impl/BvhBuilderKernels.h",
-		"Collapse_" + containerNodeParam,
-		opts,
-		GET_ARG_LIST( BvhBuilderKernels ) );
+	static const Compiler::KernelKey collapseKey( "../hiprt/impl/BvhBuilderKernels.h", "Collapse_" + containerNodeParam );
+	Kernel							 collapseKernel =
+		compiler.getKernel( context, collapseKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 	collapseKernel.setArgs(
-		{ referenceCount, header, scratchNodes, references, boxNodes, primNodes, primitives, taskCounter, taskQueue } );
+		{ referenceCount,
+		  header,
+		  scratchNodes,
+		  references,
+		  boxNodes,
+		  primNodes,
+		  primitives,
+		  taskCounter,
+		  taskQueue,
+		  buildOptions.customLeafMaxPrimCount } );
 	timer.measure( CollapseTime, [&]() { collapseKernel.launch( referenceCount, stream ); } );
 
 	if constexpr ( LogBvhCost )
@@ -464,12 +471,10 @@ void SbvhBuilder::build(
 			&nodeCount, reinterpret_cast<oroDeviceptr>( &header->m_boxNodeCount ), sizeof( uint32_t ), stream ) );
 		checkOro( oroStreamSynchronize( stream ) );
 		checkOro( oroMemsetD8Async( reinterpret_cast<oroDeviceptr>( taskCounter ), 0, sizeof( float ), stream ) );
-		Kernel computeCostKernel = compiler.getKernel(
-			context,
-			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-			"ComputeCost",
-			opts,
-			GET_ARG_LIST( BvhBuilderKernels ) );
+		static const Compiler::KernelKey computeCostKey(
+			Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "ComputeCost" );
+		Kernel							 computeCostKernel =
+			compiler.getKernel( context, computeCostKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 		computeCostKernel.setArgs( { nodeCount, boxNodes, taskCounter } );
 		computeCostKernel.launch( nodeCount, ReductionBlockSize, stream );
 
@@ -479,25 +484,7 @@ void SbvhBuilder::build(
 		std::cout << "Bvh cost: " << cost << std::endl;
 	}
 
-	if constexpr ( Timer::EnableTimer )
-	{
-		float time = timer.getTimeRecord( PairTrianglesTime ) + timer.getTimeRecord( ComputeBoxTime ) +
-					 timer.getTimeRecord( SetupReferencesTime ) + timer.getTimeRecord( ResetBinsTime ) +
-					 timer.getTimeRecord( BinReferencesObjectTime ) + timer.getTimeRecord( BinReferencesSpatialTime ) +
-					 timer.getTimeRecord( FindObjectSplitTime ) + timer.getTimeRecord( SplitTime ) +
-					 timer.getTimeRecord( DistributeReferencesTime ) + timer.getTimeRecord( CollapseTime );
-		std::cout << "Sbvh total construction time: " << time << " ms" << std::endl;
-		std::cout << "\tpair triangles time: " << timer.getTimeRecord( PairTrianglesTime ) << " ms" << std::endl;
-		std::cout << "\tcompute box time: " << timer.getTimeRecord( ComputeBoxTime ) << " ms" << std::endl;
-		std::cout << "\tsetup references time: " << timer.getTimeRecord( SetupReferencesTime ) << " ms" << std::endl;
-		std::cout << "\treset bins time: " << timer.getTimeRecord( ResetBinsTime ) << " ms" << std::endl;
-		std::cout << "\tbin references object time: " << timer.getTimeRecord( BinReferencesObjectTime ) << " ms" << std::endl;
-		std::cout << "\tbin references spatial time: " << timer.getTimeRecord( BinReferencesSpatialTime ) << " ms" << std::endl;
-		std::cout << "\tfind object split time: " << timer.getTimeRecord( FindObjectSplitTime ) << " ms" << std::endl;
-		std::cout << "\tsplit time: " << timer.getTimeRecord( SplitTime ) << " ms" << std::endl;
-		std::cout << "\tdistribute references time: " << timer.getTimeRecord( DistributeReferencesTime ) << " ms" << std::endl;
-		std::cout << "\tcollapse time: " << timer.getTimeRecord( CollapseTime ) << " ms" << std::endl;
-	}
+	context.getBuildProfiler().record( "Sbvh", TimeNames, std::size( TimeNames ), std::move( timer ) );
 }
 
 template <typename PrimitiveNode, typename PrimitiveContainer>
@@ -523,8 +510,9 @@ void SbvhBuilder::update(
 	BoxNode*	   boxNodes	 = reinterpret_cast<BoxNode*>( h.m_boxNodes );
 	PrimitiveNode* primNodes = reinterpret_cast<PrimitiveNode*>( h.m_primNodes );
 
-	std::string containerParam		   = Compiler::kernelNameSufix( Traits<PrimitiveContainer>::TYPE_NAME );
-	std::string containerPrimNodeParam = containerParam + "_" + Compiler::kernelNameSufix( Traits<PrimitiveNode>::TYPE_NAME );
+	static const std::string containerParam			= Compiler::kernelNameSufix( Traits<PrimitiveContainer>::TYPE_NAME );
+	static const std::string containerPrimNodeParam	=
+		containerParam + "_" + Compiler::kernelNameSufix( Traits<PrimitiveNode>::TYPE_NAME );
 
 	Compiler&				 compiler = context.getCompiler();
 	std::vector<const char*> opts;
@@ -538,21 +526,17 @@ void SbvhBuilder::update(
 		resetThreadCount = std::max( primitives.getCount(), primitives.getFrameCount() );
 	}
 
-	Kernel resetCountersAndUpdateLeavesKernel = compiler.getKernel(
-		context,
-		Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-		"ResetCountersAndUpdateLeaves_" + containerPrimNodeParam,
-		opts,
-		GET_ARG_LIST( BvhBuilderKernels ) );
+	static const Compiler::KernelKey resetCountersAndUpdateLeavesKey(
+		Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "ResetCountersAndUpdateLeaves_" + containerPrimNodeParam );
+	Kernel							 resetCountersAndUpdateLeavesKernel =
+		compiler.getKernel( context, resetCountersAndUpdateLeavesKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 	resetCountersAndUpdateLeavesKernel.setArgs( { header, primitives, boxNodes, primNodes } );
 	resetCountersAndUpdateLeavesKernel.launch( resetThreadCount, stream );
 
-	Kernel fitBoundsKernel = compiler.getKernel(
-		context,
-		Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h",
-		"FitBounds_" + containerPrimNodeParam,
-		opts,
-		GET_ARG_LIST( BvhBuilderKernels ) );
+	static const Compiler::KernelKey fitBoundsKey(
+		Utility::getRootDir() / "hiprt/impl/BvhBuilderKernels.h", "FitBounds_" + containerPrimNodeParam );
+	Kernel							 fitBoundsKernel =
+		compiler.getKernel( context, fitBoundsKey, opts, GET_ARG_LIST( BvhBuilderKernels ) );
 	fitBoundsKernel.setArgs( { header, primitives, boxNodes, primNodes } );
 	fitBoundsKernel.launch( h.m_boxNodeCount, stream );
 }
@@ -43,6 +43,22 @@ struct SceneHeader
 	uint32_t	  m_primNodeCount;
 	uint32_t	  m_boxNodeCount;
 	uint32_t	  m_frameCount;
+	// time segments are stored one after another; only the first header holds their count
+	uint32_t	  m_timeSegmentCount;
+	size_t		  m_timeSegmentStride;
+
+	HIPRT_HOST_DEVICE SceneHeader* getTimeSegmentByIndex( uint32_t index )
+	{
+		return reinterpret_cast<SceneHeader*>( reinterpret_cast<uint8_t*>( this ) + index * m_timeSegmentStride );
+	}
+
+	HIPRT_HOST_DEVICE SceneHeader* getTimeSegment( float time )
+	{
+		if ( m_timeSegmentCount <= 1 ) return this;
+		const float t = time * m_timeSegmentCount;
+		return getTimeSegmentByIndex(
+			t <= 0.0f ? 0 : ( t >= m_timeSegmentCount - 1 ? m_timeSegmentCount - 1 : static_cast<uint32_t>( t ) ) );
+	}
 };
 HIPRT_STATIC_ASSERT( alignof( SceneHeader ) <= DefaultAlignment );
 } // namespace hiprt
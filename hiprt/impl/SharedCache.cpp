@@ -0,0 +1,70 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <hiprt/impl/SharedCache.h>
+
+namespace hiprt
+{
+SharedCache& SharedCache::getSources()
+{
+	static SharedCache cache;
+	return cache;
+}
+
+SharedCache& SharedCache::getBinaries()
+{
+	static SharedCache cache;
+	return cache;
+}
+
+SharedCache::Entry SharedCache::get( const std::string& key, const std::function<std::string()>& create )
+{
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		auto						it = m_entries.find( key );
+		if ( it != m_entries.end() )
+		{
+			if ( Entry entry = it->second.lock() ) return entry;
+		}
+	}
+
+	// created outside of the lock, the first entry inserted wins if several threads create the same key
+	Entry created = std::make_shared<const std::string>( create() );
+
+	std::lock_guard<std::mutex> lock( m_mutex );
+	for ( auto it = m_entries.begin(); it != m_entries.end(); )
+	{
+		if ( it->second.expired() && it->first != key )
+			it = m_entries.erase( it );
+		else
+			++it;
+	}
+
+	std::weak_ptr<const std::string>& slot = m_entries[key];
+	if ( Entry entry = slot.lock() ) return entry;
+	slot = created;
+	return created;
+}
+} // namespace hiprt
@@ -0,0 +1,57 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace hiprt
+{
+// Process-wide cache of decrypted sources and kernel binaries shared by all contexts.
+// The cache only keeps weak references, an entry lives as long as a compiler holds it.
+class SharedCache
+{
+  public:
+	using Entry = std::shared_ptr<const std::string>;
+
+	static SharedCache& getSources();
+	static SharedCache& getBinaries();
+
+	/// Returns the entry of the key, calls the callable to create it if no compiler holds it.
+	/// @param[in] key The key of the entry.
+	/// @param[in] create The callable returning the content of the entry.
+	/// @return The shared entry.
+	Entry get( const std::string& key, const std::function<std::string()>& create );
+
+  private:
+	SharedCache() = default;
+
+	std::mutex														  m_mutex;
+	std::unordered_map<std::string, std::weak_ptr<const std::string>> m_entries;
+};
+} // namespace hiprt
@@ -0,0 +1,106 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace hiprt
+{
+class ThreadPool final
+{
+  public:
+	explicit ThreadPool( uint32_t threadCount = std::max( std::thread::hardware_concurrency(), 1u ) )
+	{
+		for ( uint32_t i = 0; i < threadCount; ++i )
+			m_threads.emplace_back( [this]() { work(); } );
+	}
+
+	ThreadPool( const ThreadPool& )			   = delete;
+	ThreadPool& operator=( const ThreadPool& ) = delete;
+
+	/// Runs the queued tasks to completion and joins the workers.
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock( m_mutex );
+			m_stop = true;
+		}
+		m_condition.notify_all();
+		for ( std::thread& thread : m_threads )
+			thread.join();
+	}
+
+	/// Queue the callable on the pool.
+	/// @param[in] callable The callable object to be called on a worker thread.
+	/// @return The future of the returned result of the callable.
+	template <typename CallableType>
+	std::future<std::invoke_result_t<CallableType>> submit( CallableType&& callable )
+	{
+		using return_type = std::invoke_result_t<CallableType>;
+
+		auto task = std::make_shared<std::packaged_task<return_type()>>( std::forward<CallableType>( callable ) );
+
+		std::future<return_type> future = task->get_future();
+		{
+			std::lock_guard<std::mutex> lock( m_mutex );
+			m_tasks.emplace( [task]() { ( *task )(); } );
+		}
+		m_condition.notify_one();
+		return future;
+	}
+
+  private:
+	void work()
+	{
+		for ( ;; )
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock( m_mutex );
+				m_condition.wait( lock, [this]() { return m_stop || !m_tasks.empty(); } );
+				if ( m_tasks.empty() ) return;
+				task = std::move( m_tasks.front() );
+				m_tasks.pop();
+			}
+			task();
+		}
+	}
+
+	std::vector<std::thread>		  m_threads;
+	std::queue<std::function<void()>> m_tasks;
+	std::mutex						  m_mutex;
+	std::condition_variable			  m_condition;
+	bool							  m_stop = false;
+};
+} // namespace hiprt
@@ -22,12 +22,17 @@
 //
 //////////////////////////////////////////////////////////////////////////////////////////
 
+
 #pragma once
 
 #include <Orochi/Orochi.h>
 #include <hiprt/impl/Error.h>
+#include <hiprt/impl/Tracer.h>
+#include <chrono>
 #include <functional>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace hiprt
 {
@@ -35,78 +40,197 @@ namespace hiprt
 class Timer final
 {
   public:
-	static constexpr bool EnableTimer = false;
-
 	using TokenType = int;
 	using TimeUnit	= float;
+	using Clock		= std::chrono::steady_clock;
+
+	/// Recycles the events of the timers, they are destroyed with the pool.
+	class EventPool
+	{
+	  public:
+		EventPool()								 = default;
+		EventPool( const EventPool& )			 = delete;
+		EventPool& operator=( const EventPool& ) = delete;
+
+		~EventPool()
+		{
+			for ( oroEvent event : m_events )
+				oroEventDestroy( event );
+		}
+
+		oroEvent acquire()
+		{
+			{
+				std::lock_guard<std::mutex> lock( m_mutex );
+				if ( !m_events.empty() )
+				{
+					oroEvent event = m_events.back();
+					m_events.pop_back();
+					return event;
+				}
+			}
+			oroEvent event;
+			checkOro( oroEventCreateWithFlags( &event, 0 ) );
+			return event;
+		}
+
+		void release( oroEvent event )
+		{
+			std::lock_guard<std::mutex> lock( m_mutex );
+			m_events.push_back( event );
+		}
+
+	  private:
+		std::mutex			  m_mutex;
+		std::vector<oroEvent> m_events;
+	};
 
 	Timer() = default;
 
-	Timer( const Timer& ) = default;
-	Timer( Timer&& )	  = default;
+	/// @param[in] enabled If false, the callables are only called.
+	/// @param[in] stream The stream the measured work is launched to.
+	/// @param[in] tracer The tracer receiving a span per measured call (optional).
+	/// @param[in] names The span names indexed by the tokens, required for the tracing.
+	/// @param[in] eventPool The pool the events are taken from, outliving the timer (optional).
+	Timer(
+		bool			   enabled,
+		oroStream		   stream,
+		Tracer*			   tracer	 = nullptr,
+		const char* const* names	 = nullptr,
+		EventPool*		   eventPool = nullptr )
+		: m_enabled( enabled ), m_stream( stream ), m_start( Clock::now() ), m_tracer( names != nullptr ? tracer : nullptr ),
+		  m_names( names ), m_eventPool( eventPool )
+	{
+	}
 
-	Timer& operator=( const Timer& )  = default;
-	Timer& operator=( Timer&& other ) = default;
+	Timer( const Timer& ) = delete;
+	Timer( Timer&& other ) noexcept { *this = std::move( other ); }
 
-	~Timer() = default;
+	Timer& operator=( const Timer& ) = delete;
+	Timer& operator=( Timer&& other ) noexcept
+	{
+		std::swap( m_enabled, other.m_enabled );
+		std::swap( m_stream, other.m_stream );
+		std::swap( m_start, other.m_start );
+		std::swap( m_tracer, other.m_tracer );
+		std::swap( m_names, other.m_names );
+		std::swap( m_eventPool, other.m_eventPool );
+		std::swap( m_events, other.m_events );
+		std::swap( timeRecord, other.timeRecord );
+		return *this;
+	}
+
+	~Timer()
+	{
+		for ( const Events& events : m_events )
+			destroy( events );
+	}
 
 	class Profiler;
 
-	/// Call the callable and measure the elapsed time using Orochi events.
+	[[nodiscard]] bool isEnabled() const noexcept { return m_enabled; }
+
+	/// Call the callable and measure the elapsed device time using Orochi events.
+	/// The events are recorded to the stream and only waited for when the time is read.
 	/// @param[in] token The token of the time record.
 	/// @param[in] callable The callable object to be called.
 	/// @param[in] args The parameters of the callable.
 	/// @return The forwarded returned result of the callable.
 	template <typename CallableType, typename... Args>
-	decltype( auto ) measure( const TokenType token, CallableType&& callable, Args&&... args ) noexcept
+	decltype( auto ) measure( const TokenType token, CallableType&& callable, Args&&... args )
 	{
-		TimeUnit time{};
-		oroEvent start{};
-		oroEvent stop{};
-		if constexpr ( EnableTimer )
+		Tracer::Span span( m_tracer, m_tracer != nullptr ? m_names[token] : nullptr, "phase" );
+		if ( !m_enabled ) return std::invoke( std::forward<CallableType>( callable ), std::forward<Args>( args )... );
+
+		Events& events = m_events.emplace_back( Events{ token } );
+		events.start   = acquire();
+		events.stop	   = acquire();
+		checkOro( oroEventRecord( events.start, m_stream ) );
+
+		using return_type = std::invoke_result_t<CallableType, Args...>;
+		if constexpr ( std::is_void_v<return_type> )
 		{
-			checkOro( oroEventCreateWithFlags( &start, 0 ) );
-			checkOro( oroEventCreateWithFlags( &stop, 0 ) );
-			checkOro( oroEventRecord( start, 0 ) );
+			std::invoke( std::forward<CallableType>( callable ), std::forward<Args>( args )... );
+			recordStop();
+			return;
 		}
+		else
+		{
+			decltype( auto ) result{ std::invoke( std::forward<CallableType>( callable ), std::forward<Args>( args )... ) };
+			recordStop();
+			return result;
+		}
+	}
 
-		using return_type = std::invoke_result_t<CallableType, Args...>;
+	/// Call the callable and measure the elapsed host time.
+	/// @param[in] token The token of the time record.
+	/// @param[in] callable The callable object to be called.
+	/// @param[in] args The parameters of the callable.
+	/// @return The forwarded returned result of the callable.
+	template <typename CallableType, typename... Args>
+	decltype( auto ) measureHost( const TokenType token, CallableType&& callable, Args&&... args )
+	{
+		Tracer::Span span( m_tracer, m_tracer != nullptr ? m_names[token] : nullptr, "phase" );
+		if ( !m_enabled ) return std::invoke( std::forward<CallableType>( callable ), std::forward<Args>( args )... );
+
+		const Clock::time_point start = Clock::now();
+		using return_type			  = std::invoke_result_t<CallableType, Args...>;
 		if constexpr ( std::is_void_v<return_type> )
 		{
 			std::invoke( std::forward<CallableType>( callable ), std::forward<Args>( args )... );
-			if constexpr ( EnableTimer )
-			{
-				checkOro( oroEventRecord( stop, 0 ) );
-				checkOro( oroEventSynchronize( stop ) );
-				checkOro( oroEventElapsedTime( &time, start, stop ) );
-				checkOro( oroEventDestroy( start ) );
-				checkOro( oroEventDestroy( stop ) );
-				timeRecord[token] += time;
-			}
+			timeRecord[token] += std::chrono::duration<TimeUnit, std::milli>( Clock::now() - start ).count();
 			return;
 		}
 		else
 		{
 			decltype( auto ) result{ std::invoke( std::forward<CallableType>( callable ), std::forward<Args>( args )... ) };
-			if constexpr ( EnableTimer )
-			{
-				checkOro( oroEventRecord( stop, 0 ) );
-				checkOro( oroEventSynchronize( stop ) );
-				checkOro( oroEventElapsedTime( &time, start, stop ) );
-				checkOro( oroEventDestroy( start ) );
-				checkOro( oroEventDestroy( stop ) );
-				timeRecord[token] += time;
-			}
+			timeRecord[token] += std::chrono::duration<TimeUnit, std::milli>( Clock::now() - start ).count();
 			return result;
 		}
 	}
 
-	[[nodiscard]] TimeUnit getTimeRecord( const TokenType token ) const noexcept
+	/// Whether the device work of the measured calls completed, the time records are then read without waiting.
+	[[nodiscard]] bool isReady() const
 	{
+		for ( const Events& events : m_events )
+		{
+			if ( events.recorded && oroEventQuery( events.stop ) != oroSuccess ) return false;
+		}
+		return true;
+	}
+
+	/// Waits for the pending events of the token.
+	[[nodiscard]] TimeUnit getTimeRecord( const TokenType token )
+	{
+		resolve();
 		if ( timeRecord.find( token ) != timeRecord.end() ) return timeRecord.at( token );
 		return TimeUnit{};
 	}
 
+	/// Waits for the pending events and releases them, only the time records are kept.
+	void resolve()
+	{
+		std::vector<Events> pending;
+		pending.swap( m_events );
+		for ( const Events& events : pending )
+		{
+			if ( events.recorded )
+			{
+				TimeUnit time{};
+				checkOro( oroEventSynchronize( events.stop ) );
+				checkOro( oroEventElapsedTime( &time, events.start, events.stop ) );
+				timeRecord[events.token] += time;
+			}
+			destroy( events );
+		}
+	}
+
+	/// The host time since the construction of the timer.
+	[[nodiscard]] TimeUnit getElapsedTime() const noexcept
+	{
+		return std::chrono::duration<TimeUnit, std::milli>( Clock::now() - m_start ).count();
+	}
+
 	void reset( const TokenType token ) noexcept
 	{
 		if ( timeRecord.count( token ) > 0UL )
@@ -118,8 +242,51 @@ class Timer final
 	void clear() noexcept { timeRecord.clear(); }
 
   private:
+	struct Events
+	{
+		TokenType token;
+		oroEvent  start	   = nullptr;
+		oroEvent  stop	   = nullptr;
+		bool	  recorded = false;
+	};
+
+	void recordStop()
+	{
+		Events& events = m_events.back();
+		checkOro( oroEventRecord( events.stop, m_stream ) );
+		events.recorded = true;
+	}
+
+	oroEvent acquire()
+	{
+		if ( m_eventPool != nullptr ) return m_eventPool->acquire();
+		oroEvent event;
+		checkOro( oroEventCreateWithFlags( &event, 0 ) );
+		return event;
+	}
+
+	void destroy( const Events& events ) noexcept
+	{
+		for ( oroEvent event : { events.start, events.stop } )
+		{
+			if ( event == nullptr ) continue;
+			if ( m_eventPool != nullptr )
+				m_eventPool->release( event );
+			else
+				oroEventDestroy( event );
+		}
+	}
+
 	using TimeRecord = std::unordered_map<TokenType, TimeUnit>;
-	TimeRecord timeRecord;
+
+	bool				m_enabled = false;
+	oroStream			m_stream  = nullptr;
+	Clock::time_point	m_start;
+	Tracer*				m_tracer	= nullptr;
+	const char* const*	m_names		= nullptr;
+	EventPool*			m_eventPool = nullptr;
+	std::vector<Events> m_events;
+	TimeRecord			timeRecord;
 };
 
-} // namespace hiprt
\ No newline at end of file
+} // namespace hiprt
@@ -0,0 +1,172 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <hiprt/impl/Tracer.h>
+#include <hiprt/impl/Utility.h>
+#include <fstream>
+#include <iomanip>
+#include <thread>
+
+namespace
+{
+std::atomic<uint32_t> threadCount = 0u;
+
+// small sequential ids are easier to read in the trace viewers than the native ones
+thread_local const uint32_t threadId = ++threadCount;
+
+double toMicroseconds( hiprt::Tracer::Clock::duration duration )
+{
+	return std::chrono::duration<double, std::micro>( duration ).count();
+}
+} // namespace
+
+namespace hiprt
+{
+Tracer::Span::Span( Tracer& tracer, const char* name, const char* category ) : Span( &tracer, name, category ) {}
+
+Tracer::Span::Span( Tracer* tracer, const char* name, const char* category ) : m_name( name ), m_category( category )
+{
+	if ( tracer == nullptr || !tracer->m_enabled.load( std::memory_order_acquire ) ) return;
+	m_tracer = tracer;
+	m_start	 = Clock::now();
+}
+
+Tracer::Span::~Span()
+{
+	if ( m_tracer != nullptr ) m_tracer->record( m_name, m_category, m_start, std::move( m_args ) );
+}
+
+void Tracer::Span::arg( const char* key, uint64_t value )
+{
+	if ( m_tracer == nullptr ) return;
+	m_args += ( m_args.empty() ? "" : ", " ) + Utility::toJsonString( key ) + ": " + std::to_string( value );
+}
+
+void Tracer::Span::arg( const char* key, const std::string& value )
+{
+	if ( m_tracer == nullptr ) return;
+	m_args += ( m_args.empty() ? "" : ", " ) + Utility::toJsonString( key ) + ": " + Utility::toJsonString( value );
+}
+
+void Tracer::Span::stream( oroStream stream )
+{
+	if ( m_tracer == nullptr ) return;
+	arg( "stream", Utility::format( "%p", reinterpret_cast<void*>( stream ) ) );
+}
+
+void Tracer::setEnabled( bool enabled )
+{
+	std::lock_guard<std::mutex> lock( m_mutex );
+	if ( enabled && !m_events ) m_events = std::make_unique<Event[]>( Capacity );
+
+	// a new session starts with an empty buffer
+	if ( enabled && !m_enabled.load( std::memory_order_relaxed ) )
+	{
+		size_t droppedCount;
+		takeRecords( droppedCount );
+	}
+	m_enabled.store( enabled, std::memory_order_release );
+}
+
+void Tracer::record( const char* name, const char* category, Clock::time_point start, std::string&& args )
+{
+	const Clock::time_point end	  = Clock::now();
+	const size_t			index = m_eventCount.fetch_add( 1u, std::memory_order_acquire );
+	if ( index >= Capacity )
+	{
+		m_droppedCount.fetch_add( 1u, std::memory_order_relaxed );
+		return;
+	}
+
+	Event& event			= m_events[index];
+	event.record.name		= name;
+	event.record.category	= category;
+	event.record.threadId	= threadId;
+	event.record.start		= start;
+	event.record.end		= end;
+	event.record.args		= std::move( args );
+	event.ready.store( true, std::memory_order_release );
+}
+
+std::vector<Tracer::Record> Tracer::takeRecords( size_t& droppedCountOut )
+{
+	droppedCountOut = 0u;
+	if ( !m_events ) return {};
+
+	// the full count drops the spans ending meanwhile, the slots claimed before are written shortly
+	const size_t count = std::min( m_eventCount.exchange( Capacity, std::memory_order_acq_rel ), Capacity );
+	droppedCountOut	   = m_droppedCount.exchange( 0u, std::memory_order_relaxed );
+
+	std::vector<Record> records;
+	records.reserve( count );
+	for ( size_t i = 0; i < count; ++i )
+	{
+		Event& event = m_events[i];
+		while ( !event.ready.load( std::memory_order_acquire ) )
+			std::this_thread::yield();
+		records.push_back( std::move( event.record ) );
+		event.ready.store( false, std::memory_order_relaxed );
+	}
+
+	m_eventCount.store( 0u, std::memory_order_release );
+	return records;
+}
+
+void Tracer::exportJson( const std::filesystem::path& path )
+{
+	std::ofstream file( path, std::ios::out | std::ios::trunc );
+	if ( !file ) throw std::runtime_error( "Cannot open the trace file: " + path.string() );
+
+	const uint32_t processId = Utility::getProcessId();
+
+	// the spans are only exported once, recording continues while the file is written
+	size_t				droppedCount;
+	std::vector<Record> records;
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		records = takeRecords( droppedCount );
+	}
+
+	// the timestamps are steady clock times, so the spans line up with other traces of the process
+	file << std::fixed << std::setprecision( 3 );
+	file << "{\n\t\"traceEvents\": [";
+	bool first = true;
+	for ( const Record& event : records )
+	{
+		file << ( first ? "\n" : ",\n" );
+		file << "\t\t{ \"name\": " << Utility::toJsonString( event.name ) << ", \"cat\": " << Utility::toJsonString( event.category );
+		file << ", \"ph\": \"X\"";
+		file << ", \"ts\": " << toMicroseconds( event.start.time_since_epoch() );
+		file << ", \"dur\": " << toMicroseconds( event.end - event.start );
+		file << ", \"pid\": " << processId << ", \"tid\": " << event.threadId;
+		file << ", \"args\": { " << event.args << " } }";
+		first = false;
+	}
+	file << ( first ? "],\n" : "\n\t],\n" );
+	file << "\t\"displayTimeUnit\": \"ms\",\n";
+	file << "\t\"otherData\": { \"droppedEvents\": " << droppedCount << " }\n}\n";
+	if ( !file ) throw std::runtime_error( "Cannot write the trace file: " + path.string() );
+}
+} // namespace hiprt
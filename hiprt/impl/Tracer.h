@@ -0,0 +1,109 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <Orochi/Orochi.h>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hiprt
+{
+// Opt-in spans of the builds, compilations and loads, exported as Chrome trace-event JSON.
+// A span claims a slot of a bounded buffer with an atomic counter when it ends, so recording
+// does not lock and costs a relaxed load while the tracing is disabled. Exporting and enabling
+// again empty the buffer, spans beyond the capacity in between are dropped.
+class Tracer
+{
+  public:
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr size_t Capacity = 1u << 16u;
+
+	class Span
+	{
+	  public:
+		// the name and category are expected to be string literals
+		Span( Tracer& tracer, const char* name, const char* category );
+		Span( Tracer* tracer, const char* name, const char* category );
+		Span( const Span& )			   = delete;
+		Span& operator=( const Span& ) = delete;
+		~Span();
+
+		bool isActive() const { return m_tracer != nullptr; }
+
+		// the arguments are only formatted while tracing
+		void arg( const char* key, uint64_t value );
+		void arg( const char* key, const std::string& value );
+		void stream( oroStream stream );
+
+	  private:
+		Tracer*			  m_tracer = nullptr;
+		const char*		  m_name;
+		const char*		  m_category;
+		Clock::time_point m_start;
+		std::string		  m_args;
+	};
+
+	void setEnabled( bool enabled );
+	bool isEnabled() const { return m_enabled.load( std::memory_order_relaxed ); }
+
+	void exportJson( const std::filesystem::path& path );
+
+  private:
+	struct Record
+	{
+		const char*		  name;
+		const char*		  category;
+		uint32_t		  threadId;
+		Clock::time_point start;
+		Clock::time_point end;
+		std::string		  args;
+	};
+
+	struct Event
+	{
+		Record			  record;
+		std::atomic<bool> ready = false;
+	};
+
+	void record( const char* name, const char* category, Clock::time_point start, std::string&& args );
+
+	// empties the buffer, the caller holds the mutex
+	std::vector<Record> takeRecords( size_t& droppedCountOut );
+
+	static uint32_t getThreadId();
+
+	std::atomic<bool>		 m_enabled		= false;
+	std::atomic<size_t>		 m_eventCount	= 0u;
+	std::atomic<size_t>		 m_droppedCount	= 0u;
+	std::mutex				 m_mutex;
+	std::unique_ptr<Event[]> m_events;
+};
+} // namespace hiprt
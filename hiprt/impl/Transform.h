@@ -401,6 +401,72 @@ class Transform
 		return outAabb;
 	}
 
+	HIPRT_HOST_DEVICE Aabb boundPointMotion( const float3& p, float timeBegin, float timeEnd ) const
+	{
+		Aabb outAabb;
+
+		if ( m_frameCount == 0 || m_frames == nullptr )
+		{
+			outAabb.grow( p );
+			return outAabb;
+		}
+
+		if ( m_frameCount == 1 )
+		{
+			outAabb.grow( m_frames[0].transform( p ) );
+			return outAabb;
+		}
+
+		const float firstTime = m_frames[0].m_time;
+		const float lastTime  = m_frames[m_frameCount - 1].m_time;
+		timeBegin			  = fminf( fmaxf( timeBegin, firstTime ), lastTime );
+		timeEnd				  = fminf( fmaxf( timeEnd, firstTime ), lastTime );
+
+		constexpr uint32_t Steps = 3;
+		constexpr float	   Delta = 1.0f / float( Steps + 1 );
+
+		float t0 = timeBegin;
+		Frame f0 = interpolateFrames( t0 );
+		outAabb.grow( f0.transform( p ) );
+
+		// key frames inside the interval and its end
+		for ( uint32_t i = 0; i <= m_frameCount; ++i )
+		{
+			const float t1 = i < m_frameCount ? fminf( m_frames[i].m_time, timeEnd ) : timeEnd;
+			if ( t1 <= t0 ) continue;
+
+			Frame f1 = interpolateFrames( t1 );
+			float t	 = Delta;
+			for ( uint32_t j = 1; j <= Steps; ++j )
+			{
+				Frame f;
+				f.m_scale		= mix( f0.m_scale, f1.m_scale, t );
+				f.m_shear		= mix( f0.m_shear, f1.m_shear, t );
+				f.m_translation = mix( f0.m_translation, f1.m_translation, t );
+				f.m_rotation	= qtMix( f0.m_rotation, f1.m_rotation, t );
+				outAabb.grow( f.transform( p ) );
+				t += Delta;
+			}
+			outAabb.grow( f1.transform( p ) );
+			t0 = t1;
+			f0 = f1;
+		}
+
+		return outAabb;
+	}
+
+	HIPRT_HOST_DEVICE Aabb motionBounds( const Aabb& aabb, float timeBegin, float timeEnd ) const
+	{
+		Aabb outAabb;
+		for ( uint32_t i = 0; i < 8; ++i )
+		{
+			const float3 p = {
+				i & 1 ? aabb.m_max.x : aabb.m_min.x, i & 2 ? aabb.m_max.y : aabb.m_min.y, i & 4 ? aabb.m_max.z : aabb.m_min.z };
+			outAabb.grow( boundPointMotion( p, timeBegin, timeEnd ) );
+		}
+		return outAabb;
+	}
+
 	HIPRT_HOST_DEVICE Aabb motionBounds( const Aabb& aabb ) const
 	{
 		float3 p0 = aabb.m_min;
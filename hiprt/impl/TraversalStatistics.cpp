@@ -0,0 +1,54 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+#include <hiprt/impl/TraversalStatistics.h>
+#include <algorithm>
+
+namespace hiprt
+{
+hiprtTraversalStatisticsSummary TraversalStatistics::summarize( const std::vector<hiprtTraversalStatistics>& rayStats )
+{
+	hiprtTraversalStatisticsSummary summary;
+	summary.rayCount = static_cast<uint32_t>( rayStats.size() );
+	for ( const hiprtTraversalStatistics& stats : rayStats )
+	{
+		summary.internalNodeCount += stats.internalNodeCount;
+		summary.leafNodeCount += stats.leafNodeCount;
+		summary.triangleTestCount += stats.triangleTestCount;
+		summary.customIntersectionCount += stats.customIntersectionCount;
+		summary.instanceCount += stats.instanceCount;
+		summary.maxInternalNodeCount = std::max( summary.maxInternalNodeCount, stats.internalNodeCount );
+		summary.maxStackDepth		 = std::max( summary.maxStackDepth, stats.maxStackDepth );
+		if ( stats.stackOverflowCount > 0 ) summary.stackOverflowRayCount++;
+
+		// bucket i > 0 holds [2^(i-1), 2^i), i.e. the bit width of the count
+		uint32_t nodeBucket = 0u;
+		while ( nodeBucket < 32u && ( stats.internalNodeCount >> nodeBucket ) != 0u )
+			nodeBucket++;
+		summary.internalNodeHistogram[std::min( nodeBucket, TraversalHistogramSize - 1u )]++;
+		summary.stackDepthHistogram[std::min( stats.maxStackDepth, TraversalHistogramSize - 1u )]++;
+	}
+	return summary;
+}
+} // namespace hiprt
@@ -22,11 +22,37 @@
 //
 //////////////////////////////////////////////////////////////////////////////////////////
 
+#include <hiprt/impl/Error.h>
 #include <hiprt/impl/TriangleMesh.h>
 
 namespace hiprt
 {
 #if !defined( __KERNELCC__ )
 DECLARE_TYPE_TRAITS( hiprt::TriangleMesh );
+
+TriangleMesh TriangleMesh::copyToHost( std::vector<uint8_t>& vertices, std::vector<uint8_t>& triangleIndices ) const
+{
+	TriangleMesh mesh = *this;
+
+	// the last element does not need to be padded to the full stride
+	vertices.resize( static_cast<size_t>( m_vertexCount - 1 ) * m_vertexStride + 3 * sizeof( float ) );
+	checkOro(
+		oroMemcpyDtoH( vertices.data(), reinterpret_cast<oroDeviceptr>( const_cast<uint8_t*>( m_vertices ) ), vertices.size() ) );
+	mesh.m_vertices = vertices.data();
+
+	if ( m_triangleIndices != nullptr )
+	{
+		triangleIndices.resize( static_cast<size_t>( m_triangleCount - 1 ) * m_triangleStride + 3 * sizeof( uint32_t ) );
+		checkOro( oroMemcpyDtoH(
+			triangleIndices.data(),
+			reinterpret_cast<oroDeviceptr>( const_cast<uint8_t*>( m_triangleIndices ) ),
+			triangleIndices.size() ) );
+		mesh.m_triangleIndices = triangleIndices.data();
+	}
+
+	mesh.m_pairIndices = nullptr;
+	mesh.m_pairCount   = 0u;
+	return mesh;
+}
 #endif
 } // namespace hiprt
@@ -172,6 +172,14 @@ class TriangleMesh
 
 	HIPRT_HOST_DEVICE bool pairable() { return m_triangleIndices != nullptr && m_triangleCount > 2 && m_pairCount == 0; }
 
+#if !defined( __KERNELCC__ )
+	/// @brief Copies the vertex and index buffers from the device
+	/// @param vertices The host storage for the vertices
+	/// @param triangleIndices The host storage for the triangle indices
+	/// @return The mesh referencing the host storage
+	TriangleMesh copyToHost( std::vector<uint8_t>& vertices, std::vector<uint8_t>& triangleIndices ) const;
+#endif
+
   private:
 	const uint8_t* m_vertices;
 	uint32_t	   m_vertexCount;
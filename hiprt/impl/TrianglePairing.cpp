@@ -0,0 +1,195 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <hiprt/impl/Error.h>
+#include <hiprt/impl/Logger.h>
+#include <hiprt/impl/TrianglePairing.h>
+#include <algorithm>
+#include <numeric>
+
+namespace hiprt
+{
+std::vector<uint2> TrianglePairing::pairTriangles( const TriangleMesh& mesh )
+{
+	const uint32_t triangleCount = mesh.getCount();
+
+	// edge-adjacency graph: triangles sorted by their (undirected) edges
+	std::vector<std::pair<uint64_t, uint32_t>> edges;
+	edges.reserve( 3 * static_cast<size_t>( triangleCount ) );
+	for ( uint32_t i = 0; i < triangleCount; ++i )
+	{
+		const uint3	   indices	= mesh.fetchTriangleIndices( i );
+		const uint32_t vertices[] = { indices.x, indices.y, indices.z };
+		for ( uint32_t j = 0; j < 3; ++j )
+		{
+			const uint64_t a = std::min( vertices[j], vertices[( j + 1 ) % 3] );
+			const uint64_t b = std::max( vertices[j], vertices[( j + 1 ) % 3] );
+			if ( a != b ) edges.push_back( { ( a << 32 ) | b, i } );
+		}
+	}
+	std::sort( edges.begin(), edges.end() );
+
+	struct Candidate
+	{
+		float	 m_area;
+		uint32_t m_first;
+		uint32_t m_second;
+	};
+
+	std::vector<Candidate> candidates;
+	for ( size_t begin = 0; begin < edges.size(); )
+	{
+		size_t end = begin + 1;
+		while ( end < edges.size() && edges[end].first == edges[begin].first )
+			++end;
+
+		// cap non-manifold edges to avoid the quadratic blow up
+		const size_t last = std::min( end, begin + MaxTrianglesPerEdge );
+		for ( size_t i = begin; i < last; ++i )
+		{
+			for ( size_t j = i + 1; j < last; ++j )
+			{
+				const uint32_t first  = std::min( edges[i].second, edges[j].second );
+				const uint32_t second = std::max( edges[i].second, edges[j].second );
+				if ( first == second ) continue;
+				if ( tryPairTriangles( mesh.fetchTriangleIndices( first ), mesh.fetchTriangleIndices( second ) ).x ==
+					 InvalidValue )
+					continue;
+				const float area = mesh.fetchTriangleNode( uint2{ first, second } ).area();
+				candidates.push_back( { area, first, second } );
+			}
+		}
+		begin = end;
+	}
+
+	// two triangles sharing more than one edge are degenerate, keep a single candidate
+	std::sort( candidates.begin(), candidates.end(), []( const Candidate& a, const Candidate& b ) {
+		if ( a.m_first != b.m_first ) return a.m_first < b.m_first;
+		return a.m_second < b.m_second;
+	} );
+	candidates.erase(
+		std::unique(
+			candidates.begin(),
+			candidates.end(),
+			[]( const Candidate& a, const Candidate& b ) { return a.m_first == b.m_first && a.m_second == b.m_second; } ),
+		candidates.end() );
+
+	// adjacency lists
+	std::vector<uint32_t> offsets( triangleCount + 1, 0u );
+	for ( const Candidate& c : candidates )
+	{
+		offsets[c.m_first + 1]++;
+		offsets[c.m_second + 1]++;
+	}
+	std::partial_sum( offsets.begin(), offsets.end(), offsets.begin() );
+	std::vector<uint32_t> neighbors( offsets.back() );
+	{
+		std::vector<uint32_t> counters( offsets.begin(), offsets.end() - 1 );
+		for ( const Candidate& c : candidates )
+		{
+			neighbors[counters[c.m_first]++]  = c.m_second;
+			neighbors[counters[c.m_second]++] = c.m_first;
+		}
+	}
+
+	// greedy matching biased toward tight pairs
+	std::stable_sort( candidates.begin(), candidates.end(), []( const Candidate& a, const Candidate& b ) {
+		return a.m_area < b.m_area;
+	} );
+	std::vector<uint32_t> mates( triangleCount, InvalidValue );
+	for ( const Candidate& c : candidates )
+	{
+		if ( mates[c.m_first] != InvalidValue || mates[c.m_second] != InvalidValue ) continue;
+		mates[c.m_first]  = c.m_second;
+		mates[c.m_second] = c.m_first;
+	}
+
+	// augmenting paths u - v = w - x turning one matched edge into two
+	bool augmented = true;
+	while ( augmented )
+	{
+		augmented = false;
+		for ( uint32_t u = 0; u < triangleCount; ++u )
+		{
+			if ( mates[u] != InvalidValue ) continue;
+			for ( uint32_t i = offsets[u]; i < offsets[u + 1] && mates[u] == InvalidValue; ++i )
+			{
+				const uint32_t v = neighbors[i];
+				if ( mates[v] == InvalidValue )
+				{
+					mates[u] = v;
+					mates[v] = u;
+					break;
+				}
+
+				const uint32_t w = mates[v];
+				for ( uint32_t j = offsets[w]; j < offsets[w + 1]; ++j )
+				{
+					const uint32_t x = neighbors[j];
+					if ( x == u || mates[x] != InvalidValue ) continue;
+					mates[u] = v;
+					mates[v] = u;
+					mates[w] = x;
+					mates[x] = w;
+
+					augmented = true;
+					break;
+				}
+			}
+		}
+	}
+
+	std::vector<uint2> pairIndices;
+	pairIndices.reserve( triangleCount );
+	for ( uint32_t i = 0; i < triangleCount; ++i )
+	{
+		if ( mates[i] == InvalidValue )
+			pairIndices.push_back( uint2{ i, i } );
+		else if ( i < mates[i] )
+			pairIndices.push_back( uint2{ i, mates[i] } );
+	}
+	return pairIndices;
+}
+
+uint32_t TrianglePairing::pairTriangles( const TriangleMesh& mesh, uint2* pairIndices, oroStream stream )
+{
+	std::vector<uint8_t> vertices;
+	std::vector<uint8_t> triangleIndices;
+	checkOro( oroStreamSynchronize( stream ) );
+	const TriangleMesh hostMesh = mesh.copyToHost( vertices, triangleIndices );
+
+	const std::vector<uint2> pairs	   = pairTriangles( hostMesh );
+	const uint32_t			 pairCount = static_cast<uint32_t>( pairs.size() );
+	checkOro( oroMemcpyHtoD(
+		reinterpret_cast<oroDeviceptr>( pairIndices ), const_cast<uint2*>( pairs.data() ), sizeof( uint2 ) * pairCount ) );
+
+	const uint32_t triangleCount = hostMesh.getCount();
+	logInfo(
+		"Triangle pairing ratio: %f\n",
+		static_cast<float>( 2 * ( triangleCount - pairCount ) ) / static_cast<float>( triangleCount ) );
+
+	return pairCount;
+}
+} // namespace hiprt
@@ -0,0 +1,56 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <Orochi/Orochi.h>
+#include <hiprt/hiprt_types.h>
+#include <hiprt/impl/TriangleMesh.h>
+#include <vector>
+
+namespace hiprt
+{
+class TrianglePairing
+{
+  public:
+	static constexpr uint32_t MaxTrianglesPerEdge = 8u;
+
+	TrianglePairing()									 = delete;
+	TrianglePairing& operator=( const TrianglePairing& ) = delete;
+
+	/// @brief Pairs triangles by a matching over the edge-adjacency graph
+	/// The matching is seeded greedily with pairs of the smallest combined area
+	/// and then grown by augmenting paths of length three.
+	/// @param mesh The mesh (in the host memory)
+	/// @return The pair indices (unpaired triangles are paired with themselves)
+	static std::vector<uint2> pairTriangles( const TriangleMesh& mesh );
+
+	/// @brief Pairs triangles of a device mesh on the host
+	/// @param mesh The mesh (in the device memory)
+	/// @param pairIndices The output pair indices (in the device memory)
+	/// @param stream The stream
+	/// @return The number of pairs
+	static uint32_t pairTriangles( const TriangleMesh& mesh, uint2* pairIndices, oroStream stream );
+};
+} // namespace hiprt
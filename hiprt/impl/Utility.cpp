@@ -27,11 +27,13 @@
 #include <hiprt/impl/Utility.h>
 #include <locale>
 #include <codecvt>
+#include <cstring>
 
 #if defined( __GNUC__ )
 #include <dlfcn.h>
 #include <sys/stat.h>
 #include <errno.h>
+#include <unistd.h>
 #endif
 
 #if defined( _WIN32 )
@@ -70,22 +72,100 @@ std::filesystem::path Utility::getCurrentDir()
 	return std::string( buff ).substr( 0, position ) + "/";
 }
 
-uint32_t Utility::hashString( const std::string& str )
+std::string Utility::hashString( const std::string& str )
 {
-	uint32_t hash = 0;
+	const uint64_t low	= hash64( str.data(), str.size() );
+	const uint64_t high = hash64( str.data(), str.size(), low ^ 0x9e3779b97f4a7c15ull );
+	return format( "%016llx%016llx", static_cast<unsigned long long>( high ), static_cast<unsigned long long>( low ) );
+}
+
+// MurmurHash64A
+uint64_t Utility::hash64( const void* data, size_t size, uint64_t seed )
+{
+	constexpr uint64_t M = 0xc6a4a7935bd1e995ull;
+	constexpr int	   R = 47;
 
-	const char* data = str.data();
-	for ( uint32_t i = 0; i < str.length(); ++i )
+	uint64_t	   hash	 = seed ^ ( size * M );
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>( data );
+	const uint8_t* end	 = bytes + ( size & ~size_t( 7 ) );
+	for ( ; bytes != end; bytes += 8 )
 	{
-		hash += *data++;
-		hash += ( hash << 10 );
-		hash ^= ( hash >> 6 );
+		uint64_t k;
+		std::memcpy( &k, bytes, sizeof( uint64_t ) );
+		k *= M;
+		k ^= k >> R;
+		k *= M;
+		hash ^= k;
+		hash *= M;
 	}
 
-	hash += ( hash << 3 );
-	hash ^= ( hash >> 11 );
-	hash += ( hash << 15 );
+	switch ( size & 7 )
+	{
+	case 7:
+		hash ^= uint64_t( bytes[6] ) << 48;
+		[[fallthrough]];
+	case 6:
+		hash ^= uint64_t( bytes[5] ) << 40;
+		[[fallthrough]];
+	case 5:
+		hash ^= uint64_t( bytes[4] ) << 32;
+		[[fallthrough]];
+	case 4:
+		hash ^= uint64_t( bytes[3] ) << 24;
+		[[fallthrough]];
+	case 3:
+		hash ^= uint64_t( bytes[2] ) << 16;
+		[[fallthrough]];
+	case 2:
+		hash ^= uint64_t( bytes[1] ) << 8;
+		[[fallthrough]];
+	case 1:
+		hash ^= uint64_t( bytes[0] );
+		hash *= M;
+	}
+
+	hash ^= hash >> R;
+	hash *= M;
+	hash ^= hash >> R;
 
 	return hash;
 }
+
+std::string Utility::toJsonString( const std::string& str )
+{
+	std::string json = "\"";
+	for ( const char c : str )
+	{
+		switch ( c )
+		{
+		case '"':
+			json += "\\\"";
+			break;
+		case '\\':
+			json += "\\\\";
+			break;
+		case '\n':
+			json += "\\n";
+			break;
+		case '\t':
+			json += "\\t";
+			break;
+		default:
+			if ( static_cast<unsigned char>( c ) < 0x20 )
+				json += format( "\\u%04x", c );
+			else
+				json += c;
+		}
+	}
+	return json + "\"";
+}
+
+uint32_t Utility::getProcessId()
+{
+#if !defined( __GNUC__ )
+	return static_cast<uint32_t>( GetCurrentProcessId() );
+#else
+	return static_cast<uint32_t>( getpid() );
+#endif
+}
 } // namespace hiprt
@@ -36,7 +36,15 @@ class Utility
   public:
 	static std::filesystem::path getCurrentDir();
 
-	static uint32_t hashString( const std::string& str );
+	// 128-bit hash as a hexadecimal string
+	static std::string hashString( const std::string& str );
+
+	static uint64_t hash64( const void* data, size_t size, uint64_t seed = 0 );
+
+	// quoted and escaped JSON string
+	static std::string toJsonString( const std::string& str );
+
+	static uint32_t getProcessId();
 
 	template <typename... Args>
 	static std::string format( const std::string& format, Args... args )
@@ -24,14 +24,86 @@
 
 #include <hiprt/hiprt.h>
 #include <hiprt/hiprt_libpath.h>
+#include <hiprt/impl/BvhNode.h>
 #include <hiprt/impl/Error.h>
 #include <hiprt/impl/Context.h>
 #include <hiprt/impl/Geometry.h>
 #include <hiprt/impl/Utility.h>
 #include <hiprt/impl/Logger.h>
+#include <deque>
 
 using namespace hiprt;
 
+namespace
+{
+// keeps copies of the inputs of an asynchronous compilation
+class CompileInputs
+{
+  public:
+	const char* copy( const char* str )
+	{
+		if ( str == nullptr ) return nullptr;
+		return m_strings.emplace_back( str ).c_str();
+	}
+
+	std::vector<const char*> copy( uint32_t count, const char** strs )
+	{
+		std::vector<const char*> copies;
+		for ( uint32_t i = 0; i < count; ++i )
+			copies.push_back( copy( strs[i] ) );
+		return copies;
+	}
+
+	std::vector<hiprtFuncNameSet> copy( uint32_t count, const hiprtFuncNameSet* funcNameSets )
+	{
+		std::vector<hiprtFuncNameSet> copies;
+		if ( funcNameSets == nullptr ) return copies;
+		for ( uint32_t i = 0; i < count; ++i )
+			copies.push_back( { copy( funcNameSets[i].intersectFuncName ), copy( funcNameSets[i].filterFuncName ) } );
+		return copies;
+	}
+
+  private:
+	std::deque<std::string> m_strings;
+};
+
+// an asynchronous compilation, owned by the caller until it is waited for or destroyed
+struct CompileTask
+{
+	hiprtContext			context;
+	std::future<hiprtError> future;
+};
+
+template <typename T>
+T* dataOrNull( std::vector<T>& data )
+{
+	return data.empty() ? nullptr : data.data();
+}
+
+// the sbvh builder has no deterministic variant
+bool validBuildOptions( const hiprtBuildOptions& buildOptions )
+{
+	if ( ( buildOptions.buildFlags & 3 ) == hiprtBuildFlagBitPreferHighQualityBuild &&
+		 ( buildOptions.buildFlags & hiprtBuildFlagBitDeterministic ) )
+	{
+		logError( "Deterministic builds are not supported with hiprtBuildFlagBitPreferHighQualityBuild" );
+		return false;
+	}
+	return true;
+}
+
+// the last bit of the primitive index of a custom node marks a leaf continuing in the next node
+bool validBuildInput( const hiprtGeometryBuildInput& buildInput )
+{
+	if ( buildInput.type == hiprtPrimitiveTypeAABBList && buildInput.primitive.aabbList.aabbCount >= CustomNode::NextBit )
+	{
+		logError( "AABB lists are limited to 2^31 - 1 boxes" );
+		return false;
+	}
+	return true;
+}
+} // namespace
+
 hiprtError hiprtCreateContext( uint32_t hiprtApiVersion, const hiprtContextCreationInput& input, hiprtContext& contextOut )
 {
 	oroInitialize( ( input.deviceType == hiprtDeviceAMD ) ? ORO_API_HIP : ORO_API_CUDA, 0, g_hip_paths, g_hiprtc_paths );
@@ -67,12 +139,13 @@ hiprtError hiprtCreateGeometries(
 {
 	if ( !context || numGeometries == 0 || buildInputsIn == nullptr || geometriesOut == nullptr )
 		return hiprtErrorInvalidParameter;
+	if ( !validBuildOptions( buildOptions ) ) return hiprtErrorInvalidParameter;
 
 	// TODO: use std::span after we switch to c++20
 	std::vector<hiprtGeometryBuildInput> buildInputs;
 	for ( uint32_t i = 0; i < numGeometries; ++i )
 	{
-		if ( geometriesOut[i] == nullptr ) return hiprtErrorInvalidParameter;
+		if ( geometriesOut[i] == nullptr || !validBuildInput( buildInputsIn[i] ) ) return hiprtErrorInvalidParameter;
 		buildInputs.push_back( buildInputsIn[i] );
 	}
 
@@ -144,13 +217,14 @@ hiprtError hiprtBuildGeometries(
 {
 	if ( !context || numGeometries == 0 || buildInputsIn == nullptr || geometriesOut == nullptr )
 		return hiprtErrorInvalidParameter;
+	if ( !validBuildOptions( buildOptions ) ) return hiprtErrorInvalidParameter;
 
 	// TODO: use std::span after we switch to c++20
 	std::vector<hiprtDevicePtr>			 buffers;
 	std::vector<hiprtGeometryBuildInput> buildInputs;
 	for ( uint32_t i = 0; i < numGeometries; ++i )
 	{
-		if ( !geometriesOut[i] ) return hiprtErrorInvalidParameter;
+		if ( !geometriesOut[i] || !validBuildInput( buildInputsIn[i] ) ) return hiprtErrorInvalidParameter;
 		buffers.push_back( geometriesOut[i] );
 		buildInputs.push_back( buildInputsIn[i] );
 	}
@@ -194,11 +268,15 @@ hiprtError hiprtGetGeometriesBuildTemporaryBufferSize(
 	size_t&						   sizeOut )
 {
 	if ( !context || numGeometries == 0 || buildInputsIn == nullptr ) return hiprtErrorInvalidParameter;
+	if ( !validBuildOptions( buildOptions ) ) return hiprtErrorInvalidParameter;
 
 	// TODO: use std::span after we switch to c++20
 	std::vector<hiprtGeometryBuildInput> buildInputs;
 	for ( uint32_t i = 0; i < numGeometries; ++i )
+	{
+		if ( !validBuildInput( buildInputsIn[i] ) ) return hiprtErrorInvalidParameter;
 		buildInputs.push_back( buildInputsIn[i] );
+	}
 
 	try
 	{
@@ -268,6 +346,7 @@ hiprtError hiprtCreateScenes(
 	hiprtScene**				scenesOut )
 {
 	if ( !context || numScenes == 0 || buildInputsIn == nullptr || scenesOut == nullptr ) return hiprtErrorInvalidParameter;
+	if ( !validBuildOptions( buildOptions ) ) return hiprtErrorInvalidParameter;
 
 	// TODO: use std::span after we switch to c++20
 	std::vector<hiprtSceneBuildInput> buildInputs;
@@ -340,6 +419,7 @@ hiprtError hiprtBuildScenes(
 	hiprtScene*					scenesOut )
 {
 	if ( !context || numScenes == 0 || buildInputsIn == nullptr || scenesOut == nullptr ) return hiprtErrorInvalidParameter;
+	if ( !validBuildOptions( buildOptions ) ) return hiprtErrorInvalidParameter;
 
 	// TODO: use std::span after we switch to c++20
 	std::vector<hiprtDevicePtr>		  buffers;
@@ -390,6 +470,7 @@ hiprtError hiprtGetScenesBuildTemporaryBufferSize(
 	size_t&						sizeOut )
 {
 	if ( !context || numScenes == 0 || buildInputsIn == nullptr ) return hiprtErrorInvalidParameter;
+	if ( !validBuildOptions( buildOptions ) ) return hiprtErrorInvalidParameter;
 
 	// TODO: use std::span after we switch to c++20
 	std::vector<hiprtSceneBuildInput> buildInputs;
@@ -611,6 +692,52 @@ hiprtError hiprtExportSceneAabb( hiprtContext context, hiprtScene scene, float3&
 	return hiprtSuccess;
 }
 
+hiprtError hiprtGetGeometryStatistics( hiprtContext context, hiprtGeometry geometry, hiprtBvhStatistics& statisticsOut )
+{
+	if ( !context || !geometry ) return hiprtErrorInvalidParameter;
+	try
+	{
+		statisticsOut = reinterpret_cast<Context*>( context )->getGeometryStatistics( geometry );
+	}
+	catch ( std::exception& e )
+	{
+		logError( e.what() );
+		return hiprtErrorInternal;
+	}
+	return hiprtSuccess;
+}
+
+hiprtError hiprtGetSceneStatistics( hiprtContext context, hiprtScene scene, hiprtBvhStatistics& statisticsOut )
+{
+	if ( !context || !scene ) return hiprtErrorInvalidParameter;
+	try
+	{
+		statisticsOut = reinterpret_cast<Context*>( context )->getSceneStatistics( scene );
+	}
+	catch ( std::exception& e )
+	{
+		logError( e.what() );
+		return hiprtErrorInternal;
+	}
+	return hiprtSuccess;
+}
+
+hiprtError hiprtSummarizeTraversalStatistics(
+	hiprtContext context, uint32_t rayCount, hiprtDevicePtr statistics, hiprtTraversalStatisticsSummary& summaryOut )
+{
+	if ( !context || ( rayCount > 0 && !statistics ) ) return hiprtErrorInvalidParameter;
+	try
+	{
+		summaryOut = reinterpret_cast<Context*>( context )->summarizeTraversalStatistics( rayCount, statistics );
+	}
+	catch ( std::exception& e )
+	{
+		logError( e.what() );
+		return hiprtErrorInternal;
+	}
+	return hiprtSuccess;
+}
+
 hiprtError hiprtBuildTraceKernels(
 	hiprtContext	  context,
 	uint32_t		  numFunctions,
@@ -736,9 +863,283 @@ hiprtError hiprtBuildTraceKernelsFromBitcode(
 	return hiprtSuccess;
 }
 
+hiprtError hiprtBuildTraceKernelsAsync(
+	hiprtContext	  context,
+	uint32_t		  numFunctions,
+	const char**	  funcNamesIn,
+	const char*		  src,
+	const char*		  moduleName,
+	uint32_t		  numHeaders,
+	const char**	  headersIn,
+	const char**	  includeNamesIn,
+	uint32_t		  numOptions,
+	const char**	  optionsIn,
+	uint32_t		  numGeomTypes,
+	uint32_t		  numRayTypes,
+	hiprtFuncNameSet* funcNameSetsIn,
+	hiprtApiFunction* functionsOut,
+	hiprtApiModule*	  moduleOut,
+	bool			  cache,
+	hiprtCompileTask& taskOut )
+{
+	if ( !context || moduleName == nullptr || src == nullptr ||
+		 ( ( funcNamesIn == nullptr || functionsOut == nullptr || numFunctions == 0 ) && moduleOut == nullptr ) )
+		return hiprtErrorInvalidParameter;
+
+	try
+	{
+		auto inputs = std::make_shared<CompileInputs>();
+
+		const char*					  srcCopy		 = inputs->copy( src );
+		const char*					  moduleNameCopy = inputs->copy( moduleName );
+		std::vector<const char*>	  funcNames		 = inputs->copy( numFunctions, funcNamesIn );
+		std::vector<const char*>	  headers		 = inputs->copy( numHeaders, headersIn );
+		std::vector<const char*>	  includeNames	 = inputs->copy( numHeaders, includeNamesIn );
+		std::vector<const char*>	  options		 = inputs->copy( numOptions, optionsIn );
+		std::vector<hiprtFuncNameSet> funcNameSets	 = inputs->copy( numGeomTypes * numRayTypes, funcNameSetsIn );
+
+		// the copies live as long as the task
+		std::future<hiprtError> future =
+			reinterpret_cast<Context*>( context )->getCompilePool().submit( [=, inputs = std::move( inputs )]() mutable {
+				return hiprtBuildTraceKernels(
+					context,
+					numFunctions,
+					dataOrNull( funcNames ),
+					srcCopy,
+					moduleNameCopy,
+					numHeaders,
+					dataOrNull( headers ),
+					dataOrNull( includeNames ),
+					numOptions,
+					dataOrNull( options ),
+					numGeomTypes,
+					numRayTypes,
+					dataOrNull( funcNameSets ),
+					functionsOut,
+					moduleOut,
+					cache );
+			} );
+		taskOut = reinterpret_cast<hiprtCompileTask>( new CompileTask{ context, std::move( future ) } );
+	}
+	catch ( std::exception& e )
+	{
+		logError( e.what() );
+		return hiprtErrorInternal;
+	}
+
+	return hiprtSuccess;
+}
+
+hiprtError hiprtBuildTraceKernelsFromBitcodeAsync(
+	hiprtContext	  context,
+	uint32_t		  numFunctions,
+	const char**	  functionNames,
+	const char*		  moduleName,
+	const char*		  bitcodeBinary,
+	size_t			  bitcodeBinarySize,
+	uint32_t		  numGeomTypes,
+	uint32_t		  numRayTypes,
+	hiprtFuncNameSet* functionNameSets,
+	hiprtApiFunction* functionsOut,
+	bool			  cache,
+	hiprtCompileTask& taskOut )
+{
+	if ( !context || numFunctions == 0 || functionNames == nullptr || functionsOut == nullptr || moduleName == nullptr ||
+		 bitcodeBinary == nullptr || bitcodeBinarySize == 0 )
+		return hiprtErrorInvalidParameter;
+
+	try
+	{
+		auto inputs = std::make_shared<CompileInputs>();
+
+		const char*					  moduleNameCopy = inputs->copy( moduleName );
+		std::vector<const char*>	  funcNames		 = inputs->copy( numFunctions, functionNames );
+		std::vector<hiprtFuncNameSet> funcNameSets	 = inputs->copy( numGeomTypes * numRayTypes, functionNameSets );
+		std::string					  bitcode( bitcodeBinary, bitcodeBinarySize );
+
+		// the copies live as long as the task
+		std::future<hiprtError> future =
+			reinterpret_cast<Context*>( context )->getCompilePool().submit( [=, inputs = std::move( inputs )]() mutable {
+				return hiprtBuildTraceKernelsFromBitcode(
+					context,
+					numFunctions,
+					funcNames.data(),
+					moduleNameCopy,
+					bitcode.data(),
+					bitcode.size(),
+					numGeomTypes,
+					numRayTypes,
+					dataOrNull( funcNameSets ),
+					functionsOut,
+					cache );
+			} );
+		taskOut = reinterpret_cast<hiprtCompileTask>( new CompileTask{ context, std::move( future ) } );
+	}
+	catch ( std::exception& e )
+	{
+		logError( e.what() );
+		return hiprtErrorInternal;
+	}
+
+	return hiprtSuccess;
+}
+
+hiprtError hiprtQueryCompileTask( hiprtContext context, hiprtCompileTask task, bool& readyOut )
+{
+	CompileTask* compileTask = reinterpret_cast<CompileTask*>( task );
+	if ( !context || !task || compileTask->context != context ) return hiprtErrorInvalidParameter;
+	readyOut = compileTask->future.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready;
+	return hiprtSuccess;
+}
+
+hiprtError hiprtWaitCompileTask( hiprtContext context, hiprtCompileTask task )
+{
+	if ( !context || !task || reinterpret_cast<CompileTask*>( task )->context != context ) return hiprtErrorInvalidParameter;
+	std::unique_ptr<CompileTask> compileTask( reinterpret_cast<CompileTask*>( task ) );
+	return compileTask->future.get();
+}
+
+hiprtError hiprtDestroyCompileTask( hiprtContext context, hiprtCompileTask task )
+{
+	if ( !context || !task || reinterpret_cast<CompileTask*>( task )->context != context ) return hiprtErrorInvalidParameter;
+	std::unique_ptr<CompileTask> compileTask( reinterpret_cast<CompileTask*>( task ) );
+	compileTask->future.wait();
+	return hiprtSuccess;
+}
+
 void hiprtSetCacheDirPath( hiprtContext context, const char* path )
 {
 	reinterpret_cast<Context*>( context )->setCacheDir( path );
 }
 
+void hiprtSetCacheSizeLimit( hiprtContext context, size_t maxSize )
+{
+	reinterpret_cast<Context*>( context )->setCacheSizeLimit( maxSize );
+}
+
+hiprtError hiprtTrimCache( hiprtContext context, size_t maxSize )
+{
+	if ( !context ) return hiprtErrorInvalidParameter;
+	try
+	{
+		reinterpret_cast<Context*>( context )->trimCache( maxSize );
+	}
+	catch ( std::exception& e )
+	{
+		logError( e.what() );
+		return hiprtErrorInternal;
+	}
+	return hiprtSuccess;
+}
+
+hiprtError hiprtGetCacheStatistics( hiprtContext context, hiprtCacheStatistics& statisticsOut )
+{
+	if ( !context ) return hiprtErrorInvalidParameter;
+	try
+	{
+		statisticsOut = reinterpret_cast<Context*>( context )->getCacheStatistics();
+	}
+	catch ( std::exception& e )
+	{
+		logError( e.what() );
+		return hiprtErrorInternal;
+	}
+	return hiprtSuccess;
+}
+
+hiprtError hiprtSetCompileTarget( hiprtContext context, const hiprtCompileTarget* target )
+{
+	if ( !context || ( target != nullptr && ( target->deviceName == nullptr || target->archName == nullptr ) ) )
+		return hiprtErrorInvalidParameter;
+	reinterpret_cast<Context*>( context )->setCompileTarget( target );
+	return hiprtSuccess;
+}
+
+void hiprtSetCacheReadOnly( hiprtContext context, bool readOnly )
+{
+	reinterpret_cast<Context*>( context )->setCacheReadOnly( readOnly );
+}
+
+void hiprtEnableCompileTelemetry( hiprtContext context, bool enable )
+{
+	reinterpret_cast<Context*>( context )->enableCompileTelemetry( enable );
+}
+
+hiprtError hiprtExportCompileTelemetry( hiprtContext context, const char* filename )
+{
+	if ( !context || !filename ) return hiprtErrorInvalidParameter;
+	try
+	{
+		reinterpret_cast<Context*>( context )->exportCompileTelemetry( filename );
+	}
+	catch ( std::exception& e )
+	{
+		logError( e.what() );
+		return hiprtErrorInternal;
+	}
+	return hiprtSuccess;
+}
+
+void hiprtEnableBuildProfiler( hiprtContext context, bool enable )
+{
+	reinterpret_cast<Context*>( context )->enableBuildProfiler( enable );
+}
+
+hiprtError hiprtGetBuildProfile( hiprtContext context, uint32_t& countInOut, hiprtBuildProfile* profilesOut )
+{
+	if ( !context ) return hiprtErrorInvalidParameter;
+	try
+	{
+		countInOut = reinterpret_cast<Context*>( context )->getBuildProfiles( countInOut, profilesOut );
+	}
+	catch ( std::exception& e )
+	{
+		logError( e.what() );
+		return hiprtErrorInternal;
+	}
+	return hiprtSuccess;
+}
+
+void hiprtEnableTracing( hiprtContext context, bool enable )
+{
+	reinterpret_cast<Context*>( context )->enableTracing( enable );
+}
+
+hiprtError hiprtExportTrace( hiprtContext context, const char* filename )
+{
+	if ( !context || !filename ) return hiprtErrorInvalidParameter;
+	try
+	{
+		reinterpret_cast<Context*>( context )->exportTrace( filename );
+	}
+	catch ( std::exception& e )
+	{
+		logError( e.what() );
+		return hiprtErrorInternal;
+	}
+	return hiprtSuccess;
+}
+
 void hiprtSetLogLevel( hiprtLogLevel level ) { Logger::getInstance().setLevel( level ); }
+
+void hiprtSetLogCallback( hiprtLogCallback callback, void* userData )
+{
+	Logger::getInstance().setCallback( callback, userData );
+}
+
+hiprtError hiprtSetLogFile( const char* filename, hiprtLogFormat format )
+{
+	if ( format != hiprtLogFormatText && format != hiprtLogFormatJson ) return hiprtErrorInvalidParameter;
+	try
+	{
+		Logger::getInstance().setFile( filename, format );
+	}
+	catch ( std::exception& e )
+	{
+		logError( e.what() );
+		return hiprtErrorInternal;
+	}
+	return hiprtSuccess;
+}
+
+void hiprtFlushLog() { Logger::getInstance().flush(); }
@@ -244,8 +244,57 @@ HIPRT_DEVICE HIPRT_INLINE void GlobalStack<StackEntry, DynamicAssignment>::reset
 	m_sharedCount = 0u;
 }
 
+// per-ray counters of the statistics mode, an empty base otherwise so the traversal layout does not change
+#if defined( HIPRT_TRAVERSAL_STATISTICS )
+class alignas( 16 ) TraversalCounters
+{
+  public:
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics() const { return m_stats; }
+
+  protected:
+	HIPRT_DEVICE void resetCounters( uint32_t stackCapacity )
+	{
+		m_stats			= hiprtTraversalStatistics();
+		m_stackCapacity = stackCapacity;
+	}
+
+	HIPRT_DEVICE void countInternalNode() { m_stats.internalNodeCount++; }
+	HIPRT_DEVICE void countLeafNode() { m_stats.leafNodeCount++; }
+	HIPRT_DEVICE void countTriangleTest() { m_stats.triangleTestCount++; }
+	HIPRT_DEVICE void countCustomIntersection() { m_stats.customIntersectionCount++; }
+	HIPRT_DEVICE void countInstance() { m_stats.instanceCount++; }
+	HIPRT_DEVICE void countStackOverflow() { m_stats.stackOverflowCount++; }
+	HIPRT_DEVICE void countStackDepth( uint32_t vacancy )
+	{
+		const uint32_t depth = m_stackCapacity - vacancy;
+		if ( depth > m_stats.maxStackDepth ) m_stats.maxStackDepth = depth;
+	}
+
+  private:
+	hiprtTraversalStatistics m_stats;
+	uint32_t				 m_stackCapacity;
+};
+HIPRT_STATIC_ASSERT( sizeof( TraversalCounters ) == SizeTraversalStatistics );
+#else
+class TraversalCounters
+{
+  public:
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics() const { return hiprtTraversalStatistics(); }
+
+  protected:
+	HIPRT_DEVICE void resetCounters( uint32_t stackCapacity ) {}
+	HIPRT_DEVICE void countInternalNode() {}
+	HIPRT_DEVICE void countLeafNode() {}
+	HIPRT_DEVICE void countTriangleTest() {}
+	HIPRT_DEVICE void countCustomIntersection() {}
+	HIPRT_DEVICE void countInstance() {}
+	HIPRT_DEVICE void countStackOverflow() {}
+	HIPRT_DEVICE void countStackDepth( uint32_t vacancy ) {}
+};
+#endif
+
 template <typename Stack>
-class TraversalBase
+class TraversalBase : public TraversalCounters
 {
   public:
 	HIPRT_DEVICE TraversalBase(
@@ -367,14 +416,17 @@ TraversalBase<Stack>::testInternalNode( const hiprtRay& ray, const float3& invD,
 		float4{ invD.x, invD.y, invD.z, 0.0f }.data,
 		m_descriptor.data );
 #endif
+	this->countInternalNode();
 	if ( m_stack.vacancy() < 3 )
 	{
+		this->countStackOverflow();
 		m_state = hiprtTraversalStateStackOverflow;
 		return true;
 	}
 	if ( result[3] != InvalidValue ) m_stack.push( result[3] );
 	if ( result[2] != InvalidValue ) m_stack.push( result[2] );
 	if ( result[1] != InvalidValue ) m_stack.push( result[1] );
+	this->countStackDepth( m_stack.vacancy() );
 	if ( result[0] != InvalidValue )
 	{
 		nodeIndex = result[0];
@@ -387,6 +439,7 @@ template <typename Stack>
 HIPRT_DEVICE bool TraversalBase<Stack>::testTriangleNode(
 	const hiprtRay& ray, const float3& invD, const TriangleNode& node, TriangleNode* nodes, uint32_t leafIndex, hiprtHit& hit )
 {
+	this->countTriangleTest();
 	bool hasHit = false;
 #if !defined( __USE_HWI__ )
 	hasHit = node.m_triPair.fetchTriangle( leafIndex & 1 )
@@ -469,12 +522,14 @@ HIPRT_DEVICE GeomTraversal<Stack, PrimitiveNode, TraversalType>::GeomTraversal(
 	m_primNodes			   = reinterpret_cast<PrimitiveNode*>( geomHeader->m_primNodes );
 	m_geomType			   = geomHeader->m_geomType;
 	m_stack.reset();
+	this->resetCounters( m_stack.vacancy() );
 }
 
 template <typename Stack, typename PrimitiveNode, hiprtTraversalType TraversalType>
 HIPRT_DEVICE bool GeomTraversal<Stack, PrimitiveNode, TraversalType>::testLeafNode(
 	const hiprtRay& ray, const float3& invD, uint32_t& leafIndex, hiprtHit& hit )
 {
+	this->countLeafNode();
 	uint32_t leafAddr = getNodeAddr( leafIndex );
 	bool	 hasHit	  = false;
 	if constexpr ( is_same<PrimitiveNode, TriangleNode>::value )
@@ -511,9 +566,13 @@ HIPRT_DEVICE bool GeomTraversal<Stack, PrimitiveNode, TraversalType>::testLeafNo
 	}
 	else
 	{
-		hit.primID = m_primNodes[leafAddr].m_primIndex;
-		hasHit	   = intersectFunc( m_geomType >> 1, m_rayType, m_tableHeader, ray, m_payload, hit );
+		// multi-primitive leaves are processed one primitive at a time
+		const CustomNode node = m_primNodes[leafAddr];
+		hit.primID			  = node.getPrimIndex();
+		this->countCustomIntersection();
+		hasHit = intersectFunc( m_geomType >> 1, m_rayType, m_tableHeader, ray, m_payload, hit );
 		if ( !hasHit ) hit.primID = InvalidValue;
+		leafIndex = node.hasNext() ? encodeNodeIndex( leafAddr + 1, CustomType ) : InvalidValue;
 	}
 	return hasHit;
 }
@@ -563,7 +622,10 @@ HIPRT_DEVICE hiprtHit GeomTraversal<Stack, PrimitiveNode, TraversalType>::getNex
 				{
 					if constexpr ( TraversalType == hiprtTraversalTerminateAtAnyHit )
 					{
-						if ( getNodeType( m_leafIndex ) >= TriangleType1 ) m_leafIndex = InvalidValue;
+						if constexpr ( is_same<PrimitiveNode, TriangleNode>::value )
+						{
+							if ( getNodeType( m_leafIndex ) >= TriangleType1 ) m_leafIndex = InvalidValue;
+						}
 						m_state = hiprtTraversalStateHit;
 						return hit;
 					}
@@ -575,8 +637,8 @@ HIPRT_DEVICE hiprtHit GeomTraversal<Stack, PrimitiveNode, TraversalType>::getNex
 				}
 			}
 
-			m_leafIndex = InvalidValue;
-			if ( isLeafNode( m_nodeIndex ) )
+			if constexpr ( is_same<PrimitiveNode, TriangleNode>::value ) m_leafIndex = InvalidValue;
+			if ( m_leafIndex == InvalidValue && isLeafNode( m_nodeIndex ) )
 			{
 				m_leafIndex = m_nodeIndex;
 				m_nodeIndex = m_stack.pop();
@@ -674,11 +736,12 @@ HIPRT_DEVICE SceneTraversal<Stack, InstanceStack, TraversalType>::SceneTraversal
 	: TraversalBase<Stack>( ray, stack, hint, payload, funcTable, rayType ), m_time( time ), m_mask( mask ),
 	  m_instanceStack( instanceStack ), m_level( 0u )
 {
-	SceneHeader* sceneHeader = reinterpret_cast<SceneHeader*>( scene );
+	SceneHeader* sceneHeader = reinterpret_cast<SceneHeader*>( scene )->getTimeSegment( time );
 	m_boxNodes				 = sceneHeader->m_boxNodes;
 	m_instanceNodes			 = sceneHeader->m_primNodes;
 	m_frames				 = sceneHeader->m_frames;
 	m_stack.reset();
+	this->resetCounters( m_stack.vacancy() );
 	m_instanceIndex = InvalidValue;
 	instanceId()	= InvalidValue;
 	if constexpr ( !is_same<InstanceStack, hiprtEmptyInstanceStack>::value )
@@ -719,6 +782,7 @@ template <typename Stack, typename InstanceStack, hiprtTraversalType TraversalTy
 HIPRT_DEVICE bool SceneTraversal<Stack, InstanceStack, TraversalType>::testLeafNode(
 	void* primNodes, const hiprtRay& ray, const float3& invD, uint32_t& leafIndex, uint32_t geomType, hiprtHit& hit )
 {
+	this->countLeafNode();
 	bool	 hasHit	  = false;
 	uint32_t leafAddr = getNodeAddr( leafIndex );
 	if constexpr ( !is_same<InstanceStack, hiprtEmptyInstanceStack>::value )
@@ -772,10 +836,12 @@ HIPRT_DEVICE bool SceneTraversal<Stack, InstanceStack, TraversalType>::testLeafN
 	}
 	else
 	{
-		CustomNode* nodes = reinterpret_cast<CustomNode*>( primNodes );
-		hit.primID		  = nodes[leafAddr].m_primIndex;
-		hasHit			  = intersectFunc( geomType >> 1, m_rayType, m_tableHeader, ray, m_payload, hit );
+		const CustomNode node = reinterpret_cast<CustomNode*>( primNodes )[leafAddr];
+		hit.primID			  = node.getPrimIndex();
+		this->countCustomIntersection();
+		hasHit = intersectFunc( geomType >> 1, m_rayType, m_tableHeader, ray, m_payload, hit );
 		if ( !hasHit ) hit.primID = InvalidValue;
+		leafIndex = node.hasNext() ? encodeNodeIndex( leafAddr + 1, CustomType ) : InvalidValue;
 	}
 
 	return hasHit;
@@ -826,7 +892,7 @@ HIPRT_DEVICE hiprtHit SceneTraversal<Stack, InstanceStack, TraversalType>::getNe
 						if constexpr ( TraversalType == hiprtTraversalTerminateAtAnyHit )
 						{
 							m_state = hiprtTraversalStateHit;
-							if ( getNodeType( m_nodeIndex ) >= TriangleType1 )
+							if ( ( geomType & 1 ) ? getNodeType( m_nodeIndex ) >= TriangleType1 : m_nodeIndex == InvalidValue )
 							{
 								m_nodeIndex = m_stack.pop();
 
@@ -859,6 +925,9 @@ HIPRT_DEVICE hiprtHit SceneTraversal<Stack, InstanceStack, TraversalType>::getNe
 						}
 					}
 				}
+
+				// continue with the next primitive of a multi-primitive leaf
+				if ( !( geomType & 1 ) && m_nodeIndex != InvalidValue ) continue;
 			}
 			else
 			{
@@ -867,12 +936,15 @@ HIPRT_DEVICE hiprtHit SceneTraversal<Stack, InstanceStack, TraversalType>::getNe
 				{
 					if ( m_stack.vacancy() < 1 )
 					{
+						this->countStackOverflow();
 						m_state = hiprtTraversalStateStackOverflow;
 						continue;
 					}
 
 					m_nodeIndex = RootIndex;
 					m_stack.push( InvalidValue );
+					this->countStackDepth( m_stack.vacancy() );
+					this->countInstance();
 
 					m_instanceIndex = newInstanceIndex;
 					instanceId()	= m_instanceNodes[newInstanceIndex].m_primIndex;
@@ -883,7 +955,7 @@ HIPRT_DEVICE hiprtHit SceneTraversal<Stack, InstanceStack, TraversalType>::getNe
 						{
 							m_instanceStack.push( { m_ray, reinterpret_cast<hiprtScene>( m_scene ) } );
 							m_ray	= ray;
-							m_scene = m_instanceNodes[m_instanceIndex].m_scene;
+							m_scene = m_instanceNodes[m_instanceIndex].m_scene->getTimeSegment( m_time );
 							m_level++;
 							instanceId() = InvalidValue;
 
@@ -952,6 +1024,8 @@ class GeomTraversalPrivateStack
 
 	HIPRT_DEVICE hiprtTraversalState getCurrentState() { return m_traversal.getCurrentState(); }
 
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics() { return m_traversal.getStatistics(); }
+
   private:
 	Stack											   m_stack;
 	GeomTraversal<Stack, PrimitiveNode, TraversalType> m_traversal;
@@ -981,6 +1055,8 @@ class SceneTraversalPrivateStack
 
 	HIPRT_DEVICE hiprtTraversalState getCurrentState() { return m_traversal.getCurrentState(); }
 
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics() { return m_traversal.getStatistics(); }
+
   private:
 	Stack												m_stack;
 	InstanceStack										m_instanceStack;
@@ -1043,6 +1119,8 @@ class hiprtGeomTraversal_impl
 
 	HIPRT_DEVICE hiprtTraversalState getCurrentState() { return m_traversal.getCurrentState(); }
 
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics() { return m_traversal.getStatistics(); }
+
   private:
 	typedef typename hiprt::conditional<PrimitiveNodeType == hiprtTriangleNode, hiprt::TriangleNode, hiprt::CustomNode>::type
 															  NodeType;
@@ -1070,6 +1148,8 @@ class hiprtSceneTraversal_impl
 
 	HIPRT_DEVICE hiprtTraversalState getCurrentState() { return m_traversal.getCurrentState(); }
 
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics() { return m_traversal.getStatistics(); }
+
   private:
 	hiprt::SceneTraversalPrivateStack<TraversalType> m_traversal;
 };
@@ -1094,6 +1174,8 @@ class hiprtGeomTraversalCustomStack_impl
 
 	HIPRT_DEVICE hiprtTraversalState getCurrentState() { return m_traversal.getCurrentState(); }
 
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics() { return m_traversal.getStatistics(); }
+
   private:
 	typedef typename hiprt::conditional<PrimitiveNodeType == hiprtTriangleNode, hiprt::TriangleNode, hiprt::CustomNode>::type
 															  NodeType;
@@ -1123,6 +1205,8 @@ class hiprtSceneTraversalCustomStack_impl
 
 	HIPRT_DEVICE hiprtTraversalState getCurrentState() { return m_traversal.getCurrentState(); }
 
+	HIPRT_DEVICE hiprtTraversalStatistics getStatistics() { return m_traversal.getStatistics(); }
+
   private:
 	hiprt::SceneTraversal<hiprtStack, hiprtInstanceStack, TraversalType> m_traversal;
 };
@@ -1253,6 +1337,8 @@ HIPRT_DEVICE hiprtHit hiprtGeomTraversalClosest::getNextHit() { return m_impl->g
 
 HIPRT_DEVICE hiprtTraversalState hiprtGeomTraversalClosest::getCurrentState() { return m_impl->getCurrentState(); }
 
+HIPRT_DEVICE hiprtTraversalStatistics hiprtGeomTraversalClosest::getStatistics() { return m_impl->getStatistics(); }
+
 // hiprtGeomTraversalAnyHit
 HIPRT_DEVICE hiprtGeomTraversalAnyHit::hiprtGeomTraversalAnyHit(
 	hiprtGeometry	   geom,
@@ -1269,6 +1355,8 @@ HIPRT_DEVICE hiprtHit hiprtGeomTraversalAnyHit::getNextHit() { return m_impl->ge
 
 HIPRT_DEVICE hiprtTraversalState hiprtGeomTraversalAnyHit::getCurrentState() { return m_impl->getCurrentState(); }
 
+HIPRT_DEVICE hiprtTraversalStatistics hiprtGeomTraversalAnyHit::getStatistics() { return m_impl->getStatistics(); }
+
 // hiprtGeomCustomTraversalClosest
 HIPRT_DEVICE hiprtGeomCustomTraversalClosest::hiprtGeomCustomTraversalClosest(
 	hiprtGeometry	   geom,
@@ -1285,6 +1373,8 @@ HIPRT_DEVICE hiprtHit hiprtGeomCustomTraversalClosest::getNextHit() { return m_i
 
 HIPRT_DEVICE hiprtTraversalState hiprtGeomCustomTraversalClosest::getCurrentState() { return m_impl->getCurrentState(); }
 
+HIPRT_DEVICE hiprtTraversalStatistics hiprtGeomCustomTraversalClosest::getStatistics() { return m_impl->getStatistics(); }
+
 // hiprtGeomCustomTraversalAnyHit
 HIPRT_DEVICE hiprtGeomCustomTraversalAnyHit::hiprtGeomCustomTraversalAnyHit(
 	hiprtGeometry	   geom,
@@ -1301,6 +1391,8 @@ HIPRT_DEVICE hiprtHit hiprtGeomCustomTraversalAnyHit::getNextHit() { return m_im
 
 HIPRT_DEVICE hiprtTraversalState hiprtGeomCustomTraversalAnyHit::getCurrentState() { return m_impl->getCurrentState(); }
 
+HIPRT_DEVICE hiprtTraversalStatistics hiprtGeomCustomTraversalAnyHit::getStatistics() { return m_impl->getStatistics(); }
+
 // hiprtSceneTraversalClosest
 HIPRT_DEVICE hiprtSceneTraversalClosest::hiprtSceneTraversalClosest(
 	hiprtScene		   scene,
@@ -1319,6 +1411,8 @@ HIPRT_DEVICE hiprtHit hiprtSceneTraversalClosest::getNextHit() { return m_impl->
 
 HIPRT_DEVICE hiprtTraversalState hiprtSceneTraversalClosest::getCurrentState() { return m_impl->getCurrentState(); }
 
+HIPRT_DEVICE hiprtTraversalStatistics hiprtSceneTraversalClosest::getStatistics() { return m_impl->getStatistics(); }
+
 // hiprtSceneTraversalAnyHit
 HIPRT_DEVICE hiprtSceneTraversalAnyHit::hiprtSceneTraversalAnyHit(
 	hiprtScene		   scene,
@@ -1337,6 +1431,8 @@ HIPRT_DEVICE hiprtHit hiprtSceneTraversalAnyHit::getNextHit() { return m_impl->g
 
 HIPRT_DEVICE hiprtTraversalState hiprtSceneTraversalAnyHit::getCurrentState() { return m_impl->getCurrentState(); }
 
+HIPRT_DEVICE hiprtTraversalStatistics hiprtSceneTraversalAnyHit::getStatistics() { return m_impl->getStatistics(); }
+
 // hiprtGeomTraversalClosestCustomStack
 template <typename hiprtStack>
 HIPRT_DEVICE hiprtGeomTraversalClosestCustomStack<hiprtStack>::hiprtGeomTraversalClosestCustomStack(
@@ -1363,6 +1459,12 @@ HIPRT_DEVICE hiprtTraversalState hiprtGeomTraversalClosestCustomStack<hiprtStack
 	return m_impl->getCurrentState();
 }
 
+template <typename hiprtStack>
+HIPRT_DEVICE hiprtTraversalStatistics hiprtGeomTraversalClosestCustomStack<hiprtStack>::getStatistics()
+{
+	return m_impl->getStatistics();
+}
+
 // hiprtGeomTraversalAnyHitCustomStack
 template <typename hiprtStack>
 HIPRT_DEVICE hiprtGeomTraversalAnyHitCustomStack<hiprtStack>::hiprtGeomTraversalAnyHitCustomStack(
@@ -1389,6 +1491,12 @@ HIPRT_DEVICE hiprtTraversalState hiprtGeomTraversalAnyHitCustomStack<hiprtStack>
 	return m_impl->getCurrentState();
 }
 
+template <typename hiprtStack>
+HIPRT_DEVICE hiprtTraversalStatistics hiprtGeomTraversalAnyHitCustomStack<hiprtStack>::getStatistics()
+{
+	return m_impl->getStatistics();
+}
+
 // hiprtGeomCustomTraversalClosestCustomStack
 template <typename hiprtStack>
 HIPRT_DEVICE hiprtGeomCustomTraversalClosestCustomStack<hiprtStack>::hiprtGeomCustomTraversalClosestCustomStack(
@@ -1415,6 +1523,12 @@ HIPRT_DEVICE hiprtTraversalState hiprtGeomCustomTraversalClosestCustomStack<hipr
 	return m_impl->getCurrentState();
 }
 
+template <typename hiprtStack>
+HIPRT_DEVICE hiprtTraversalStatistics hiprtGeomCustomTraversalClosestCustomStack<hiprtStack>::getStatistics()
+{
+	return m_impl->getStatistics();
+}
+
 // hiprtGeomCustomTraversalAnyHitCustomStack
 template <typename hiprtStack>
 HIPRT_DEVICE hiprtGeomCustomTraversalAnyHitCustomStack<hiprtStack>::hiprtGeomCustomTraversalAnyHitCustomStack(
@@ -1441,6 +1555,12 @@ HIPRT_DEVICE hiprtTraversalState hiprtGeomCustomTraversalAnyHitCustomStack<hiprt
 	return m_impl->getCurrentState();
 }
 
+template <typename hiprtStack>
+HIPRT_DEVICE hiprtTraversalStatistics hiprtGeomCustomTraversalAnyHitCustomStack<hiprtStack>::getStatistics()
+{
+	return m_impl->getStatistics();
+}
+
 // hiprtSceneTraversalClosestCustomStack
 template <typename hiprtStack, typename hiprtInstanceStack>
 HIPRT_DEVICE hiprtSceneTraversalClosestCustomStack<hiprtStack, hiprtInstanceStack>::hiprtSceneTraversalClosestCustomStack(
@@ -1471,6 +1591,12 @@ HIPRT_DEVICE hiprtTraversalState hiprtSceneTraversalClosestCustomStack<hiprtStac
 	return m_impl->getCurrentState();
 }
 
+template <typename hiprtStack, typename hiprtInstanceStack>
+HIPRT_DEVICE hiprtTraversalStatistics hiprtSceneTraversalClosestCustomStack<hiprtStack, hiprtInstanceStack>::getStatistics()
+{
+	return m_impl->getStatistics();
+}
+
 // hiprtSceneTraversalAnyHitCustomStack
 template <typename hiprtStack, typename hiprtInstanceStack>
 HIPRT_DEVICE hiprtSceneTraversalAnyHitCustomStack<hiprtStack, hiprtInstanceStack>::hiprtSceneTraversalAnyHitCustomStack(
@@ -1500,6 +1626,12 @@ HIPRT_DEVICE hiprtTraversalState hiprtSceneTraversalAnyHitCustomStack<hiprtStack
 	return m_impl->getCurrentState();
 }
 
+template <typename hiprtStack, typename hiprtInstanceStack>
+HIPRT_DEVICE hiprtTraversalStatistics hiprtSceneTraversalAnyHitCustomStack<hiprtStack, hiprtInstanceStack>::getStatistics()
+{
+	return m_impl->getStatistics();
+}
+
 // transformation getters
 HIPRT_DEVICE hiprtFrameSRT hiprtGetObjectToWorldFrameSRT( hiprtScene scene, uint32_t instanceID, float time )
 {
@@ -24,6 +24,16 @@ newoption {
     description = "Don't build unit tests",
 }
 
+newoption {
+    trigger = "noTools",
+    description = "Don't build command line tools",
+}
+
+newoption {
+    trigger = "noBenchmarks",
+    description = "Don't build benchmarks",
+}
+
 newoption {
     trigger = "noEncrypt",
     description = "Don't encrypt kernel source and binaries",
@@ -390,6 +400,93 @@ workspace "hiprt"
 
 	end
 
+	if not _OPTIONS["noTools"] then
+		project( "hiprtcache" )
+			cppdialect "C++17"
+			kind "ConsoleApp"
+			if os.ishost("windows") then
+				links{ "version" }
+			end
+			externalincludedirs {"./"}
+			links { HIPRT_NAME }
+
+			if os.ishost("linux") then
+				links { "pthread", "dl" }
+			end
+			files { "tools/hiprtCache/*.cpp" }
+			externalincludedirs { "./contrib/Orochi/" }
+			files {"contrib/Orochi/Orochi/**.h", "contrib/Orochi/Orochi/**.cpp"}
+			files {"contrib/Orochi/contrib/cuew/**.h", "contrib/Orochi/contrib/cuew/**.cpp"}
+			files {"contrib/Orochi/contrib/hipew/**.h", "contrib/Orochi/contrib/hipew/**.cpp"}
+
+		project( "hiprtprewarm" )
+			cppdialect "C++17"
+			kind "ConsoleApp"
+			if os.ishost("windows") then
+				links{ "version" }
+			end
+			externalincludedirs {"./"}
+			links { HIPRT_NAME }
+
+			if os.ishost("linux") then
+				links { "pthread", "dl" }
+			end
+			files { "tools/hiprtPrewarm/*.cpp" }
+			externalincludedirs { "./contrib/Orochi/" }
+			files {"contrib/Orochi/Orochi/**.h", "contrib/Orochi/Orochi/**.cpp"}
+			files {"contrib/Orochi/contrib/cuew/**.h", "contrib/Orochi/contrib/cuew/**.cpp"}
+			files {"contrib/Orochi/contrib/hipew/**.h", "contrib/Orochi/contrib/hipew/**.cpp"}
+
+		project( "hiprtheatmap" )
+			cppdialect "C++17"
+			kind "ConsoleApp"
+			if os.ishost("windows") then
+				links{ "version" }
+			end
+			externalincludedirs {"./"}
+			links { HIPRT_NAME }
+
+			if os.ishost("linux") then
+				links { "pthread", "dl" }
+			end
+			files { "tools/hiprtHeatmap/*.cpp" }
+			externalincludedirs { "./contrib/Orochi/" }
+			files {"contrib/Orochi/Orochi/**.h", "contrib/Orochi/Orochi/**.cpp"}
+			files {"contrib/Orochi/contrib/cuew/**.h", "contrib/Orochi/contrib/cuew/**.cpp"}
+			files {"contrib/Orochi/contrib/hipew/**.h", "contrib/Orochi/contrib/hipew/**.cpp"}
+	end
+
+	if not _OPTIONS["noBenchmarks"] then
+		project( "hiprtbench" )
+			cppdialect "C++17"
+			kind "ConsoleApp"
+			if os.ishost("windows") then
+				links{ "version" }
+			end
+			externalincludedirs {"./"}
+			links { HIPRT_NAME }
+
+			if os.ishost("linux") then
+				links { "pthread", "dl" }
+			end
+			files { "test/benchmarks/*.h", "test/benchmarks/*.cpp" }
+			externalincludedirs { "./contrib/Orochi/" }
+			files {"contrib/Orochi/Orochi/**.h", "contrib/Orochi/Orochi/**.cpp"}
+			files {"contrib/Orochi/contrib/cuew/**.h", "contrib/Orochi/contrib/cuew/**.cpp"}
+			files {"contrib/Orochi/contrib/hipew/**.h", "contrib/Orochi/contrib/hipew/**.cpp"}
+
+			externalincludedirs { "contrib/embree/include/" }
+			if os.istarget("windows") then
+				libdirs{"contrib/embree/win/"}
+				copydir( "./contrib/embree/win", "./dist/bin/Release/", "*.dll" )
+				copydir( "./contrib/embree/win", "./dist/bin/Debug/", "*.dll" )
+			end
+			if os.istarget("linux") then
+				libdirs{"contrib/embree/linux/"}
+			end
+			links{ "embree4", "tbb" }
+	end
+
 	if _OPTIONS["hiprtew"] then
 		 project( "hiprtewtest" )
 				 kind "ConsoleApp"
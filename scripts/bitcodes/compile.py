@@ -47,6 +47,9 @@ def getVersion():
 
 hiprt_ver = getVersion()
 
+# each builder is also compiled separately so that only the kernels of the used builders are loaded
+builders = ['BvhBuilderKernels', 'LbvhBuilderKernels', 'PlocBuilderKernels', 'SbvhBuilderKernels', 'BatchBuilderKernels', 'BvhImporterKernels']
+
 def remove_trailing_slash(path):
     if path.endswith('/') or path.endswith('\\'):
         return path[:-1]
@@ -124,6 +127,11 @@ def compileAmd():
     cmd = hipccpath + ' -x hip ../../hiprt/impl/hiprt_kernels.h -O3 -std=c++17 ' + targets + ' -mllvm -amdgpu-early-inline-all=false -mllvm -amdgpu-function-calls=true --genco -I../../ -DHIPRT_BITCODE_LINKING -ffast-math -parallel-jobs=' + str(parallel_jobs) + ' -o ' + dst
     compileScript(cmd, dst)
 
+    for builder in builders:
+        dst = 'hiprt' + hiprt_ver + '_' + hip_version + '_amd_' + builder + '.hipfb'
+        cmd = hipccpath + ' -x hip ../../hiprt/impl/' + builder + '.h -O3 -std=c++17 ' + targets + ' -mllvm -amdgpu-early-inline-all=false -mllvm -amdgpu-function-calls=true --genco -I../../ -include hip/hip_runtime.h -DHIPRT_BITCODE_LINKING -ffast-math -parallel-jobs=' + str(parallel_jobs) + ' -o ' + dst
+        compileScript(cmd, dst)
+
     dst = 'oro_compiled_kernels.hipfb'
     cmd = hipccpath + ' -x hip ../../contrib/Orochi/ParallelPrimitives/RadixSortKernels.h -O3 -std=c++17 ' + targets + ' --genco -I../../contrib/Orochi/ -include hip/hip_runtime.h -DHIPRT_BITCODE_LINKING -ffast-math -parallel-jobs=' + str(parallel_jobs) + ' -o ' + dst
     compileScript(cmd, dst)
@@ -165,6 +173,11 @@ def compileNv():
     cmd = 'nvcc -x cu ../../hiprt/impl/hiprt_kernels.h -O3 ' + ccbin + '-std=c++17 -fatbin -arch=all -I../../contrib/Orochi/ -I../../ -DHIPRT_BITCODE_LINKING --use_fast_math --threads 0 -o ' + dst
     compileScript(cmd, dst)
 
+    for builder in builders:
+        dst = 'hiprt' + hiprt_ver + '_nv_' + builder + '.fatbin'
+        cmd = 'nvcc -x cu ../../hiprt/impl/' + builder + '.h -O3 ' + ccbin + '-std=c++17 -fatbin -arch=all -I../../contrib/Orochi/ -I../../ -include cuda_runtime.h -DHIPRT_BITCODE_LINKING --use_fast_math --threads 0 -o ' + dst
+        compileScript(cmd, dst)
+
     dst = 'oro_compiled_kernels.fatbin'
     cmd = 'nvcc -x cu ../../contrib/Orochi/ParallelPrimitives/RadixSortKernels.h -O3 ' + ccbin + '-std=c++17 -fatbin -arch=all -I../../contrib/Orochi/ -include cuda_runtime.h -DHIPRT_BITCODE_LINKING --use_fast_math --threads 0 -o ' + dst
     compileScript(cmd, dst)
@@ -1 +1,6 @@
 ..\dist\bin\release\unittest64.exe --width=512 --height=512 --referencePath=..\test\references\ --gtest_filter=*PerformanceTest* --gtest_output=xml:../result.xml
+if defined HIPRT_BENCHMARK_BASELINE (
+  ..\dist\bin\release\hiprtbench.exe --suite=build --json=../benchmark.json --baseline=%HIPRT_BENCHMARK_BASELINE%
+) else (
+  ..\dist\bin\release\hiprtbench.exe --suite=build --json=../benchmark.json
+)
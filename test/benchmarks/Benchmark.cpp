@@ -0,0 +1,297 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+#include <test/benchmarks/Benchmark.h>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+double median( std::vector<double> values )
+{
+	if ( values.empty() ) return 0.0;
+	const size_t mid = values.size() / 2;
+	std::nth_element( values.begin(), values.begin() + mid, values.end() );
+	if ( values.size() % 2 == 1 ) return values[mid];
+	return 0.5 * ( values[mid] + *std::max_element( values.begin(), values.begin() + mid ) );
+}
+
+std::string toJsonString( const std::string& str )
+{
+	std::string json = "\"";
+	for ( const char c : str )
+	{
+		if ( c == '"' || c == '\\' )
+		{
+			json += '\\';
+			json += c;
+		}
+		else if ( static_cast<unsigned char>( c ) < 0x20 )
+		{
+			json += ' ';
+		}
+		else
+		{
+			json += c;
+		}
+	}
+	return json + "\"";
+}
+
+// a parser of the subset of JSON written by the runner, only quotes and backslashes are escaped
+class JsonParser
+{
+  public:
+	explicit JsonParser( const std::string& text ) : m_text( text ) {}
+
+	bool parseResults( std::vector<bench::Result>& results )
+	{
+		return parseObject( [&]( const std::string& key ) {
+			if ( key != "results" ) return skipValue();
+			return parseArray( [&]() {
+				bench::Result result;
+				if ( !parseObject( [&]( const std::string& key ) { return parseResult( key, result ); } ) ) return false;
+				results.push_back( std::move( result ) );
+				return true;
+			} );
+		} );
+	}
+
+  private:
+	bool parseResult( const std::string& key, bench::Result& result )
+	{
+		if ( key == "suite" ) return parseString( result.suite );
+		if ( key == "name" ) return parseString( result.name );
+		if ( key != "metrics" ) return skipValue();
+		return parseArray( [&]() {
+			bench::Metric metric;
+			if ( !parseObject( [&]( const std::string& key ) { return parseMetric( key, metric ); } ) ) return false;
+			result.metrics.push_back( std::move( metric ) );
+			return true;
+		} );
+	}
+
+	bool parseMetric( const std::string& key, bench::Metric& metric )
+	{
+		if ( key == "name" ) return parseString( metric.name );
+		if ( key == "unit" ) return parseString( metric.unit );
+		if ( key == "lowerIsBetter" ) return parseBool( metric.lowerIsBetter );
+		if ( key != "samples" ) return skipValue();
+		return parseArray( [&]() {
+			double sample;
+			if ( !parseNumber( sample ) ) return false;
+			metric.samples.push_back( sample );
+			return true;
+		} );
+	}
+
+	template <typename Func>
+	bool parseObject( Func&& parseMember )
+	{
+		if ( !consume( '{' ) ) return false;
+		if ( consume( '}' ) ) return true;
+		do
+		{
+			std::string key;
+			if ( !parseString( key ) || !consume( ':' ) || !parseMember( key ) ) return false;
+		} while ( consume( ',' ) );
+		return consume( '}' );
+	}
+
+	template <typename Func>
+	bool parseArray( Func&& parseElement )
+	{
+		if ( !consume( '[' ) ) return false;
+		if ( consume( ']' ) ) return true;
+		do
+		{
+			if ( !parseElement() ) return false;
+		} while ( consume( ',' ) );
+		return consume( ']' );
+	}
+
+	bool parseString( std::string& str )
+	{
+		if ( !consume( '"' ) ) return false;
+		str.clear();
+		while ( m_pos < m_text.size() && m_text[m_pos] != '"' )
+		{
+			if ( m_text[m_pos] == '\\' ) m_pos++;
+			if ( m_pos < m_text.size() ) str += m_text[m_pos++];
+		}
+		return m_pos++ < m_text.size();
+	}
+
+	bool parseNumber( double& value )
+	{
+		skipWhitespace();
+		const char* begin = m_text.c_str() + m_pos;
+		char*		end	  = nullptr;
+		value			  = std::strtod( begin, &end );
+		m_pos += end - begin;
+		return end != begin;
+	}
+
+	bool parseBool( bool& value )
+	{
+		skipWhitespace();
+		value = m_text.compare( m_pos, 4, "true" ) == 0;
+		if ( !value && m_text.compare( m_pos, 5, "false" ) != 0 ) return false;
+		m_pos += value ? 4 : 5;
+		return true;
+	}
+
+	bool skipValue()
+	{
+		skipWhitespace();
+		if ( m_pos >= m_text.size() ) return false;
+
+		std::string str;
+		double		number;
+		bool		flag;
+		switch ( m_text[m_pos] )
+		{
+		case '{':
+			return parseObject( [&]( const std::string& ) { return skipValue(); } );
+		case '[':
+			return parseArray( [&]() { return skipValue(); } );
+		case '"':
+			return parseString( str );
+		case 't':
+		case 'f':
+			return parseBool( flag );
+		default:
+			return parseNumber( number );
+		}
+	}
+
+	bool consume( char c )
+	{
+		skipWhitespace();
+		if ( m_pos >= m_text.size() || m_text[m_pos] != c ) return false;
+		m_pos++;
+		return true;
+	}
+
+	void skipWhitespace()
+	{
+		while ( m_pos < m_text.size() && std::isspace( static_cast<unsigned char>( m_text[m_pos] ) ) )
+			m_pos++;
+	}
+
+	const std::string& m_text;
+	size_t			   m_pos = 0u;
+};
+} // namespace
+
+namespace bench
+{
+double Metric::median() const { return ::median( samples ); }
+
+double Metric::mad() const
+{
+	const double		m = median();
+	std::vector<double> deviations;
+	for ( const double sample : samples )
+		deviations.push_back( std::abs( sample - m ) );
+	return ::median( deviations );
+}
+
+double Metric::min() const { return samples.empty() ? 0.0 : *std::min_element( samples.begin(), samples.end() ); }
+
+BenchmarkRunner::BenchmarkRunner( const std::string& filter, uint32_t repetitions, double minTime )
+	: m_filter( filter ), m_repetitions( std::max( repetitions, 1u ) ), m_minTime( minTime )
+{
+}
+
+bool BenchmarkRunner::enabled( const std::string& name ) const
+{
+	return m_filter.empty() || name.find( m_filter ) != std::string::npos;
+}
+
+void BenchmarkRunner::addResult( Result result )
+{
+	std::cout << std::left << std::setw( 48 ) << result.suite + "/" + result.name << std::right;
+	for ( const Metric& metric : result.metrics )
+	{
+		std::cout << std::fixed << std::setprecision( metric.median() < 10.0 ? 3 : 1 ) << std::setw( 12 ) << metric.median()
+				  << " " << std::left << std::setw( 8 ) << metric.unit << std::right << "(+-" << std::setprecision( 1 )
+				  << ( metric.median() != 0.0 ? 100.0 * metric.mad() / metric.median() : 0.0 ) << "%)";
+	}
+	std::cout << std::endl;
+	m_results.push_back( std::move( result ) );
+}
+
+void BenchmarkRunner::addFailure( const std::string& name, const std::string& message )
+{
+	std::cerr << m_suite << "/" << name << ": " << message << std::endl;
+	m_failureCount++;
+}
+
+bool BenchmarkRunner::writeJson( const std::filesystem::path& path ) const
+{
+	std::ofstream file( path );
+	if ( !file ) return false;
+
+	file << std::setprecision( 9 );
+	file << "{\n\t\"repetitions\": " << m_repetitions << ",\n\t\"results\": [";
+	for ( size_t i = 0; i < m_results.size(); ++i )
+	{
+		const Result& result = m_results[i];
+		file << ( i > 0 ? "," : "" ) << "\n\t\t{\n\t\t\t\"suite\": " << toJsonString( result.suite )
+			 << ",\n\t\t\t\"name\": " << toJsonString( result.name ) << ",\n\t\t\t\"metrics\": [";
+		for ( size_t j = 0; j < result.metrics.size(); ++j )
+		{
+			const Metric& metric = result.metrics[j];
+			file << ( j > 0 ? "," : "" ) << "\n\t\t\t\t{ \"name\": " << toJsonString( metric.name )
+				 << ", \"unit\": " << toJsonString( metric.unit )
+				 << ", \"lowerIsBetter\": " << ( metric.lowerIsBetter ? "true" : "false" )
+				 << ", \"median\": " << metric.median() << ", \"mad\": " << metric.mad() << ", \"samples\": [";
+			for ( size_t k = 0; k < metric.samples.size(); ++k )
+				file << ( k > 0 ? ", " : "" ) << metric.samples[k];
+			file << "] }";
+		}
+		file << "\n\t\t\t]\n\t\t}";
+	}
+	file << "\n\t]\n}\n";
+	return static_cast<bool>( file );
+}
+
+bool readJson( const std::filesystem::path& path, std::vector<Result>& resultsOut )
+{
+	std::ifstream file( path );
+	if ( !file ) return false;
+
+	std::stringstream stream;
+	stream << file.rdbuf();
+	const std::string text = stream.str();
+	return JsonParser( text ).parseResults( resultsOut );
+}
+} // namespace bench
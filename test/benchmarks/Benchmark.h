@@ -0,0 +1,165 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+namespace bench
+{
+// keeps the compiler from dropping computations whose results are not used
+template <typename T>
+inline void doNotOptimize( const T& value )
+{
+#if defined( _MSC_VER )
+	const volatile char* data = reinterpret_cast<const volatile char*>( &value );
+	static_cast<void>( *data );
+	_ReadWriteBarrier();
+#else
+	asm volatile( "" : : "r,m"( value ) : "memory" );
+#endif
+}
+
+// one sample per repetition, the report uses the median and the median absolute deviation
+struct Metric
+{
+	std::string			name;
+	std::string			unit;
+	bool				lowerIsBetter = true;
+	std::vector<double> samples;
+
+	double median() const;
+	double mad() const;
+	double min() const;
+};
+
+struct Result
+{
+	std::string			suite;
+	std::string			name;
+	std::vector<Metric> metrics;
+};
+
+class BenchmarkRunner
+{
+  public:
+	BenchmarkRunner( const std::string& filter, uint32_t repetitions, double minTime );
+
+	void setSuite( const std::string& suite ) { m_suite = suite; }
+
+	// the benchmarks run if the filter is a substring of their name
+	bool enabled( const std::string& name ) const;
+
+	uint32_t repetitions() const { return m_repetitions; }
+
+	// seconds
+	double minTime() const { return m_minTime; }
+
+	// triangle counts of the generated scenes
+	void setSizes( const std::vector<uint32_t>& sizes ) { m_sizes = sizes; }
+
+	const std::vector<uint32_t>& sizes() const { return m_sizes; }
+
+	// meshes benchmarked in addition to the generated scenes
+	void setObjPaths( const std::vector<std::filesystem::path>& objPaths ) { m_objPaths = objPaths; }
+
+	const std::vector<std::filesystem::path>& objPaths() const { return m_objPaths; }
+
+	void setDeviceIndex( int deviceIndex ) { m_deviceIndex = deviceIndex; }
+
+	int deviceIndex() const { return m_deviceIndex; }
+
+	// times 'func', which performs 'opCount' operations per call, the calls are batched to run
+	// at least the minimum time per repetition
+	template <typename Func>
+	void measure( const std::string& name, uint64_t opCount, Func&& func );
+
+	void addResult( Result result );
+
+	// a benchmark that could not run, fails the run
+	void addFailure( const std::string& name, const std::string& message );
+
+	bool failed() const { return m_failureCount > 0u; }
+
+	const std::vector<Result>& results() const { return m_results; }
+
+	bool writeJson( const std::filesystem::path& path ) const;
+
+  private:
+	std::string			m_suite;
+	std::string			m_filter;
+	uint32_t			m_repetitions;
+	double				m_minTime;
+	std::vector<Result> m_results;
+
+	std::vector<uint32_t>				m_sizes		   = { 1u << 16, 1u << 20 };
+	std::vector<std::filesystem::path>	m_objPaths;
+	int									m_deviceIndex  = 0;
+	uint32_t							m_failureCount = 0u;
+};
+
+template <typename Func>
+void BenchmarkRunner::measure( const std::string& name, uint64_t opCount, Func&& func )
+{
+	if ( !enabled( name ) ) return;
+
+	using Clock = std::chrono::steady_clock;
+	auto timeCalls = [&]( uint64_t callCount ) {
+		const Clock::time_point begin = Clock::now();
+		for ( uint64_t i = 0; i < callCount; ++i )
+			func();
+		return std::chrono::duration<double>( Clock::now() - begin ).count();
+	};
+
+	// warms up the caches and finds the batch size
+	uint64_t callCount = 1u;
+	while ( timeCalls( callCount ) < m_minTime && callCount < ( 1ull << 40 ) )
+		callCount *= 2u;
+
+	Metric time{ "time", "ns/op", true, {} };
+	Metric throughput{ "throughput", "Mops/s", false, {} };
+	for ( uint32_t i = 0; i < m_repetitions; ++i )
+	{
+		const double nsPerOp = 1e9 * timeCalls( callCount ) / ( callCount * opCount );
+		time.samples.push_back( nsPerOp );
+		throughput.samples.push_back( 1e3 / nsPerOp );
+	}
+	addResult( { m_suite, name, { time, throughput } } );
+}
+
+// reads the results written by BenchmarkRunner::writeJson
+bool readJson( const std::filesystem::path& path, std::vector<Result>& resultsOut );
+
+// suites
+void runMicroBenchmarks( BenchmarkRunner& runner );
+void runBuildBenchmarks( BenchmarkRunner& runner );
+void runRayBenchmarks( BenchmarkRunner& runner );
+void runEmbreeValidation( BenchmarkRunner& runner );
+} // namespace bench
@@ -0,0 +1,102 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+#include <test/benchmarks/BenchmarkComparison.h>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+// the MAD of normally distributed samples times this is their standard deviation
+constexpr double MadToSigma = 1.4826;
+
+const bench::Result* findResult( const std::vector<bench::Result>& results, const bench::Result& result )
+{
+	for ( const bench::Result& r : results )
+		if ( r.suite == result.suite && r.name == result.name ) return &r;
+	return nullptr;
+}
+
+const bench::Metric* findMetric( const bench::Result& result, const std::string& name )
+{
+	for ( const bench::Metric& metric : result.metrics )
+		if ( metric.name == name ) return &metric;
+	return nullptr;
+}
+} // namespace
+
+namespace bench
+{
+uint32_t compareResults( const std::vector<Result>& baseline, const std::vector<Result>& current, const ComparisonOptions& options )
+{
+	uint32_t regressionCount  = 0u;
+	uint32_t improvementCount = 0u;
+	for ( const Result& result : current )
+	{
+		const Result* baseResult = findResult( baseline, result );
+		if ( baseResult == nullptr )
+		{
+			std::cout << result.suite << "/" << result.name << ": not in the baseline" << std::endl;
+			continue;
+		}
+
+		for ( const Metric& metric : result.metrics )
+		{
+			const Metric* baseMetric = findMetric( *baseResult, metric.name );
+			if ( baseMetric == nullptr || baseMetric->samples.empty() || metric.samples.empty() ) continue;
+
+			const double baseMedian = baseMetric->median();
+			const double delta		= metric.median() - baseMedian;
+			const double worse		= metric.lowerIsBetter ? delta : -delta;
+			const double noise =
+				options.madFactor * MadToSigma * std::sqrt( baseMetric->mad() * baseMetric->mad() + metric.mad() * metric.mad() );
+			const double allowed = std::max( options.tolerance * std::abs( baseMedian ), noise );
+
+			const char* status = "";
+			if ( worse > allowed )
+			{
+				status = "REGRESSION";
+				regressionCount++;
+			}
+			else if ( -worse > allowed )
+			{
+				status = "improvement";
+				improvementCount++;
+			}
+
+			std::cout << std::left << std::setw( 48 ) << result.suite + "/" + result.name << std::setw( 18 ) << metric.name
+					  << std::right << std::fixed << std::setprecision( 3 ) << std::setw( 12 ) << baseMedian << " -> "
+					  << std::setw( 12 ) << metric.median() << " " << std::left << std::setw( 8 ) << metric.unit << std::right
+					  << std::setprecision( 1 ) << std::setw( 8 ) << ( baseMedian != 0.0 ? 100.0 * delta / std::abs( baseMedian ) : 0.0 )
+					  << "% (allowed " << ( baseMedian != 0.0 ? 100.0 * allowed / std::abs( baseMedian ) : 0.0 ) << "%) " << status
+					  << std::endl;
+		}
+	}
+
+	std::cout << regressionCount << " regressions, " << improvementCount << " improvements" << std::endl;
+	return regressionCount;
+}
+} // namespace bench
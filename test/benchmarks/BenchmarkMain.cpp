@@ -0,0 +1,196 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+#include <contrib/argparse/argparse.h>
+#include <test/benchmarks/Benchmark.h>
+#include <test/benchmarks/BenchmarkComparison.h>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Benchmarks of HIPRT, e.g.
+//   hiprtbench                                   runs all suites
+//   hiprtbench -s micro -f Quaternion            runs the quaternion micro benchmarks
+//   hiprtbench -s micro -r 30 -j micro.json      30 repetitions, writes the samples as JSON
+//   hiprtbench -s build -z 10000,1000000         builds the generated scenes of these triangle counts
+//   hiprtbench -s rays -f anyhit                 traces the ray sets in the any-hit mode only
+//   hiprtbench -s embree -o bunny.obj -f bunny   validates the traversal of an OBJ file against Embree
+//   hiprtbench -s build -b build.json            fails if a result regressed from the baseline
+//   hiprtbench -i new.json -b old.json           compares two runs
+//
+// Suites:
+//   micro    host-device math and intersection routines, measured on the host
+//   build    builds of generated scenes with every builder on the device
+//   rays     primary, ambient occlusion, shadow, diffuse and random rays traced on the device
+//   embree   hits, SAH cost and throughput of every builder compared with Embree on the host
+
+namespace
+{
+struct Suite
+{
+	const char* name;
+	void ( *run )( bench::BenchmarkRunner& runner );
+};
+
+constexpr Suite Suites[] = {
+	{ "micro", bench::runMicroBenchmarks },
+	{ "build", bench::runBuildBenchmarks },
+	{ "rays", bench::runRayBenchmarks },
+	{ "embree", bench::runEmbreeValidation } };
+
+std::vector<std::string> split( const std::string& str )
+{
+	std::vector<std::string> items;
+	std::stringstream		 stream( str );
+	std::string				 item;
+	while ( std::getline( stream, item, ',' ) )
+		items.push_back( item );
+	return items;
+}
+
+std::vector<uint32_t> parseSizes( const std::string& str )
+{
+	std::vector<uint32_t> sizes;
+	for ( const std::string& size : split( str ) )
+		sizes.push_back( static_cast<uint32_t>( std::stoul( size ) ) );
+	return sizes;
+}
+} // namespace
+
+int main( int argc, const char* argv[] )
+{
+	using namespace argparse;
+	ArgumentParser parser( "hiprtbench", "HIPRT benchmarks" );
+	parser.add_argument().names( { "-s", "--suite" } ).description( "suite to run, all by default" ).required( false );
+	parser.add_argument()
+		.names( { "-f", "--filter" } )
+		.description( "runs the benchmarks containing the string in their name" )
+		.required( false );
+	parser.add_argument().names( { "-r", "--repetitions" } ).description( "repetitions (default 15)" ).required( false );
+	parser.add_argument()
+		.names( { "-t", "--time" } )
+		.description( "minimum time of a repetition in milliseconds (default 10)" )
+		.required( false );
+	parser.add_argument()
+		.names( { "-z", "--sizes" } )
+		.description( "comma-separated triangle counts of the generated scenes (default 65536,1048576)" )
+		.required( false );
+	parser.add_argument()
+		.names( { "-o", "--obj" } )
+		.description( "comma-separated OBJ files benchmarked in addition to the generated scenes" )
+		.required( false );
+	parser.add_argument().names( { "-d", "--device" } ).description( "device index" ).required( false );
+	parser.add_argument().names( { "-j", "--json" } ).description( "JSON file for the results" ).required( false );
+	parser.add_argument()
+		.names( { "-i", "--input" } )
+		.description( "reads the results from a JSON file instead of running the suites" )
+		.required( false );
+	parser.add_argument()
+		.names( { "-b", "--baseline" } )
+		.description( "JSON file of baseline results, fails if a metric regressed" )
+		.required( false );
+	parser.add_argument()
+		.names( { "--tolerance" } )
+		.description( "allowed regression of a median in percent (default 5)" )
+		.required( false );
+	parser.add_argument()
+		.names( { "--noise" } )
+		.description( "regressions within this many standard deviations of the samples are noise (default 3)" )
+		.required( false );
+
+	ArgumentParser::Result result = parser.parse( argc, argv );
+	if ( result )
+	{
+		std::cerr << result.what() << std::endl;
+		parser.print_help();
+		return EXIT_FAILURE;
+	}
+
+	const std::string suite		  = parser.exists( "s" ) ? parser.get<std::string>( "s" ) : "";
+	const std::string filter	  = parser.exists( "f" ) ? parser.get<std::string>( "f" ) : "";
+	const uint32_t	  repetitions = parser.exists( "r" ) ? parser.get<uint32_t>( "r" ) : 15u;
+	const double	  minTime	  = parser.exists( "t" ) ? parser.get<double>( "t" ) * 1e-3 : 10e-3;
+
+	bench::BenchmarkRunner runner( filter, repetitions, minTime );
+	if ( parser.exists( "z" ) ) runner.setSizes( parseSizes( parser.get<std::string>( "z" ) ) );
+	if ( parser.exists( "o" ) )
+	{
+		const std::vector<std::string> paths = split( parser.get<std::string>( "o" ) );
+		runner.setObjPaths( { paths.begin(), paths.end() } );
+	}
+	if ( parser.exists( "d" ) ) runner.setDeviceIndex( parser.get<int>( "d" ) );
+
+	if ( parser.exists( "i" ) )
+	{
+		std::vector<bench::Result> results;
+		if ( !bench::readJson( parser.get<std::string>( "i" ), results ) )
+		{
+			std::cerr << "Unable to read '" << parser.get<std::string>( "i" ) << "'" << std::endl;
+			return EXIT_FAILURE;
+		}
+		for ( bench::Result& r : results )
+			runner.addResult( std::move( r ) );
+	}
+	else
+	{
+		bool found = false;
+		for ( const Suite& s : Suites )
+		{
+			if ( !suite.empty() && suite != s.name ) continue;
+			found = true;
+			runner.setSuite( s.name );
+			s.run( runner );
+		}
+
+		if ( !found )
+		{
+			std::cerr << "Unknown suite '" << suite << "'" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	if ( parser.exists( "j" ) && !runner.writeJson( parser.get<std::string>( "j" ) ) )
+	{
+		std::cerr << "Unable to write '" << parser.get<std::string>( "j" ) << "'" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if ( parser.exists( "b" ) )
+	{
+		std::vector<bench::Result> baseline;
+		if ( !bench::readJson( parser.get<std::string>( "b" ), baseline ) )
+		{
+			std::cerr << "Unable to read '" << parser.get<std::string>( "b" ) << "'" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		bench::ComparisonOptions options;
+		if ( parser.exists( "tolerance" ) ) options.tolerance = parser.get<double>( "tolerance" ) * 1e-2;
+		if ( parser.exists( "noise" ) ) options.madFactor = parser.get<double>( "noise" );
+		if ( bench::compareResults( baseline, runner.results(), options ) > 0u ) return EXIT_FAILURE;
+	}
+	return runner.failed() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
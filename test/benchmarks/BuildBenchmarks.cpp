@@ -0,0 +1,152 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+#include <test/benchmarks/Benchmark.h>
+#include <test/benchmarks/DeviceScene.h>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+
+// Builds the generated scenes and the OBJ files with every builder and reports the build time and
+// throughput, the memory of the hierarchies and their SAH cost. The builders run on the device, the
+// suite is skipped without one.
+
+namespace
+{
+struct Builder
+{
+	const char*		name;
+	hiprtBuildFlags flags;
+};
+
+constexpr Builder Builders[] = {
+	{ "fast", hiprtBuildFlagBitPreferFastBuild },
+	{ "balanced", hiprtBuildFlagBitPreferBalancedBuild },
+	{ "high", hiprtBuildFlagBitPreferHighQualityBuild } };
+
+bench::Metric constant( const std::string& name, const std::string& unit, double value )
+{
+	return { name, unit, true, { value } };
+}
+
+void checkHiprt( hiprtError error )
+{
+	if ( error != hiprtSuccess ) throw std::runtime_error( "failed with error " + std::to_string( error ) );
+}
+
+bench::Result benchmarkBuild(
+	bench::BenchmarkRunner& runner, hiprtContext context, const bench::Scene& scene, const Builder& builder, const std::string& name )
+{
+	using Clock = std::chrono::steady_clock;
+
+	bench::DeviceScene deviceScene( context, scene, builder.flags );
+
+	// the first build also compiles the kernels
+	deviceScene.build();
+	oroDeviceSynchronize();
+
+	uint64_t primCount = scene.uniqueTriangleCount();
+	for ( const std::vector<bench::Instance>& level : scene.levels )
+		primCount += level.size();
+
+	bench::Metric time{ "buildTime", "ms", true, {} };
+	bench::Metric throughput{ "buildThroughput", "Mprims/s", false, {} };
+	for ( uint32_t i = 0; i < runner.repetitions(); ++i )
+	{
+		const Clock::time_point begin = Clock::now();
+		deviceScene.build();
+		oroDeviceSynchronize();
+		const double seconds = std::chrono::duration<double>( Clock::now() - begin ).count();
+		time.samples.push_back( 1e3 * seconds );
+		throughput.samples.push_back( 1e-6 * primCount / seconds );
+	}
+
+	// the SAH cost of the meshes is weighted by their triangle count
+	uint64_t memorySize = 0u;
+	double	 sahCost	= 0.0;
+	for ( size_t i = 0; i < deviceScene.geometries().size(); ++i )
+	{
+		hiprtBvhStatistics stats;
+		checkHiprt( hiprtGetGeometryStatistics( context, deviceScene.geometries()[i], stats ) );
+		memorySize += stats.memorySize;
+		sahCost += static_cast<double>( stats.sahCost ) * scene.meshes[i].triangleCount() / scene.uniqueTriangleCount();
+	}
+
+	std::optional<double> topLevelSahCost;
+	for ( const hiprtScene hiprtScene : deviceScene.scenes() )
+	{
+		hiprtBvhStatistics stats;
+		checkHiprt( hiprtGetSceneStatistics( context, hiprtScene, stats ) );
+		memorySize += stats.memorySize;
+		topLevelSahCost = stats.sahCost;
+	}
+
+	bench::Result result{ "build", name, { time, throughput } };
+	result.metrics.push_back( constant( "memory", "MB", memorySize / ( 1024.0 * 1024.0 ) ) );
+	result.metrics.push_back( constant( "temporaryMemory", "MB", deviceScene.temporaryMemorySize() / ( 1024.0 * 1024.0 ) ) );
+	result.metrics.push_back( constant( "sahCost", "", sahCost ) );
+	if ( topLevelSahCost ) result.metrics.push_back( constant( "topLevelSahCost", "", *topLevelSahCost ) );
+	return result;
+}
+} // namespace
+
+namespace bench
+{
+void runBuildBenchmarks( BenchmarkRunner& runner )
+{
+	Device device( runner.deviceIndex() );
+	if ( !device.valid() )
+	{
+		std::cout << "build: no device " << runner.deviceIndex() << ", skipped" << std::endl;
+		return;
+	}
+	std::cout << "build: " << device.name() << std::endl;
+
+	for ( const SceneSource& source : getSceneSources( runner.sizes(), runner.objPaths() ) )
+	{
+		std::optional<Scene> scene;
+		for ( const Builder& builder : Builders )
+		{
+			const std::string name = source.name + "/" + builder.name;
+			if ( !runner.enabled( name ) ) continue;
+
+			try
+			{
+				if ( !scene )
+				{
+					scene = source.create();
+					std::cout << source.name << ": " << scene->uniqueTriangleCount() << " unique triangles, "
+							  << scene->instancedTriangleCount() << " instanced triangles" << std::endl;
+				}
+				runner.addResult( benchmarkBuild( runner, device.context(), *scene, builder, name ) );
+			}
+			catch ( const std::exception& e )
+			{
+				runner.addFailure( name, e.what() );
+			}
+		}
+	}
+}
+} // namespace bench
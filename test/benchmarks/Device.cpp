@@ -0,0 +1,83 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+#include <hiprt/hiprt.h>
+#include <hiprt/hiprt_libpath.h>
+#include <test/benchmarks/Device.h>
+#include <utility>
+
+namespace bench
+{
+Device::Device( int deviceIndex )
+{
+	oroInitialize( (oroApi)( ORO_API_HIP | ORO_API_CUDA ), 0, g_hip_paths, g_hiprtc_paths );
+
+	oroDevice oroDevice;
+	if ( oroInit( 0 ) != oroSuccess || oroDeviceGet( &oroDevice, deviceIndex ) != oroSuccess ||
+		 oroCtxCreate( &m_oroCtx, 0, oroDevice ) != oroSuccess )
+		return;
+
+	oroDeviceProp props;
+	oroGetDeviceProperties( &props, oroDevice );
+	m_name = props.name;
+
+	hiprtContextCreationInput ctxtInput;
+	ctxtInput.deviceType = m_name.find( "NVIDIA" ) != std::string::npos ? hiprtDeviceNVIDIA : hiprtDeviceAMD;
+	ctxtInput.ctxt		 = oroGetRawCtx( m_oroCtx );
+	ctxtInput.device	 = oroGetRawDevice( oroDevice );
+	if ( hiprtCreateContext( HIPRT_API_VERSION, ctxtInput, m_context ) != hiprtSuccess ) m_context = nullptr;
+}
+
+Device::~Device()
+{
+	if ( m_context != nullptr ) hiprtDestroyContext( m_context );
+	if ( m_oroCtx != nullptr ) oroCtxDestroy( m_oroCtx );
+}
+
+DeviceBuffer::DeviceBuffer( size_t size ) : m_size( size )
+{
+	if ( m_size > 0u && oroMalloc( &m_ptr, m_size ) != oroSuccess )
+	{
+		m_ptr  = nullptr;
+		m_size = 0u;
+	}
+}
+
+DeviceBuffer::~DeviceBuffer()
+{
+	if ( m_ptr != nullptr ) oroFree( m_ptr );
+}
+
+DeviceBuffer::DeviceBuffer( DeviceBuffer&& other ) noexcept
+	: m_ptr( std::exchange( other.m_ptr, nullptr ) ), m_size( std::exchange( other.m_size, 0u ) )
+{
+}
+
+DeviceBuffer& DeviceBuffer::operator=( DeviceBuffer&& other ) noexcept
+{
+	std::swap( m_ptr, other.m_ptr );
+	std::swap( m_size, other.m_size );
+	return *this;
+}
+} // namespace bench
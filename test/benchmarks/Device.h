@@ -0,0 +1,89 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <hiprt/hiprt.h>
+#include <Orochi/Orochi.h>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+// the HIPRT context of the device suites, invalid if there is no device
+class Device
+{
+  public:
+	explicit Device( int deviceIndex );
+	~Device();
+
+	Device( const Device& )			   = delete;
+	Device& operator=( const Device& ) = delete;
+
+	bool valid() const { return m_context != nullptr; }
+
+	hiprtContext context() const { return m_context; }
+
+	const std::string& name() const { return m_name; }
+
+  private:
+	oroCtx		 m_oroCtx  = nullptr;
+	hiprtContext m_context = nullptr;
+	std::string	 m_name;
+};
+
+class DeviceBuffer
+{
+  public:
+	DeviceBuffer() = default;
+	explicit DeviceBuffer( size_t size );
+	~DeviceBuffer();
+
+	DeviceBuffer( DeviceBuffer&& other ) noexcept;
+	DeviceBuffer& operator=( DeviceBuffer&& other ) noexcept;
+
+	template <typename T>
+	static DeviceBuffer upload( const std::vector<T>& data )
+	{
+		DeviceBuffer buffer( data.size() * sizeof( T ) );
+		if ( !data.empty() ) oroMemcpyHtoD( buffer.m_ptr, const_cast<T*>( data.data() ), buffer.m_size );
+		return buffer;
+	}
+
+	template <typename T>
+	std::vector<T> download() const
+	{
+		std::vector<T> data( m_size / sizeof( T ) );
+		if ( !data.empty() ) oroMemcpyDtoH( data.data(), m_ptr, data.size() * sizeof( T ) );
+		return data;
+	}
+
+	hiprtDevicePtr get() const { return reinterpret_cast<hiprtDevicePtr>( m_ptr ); }
+
+	size_t size() const { return m_size; }
+
+  private:
+	oroDeviceptr m_ptr	= nullptr;
+	size_t		 m_size = 0u;
+};
+} // namespace bench
@@ -0,0 +1,144 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+#include <test/benchmarks/DeviceScene.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+void checkHiprt( hiprtError error, const char* function )
+{
+	if ( error != hiprtSuccess ) throw std::runtime_error( std::string( function ) + " failed with error " + std::to_string( error ) );
+}
+} // namespace
+
+namespace bench
+{
+DeviceScene::DeviceScene( hiprtContext context, const Scene& scene, hiprtBuildFlags buildFlags ) : m_context( context )
+{
+	m_options.buildFlags = buildFlags;
+	try
+	{
+		create( scene );
+	}
+	catch ( ... )
+	{
+		destroy();
+		throw;
+	}
+}
+
+DeviceScene::~DeviceScene() { destroy(); }
+
+void DeviceScene::create( const Scene& scene )
+{
+
+	size_t tempSize = 0u;
+	for ( const Mesh& mesh : scene.meshes )
+	{
+		m_buffers.push_back( DeviceBuffer::upload( mesh.vertices ) );
+		m_buffers.push_back( DeviceBuffer::upload( mesh.indices ) );
+
+		hiprtGeometryBuildInput input;
+		input.type									 = hiprtPrimitiveTypeTriangleMesh;
+		input.primitive.triangleMesh.vertices		 = m_buffers[m_buffers.size() - 2].get();
+		input.primitive.triangleMesh.vertexCount	 = static_cast<uint32_t>( mesh.vertices.size() );
+		input.primitive.triangleMesh.vertexStride	 = sizeof( hiprtFloat3 );
+		input.primitive.triangleMesh.triangleIndices = m_buffers.back().get();
+		input.primitive.triangleMesh.triangleCount	 = mesh.triangleCount();
+		input.primitive.triangleMesh.triangleStride	 = 3 * sizeof( uint32_t );
+		m_geometryInputs.push_back( input );
+
+		size_t size;
+		checkHiprt( hiprtGetGeometryBuildTemporaryBufferSize( m_context, input, m_options, size ), "hiprtGetGeometryBuildTemporaryBufferSize" );
+		tempSize = std::max( tempSize, size );
+
+		hiprtGeometry geometry;
+		checkHiprt( hiprtCreateGeometry( m_context, input, m_options, geometry ), "hiprtCreateGeometry" );
+		m_geometries.push_back( geometry );
+	}
+
+	for ( const std::vector<Instance>& level : scene.levels )
+	{
+		std::vector<hiprtInstance> instances;
+		std::vector<hiprtFrameSRT> frames;
+		for ( const Instance& instance : level )
+		{
+			hiprtInstance hiprtInstance;
+			hiprtInstance.type = instance.type;
+			if ( instance.type == hiprtInstanceTypeGeometry )
+				hiprtInstance.geometry = m_geometries[instance.index];
+			else
+				hiprtInstance.scene = m_scenes[instance.index];
+			instances.push_back( hiprtInstance );
+			frames.push_back( instance.frame );
+		}
+		m_buffers.push_back( DeviceBuffer::upload( instances ) );
+		m_buffers.push_back( DeviceBuffer::upload( frames ) );
+
+		hiprtSceneBuildInput input;
+		input.instances				   = m_buffers[m_buffers.size() - 2].get();
+		input.instanceTransformHeaders = nullptr;
+		input.instanceFrames		   = m_buffers.back().get();
+		input.instanceMasks			   = nullptr;
+		input.instanceCount			   = static_cast<uint32_t>( level.size() );
+		input.frameCount			   = static_cast<uint32_t>( level.size() );
+		input.frameType				   = hiprtFrameTypeSRT;
+		m_sceneInputs.push_back( input );
+
+		size_t size;
+		checkHiprt( hiprtGetSceneBuildTemporaryBufferSize( m_context, input, m_options, size ), "hiprtGetSceneBuildTemporaryBufferSize" );
+		tempSize = std::max( tempSize, size );
+
+		hiprtScene hiprtScene;
+		checkHiprt( hiprtCreateScene( m_context, input, m_options, hiprtScene ), "hiprtCreateScene" );
+		m_scenes.push_back( hiprtScene );
+	}
+
+	m_temp = DeviceBuffer( tempSize );
+}
+
+void DeviceScene::destroy()
+{
+	for ( const hiprtScene scene : m_scenes )
+		hiprtDestroyScene( m_context, scene );
+	for ( const hiprtGeometry geometry : m_geometries )
+		hiprtDestroyGeometry( m_context, geometry );
+}
+
+void DeviceScene::build()
+{
+	for ( size_t i = 0; i < m_geometries.size(); ++i )
+		checkHiprt(
+			hiprtBuildGeometry(
+				m_context, hiprtBuildOperationBuild, m_geometryInputs[i], m_options, m_temp.get(), 0, m_geometries[i] ),
+			"hiprtBuildGeometry" );
+	for ( size_t i = 0; i < m_scenes.size(); ++i )
+		checkHiprt(
+			hiprtBuildScene( m_context, hiprtBuildOperationBuild, m_sceneInputs[i], m_options, m_temp.get(), 0, m_scenes[i] ),
+			"hiprtBuildScene" );
+}
+} // namespace bench
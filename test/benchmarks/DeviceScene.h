@@ -0,0 +1,72 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <test/benchmarks/Device.h>
+#include <test/benchmarks/SceneGenerator.h>
+
+namespace bench
+{
+// the geometries and scenes of a generated scene, they are created once and can be rebuilt,
+// failures throw std::runtime_error
+class DeviceScene
+{
+  public:
+	DeviceScene( hiprtContext context, const Scene& scene, hiprtBuildFlags buildFlags );
+	~DeviceScene();
+
+	DeviceScene( const DeviceScene& )			 = delete;
+	DeviceScene& operator=( const DeviceScene& ) = delete;
+
+	// builds the geometries and then the levels, bottom up
+	void build();
+
+	bool instanced() const { return !m_scenes.empty(); }
+
+	// the mesh of a scene without levels
+	hiprtGeometry geometry() const { return m_geometries.front(); }
+
+	// the top level
+	hiprtScene scene() const { return m_scenes.back(); }
+
+	const std::vector<hiprtGeometry>& geometries() const { return m_geometries; }
+
+	const std::vector<hiprtScene>& scenes() const { return m_scenes; }
+
+	size_t temporaryMemorySize() const { return m_temp.size(); }
+
+  private:
+	void create( const Scene& scene );
+	void destroy();
+
+	hiprtContext						 m_context;
+	hiprtBuildOptions					 m_options;
+	std::vector<DeviceBuffer>			 m_buffers;
+	std::vector<hiprtGeometryBuildInput> m_geometryInputs;
+	std::vector<hiprtSceneBuildInput>	 m_sceneInputs;
+	std::vector<hiprtGeometry>			 m_geometries;
+	std::vector<hiprtScene>				 m_scenes;
+	DeviceBuffer						 m_temp;
+};
+} // namespace bench
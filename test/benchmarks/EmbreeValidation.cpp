@@ -0,0 +1,800 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <hiprt/hiprt.h>
+// defines the host vector types used by the implementation headers
+#include <test/shared.h>
+#include <hiprt/impl/BvhNode.h>
+#include <hiprt/impl/Transform.h>
+#include <embree4/rtcore.h>
+#include <test/benchmarks/Benchmark.h>
+#include <test/benchmarks/DeviceScene.h>
+#include <test/benchmarks/RaySets.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+// Validates the traversal of every builder against Embree on the host. The generated scenes and the
+// OBJ files are flattened to world space and built with Embree, whose closest hits of the primary
+// rays give the ray sets traced by both. The closest hits and the occlusion of the rays are compared,
+// the SAH cost of the meshes and the closest-hit throughput are reported relative to Embree. The
+// suite fails if more than 0.1% of the rays disagree, it is skipped without a device.
+
+namespace
+{
+using namespace hiprt;
+
+constexpr double MaxMismatchRatio = 1e-3;
+
+// of the scene radius
+constexpr float DistanceTolerance = 1e-3f;
+
+constexpr uint32_t BlockSize = 64u;
+
+struct Builder
+{
+	const char*		name;
+	hiprtBuildFlags flags;
+};
+
+constexpr Builder Builders[] = {
+	{ "fast", hiprtBuildFlagBitPreferFastBuild },
+	{ "balanced", hiprtBuildFlagBitPreferBalancedBuild },
+	{ "high", hiprtBuildFlagBitPreferHighQualityBuild } };
+
+constexpr const char* ValidationKernelSource = R"(
+#include <hiprt/hiprt_device.h>
+
+extern "C" __global__ void GeomClosestKernel( hiprtGeometry geom, const hiprtRay* rays, uint32_t rayCount, hiprtHit* hits )
+{
+	const uint32_t index = blockIdx.x * blockDim.x + threadIdx.x;
+	if ( index >= rayCount ) return;
+
+	hiprtGeomTraversalClosest tr( geom, rays[index] );
+	hits[index] = tr.getNextHit();
+}
+
+extern "C" __global__ void GeomAnyHitKernel( hiprtGeometry geom, const hiprtRay* rays, uint32_t rayCount, hiprtHit* hits )
+{
+	const uint32_t index = blockIdx.x * blockDim.x + threadIdx.x;
+	if ( index >= rayCount ) return;
+
+	hiprtGeomTraversalAnyHit tr( geom, rays[index] );
+	hits[index] = tr.getNextHit();
+}
+
+extern "C" __global__ void SceneClosestKernel( hiprtScene scene, const hiprtRay* rays, uint32_t rayCount, hiprtHit* hits )
+{
+	const uint32_t index = blockIdx.x * blockDim.x + threadIdx.x;
+	if ( index >= rayCount ) return;
+
+	hiprtSceneTraversalClosest tr( scene, rays[index] );
+	hits[index] = tr.getNextHit();
+}
+
+extern "C" __global__ void SceneAnyHitKernel( hiprtScene scene, const hiprtRay* rays, uint32_t rayCount, hiprtHit* hits )
+{
+	const uint32_t index = blockIdx.x * blockDim.x + threadIdx.x;
+	if ( index >= rayCount ) return;
+
+	hiprtSceneTraversalAnyHit tr( scene, rays[index] );
+	hits[index] = tr.getNextHit();
+}
+)";
+
+enum KernelIndex
+{
+	GeomClosest,
+	GeomAnyHit,
+	SceneClosest,
+	SceneAnyHit,
+	KernelCount
+};
+
+void checkHiprt( hiprtError error )
+{
+	if ( error != hiprtSuccess ) throw std::runtime_error( "failed with error " + std::to_string( error ) );
+}
+
+void checkOro( oroError error )
+{
+	if ( error != oroSuccess ) throw std::runtime_error( "failed with error " + std::to_string( error ) );
+}
+
+void checkEmbree( RTCDevice device )
+{
+	const RTCError error = rtcGetDeviceError( device );
+	if ( error != RTC_ERROR_NONE ) throw std::runtime_error( "Embree: failed with error " + std::to_string( error ) );
+}
+
+bench::Metric constant( const std::string& name, const std::string& unit, double value, bool lowerIsBetter = true )
+{
+	return { name, unit, lowerIsBetter, { value } };
+}
+
+// seconds per call, the calls are batched to run at least the minimum time
+template <typename Func>
+double timeCall( const bench::BenchmarkRunner& runner, Func&& func )
+{
+	using Clock = std::chrono::steady_clock;
+	auto timeCalls = [&]( uint32_t callCount ) {
+		const Clock::time_point begin = Clock::now();
+		for ( uint32_t i = 0; i < callCount; ++i )
+			func();
+		return std::chrono::duration<double>( Clock::now() - begin ).count();
+	};
+
+	uint32_t callCount = 1u;
+	double	 seconds   = timeCalls( callCount );
+	while ( seconds < runner.minTime() && callCount < ( 1u << 16 ) )
+	{
+		callCount *= 2u;
+		seconds = timeCalls( callCount );
+	}
+	return seconds / callCount;
+}
+
+template <typename Func>
+void parallelFor( size_t count, Func&& func )
+{
+	const size_t threadCount = std::max( std::thread::hardware_concurrency(), 1u );
+	const size_t chunkSize	 = ( count + threadCount - 1 ) / threadCount;
+
+	std::vector<std::thread> threads;
+	for ( size_t begin = 0; begin < count; begin += chunkSize )
+	{
+		threads.emplace_back( [&func, begin, end = std::min( begin + chunkSize, count )]() {
+			for ( size_t i = begin; i < end; ++i )
+				func( i );
+		} );
+	}
+	for ( std::thread& thread : threads )
+		thread.join();
+}
+
+float3 toFloat3( const hiprtFloat3& v ) { return float3{ v.x, v.y, v.z }; }
+
+Frame toFrame( const hiprtFrameSRT& frame )
+{
+	SRTFrame srtFrame;
+	srtFrame.m_rotation	   = float4{ frame.rotation.x, frame.rotation.y, frame.rotation.z, frame.rotation.w };
+	srtFrame.m_scale	   = toFloat3( frame.scale );
+	srtFrame.m_translation = toFloat3( frame.translation );
+	srtFrame.m_time		   = frame.time;
+	return srtFrame.convert();
+}
+
+// the triangles of every mesh instance in world space
+struct FlatScene
+{
+	std::vector<float3>	  vertices;
+	std::vector<uint32_t> indices;
+
+	// the first triangle of the mesh instance reached by the instance IDs of the levels, top level first
+	std::map<std::vector<uint32_t>, uint32_t> instanceOffsets;
+
+	uint32_t triangleCount() const { return static_cast<uint32_t>( indices.size() / 3 ); }
+};
+
+void flattenMesh(
+	const bench::Mesh& mesh, const std::vector<uint32_t>& path, const std::vector<Frame>& frames, FlatScene& flat )
+{
+	flat.instanceOffsets[path] = flat.triangleCount();
+
+	const uint32_t vertexOffset = static_cast<uint32_t>( flat.vertices.size() );
+	for ( const hiprtFloat3& vertex : mesh.vertices )
+	{
+		// the frame of the innermost level is applied first
+		float3 p = toFloat3( vertex );
+		for ( auto it = frames.rbegin(); it != frames.rend(); ++it )
+			p = it->transform( p );
+		flat.vertices.push_back( p );
+	}
+	for ( const uint32_t index : mesh.indices )
+		flat.indices.push_back( vertexOffset + index );
+}
+
+void flattenLevel(
+	const bench::Scene& scene, uint32_t levelIndex, std::vector<uint32_t>& path, std::vector<Frame>& frames, FlatScene& flat )
+{
+	const std::vector<bench::Instance>& level = scene.levels[levelIndex];
+	for ( uint32_t i = 0; i < level.size(); ++i )
+	{
+		path.push_back( i );
+		frames.push_back( toFrame( level[i].frame ) );
+		if ( level[i].type == hiprtInstanceTypeGeometry )
+			flattenMesh( scene.meshes[level[i].index], path, frames, flat );
+		else
+			flattenLevel( scene, level[i].index, path, frames, flat );
+		frames.pop_back();
+		path.pop_back();
+	}
+}
+
+FlatScene flatten( const bench::Scene& scene )
+{
+	FlatScene			  flat;
+	std::vector<uint32_t> path;
+	std::vector<Frame>	  frames;
+	if ( scene.levels.empty() )
+		flattenMesh( scene.meshes.front(), path, frames, flat );
+	else
+		flattenLevel( scene, static_cast<uint32_t>( scene.levels.size() - 1 ), path, frames, flat );
+	return flat;
+}
+
+// replaces the primitive ID of a device hit by the index of the flattened triangle
+hiprtHit toFlatHit( const hiprtHit& hit, const FlatScene& flat )
+{
+	if ( !hit.hasHit() ) return hit;
+
+	std::vector<uint32_t> path;
+	for ( uint32_t i = 0; i < hiprtMaxInstanceLevels && hit.instanceIDs[i] != hiprtInvalidValue; ++i )
+		path.push_back( hit.instanceIDs[i] );
+
+	const auto it = flat.instanceOffsets.find( path );
+	if ( it == flat.instanceOffsets.end() ) throw std::runtime_error( "hit of an unknown instance" );
+
+	hiprtHit flatHit = hit;
+	flatHit.primID += it->second;
+	return flatHit;
+}
+
+class EmbreeDevice
+{
+  public:
+	EmbreeDevice() : m_device( rtcNewDevice( nullptr ) )
+	{
+		if ( m_device == nullptr ) throw std::runtime_error( "Embree: cannot create the device" );
+	}
+
+	~EmbreeDevice() { rtcReleaseDevice( m_device ); }
+
+	EmbreeDevice( const EmbreeDevice& )			   = delete;
+	EmbreeDevice& operator=( const EmbreeDevice& ) = delete;
+
+	RTCDevice get() const { return m_device; }
+
+  private:
+	RTCDevice m_device;
+};
+
+// the reference, a single mesh of the flattened triangles
+class EmbreeScene
+{
+  public:
+	EmbreeScene( RTCDevice device, const FlatScene& flat ) : m_scene( rtcNewScene( device ) )
+	{
+		RTCGeometry geometry = rtcNewGeometry( device, RTC_GEOMETRY_TYPE_TRIANGLE );
+		float*		vertices = static_cast<float*>( rtcSetNewGeometryBuffer(
+			 geometry, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, 3 * sizeof( float ), flat.vertices.size() ) );
+		uint32_t*	indices	 = static_cast<uint32_t*>( rtcSetNewGeometryBuffer(
+			   geometry, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, 3 * sizeof( uint32_t ), flat.triangleCount() ) );
+		checkEmbree( device );
+
+		for ( size_t i = 0; i < flat.vertices.size(); ++i )
+		{
+			vertices[3 * i + 0] = flat.vertices[i].x;
+			vertices[3 * i + 1] = flat.vertices[i].y;
+			vertices[3 * i + 2] = flat.vertices[i].z;
+		}
+		std::copy( flat.indices.begin(), flat.indices.end(), indices );
+
+		rtcCommitGeometry( geometry );
+		rtcAttachGeometry( m_scene, geometry );
+		rtcReleaseGeometry( geometry );
+
+		rtcSetSceneFlags( m_scene, RTC_SCENE_FLAG_ROBUST );
+		rtcSetSceneBuildQuality( m_scene, RTC_BUILD_QUALITY_HIGH );
+		rtcCommitScene( m_scene );
+		checkEmbree( device );
+	}
+
+	~EmbreeScene() { rtcReleaseScene( m_scene ); }
+
+	EmbreeScene( const EmbreeScene& )			 = delete;
+	EmbreeScene& operator=( const EmbreeScene& ) = delete;
+
+	void bounds( hiprtFloat3& aabbMin, hiprtFloat3& aabbMax ) const
+	{
+		RTCBounds bounds;
+		rtcGetSceneBounds( m_scene, &bounds );
+		aabbMin = { bounds.lower_x, bounds.lower_y, bounds.lower_z };
+		aabbMax = { bounds.upper_x, bounds.upper_y, bounds.upper_z };
+	}
+
+	// the hits in the layout of the device hits, the primitive IDs are the flattened triangles
+	void traceClosest( const std::vector<hiprtRay>& rays, std::vector<hiprtHit>& hits ) const
+	{
+		hits.resize( rays.size() );
+		parallelFor( rays.size(), [&]( size_t i ) {
+			RTCRayHit rayHit;
+			setRay( rays[i], rayHit.ray );
+			rayHit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+			rtcIntersect1( m_scene, &rayHit );
+
+			hiprtHit hit;
+			if ( rayHit.hit.geomID != RTC_INVALID_GEOMETRY_ID )
+			{
+				hit.primID = rayHit.hit.primID;
+				hit.uv	   = { rayHit.hit.u, rayHit.hit.v };
+				hit.normal = { rayHit.hit.Ng_x, rayHit.hit.Ng_y, rayHit.hit.Ng_z };
+				hit.t	   = rayHit.ray.tfar;
+			}
+			hits[i] = hit;
+		} );
+	}
+
+	void traceOcclusion( const std::vector<hiprtRay>& rays, std::vector<uint8_t>& occluded ) const
+	{
+		occluded.resize( rays.size() );
+		parallelFor( rays.size(), [&]( size_t i ) {
+			RTCRay ray;
+			setRay( rays[i], ray );
+			rtcOccluded1( m_scene, &ray );
+			occluded[i] = ray.tfar < 0.0f;
+		} );
+	}
+
+  private:
+	static void setRay( const hiprtRay& ray, RTCRay& rtcRay )
+	{
+		rtcRay.org_x = ray.origin.x;
+		rtcRay.org_y = ray.origin.y;
+		rtcRay.org_z = ray.origin.z;
+		rtcRay.tnear = ray.minT;
+		rtcRay.dir_x = ray.direction.x;
+		rtcRay.dir_y = ray.direction.y;
+		rtcRay.dir_z = ray.direction.z;
+		rtcRay.time	 = 0.0f;
+		rtcRay.tfar	 = ray.maxT;
+		rtcRay.mask	 = ~0u;
+		rtcRay.id	 = 0u;
+		rtcRay.flags = 0u;
+	}
+
+	RTCScene m_scene;
+};
+
+// a node of an Embree hierarchy, the leaves have no children
+struct EmbreeNode
+{
+	uint32_t	childCount = 0u;
+	EmbreeNode* children[BranchingFactor];
+	RTCBounds	bounds[BranchingFactor];
+};
+
+float area( const RTCBounds& bounds )
+{
+	const float dx = bounds.upper_x - bounds.lower_x;
+	const float dy = bounds.upper_y - bounds.lower_y;
+	const float dz = bounds.upper_z - bounds.lower_z;
+	return 2.0f * ( dx * dy + dy * dz + dz * dx );
+}
+
+// the SAH cost of a binned SAH hierarchy with the branching factor and the costs of the device
+// hierarchies, normalized by the root area the same way as hiprtGetGeometryStatistics
+double computeEmbreeSahCost( RTCDevice device, const bench::Mesh& mesh )
+{
+	std::vector<RTCBuildPrimitive> primitives( mesh.triangleCount() );
+	for ( uint32_t i = 0; i < mesh.triangleCount(); ++i )
+	{
+		Aabb box;
+		for ( uint32_t j = 0; j < 3; ++j )
+			box.grow( toFloat3( mesh.vertices[mesh.indices[3 * i + j]] ) );
+
+		RTCBuildPrimitive& primitive = primitives[i];
+		primitive.lower_x			 = box.m_min.x;
+		primitive.lower_y			 = box.m_min.y;
+		primitive.lower_z			 = box.m_min.z;
+		primitive.geomID			 = 0u;
+		primitive.upper_x			 = box.m_max.x;
+		primitive.upper_y			 = box.m_max.y;
+		primitive.upper_z			 = box.m_max.z;
+		primitive.primID			 = i;
+	}
+
+	RTCBVH			  bvh  = rtcNewBVH( device );
+	RTCBuildArguments args = rtcDefaultBuildArguments();
+
+	args.byteSize				= sizeof( args );
+	args.buildQuality			= RTC_BUILD_QUALITY_MEDIUM;
+	args.maxBranchingFactor		= BranchingFactor;
+	args.minLeafSize			= 1;
+	args.maxLeafSize			= 1;
+	args.bvh					= bvh;
+	args.primitives				= primitives.data();
+	args.primitiveCount			= primitives.size();
+	args.primitiveArrayCapacity	= primitives.size();
+
+	args.createNode = []( RTCThreadLocalAllocator allocator, uint32_t, void* ) -> void* {
+		return new ( rtcThreadLocalAlloc( allocator, sizeof( EmbreeNode ), alignof( EmbreeNode ) ) ) EmbreeNode;
+	};
+
+	args.setNodeChildren = []( void* nodePtr, void** children, uint32_t childCount, void* ) {
+		EmbreeNode* node = static_cast<EmbreeNode*>( nodePtr );
+		node->childCount = childCount;
+		for ( uint32_t i = 0; i < childCount; ++i )
+			node->children[i] = static_cast<EmbreeNode*>( children[i] );
+	};
+
+	args.setNodeBounds = []( void* nodePtr, const RTCBounds** bounds, uint32_t childCount, void* ) {
+		EmbreeNode* node = static_cast<EmbreeNode*>( nodePtr );
+		for ( uint32_t i = 0; i < childCount; ++i )
+			node->bounds[i] = *bounds[i];
+	};
+
+	args.createLeaf = []( RTCThreadLocalAllocator allocator, const RTCBuildPrimitive*, size_t, void* ) -> void* {
+		return new ( rtcThreadLocalAlloc( allocator, sizeof( EmbreeNode ), alignof( EmbreeNode ) ) ) EmbreeNode;
+	};
+
+	const EmbreeNode* root = static_cast<const EmbreeNode*>( rtcBuildBVH( &args ) );
+	if ( root == nullptr )
+	{
+		rtcReleaseBVH( bvh );
+		checkEmbree( device );
+		throw std::runtime_error( "Embree: the hierarchy build failed" );
+	}
+
+	// a single leaf is referenced by a box node on the device
+	double sahCost = Ct + Ci;
+	if ( root->childCount > 0u )
+	{
+		RTCBounds rootBounds = root->bounds[0];
+		for ( uint32_t i = 1; i < root->childCount; ++i )
+		{
+			rootBounds.lower_x = std::min( rootBounds.lower_x, root->bounds[i].lower_x );
+			rootBounds.lower_y = std::min( rootBounds.lower_y, root->bounds[i].lower_y );
+			rootBounds.lower_z = std::min( rootBounds.lower_z, root->bounds[i].lower_z );
+			rootBounds.upper_x = std::max( rootBounds.upper_x, root->bounds[i].upper_x );
+			rootBounds.upper_y = std::max( rootBounds.upper_y, root->bounds[i].upper_y );
+			rootBounds.upper_z = std::max( rootBounds.upper_z, root->bounds[i].upper_z );
+		}
+		const float rootArea	= area( rootBounds );
+		const float rootAreaInv = rootArea > 0.0f ? 1.0f / rootArea : 0.0f;
+
+		sahCost = Ct;
+		std::vector<const EmbreeNode*> stack = { root };
+		while ( !stack.empty() )
+		{
+			const EmbreeNode* node = stack.back();
+			stack.pop_back();
+			for ( uint32_t i = 0; i < node->childCount; ++i )
+			{
+				const EmbreeNode* child = node->children[i];
+				sahCost += ( child->childCount > 0u ? Ct : Ci ) * area( node->bounds[i] ) * rootAreaInv;
+				if ( child->childCount > 0u ) stack.push_back( child );
+			}
+		}
+	}
+
+	rtcReleaseBVH( bvh );
+	return sahCost;
+}
+
+class ValidationKernels
+{
+  public:
+	explicit ValidationKernels( hiprtContext context )
+	{
+		const char* funcNames[KernelCount] = {
+			"GeomClosestKernel", "GeomAnyHitKernel", "SceneClosestKernel", "SceneAnyHitKernel" };
+		hiprtApiFunction functions[KernelCount];
+		checkHiprt( hiprtBuildTraceKernels(
+			context,
+			KernelCount,
+			funcNames,
+			ValidationKernelSource,
+			"ValidationKernels",
+			0,
+			nullptr,
+			nullptr,
+			0,
+			nullptr,
+			0,
+			1,
+			nullptr,
+			functions,
+			nullptr,
+			true ) );
+		for ( uint32_t i = 0; i < KernelCount; ++i )
+			m_functions[i] = reinterpret_cast<oroFunction>( functions[i] );
+	}
+
+	void
+	trace( const bench::DeviceScene& deviceScene, bool closest, const bench::DeviceBuffer& rays, bench::DeviceBuffer& hits )
+	{
+		const KernelIndex kernel = deviceScene.instanced() ? ( closest ? SceneClosest : SceneAnyHit )
+														   : ( closest ? GeomClosest : GeomAnyHit );
+		void* hierarchy = deviceScene.instanced() ? static_cast<void*>( deviceScene.scene() )
+												  : static_cast<void*>( deviceScene.geometry() );
+
+		hiprtDevicePtr rayPtr	= rays.get();
+		hiprtDevicePtr hitPtr	= hits.get();
+		uint32_t	   rayCount = static_cast<uint32_t>( rays.size() / sizeof( hiprtRay ) );
+		void*		   args[]	= { &hierarchy, &rayPtr, &rayCount, &hitPtr };
+		checkOro( oroModuleLaunchKernel(
+			m_functions[kernel], ( rayCount + BlockSize - 1 ) / BlockSize, 1, 1, BlockSize, 1, 1, 0, 0, args, 0 ) );
+	}
+
+  private:
+	oroFunction m_functions[KernelCount];
+};
+
+// the ray sets with the reference hits of Embree
+struct ReferenceRaySet
+{
+	bench::RaySet		  raySet;
+	bench::DeviceBuffer	  rays;
+	std::vector<hiprtHit> closestHits;
+	std::vector<uint8_t>  occluded;
+};
+
+struct Reference
+{
+	FlatScene					 flat;
+	float						 radius;
+	double						 sahCost;
+	std::vector<ReferenceRaySet> raySets;
+	std::vector<double>			 throughputs;
+};
+
+struct Comparison
+{
+	uint64_t rayCount	   = 0u;
+	uint64_t mismatchCount = 0u;
+	float	 tError		   = 0.0f;
+	float	 uvError	   = 0.0f;
+};
+
+void compareClosest(
+	const std::vector<hiprtHit>& hits,
+	const std::vector<hiprtHit>& referenceHits,
+	const Reference&			 reference,
+	Comparison&					 comparison )
+{
+	for ( size_t i = 0; i < hits.size(); ++i )
+	{
+		const hiprtHit hit			= toFlatHit( hits[i], reference.flat );
+		const hiprtHit referenceHit = referenceHits[i];
+
+		comparison.rayCount++;
+		if ( hit.hasHit() != referenceHit.hasHit() )
+		{
+			comparison.mismatchCount++;
+			continue;
+		}
+		if ( !hit.hasHit() ) continue;
+
+		// rays through an edge may hit either triangle at the same distance
+		const float tError = std::abs( hit.t - referenceHit.t ) / reference.radius;
+		if ( tError > DistanceTolerance ) comparison.mismatchCount++;
+		if ( hit.primID != referenceHit.primID ) continue;
+
+		comparison.tError = std::max( comparison.tError, tError );
+		const float uvError = std::max( std::abs( hit.uv.x - referenceHit.uv.x ), std::abs( hit.uv.y - referenceHit.uv.y ) );
+		comparison.uvError	= std::max( comparison.uvError, uvError );
+	}
+}
+
+void compareOcclusion( const std::vector<hiprtHit>& hits, const std::vector<uint8_t>& occluded, Comparison& comparison )
+{
+	for ( size_t i = 0; i < hits.size(); ++i )
+	{
+		comparison.rayCount++;
+		if ( hits[i].hasHit() != ( occluded[i] != 0u ) ) comparison.mismatchCount++;
+	}
+}
+
+Reference createReference( bench::BenchmarkRunner& runner, RTCDevice device, const bench::Scene& scene )
+{
+	Reference reference;
+	reference.flat = flatten( scene );
+
+	const EmbreeScene embreeScene( device, reference.flat );
+	hiprtFloat3		  aabbMin;
+	hiprtFloat3		  aabbMax;
+	embreeScene.bounds( aabbMin, aabbMax );
+	const float3 extent = toFloat3( aabbMax ) - toFloat3( aabbMin );
+	reference.radius	= std::max( 0.5f * std::sqrt( dot( extent, extent ) ), std::numeric_limits<float>::min() );
+
+	// weighted by the triangle count as the device hierarchies
+	reference.sahCost = 0.0;
+	for ( const bench::Mesh& mesh : scene.meshes )
+		reference.sahCost += computeEmbreeSahCost( device, mesh ) * mesh.triangleCount() / scene.uniqueTriangleCount();
+
+	const std::vector<hiprtRay> primaryRays = bench::generatePrimaryRays( aabbMin, aabbMax );
+	std::vector<hiprtHit>		primaryHits;
+	embreeScene.traceClosest( primaryRays, primaryHits );
+
+	std::vector<bench::SurfaceHit> surfaceHits( primaryHits.size() );
+	for ( size_t i = 0; i < primaryHits.size(); ++i )
+		surfaceHits[i] = { primaryHits[i].hasHit() ? primaryHits[i].t : -1.0f, primaryHits[i].normal };
+
+	for ( bench::RaySet& raySet : bench::generateRaySets( aabbMin, aabbMax, primaryRays, surfaceHits ) )
+	{
+		// without primary hits there are no secondary rays
+		if ( raySet.rays.empty() ) continue;
+
+		ReferenceRaySet& referenceRaySet = reference.raySets.emplace_back();
+		referenceRaySet.rays			 = bench::DeviceBuffer::upload( raySet.rays );
+		embreeScene.traceClosest( raySet.rays, referenceRaySet.closestHits );
+		embreeScene.traceOcclusion( raySet.rays, referenceRaySet.occluded );
+		referenceRaySet.raySet = std::move( raySet );
+	}
+
+	std::vector<hiprtHit> hits;
+	for ( uint32_t i = 0; i < runner.repetitions(); ++i )
+	{
+		uint64_t rayCount = 0u;
+		double	 seconds  = 0.0;
+		for ( const ReferenceRaySet& referenceRaySet : reference.raySets )
+		{
+			rayCount += referenceRaySet.raySet.rays.size();
+			seconds += timeCall( runner, [&]() { embreeScene.traceClosest( referenceRaySet.raySet.rays, hits ); } );
+		}
+		reference.throughputs.push_back( 1e-6 * rayCount / seconds );
+	}
+	return reference;
+}
+
+bench::Result validateBuilder(
+	bench::BenchmarkRunner& runner,
+	hiprtContext			context,
+	ValidationKernels&		kernels,
+	const bench::Scene&		scene,
+	const Reference&		reference,
+	const Builder&			builder,
+	const std::string&		name )
+{
+	bench::DeviceScene deviceScene( context, scene, builder.flags );
+	deviceScene.build();
+	checkOro( oroDeviceSynchronize() );
+
+	Comparison comparison;
+	for ( const ReferenceRaySet& referenceRaySet : reference.raySets )
+	{
+		bench::DeviceBuffer hits( referenceRaySet.raySet.rays.size() * sizeof( hiprtHit ) );
+
+		kernels.trace( deviceScene, true, referenceRaySet.rays, hits );
+		checkOro( oroDeviceSynchronize() );
+		compareClosest( hits.download<hiprtHit>(), referenceRaySet.closestHits, reference, comparison );
+
+		kernels.trace( deviceScene, false, referenceRaySet.rays, hits );
+		checkOro( oroDeviceSynchronize() );
+		compareOcclusion( hits.download<hiprtHit>(), referenceRaySet.occluded, comparison );
+	}
+
+	double sahCost = 0.0;
+	for ( size_t i = 0; i < deviceScene.geometries().size(); ++i )
+	{
+		hiprtBvhStatistics stats;
+		checkHiprt( hiprtGetGeometryStatistics( context, deviceScene.geometries()[i], stats ) );
+		sahCost += static_cast<double>( stats.sahCost ) * scene.meshes[i].triangleCount() / scene.uniqueTriangleCount();
+	}
+
+	bench::Metric throughputRatio{ "throughputRatio", "", false, {} };
+	for ( uint32_t i = 0; i < runner.repetitions(); ++i )
+	{
+		uint64_t rayCount = 0u;
+		double	 seconds  = 0.0;
+		for ( const ReferenceRaySet& referenceRaySet : reference.raySets )
+		{
+			bench::DeviceBuffer hits( referenceRaySet.raySet.rays.size() * sizeof( hiprtHit ) );
+			rayCount += referenceRaySet.raySet.rays.size();
+			seconds += timeCall( runner, [&]() {
+				kernels.trace( deviceScene, true, referenceRaySet.rays, hits );
+				checkOro( oroDeviceSynchronize() );
+			} );
+		}
+		throughputRatio.samples.push_back( 1e-6 * rayCount / seconds / reference.throughputs[i] );
+	}
+
+	const double mismatchRatio =
+		comparison.rayCount > 0u ? static_cast<double>( comparison.mismatchCount ) / comparison.rayCount : 0.0;
+	if ( mismatchRatio > MaxMismatchRatio )
+		runner.addFailure(
+			name,
+			std::to_string( comparison.mismatchCount ) + " of " + std::to_string( comparison.rayCount ) +
+				" rays disagree with Embree" );
+
+	bench::Result result{ "embree", name, {} };
+	result.metrics.push_back( constant( "mismatches", "%", 100.0 * mismatchRatio ) );
+	result.metrics.push_back( constant( "tError", "", comparison.tError ) );
+	result.metrics.push_back( constant( "uvError", "", comparison.uvError ) );
+	result.metrics.push_back( constant( "sahCostRatio", "", sahCost / reference.sahCost ) );
+	result.metrics.push_back( throughputRatio );
+	return result;
+}
+
+std::string getBenchmarkName( const std::string& sceneName, const Builder& builder ) { return sceneName + "/" + builder.name; }
+} // namespace
+
+namespace bench
+{
+void runEmbreeValidation( BenchmarkRunner& runner )
+{
+	Device device( runner.deviceIndex() );
+	if ( !device.valid() )
+	{
+		std::cout << "embree: no device " << runner.deviceIndex() << ", skipped" << std::endl;
+		return;
+	}
+	std::cout << "embree: " << device.name() << std::endl;
+
+	std::optional<EmbreeDevice>		 embreeDevice;
+	std::optional<ValidationKernels> kernels;
+	try
+	{
+		embreeDevice.emplace();
+		kernels.emplace( device.context() );
+	}
+	catch ( const std::exception& e )
+	{
+		runner.addFailure( "embree", e.what() );
+		return;
+	}
+
+	for ( const SceneSource& source : getSceneSources( runner.sizes(), runner.objPaths() ) )
+	{
+		// the scenes are only created if one of their builders runs
+		const bool enabled = std::any_of( std::begin( Builders ), std::end( Builders ), [&]( const Builder& builder ) {
+			return runner.enabled( getBenchmarkName( source.name, builder ) );
+		} );
+		if ( !enabled ) continue;
+
+		try
+		{
+			const Scene		scene	  = source.create();
+			const Reference reference = createReference( runner, embreeDevice->get(), scene );
+			for ( const Builder& builder : Builders )
+			{
+				const std::string name = getBenchmarkName( source.name, builder );
+				if ( !runner.enabled( name ) ) continue;
+
+				try
+				{
+					runner.addResult( validateBuilder( runner, device.context(), *kernels, scene, reference, builder, name ) );
+				}
+				catch ( const std::exception& e )
+				{
+					runner.addFailure( name, e.what() );
+				}
+			}
+		}
+		catch ( const std::exception& e )
+		{
+			runner.addFailure( source.name, e.what() );
+		}
+	}
+}
+} // namespace bench
@@ -0,0 +1,247 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+#include <hiprt/hiprt.h>
+// defines the host vector types used by the implementation headers
+#include <test/shared.h>
+#include <hiprt/impl/Aabb.h>
+#include <hiprt/impl/MortonCode.h>
+#include <hiprt/impl/QrDecomposition.h>
+#include <hiprt/impl/Quaternion.h>
+#include <hiprt/impl/Transform.h>
+#include <hiprt/impl/Triangle.h>
+#include <test/benchmarks/Benchmark.h>
+#include <random>
+
+// The math and intersection routines are host-device code, so they are measured on the host.
+// Every call processes a batch of random inputs, which keeps the compiler from folding them.
+
+namespace
+{
+using namespace hiprt;
+
+constexpr uint32_t InputCount = 1024u;
+
+class Inputs
+{
+  public:
+	Inputs() : m_rng( 1234u ) {}
+
+	float uniform( float a = 0.0f, float b = 1.0f ) { return std::uniform_real_distribution<float>( a, b )( m_rng ); }
+
+	float3 point( float a = 0.0f, float b = 1.0f ) { return { uniform( a, b ), uniform( a, b ), uniform( a, b ) }; }
+
+	float4 rotation()
+	{
+		return qtFromAxisAngle( float4{ uniform( -1.0f, 1.0f ), uniform( -1.0f, 1.0f ), 1.0f, uniform( -3.0f, 3.0f ) } );
+	}
+
+	Frame frame( float time )
+	{
+		Frame frame;
+		frame.m_rotation	= rotation();
+		frame.m_scale		= point( 0.5f, 2.0f );
+		frame.m_shear		= point( -0.2f, 0.2f );
+		frame.m_translation = point( -10.0f, 10.0f );
+		frame.m_time		= time;
+		return frame;
+	}
+
+	MatrixFrame matrixFrame( float time ) { return MatrixFrame::getMatrixFrame( frame( time ) ); }
+
+	// rays from around the unit cube towards its inside
+	hiprtRay ray()
+	{
+		hiprtRay ray;
+		ray.origin	  = point( -1.0f, 2.0f );
+		ray.direction = normalize( point() - ray.origin + make_float3( 1e-3f ) );
+		ray.minT	  = 0.0f;
+		ray.maxT	  = 1e3f;
+		return ray;
+	}
+
+  private:
+	std::mt19937 m_rng;
+};
+
+template <typename T, typename Generator>
+std::vector<T> generate( Generator&& generator )
+{
+	std::vector<T> values;
+	for ( size_t i = 0; i < InputCount; ++i )
+		values.push_back( generator( i ) );
+	return values;
+}
+} // namespace
+
+namespace bench
+{
+void runMicroBenchmarks( BenchmarkRunner& runner )
+{
+	Inputs inputs;
+
+	const std::vector<hiprtRay> rays  = generate<hiprtRay>( [&]( size_t ) { return inputs.ray(); } );
+	const std::vector<float>	times = generate<float>( [&]( size_t ) { return inputs.uniform(); } );
+
+	const std::vector<float3> invDirections =
+		generate<float3>( [&]( size_t i ) { return make_float3( 1.0f ) / rays[i].direction; } );
+	const std::vector<Aabb> boxes = generate<Aabb>( [&]( size_t ) {
+		const float3 p = inputs.point();
+		return Aabb( p, p + inputs.point( 0.01f, 0.5f ) );
+	} );
+	runner.measure( "Aabb::intersect", InputCount, [&]() {
+		float hits = 0.0f;
+		for ( uint32_t i = 0; i < InputCount; ++i )
+		{
+			const float2 t = boxes[i].intersect( rays[i].origin, invDirections[i], rays[i].maxT );
+			hits += t.x <= t.y ? 1.0f : 0.0f;
+		}
+		doNotOptimize( hits );
+	} );
+
+	const std::vector<TrianglePair> pairs = generate<TrianglePair>( [&]( size_t ) {
+		const float3 v0 = inputs.point();
+		return TrianglePair( v0, v0 + inputs.point( 0.0f, 0.5f ), v0 + inputs.point( 0.0f, 0.5f ), v0 + inputs.point( 0.0f, 0.5f ) );
+	} );
+	runner.measure( "Triangle::intersect", InputCount, [&]() {
+		float tSum = 0.0f;
+		for ( uint32_t i = 0; i < InputCount; ++i )
+		{
+			float2 uv;
+			float  t;
+			if ( pairs[i].fetchTriangle( 0 ).intersect( rays[i], uv, t, 0u ) ) tSum += t + uv.x;
+		}
+		doNotOptimize( tSum );
+	} );
+
+	runner.measure( "TrianglePair::fetchTriangle", 2 * InputCount, [&]() {
+		float3 sum = make_float3( 0.0f );
+		for ( uint32_t i = 0; i < InputCount; ++i )
+			for ( uint32_t j = 0; j < 2; ++j )
+				sum += pairs[i].fetchTriangle( ( i + j ) & 1 ).normal();
+		doNotOptimize( sum );
+	} );
+
+	// the motion blur paths, four key frames
+	const std::vector<Frame> frames = { inputs.frame( 0.0f ), inputs.frame( 0.33f ), inputs.frame( 0.66f ), inputs.frame( 1.0f ) };
+	const Transform			 transform( frames.data(), 0u, static_cast<uint32_t>( frames.size() ) );
+	runner.measure( "Transform::interpolateFrames", InputCount, [&]() {
+		float3 sum = make_float3( 0.0f );
+		for ( uint32_t i = 0; i < InputCount; ++i )
+			sum += transform.interpolateFrames( times[i] ).m_translation;
+		doNotOptimize( sum );
+	} );
+
+	runner.measure( "Transform::transformRay", InputCount, [&]() {
+		float3 sum = make_float3( 0.0f );
+		for ( uint32_t i = 0; i < InputCount; ++i )
+			sum += transform.transformRay( rays[i], times[i] ).direction;
+		doNotOptimize( sum );
+	} );
+
+	const std::vector<float4> rotations = generate<float4>( [&]( size_t ) { return inputs.rotation(); } );
+	const std::vector<float3> points	= generate<float3>( [&]( size_t ) { return inputs.point( -1.0f, 1.0f ); } );
+	runner.measure( "Quaternion::qtMul", InputCount, [&]() {
+		float4 q = qtGetIdentity();
+		for ( uint32_t i = 0; i < InputCount; ++i )
+			q = qtMul( q, rotations[i] );
+		doNotOptimize( q );
+	} );
+
+	runner.measure( "Quaternion::qtRotate", InputCount, [&]() {
+		float3 sum = make_float3( 0.0f );
+		for ( uint32_t i = 0; i < InputCount; ++i )
+			sum += qtRotate( rotations[i], points[i] );
+		doNotOptimize( sum );
+	} );
+
+	runner.measure( "Quaternion::qtMix", InputCount, [&]() {
+		float4 sum = make_float4( 0.0f );
+		for ( uint32_t i = 0; i < InputCount; ++i )
+			sum += qtMix( rotations[i], rotations[( i + 1 ) % InputCount], times[i] );
+		doNotOptimize( sum );
+	} );
+
+	runner.measure( "Quaternion::qtToRotationMatrix", InputCount, [&]() {
+		float sum = 0.0f;
+		for ( uint32_t i = 0; i < InputCount; ++i )
+		{
+			float R[3][3];
+			qtToRotationMatrix( rotations[i], R );
+			sum += R[0][0] + R[1][1] + R[2][2];
+		}
+		doNotOptimize( sum );
+	} );
+
+	const std::vector<MatrixFrame> matrices = generate<MatrixFrame>( [&]( size_t ) { return inputs.matrixFrame( 0.0f ); } );
+	runner.measure( "Quaternion::qtFromRotationMatrix", InputCount, [&]() {
+		float4 sum = make_float4( 0.0f );
+		for ( uint32_t i = 0; i < InputCount; ++i )
+		{
+			float R[3][3];
+			for ( uint32_t j = 0; j < 3; ++j )
+				for ( uint32_t k = 0; k < 3; ++k )
+					R[j][k] = matrices[i].m_matrix[j][k];
+			sum += qtFromRotationMatrix( R );
+		}
+		doNotOptimize( sum );
+	} );
+
+	runner.measure( "qr", InputCount, [&]() {
+		float sum = 0.0f;
+		for ( uint32_t i = 0; i < InputCount; ++i )
+		{
+			float A[3][3], Q[3][3], R[3][3];
+			for ( uint32_t j = 0; j < 3; ++j )
+				for ( uint32_t k = 0; k < 3; ++k )
+					A[j][k] = matrices[i].m_matrix[j][k];
+			qr( &A[0][0], &Q[0][0], &R[0][0] );
+			sum += Q[0][0] + R[2][2];
+		}
+		doNotOptimize( sum );
+	} );
+
+	runner.measure( "MatrixFrame::convert", InputCount, [&]() {
+		float3 sum = make_float3( 0.0f );
+		for ( uint32_t i = 0; i < InputCount; ++i )
+			sum += matrices[i].convert().m_scale;
+		doNotOptimize( sum );
+	} );
+
+	const float3 extent = { 1.0f, 0.25f, 0.0625f };
+	runner.measure( "MortonCode::computeMortonCode", InputCount, [&]() {
+		uint32_t code = 0u;
+		for ( uint32_t i = 0; i < InputCount; ++i )
+			code ^= computeMortonCode( points[i] * 0.5f + 0.5f );
+		doNotOptimize( code );
+	} );
+
+	runner.measure( "MortonCode::computeExtendedMortonCode", InputCount, [&]() {
+		uint32_t code = 0u;
+		for ( uint32_t i = 0; i < InputCount; ++i )
+			code ^= computeExtendedMortonCode( points[i] * 0.5f + 0.5f, extent );
+		doNotOptimize( code );
+	} );
+}
+} // namespace bench
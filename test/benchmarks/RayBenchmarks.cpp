@@ -0,0 +1,327 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+#include <test/benchmarks/Benchmark.h>
+#include <test/benchmarks/DeviceScene.h>
+#include <test/benchmarks/RaySets.h>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+
+// Traces the standard ray sets against the generated scenes and the OBJ files in the closest-hit
+// and any-hit modes and reports the throughput in Mrays/s for several block sizes. The primary rays
+// of a camera fitted to the scene are traced first, the ambient occlusion, shadow and diffuse rays
+// start at their hits, the random rays start anywhere in the scene. Traversal runs on the device,
+// the suite is skipped without one.
+
+namespace
+{
+constexpr uint32_t BlockSizes[] = { 64u, 128u, 256u };
+
+constexpr const char* RayKernelSource = R"(
+#include <hiprt/hiprt_device.h>
+
+struct RayHit
+{
+	float  t;
+	float3 normal;
+};
+
+__device__ RayHit toRayHit( const hiprtHit& hit ) { return { hit.hasHit() ? hit.t : -1.0f, hit.normal }; }
+
+extern "C" __global__ void GeomClosestKernel( hiprtGeometry geom, const hiprtRay* rays, uint32_t rayCount, RayHit* hits )
+{
+	const uint32_t index = blockIdx.x * blockDim.x + threadIdx.x;
+	if ( index >= rayCount ) return;
+
+	hiprtGeomTraversalClosest tr( geom, rays[index] );
+	hits[index] = toRayHit( tr.getNextHit() );
+}
+
+extern "C" __global__ void GeomAnyHitKernel( hiprtGeometry geom, const hiprtRay* rays, uint32_t rayCount, RayHit* hits )
+{
+	const uint32_t index = blockIdx.x * blockDim.x + threadIdx.x;
+	if ( index >= rayCount ) return;
+
+	hiprtGeomTraversalAnyHit tr( geom, rays[index] );
+	hits[index] = toRayHit( tr.getNextHit() );
+}
+
+extern "C" __global__ void SceneClosestKernel( hiprtScene scene, const hiprtRay* rays, uint32_t rayCount, RayHit* hits )
+{
+	const uint32_t index = blockIdx.x * blockDim.x + threadIdx.x;
+	if ( index >= rayCount ) return;
+
+	hiprtSceneTraversalClosest tr( scene, rays[index] );
+	hiprtHit				   hit = tr.getNextHit();
+	if ( hit.hasHit() ) hit.normal = hiprtVectorObjectToWorld( hit.normal, scene, hit.instanceIDs );
+	hits[index] = toRayHit( hit );
+}
+
+extern "C" __global__ void SceneAnyHitKernel( hiprtScene scene, const hiprtRay* rays, uint32_t rayCount, RayHit* hits )
+{
+	const uint32_t index = blockIdx.x * blockDim.x + threadIdx.x;
+	if ( index >= rayCount ) return;
+
+	hiprtSceneTraversalAnyHit tr( scene, rays[index] );
+	hits[index] = toRayHit( tr.getNextHit() );
+}
+)";
+
+// RayHit of the kernels
+static_assert( sizeof( bench::SurfaceHit ) == 16 );
+
+enum KernelIndex
+{
+	GeomClosest,
+	GeomAnyHit,
+	SceneClosest,
+	SceneAnyHit,
+	KernelCount
+};
+
+struct Mode
+{
+	const char* name;
+	KernelIndex geomKernel;
+	KernelIndex sceneKernel;
+};
+
+constexpr Mode Modes[] = { { "closest", GeomClosest, SceneClosest }, { "anyhit", GeomAnyHit, SceneAnyHit } };
+
+void checkHiprt( hiprtError error )
+{
+	if ( error != hiprtSuccess ) throw std::runtime_error( "failed with error " + std::to_string( error ) );
+}
+
+void checkOro( oroError error )
+{
+	if ( error != oroSuccess ) throw std::runtime_error( "failed with error " + std::to_string( error ) );
+}
+
+class RayKernels
+{
+  public:
+	explicit RayKernels( hiprtContext context )
+	{
+		const char* funcNames[KernelCount] = {
+			"GeomClosestKernel", "GeomAnyHitKernel", "SceneClosestKernel", "SceneAnyHitKernel" };
+		hiprtApiFunction functions[KernelCount];
+		checkHiprt( hiprtBuildTraceKernels(
+			context,
+			KernelCount,
+			funcNames,
+			RayKernelSource,
+			"RayKernels",
+			0,
+			nullptr,
+			nullptr,
+			0,
+			nullptr,
+			0,
+			1,
+			nullptr,
+			functions,
+			nullptr,
+			true ) );
+		for ( uint32_t i = 0; i < KernelCount; ++i )
+			m_functions[i] = reinterpret_cast<oroFunction>( functions[i] );
+	}
+
+	void launch(
+		KernelIndex kernel, void* hierarchy, const bench::DeviceBuffer& rays, bench::DeviceBuffer& hits, uint32_t blockSize )
+	{
+		hiprtDevicePtr rayPtr	= rays.get();
+		hiprtDevicePtr hitPtr	= hits.get();
+		uint32_t	   rayCount = static_cast<uint32_t>( rays.size() / sizeof( hiprtRay ) );
+		void*		   args[]	= { &hierarchy, &rayPtr, &rayCount, &hitPtr };
+		checkOro( oroModuleLaunchKernel(
+			m_functions[kernel], ( rayCount + blockSize - 1 ) / blockSize, 1, 1, blockSize, 1, 1, 0, 0, args, 0 ) );
+	}
+
+  private:
+	oroFunction m_functions[KernelCount];
+};
+
+class RayTracer
+{
+  public:
+	RayTracer( RayKernels& kernels, const bench::DeviceScene& deviceScene ) : m_kernels( kernels )
+	{
+		m_instanced = deviceScene.instanced();
+		m_hierarchy = m_instanced ? static_cast<void*>( deviceScene.scene() ) : static_cast<void*>( deviceScene.geometry() );
+	}
+
+	void trace( const Mode& mode, const bench::DeviceBuffer& rays, bench::DeviceBuffer& hits, uint32_t blockSize )
+	{
+		m_kernels.launch( m_instanced ? mode.sceneKernel : mode.geomKernel, m_hierarchy, rays, hits, blockSize );
+	}
+
+  private:
+	RayKernels& m_kernels;
+	void*		m_hierarchy;
+	bool		m_instanced;
+};
+
+std::string getBenchmarkName( const std::string& sceneName, const char* raySetName, const Mode& mode, uint32_t blockSize )
+{
+	return sceneName + "/" + raySetName + "/" + mode.name + "/" + std::to_string( blockSize );
+}
+
+// the scenes are only generated and built if one of their benchmarks runs
+bool sceneEnabled( const bench::BenchmarkRunner& runner, const std::string& sceneName )
+{
+	for ( const char* raySetName : bench::RaySetNames )
+		for ( const Mode& mode : Modes )
+			for ( const uint32_t blockSize : BlockSizes )
+				if ( runner.enabled( getBenchmarkName( sceneName, raySetName, mode, blockSize ) ) ) return true;
+	return false;
+}
+
+// the launches are batched to run at least the minimum time per repetition
+bench::Result benchmarkRays(
+	bench::BenchmarkRunner& runner,
+	RayTracer&				tracer,
+	const Mode&				mode,
+	const bench::RaySet&	raySet,
+	uint32_t				blockSize,
+	const std::string&		name )
+{
+	using Clock = std::chrono::steady_clock;
+
+	const bench::DeviceBuffer rays = bench::DeviceBuffer::upload( raySet.rays );
+	bench::DeviceBuffer		  hits( raySet.rays.size() * sizeof( bench::SurfaceHit ) );
+
+	auto timeLaunches = [&]( uint32_t launchCount ) {
+		const Clock::time_point begin = Clock::now();
+		for ( uint32_t i = 0; i < launchCount; ++i )
+			tracer.trace( mode, rays, hits, blockSize );
+		checkOro( oroDeviceSynchronize() );
+		return std::chrono::duration<double>( Clock::now() - begin ).count();
+	};
+
+	uint32_t launchCount = 1u;
+	while ( timeLaunches( launchCount ) < runner.minTime() && launchCount < ( 1u << 16 ) )
+		launchCount *= 2u;
+
+	bench::Metric time{ "traceTime", "ms", true, {} };
+	bench::Metric throughput{ "throughput", "Mrays/s", false, {} };
+	for ( uint32_t i = 0; i < runner.repetitions(); ++i )
+	{
+		const double seconds = timeLaunches( launchCount ) / launchCount;
+		time.samples.push_back( 1e3 * seconds );
+		throughput.samples.push_back( 1e-6 * raySet.rays.size() / seconds );
+	}
+	return { "rays", name, { time, throughput } };
+}
+
+void benchmarkScene(
+	bench::BenchmarkRunner& runner,
+	hiprtContext			context,
+	RayKernels&				kernels,
+	const bench::Scene&		scene,
+	const std::string&		sceneName )
+{
+	bench::DeviceScene deviceScene( context, scene, hiprtBuildFlagBitPreferBalancedBuild );
+	deviceScene.build();
+	checkOro( oroDeviceSynchronize() );
+
+	hiprtFloat3 aabbMin;
+	hiprtFloat3 aabbMax;
+	if ( deviceScene.instanced() )
+		checkHiprt( hiprtExportSceneAabb( context, deviceScene.scene(), aabbMin, aabbMax ) );
+	else
+		checkHiprt( hiprtExportGeometryAabb( context, deviceScene.geometry(), aabbMin, aabbMax ) );
+
+	RayTracer tracer( kernels, deviceScene );
+
+	const std::vector<hiprtRay> primaryRays = bench::generatePrimaryRays( aabbMin, aabbMax );
+	const bench::DeviceBuffer	primaryRayBuffer = bench::DeviceBuffer::upload( primaryRays );
+	bench::DeviceBuffer			primaryHitBuffer( primaryRays.size() * sizeof( bench::SurfaceHit ) );
+	tracer.trace( Modes[0], primaryRayBuffer, primaryHitBuffer, BlockSizes[0] );
+	checkOro( oroDeviceSynchronize() );
+
+	const std::vector<bench::RaySet> raySets =
+		bench::generateRaySets( aabbMin, aabbMax, primaryRays, primaryHitBuffer.download<bench::SurfaceHit>() );
+	std::cout << sceneName << ": " << raySets[1].rays.size() << " of " << primaryRays.size() << " primary rays hit"
+			  << std::endl;
+
+	for ( const bench::RaySet& raySet : raySets )
+	{
+		for ( const Mode& mode : Modes )
+		{
+			for ( const uint32_t blockSize : BlockSizes )
+			{
+				const std::string name = getBenchmarkName( sceneName, raySet.name.c_str(), mode, blockSize );
+				if ( !runner.enabled( name ) ) continue;
+
+				// without primary hits there are no secondary rays
+				if ( raySet.rays.empty() ) continue;
+
+				runner.addResult( benchmarkRays( runner, tracer, mode, raySet, blockSize, name ) );
+			}
+		}
+	}
+}
+} // namespace
+
+namespace bench
+{
+void runRayBenchmarks( BenchmarkRunner& runner )
+{
+	Device device( runner.deviceIndex() );
+	if ( !device.valid() )
+	{
+		std::cout << "rays: no device " << runner.deviceIndex() << ", skipped" << std::endl;
+		return;
+	}
+	std::cout << "rays: " << device.name() << std::endl;
+
+	std::optional<RayKernels> kernels;
+	try
+	{
+		kernels.emplace( device.context() );
+	}
+	catch ( const std::exception& e )
+	{
+		runner.addFailure( "rays", e.what() );
+		return;
+	}
+
+	for ( const SceneSource& source : getSceneSources( runner.sizes(), runner.objPaths() ) )
+	{
+		if ( !sceneEnabled( runner, source.name ) ) continue;
+
+		try
+		{
+			benchmarkScene( runner, device.context(), *kernels, source.create(), source.name );
+		}
+		catch ( const std::exception& e )
+		{
+			runner.addFailure( source.name, e.what() );
+		}
+	}
+}
+} // namespace bench
@@ -0,0 +1,157 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+#include <test/benchmarks/RaySets.h>
+#include <test/shared.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace
+{
+using namespace hiprt;
+
+class Sampler
+{
+  public:
+	explicit Sampler( uint32_t seed ) : m_rng( seed ) {}
+
+	float uniform( float a = 0.0f, float b = 1.0f )
+	{
+		return a + ( b - a ) * static_cast<float>( m_rng() >> 8 ) * ( 1.0f / 16777216.0f );
+	}
+
+	float3 direction()
+	{
+		const float z	= uniform( -1.0f, 1.0f );
+		const float phi = uniform( 0.0f, 2.0f * Pi );
+		const float r	= std::sqrt( std::max( 1.0f - z * z, 0.0f ) );
+		return { r * std::cos( phi ), r * std::sin( phi ), z };
+	}
+
+	// cosine weighted about the normal
+	float3 hemisphere( const float3& n )
+	{
+		const float3 axis = std::abs( n.x ) > 0.9f ? float3{ 0.0f, 1.0f, 0.0f } : float3{ 1.0f, 0.0f, 0.0f };
+		const float3 t	  = normalize( cross( n, axis ) );
+		const float3 b	  = cross( n, t );
+
+		const float u	= uniform();
+		const float phi = uniform( 0.0f, 2.0f * Pi );
+		const float r	= std::sqrt( u );
+		return t * ( r * std::cos( phi ) ) + b * ( r * std::sin( phi ) ) + n * std::sqrt( std::max( 1.0f - u, 0.0f ) );
+	}
+
+  private:
+	std::mt19937 m_rng;
+};
+} // namespace
+
+namespace bench
+{
+std::vector<hiprtRay> generatePrimaryRays( const hiprtFloat3& aabbMin, const hiprtFloat3& aabbMax )
+{
+	const float3 extent = aabbMax - aabbMin;
+	const float3 center = ( aabbMin + aabbMax ) * 0.5f;
+	const float	 radius = 0.5f * std::sqrt( dot( extent, extent ) );
+
+	const float3 forward = normalize( float3{ -0.5f, -0.6f, -1.0f } );
+	const float3 right	 = normalize( cross( forward, { 0.0f, 1.0f, 0.0f } ) );
+	const float3 up		 = cross( right, forward );
+	const float	 tanFov	 = std::tan( 0.5f * 45.0f * Pi / 180.0f );
+	const float3 eye	 = center - forward * ( radius / tanFov + radius );
+
+	std::vector<hiprtRay> rays( RayResolution * RayResolution );
+	for ( uint32_t y = 0; y < RayResolution; ++y )
+	{
+		for ( uint32_t x = 0; x < RayResolution; ++x )
+		{
+			const float sx = 2.0f * ( x + 0.5f ) / RayResolution - 1.0f;
+			const float sy = 1.0f - 2.0f * ( y + 0.5f ) / RayResolution;
+
+			hiprtRay& ray = rays[x + y * RayResolution];
+			ray.origin	  = eye;
+			ray.direction = normalize( forward + right * ( sx * tanFov ) + up * ( sy * tanFov ) );
+		}
+	}
+	return rays;
+}
+
+std::vector<RaySet> generateRaySets(
+	const hiprtFloat3&			   aabbMin,
+	const hiprtFloat3&			   aabbMax,
+	const std::vector<hiprtRay>&   primaryRays,
+	const std::vector<SurfaceHit>& primaryHits )
+{
+	const float3 extent	  = aabbMax - aabbMin;
+	const float	 radius	  = 0.5f * std::sqrt( dot( extent, extent ) );
+	const float	 epsilon  = 1e-4f * radius;
+	const float3 light	  = ( aabbMin + aabbMax ) * 0.5f + float3{ 0.3f, 1.0f, 0.2f } * ( 2.0f * radius );
+	const float	 aoRadius = 0.1f * radius;
+
+	Sampler sampler( 1u );
+
+	RaySet ao{ RaySetNames[1], {} };
+	RaySet shadow{ RaySetNames[2], {} };
+	RaySet diffuse{ RaySetNames[3], {} };
+	for ( size_t i = 0; i < primaryRays.size(); ++i )
+	{
+		if ( primaryHits[i].t < 0.0f ) continue;
+
+		// the secondary rays start slightly off the surface, on the side of the camera
+
+		const hiprtRay& primaryRay = primaryRays[i];
+		float3			normal	   = normalize( primaryHits[i].normal );
+		if ( dot( normal, primaryRay.direction ) > 0.0f ) normal = -normal;
+		const float3 position = primaryRay.origin + primaryRay.direction * primaryHits[i].t + normal * epsilon;
+
+		hiprtRay ray;
+		ray.origin	  = position;
+		ray.direction = sampler.hemisphere( normal );
+		ray.maxT	  = aoRadius;
+		ao.rays.push_back( ray );
+
+		const float3 toLight = light - position;
+		ray.direction		 = normalize( toLight );
+		ray.maxT			 = std::sqrt( dot( toLight, toLight ) );
+		shadow.rays.push_back( ray );
+
+		ray.direction = sampler.hemisphere( normal );
+		ray.maxT	  = FltMax;
+		diffuse.rays.push_back( ray );
+	}
+
+	RaySet random{ RaySetNames[4], std::vector<hiprtRay>( primaryRays.size() ) };
+	for ( hiprtRay& ray : random.rays )
+	{
+		const float x = sampler.uniform();
+		const float y = sampler.uniform();
+		const float z = sampler.uniform();
+		ray.origin	  = aabbMin + extent * float3{ x, y, z };
+		ray.direction = sampler.direction();
+	}
+
+	return { { RaySetNames[0], primaryRays }, ao, shadow, diffuse, random };
+}
+} // namespace bench
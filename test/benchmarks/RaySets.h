@@ -0,0 +1,59 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <hiprt/hiprt.h>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+// the closest hit of a ray, a miss has a negative distance
+struct SurfaceHit
+{
+	float		t;
+	hiprtFloat3 normal;
+};
+
+struct RaySet
+{
+	std::string			  name;
+	std::vector<hiprtRay> rays;
+};
+
+constexpr uint32_t RayResolution = 512u;
+
+constexpr const char* RaySetNames[] = { "primary", "ao", "shadow", "diffuse", "random" };
+
+// RayResolution^2 rays of a camera looking at the center of the box from above and in front
+std::vector<hiprtRay> generatePrimaryRays( const hiprtFloat3& aabbMin, const hiprtFloat3& aabbMax );
+
+// the primary rays, the ambient occlusion, shadow and diffuse rays starting at their hits and random rays
+// starting anywhere in the box, the world space normals of the hits may face either side
+std::vector<RaySet> generateRaySets(
+	const hiprtFloat3&			   aabbMin,
+	const hiprtFloat3&			   aabbMax,
+	const std::vector<hiprtRay>&   primaryRays,
+	const std::vector<SurfaceHit>& primaryHits );
+} // namespace bench
@@ -0,0 +1,343 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+#include <test/benchmarks/SceneGenerator.h>
+#include <test/shared.h>
+#define TINYOBJLOADER_IMPLEMENTATION
+#include <test/common/tiny_obj_loader.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace
+{
+using namespace hiprt;
+
+class Generator
+{
+  public:
+	explicit Generator( uint32_t seed ) : m_rng( seed ) {}
+
+	// std::uniform_real_distribution differs between the standard libraries
+	float uniform( float a = 0.0f, float b = 1.0f )
+	{
+		return a + ( b - a ) * static_cast<float>( m_rng() >> 8 ) * ( 1.0f / 16777216.0f );
+	}
+
+	float3 point( float a = 0.0f, float b = 1.0f ) { return { uniform( a, b ), uniform( a, b ), uniform( a, b ) }; }
+
+	float3 direction()
+	{
+		const float z	= uniform( -1.0f, 1.0f );
+		const float phi = uniform( 0.0f, 2.0f * Pi );
+		const float r	= std::sqrt( std::max( 1.0f - z * z, 0.0f ) );
+		return { r * std::cos( phi ), r * std::sin( phi ), z };
+	}
+
+  private:
+	std::mt19937 m_rng;
+};
+
+void addTriangle( bench::Mesh& mesh, const float3& v0, const float3& v1, const float3& v2 )
+{
+	const uint32_t base = static_cast<uint32_t>( mesh.vertices.size() );
+	mesh.vertices.insert( mesh.vertices.end(), { v0, v1, v2 } );
+	mesh.indices.insert( mesh.indices.end(), { base, base + 1, base + 2 } );
+}
+
+// the quad spanned by u and v from the corner p
+void addQuad( bench::Mesh& mesh, const float3& p, const float3& u, const float3& v )
+{
+	const uint32_t base = static_cast<uint32_t>( mesh.vertices.size() );
+	mesh.vertices.insert( mesh.vertices.end(), { p, p + u, p + u + v, p + v } );
+	mesh.indices.insert( mesh.indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 } );
+}
+
+void addBox( bench::Mesh& mesh, const float3& mi, const float3& ma )
+{
+	const float3 e = ma - mi;
+	addQuad( mesh, mi, { 0.0f, e.y, 0.0f }, { e.x, 0.0f, 0.0f } );
+	addQuad( mesh, mi, { 0.0f, 0.0f, e.z }, { 0.0f, e.y, 0.0f } );
+	addQuad( mesh, mi, { e.x, 0.0f, 0.0f }, { 0.0f, 0.0f, e.z } );
+	addQuad( mesh, ma, { -e.x, 0.0f, 0.0f }, { 0.0f, -e.y, 0.0f } );
+	addQuad( mesh, ma, { 0.0f, -e.y, 0.0f }, { 0.0f, 0.0f, -e.z } );
+	addQuad( mesh, ma, { 0.0f, 0.0f, -e.z }, { -e.x, 0.0f, 0.0f } );
+}
+
+bench::Instance
+createInstance( hiprtInstanceType type, uint32_t index, const float3& translation, float angle = 0.0f, float scale = 1.0f )
+{
+	bench::Instance instance;
+	instance.type				 = type;
+	instance.index				 = index;
+	instance.frame.rotation		 = { 0.0f, 1.0f, 0.0f, angle };
+	instance.frame.scale		 = { scale, scale, scale };
+	instance.frame.translation	 = translation;
+	instance.frame.time			 = 0.0f;
+	return instance;
+}
+
+// triangles of a random orientation, their size is drawn log-uniformly from [minSize, maxSize]
+bench::Mesh createSoup( Generator& generator, uint32_t triangleCount, float minSize, float maxSize )
+{
+	bench::Mesh mesh;
+	for ( uint32_t i = 0; i < triangleCount; ++i )
+	{
+		// the generator is called in separate statements, the order of arguments is unspecified
+		const float	 size	= minSize * std::pow( maxSize / minSize, generator.uniform() );
+		const float3 center = generator.point();
+		const float3 v0		= center + generator.direction() * size;
+		const float3 v1		= center + generator.direction() * size;
+		const float3 v2		= center + generator.direction() * size;
+		addTriangle( mesh, v0, v1, v2 );
+	}
+	return mesh;
+}
+
+// thin ribbons growing from the ground with a random curl
+bench::Mesh createHair( Generator& generator, uint32_t triangleCount )
+{
+	constexpr uint32_t SegmentCount = 16u;
+	constexpr float	   Width		= 0.002f;
+	constexpr float	   Length		= 0.4f;
+
+	bench::Mesh	   mesh;
+	const uint32_t strandCount = std::max( triangleCount / ( 2u * SegmentCount ), 1u );
+	for ( uint32_t i = 0; i < strandCount; ++i )
+	{
+		float3		 p		   = { generator.uniform(), 0.0f, generator.uniform() };
+		float3		 direction = normalize( float3{ 0.0f, 1.0f, 0.0f } + generator.direction() * 0.3f );
+		const float3 curl	   = generator.direction() * 0.15f;
+		for ( uint32_t j = 0; j < SegmentCount; ++j )
+		{
+			const float3 next = p + direction * ( Length / SegmentCount );
+			const float3 side = normalize( cross( direction, float3{ 0.0f, 0.0f, 1.0f } ) + make_float3( 1e-3f ) ) * Width;
+			addQuad( mesh, p - side * 0.5f, side, next - p );
+			p		  = next;
+			direction = normalize( direction + curl );
+		}
+	}
+	return mesh;
+}
+
+// clusters of overlapping alpha cards, like the leaves of plants
+bench::Mesh createFoliage( Generator& generator, uint32_t triangleCount, float cardSize )
+{
+	constexpr uint32_t CardsPerPlant = 64u;
+
+	bench::Mesh	   mesh;
+	const uint32_t cardCount = std::max( triangleCount / 2u, 1u );
+	float3		   plant	 = {};
+	for ( uint32_t i = 0; i < cardCount; ++i )
+	{
+		if ( i % CardsPerPlant == 0 )
+			plant = { generator.uniform( 0.1f, 0.9f ), generator.uniform( 0.0f, 0.6f ), generator.uniform( 0.1f, 0.9f ) };
+		const float3 u = generator.direction() * cardSize;
+		const float3 v = normalize( cross( u, generator.direction() ) + make_float3( 1e-3f ) ) * cardSize;
+		const float3 p = plant + generator.point( -0.1f, 0.1f );
+		addQuad( mesh, p, u, v );
+	}
+	return mesh;
+}
+
+// a stack of boxes getting narrower towards the top
+bench::Mesh createBuilding( Generator& generator, uint32_t floorCount )
+{
+	bench::Mesh mesh;
+	float		y	  = 0.0f;
+	float		width = generator.uniform( 0.6f, 0.9f );
+	for ( uint32_t i = 0; i < floorCount; ++i )
+	{
+		const float height = generator.uniform( 0.05f, 0.15f );
+		addBox( mesh, { -width * 0.5f, y, -width * 0.5f }, { width * 0.5f, y + height, width * 0.5f } );
+		y += height;
+		width *= generator.uniform( 0.9f, 1.0f );
+	}
+	return mesh;
+}
+} // namespace
+
+namespace bench
+{
+uint64_t Scene::uniqueTriangleCount() const
+{
+	uint64_t count = 0u;
+	for ( const Mesh& mesh : meshes )
+		count += mesh.triangleCount();
+	return count;
+}
+
+uint64_t Scene::instancedTriangleCount() const
+{
+	if ( levels.empty() ) return uniqueTriangleCount();
+
+	std::vector<uint64_t> levelCounts;
+	for ( const std::vector<Instance>& level : levels )
+	{
+		uint64_t count = 0u;
+		for ( const Instance& instance : level )
+			count += instance.type == hiprtInstanceTypeGeometry ? meshes[instance.index].triangleCount()
+																: levelCounts[instance.index];
+		levelCounts.push_back( count );
+	}
+	return levelCounts.back();
+}
+
+const char* getSceneName( SceneType type )
+{
+	switch ( type )
+	{
+	case SceneType::TriangleSoup:
+		return "triangleSoup";
+	case SceneType::HairStrands:
+		return "hairStrands";
+	case SceneType::FoliageCards:
+		return "foliageCards";
+	case SceneType::CityBlocks:
+		return "cityBlocks";
+	case SceneType::PrimitiveSizes:
+		return "primitiveSizes";
+	case SceneType::MultiLevelInstancing:
+		return "multiLevelInstancing";
+	}
+	return "unknown";
+}
+
+Scene generateScene( SceneType type, uint32_t triangleCount, uint32_t seed )
+{
+	Generator generator( seed );
+	Scene	  scene;
+	switch ( type )
+	{
+	case SceneType::TriangleSoup: {
+		const float size = 0.5f / std::cbrt( static_cast<float>( std::max( triangleCount, 1u ) ) );
+		scene.meshes.push_back( createSoup( generator, triangleCount, size, size ) );
+		break;
+	}
+	case SceneType::HairStrands: {
+		scene.meshes.push_back( createHair( generator, triangleCount ) );
+		break;
+	}
+	case SceneType::FoliageCards: {
+		scene.meshes.push_back( createFoliage( generator, triangleCount, 0.03f ) );
+		break;
+	}
+	case SceneType::PrimitiveSizes: {
+		scene.meshes.push_back( createSoup( generator, triangleCount, 1e-4f, 0.5f ) );
+		break;
+	}
+	case SceneType::CityBlocks: {
+		// a few unique buildings on a grid of blocks with streets between them
+		constexpr uint32_t BuildingCount = 16u;
+		constexpr uint32_t FloorCount	 = 24u;
+		constexpr uint32_t BlockSize	 = 4u;
+		for ( uint32_t i = 0; i < BuildingCount; ++i )
+			scene.meshes.push_back( createBuilding( generator, FloorCount ) );
+
+		const uint32_t instanceCount = std::max( triangleCount / scene.meshes[0].triangleCount(), 1u );
+		const uint32_t gridSize		 = static_cast<uint32_t>( std::ceil( std::sqrt( static_cast<float>( instanceCount ) ) ) );
+		scene.levels.emplace_back();
+		for ( uint32_t i = 0; i < instanceCount; ++i )
+		{
+			const uint32_t x		   = i % gridSize;
+			const uint32_t z		   = i / gridSize;
+			const float3   translation = { x + 0.5f * ( x / BlockSize ), 0.0f, z + 0.5f * ( z / BlockSize ) };
+			const float	   scale	   = generator.uniform( 0.8f, 1.2f );
+			scene.levels.back().push_back(
+				createInstance( hiprtInstanceTypeGeometry, i % BuildingCount, translation, 0.5f * hiprt::Pi * ( i % 4 ), scale ) );
+		}
+		break;
+	}
+	case SceneType::MultiLevelInstancing: {
+		// plants in groves, groves in forest tiles and the tiles in the top level
+		constexpr uint32_t PlantsPerGrove = 16u;
+		constexpr uint32_t GrovesPerTile  = 16u;
+		constexpr uint32_t PlantTriangles = 256u;
+		scene.meshes.push_back( createFoliage( generator, PlantTriangles, 0.1f ) );
+		scene.meshes.push_back( createSoup( generator, PlantTriangles, 0.05f, 0.2f ) );
+
+		scene.levels.resize( 3 );
+		for ( uint32_t i = 0; i < PlantsPerGrove; ++i )
+		{
+			const float3 translation = { generator.uniform( 0.0f, 4.0f ), 0.0f, generator.uniform( 0.0f, 4.0f ) };
+			const float	 angle		 = generator.uniform( 0.0f, 2.0f * hiprt::Pi );
+			const float	 scale		 = generator.uniform( 0.5f, 1.5f );
+			scene.levels[0].push_back( createInstance( hiprtInstanceTypeGeometry, i % 2, translation, angle, scale ) );
+		}
+		for ( uint32_t i = 0; i < GrovesPerTile; ++i )
+			scene.levels[1].push_back( createInstance(
+				hiprtInstanceTypeScene,
+				0u,
+				{ 5.0f * ( i % 4 ), 0.0f, 5.0f * ( i / 4 ) },
+				0.5f * hiprt::Pi * ( i % 4 ) ) );
+
+		const uint32_t tileCount = std::max( triangleCount / ( PlantTriangles * PlantsPerGrove * GrovesPerTile ), 1u );
+		const uint32_t gridSize	 = static_cast<uint32_t>( std::ceil( std::sqrt( static_cast<float>( tileCount ) ) ) );
+		for ( uint32_t i = 0; i < tileCount; ++i )
+			scene.levels[2].push_back(
+				createInstance( hiprtInstanceTypeScene, 1u, { 20.0f * ( i % gridSize ), 0.0f, 20.0f * ( i / gridSize ) } ) );
+		break;
+	}
+	}
+	return scene;
+}
+
+Scene loadObjScene( const std::filesystem::path& path )
+{
+	tinyobj::attrib_t				 attrib;
+	std::vector<tinyobj::shape_t>	 shapes;
+	std::vector<tinyobj::material_t> materials;
+	std::string						 warning;
+	std::string						 error;
+	if ( !tinyobj::LoadObj(
+			 &attrib, &shapes, &materials, &warning, &error, path.string().c_str(), path.parent_path().string().c_str() ) )
+		throw std::runtime_error( "Unable to load '" + path.string() + "': " + error );
+
+	// tinyobj triangulates the faces
+	Scene scene;
+	Mesh& mesh = scene.meshes.emplace_back();
+	for ( size_t i = 0; i + 2 < attrib.vertices.size(); i += 3 )
+		mesh.vertices.push_back( { attrib.vertices[i], attrib.vertices[i + 1], attrib.vertices[i + 2] } );
+	for ( const tinyobj::shape_t& shape : shapes )
+		for ( const tinyobj::index_t& index : shape.mesh.indices )
+			mesh.indices.push_back( static_cast<uint32_t>( index.vertex_index ) );
+
+	if ( mesh.indices.empty() ) throw std::runtime_error( "No triangles in '" + path.string() + "'" );
+	return scene;
+}
+
+std::vector<SceneSource>
+getSceneSources( const std::vector<uint32_t>& sizes, const std::vector<std::filesystem::path>& objPaths )
+{
+	std::vector<SceneSource> sources;
+	for ( const SceneType type : SceneTypes )
+		for ( const uint32_t size : sizes )
+			sources.push_back(
+				{ std::string( getSceneName( type ) ) + "/" + std::to_string( size ), [=]() { return generateScene( type, size ); } } );
+	for ( const std::filesystem::path& path : objPaths )
+		sources.push_back( { path.stem().string(), [=]() { return loadObjScene( path ); } } );
+	return sources;
+}
+} // namespace bench
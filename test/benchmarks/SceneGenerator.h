@@ -0,0 +1,98 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <hiprt/hiprt.h>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+struct Mesh
+{
+	std::vector<hiprtFloat3> vertices;
+	std::vector<uint32_t>	 indices;
+
+	uint32_t triangleCount() const { return static_cast<uint32_t>( indices.size() / 3 ); }
+};
+
+// an instance of a mesh, or of a scene of a lower level
+struct Instance
+{
+	hiprtInstanceType type;
+	uint32_t		  index;
+	hiprtFrameSRT	  frame;
+};
+
+// a single mesh if there are no levels, otherwise the last level is the top level scene
+struct Scene
+{
+	std::vector<Mesh>				   meshes;
+	std::vector<std::vector<Instance>> levels;
+
+	uint64_t uniqueTriangleCount() const;
+	uint64_t instancedTriangleCount() const;
+};
+
+enum class SceneType
+{
+	TriangleSoup,
+	HairStrands,
+	FoliageCards,
+	CityBlocks,
+	PrimitiveSizes,
+	MultiLevelInstancing
+};
+
+constexpr SceneType SceneTypes[] = {
+	SceneType::TriangleSoup,
+	SceneType::HairStrands,
+	SceneType::FoliageCards,
+	SceneType::CityBlocks,
+	SceneType::PrimitiveSizes,
+	SceneType::MultiLevelInstancing };
+
+const char* getSceneName( SceneType type );
+
+// procedural scenes of about 'triangleCount' instanced triangles, the meshes are about the unit cube and
+// the instanced scenes extend along x and z, the same seed gives the same scene on every platform
+Scene generateScene( SceneType type, uint32_t triangleCount, uint32_t seed = 1u );
+
+// the shapes of the OBJ file merged into one mesh, throws std::runtime_error if it cannot be read
+Scene loadObjScene( const std::filesystem::path& path );
+
+// a scene of a suite, it is only created if one of its benchmarks runs
+struct SceneSource
+{
+	std::string			   name;
+	std::function<Scene()> create;
+};
+
+// the generated scenes of every type and size, named <type>/<size>, followed by the OBJ files named
+// by their stem
+std::vector<SceneSource>
+getSceneSources( const std::vector<uint32_t>& sizes, const std::vector<std::filesystem::path>& objPaths );
+} // namespace bench
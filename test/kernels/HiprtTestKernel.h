@@ -184,6 +184,24 @@ extern "C" __global__ void MeshIntersectionKernel( hiprtGeometry geom, uint8_t*
 	image[index * 4 + 3] = 255;
 }
 
+extern "C" __global__ void
+TraversalStatisticsKernel( hiprtGeometry geom, hiprtTraversalStatistics* statistics, uint2 resolution )
+{
+	const uint32_t x	 = blockIdx.x * blockDim.x + threadIdx.x;
+	const uint32_t y	 = blockIdx.y * blockDim.y + threadIdx.y;
+	const uint32_t index = x + y * resolution.x;
+
+	hiprtRay	 ray;
+	const float3 o = { x / static_cast<float>( resolution.x ), y / static_cast<float>( resolution.y ), -1.0f };
+	const float3 d = { 0.0f, 0.0f, 1.0f };
+	ray.origin	   = o;
+	ray.direction  = d;
+
+	hiprtGeomTraversalClosest tr( geom, ray );
+	tr.getNextHit();
+	statistics[index] = tr.getStatistics();
+}
+
 extern "C" __global__ void PairTrianglesKernel( hiprtScene scene, uint8_t* image, uint2 resolution )
 {
 	const uint32_t x	 = blockIdx.x * blockDim.x + threadIdx.x;
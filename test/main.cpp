@@ -30,6 +30,9 @@
 #include <cassert>
 #include <map>
 #include <chrono>
+#include <random>
+#include <fstream>
+#include <thread>
 
 ///
 
@@ -784,6 +787,911 @@ TEST_F( hiprtTest, BoundingBox )
 	checkHiprt( hiprtDestroyContext( ctxt ) );
 }
 
+TEST_F( hiprtTest, BvhStatistics )
+{
+	hiprtContext ctxt;
+	checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+
+	hiprtTriangleMeshPrimitive mesh;
+	mesh.triangleCount	= CornellBoxTriangleCount;
+	mesh.triangleStride = sizeof( uint3 );
+	malloc( reinterpret_cast<uint3*&>( mesh.triangleIndices ), mesh.triangleCount );
+	std::array<uint32_t, 3 * CornellBoxTriangleCount> idx;
+	std::iota( idx.begin(), idx.end(), 0 );
+	copyHtoD( reinterpret_cast<uint3*>( mesh.triangleIndices ), reinterpret_cast<uint3*>( idx.data() ), mesh.triangleCount );
+
+	mesh.vertexCount  = 3 * mesh.triangleCount;
+	mesh.vertexStride = sizeof( float3 );
+	malloc( reinterpret_cast<float3*&>( mesh.vertices ), mesh.vertexCount );
+	copyHtoD( reinterpret_cast<float3*>( mesh.vertices ), const_cast<float3*>( cornellBoxVertices.data() ), mesh.vertexCount );
+
+	hiprtGeometryBuildInput geomInput;
+	geomInput.type					 = hiprtPrimitiveTypeTriangleMesh;
+	geomInput.primitive.triangleMesh = mesh;
+
+	for ( hiprtBuildFlags buildFlags :
+		  { hiprtBuildFlagBitPreferFastBuild, hiprtBuildFlagBitPreferBalancedBuild, hiprtBuildFlagBitPreferHighQualityBuild } )
+	{
+		size_t			  geomTempSize;
+		hiprtDevicePtr	  geomTemp;
+		hiprtBuildOptions options;
+		options.buildFlags = buildFlags;
+		checkHiprt( hiprtGetGeometryBuildTemporaryBufferSize( ctxt, geomInput, options, geomTempSize ) );
+		malloc( reinterpret_cast<uint8_t*&>( geomTemp ), geomTempSize );
+
+		hiprtGeometry geom;
+		checkHiprt( hiprtCreateGeometry( ctxt, geomInput, options, geom ) );
+		checkHiprt( hiprtBuildGeometry( ctxt, hiprtBuildOperationBuild, geomInput, options, geomTemp, 0, geom ) );
+
+		hiprtBvhStatistics stats;
+		checkHiprt( hiprtGetGeometryStatistics( ctxt, geom, stats ) );
+
+		printf(
+			"Bvh statistics (flags %u): cost %f, depth %u/%f, box nodes %u, leaves %u, overlap %f, duplication %f\n",
+			buildFlags,
+			stats.sahCost,
+			stats.maxDepth,
+			stats.averageLeafDepth,
+			stats.boxNodeCount,
+			stats.leafNodeCount,
+			stats.siblingOverlapRatio,
+			stats.referenceDuplicationFactor );
+
+		uint32_t histogramSum = 0;
+		for ( uint32_t i = 0; i <= hiprtBranchingFactor; ++i )
+			histogramSum += stats.childCountHistogram[i];
+
+		ASSERT_EQ( stats.primCount, mesh.triangleCount );
+		ASSERT_GE( stats.primReferenceCount, stats.primCount );
+		ASSERT_GE( stats.referenceDuplicationFactor, 1.0f );
+		ASSERT_EQ( histogramSum, stats.boxNodeCount );
+		ASSERT_GE( stats.memorySize, stats.boxNodeCount * sizeof( hiprtBvhNode ) );
+		ASSERT_GE( stats.sahCost, 1.0f );
+		ASSERT_GE( stats.averageLeafDepth, 1.0f );
+		ASSERT_LE( stats.averageLeafDepth, static_cast<float>( stats.maxDepth ) );
+
+		free( geomTemp );
+		checkHiprt( hiprtDestroyGeometry( ctxt, geom ) );
+	}
+
+	free( mesh.triangleIndices );
+	free( mesh.vertices );
+	checkHiprt( hiprtDestroyContext( ctxt ) );
+}
+
+TEST_F( hiprtTest, BuildProfiler )
+{
+	hiprtContext ctxt;
+	checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+	hiprtEnableBuildProfiler( ctxt, true );
+
+	hiprtTriangleMeshPrimitive mesh;
+	mesh.triangleCount	= CornellBoxTriangleCount;
+	mesh.triangleStride = sizeof( uint3 );
+	malloc( reinterpret_cast<uint3*&>( mesh.triangleIndices ), mesh.triangleCount );
+	std::array<uint32_t, 3 * CornellBoxTriangleCount> idx;
+	std::iota( idx.begin(), idx.end(), 0 );
+	copyHtoD( reinterpret_cast<uint3*>( mesh.triangleIndices ), reinterpret_cast<uint3*>( idx.data() ), mesh.triangleCount );
+
+	mesh.vertexCount  = 3 * mesh.triangleCount;
+	mesh.vertexStride = sizeof( float3 );
+	malloc( reinterpret_cast<float3*&>( mesh.vertices ), mesh.vertexCount );
+	copyHtoD( reinterpret_cast<float3*>( mesh.vertices ), const_cast<float3*>( cornellBoxVertices.data() ), mesh.vertexCount );
+
+	hiprtGeometryBuildInput geomInput;
+	geomInput.type					 = hiprtPrimitiveTypeTriangleMesh;
+	geomInput.primitive.triangleMesh = mesh;
+
+	const hiprtBuildFlags buildFlags[] = {
+		hiprtBuildFlagBitPreferFastBuild, hiprtBuildFlagBitPreferBalancedBuild, hiprtBuildFlagBitPreferHighQualityBuild };
+	for ( hiprtBuildFlags flags : buildFlags )
+	{
+		size_t			  geomTempSize;
+		hiprtDevicePtr	  geomTemp;
+		hiprtBuildOptions options;
+		options.buildFlags = flags;
+		checkHiprt( hiprtGetGeometryBuildTemporaryBufferSize( ctxt, geomInput, options, geomTempSize ) );
+		malloc( reinterpret_cast<uint8_t*&>( geomTemp ), geomTempSize );
+
+		hiprtGeometry geom;
+		checkHiprt( hiprtCreateGeometry( ctxt, geomInput, options, geom ) );
+		checkHiprt( hiprtBuildGeometry( ctxt, hiprtBuildOperationBuild, geomInput, options, geomTemp, 0, geom ) );
+		checkHiprt( hiprtDestroyGeometry( ctxt, geom ) );
+		free( geomTemp );
+	}
+
+	uint32_t count = 0;
+	checkHiprt( hiprtGetBuildProfile( ctxt, count, nullptr ) );
+	ASSERT_EQ( count, 3u );
+
+	// the most recent build first
+	hiprtBuildProfile profiles[3];
+	checkHiprt( hiprtGetBuildProfile( ctxt, count, profiles ) );
+	ASSERT_EQ( count, 3u );
+	ASSERT_STREQ( profiles[0].builder, "Sbvh" );
+	ASSERT_STREQ( profiles[1].builder, "Ploc" );
+	ASSERT_STREQ( profiles[2].builder, "Lbvh" );
+	for ( const hiprtBuildProfile& profile : profiles )
+	{
+		float phaseTime = 0.0f;
+		ASSERT_GT( profile.phaseCount, 0u );
+		for ( uint32_t i = 0; i < profile.phaseCount; ++i )
+		{
+			ASSERT_NE( profile.phaseNames[i], nullptr );
+			ASSERT_GE( profile.phaseTimes[i], 0.0f );
+			phaseTime += profile.phaseTimes[i];
+		}
+		ASSERT_GT( phaseTime, 0.0f );
+		ASSERT_GT( profile.totalTime, 0.0f );
+	}
+
+	hiprtEnableBuildProfiler( ctxt, false );
+	checkHiprt( hiprtGetBuildProfile( ctxt, count, nullptr ) );
+	ASSERT_EQ( count, 0u );
+
+	free( mesh.triangleIndices );
+	free( mesh.vertices );
+	checkHiprt( hiprtDestroyContext( ctxt ) );
+}
+
+TEST_F( hiprtTest, Tracing )
+{
+	hiprtContext ctxt;
+	checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+	hiprtEnableTracing( ctxt, true );
+
+	hiprtTriangleMeshPrimitive mesh;
+	mesh.triangleCount	= CornellBoxTriangleCount;
+	mesh.triangleStride = sizeof( uint3 );
+	malloc( reinterpret_cast<uint3*&>( mesh.triangleIndices ), mesh.triangleCount );
+	std::array<uint32_t, 3 * CornellBoxTriangleCount> idx;
+	std::iota( idx.begin(), idx.end(), 0 );
+	copyHtoD( reinterpret_cast<uint3*>( mesh.triangleIndices ), reinterpret_cast<uint3*>( idx.data() ), mesh.triangleCount );
+
+	mesh.vertexCount  = 3 * mesh.triangleCount;
+	mesh.vertexStride = sizeof( float3 );
+	malloc( reinterpret_cast<float3*&>( mesh.vertices ), mesh.vertexCount );
+	copyHtoD( reinterpret_cast<float3*>( mesh.vertices ), const_cast<float3*>( cornellBoxVertices.data() ), mesh.vertexCount );
+
+	hiprtGeometryBuildInput geomInput;
+	geomInput.type					 = hiprtPrimitiveTypeTriangleMesh;
+	geomInput.primitive.triangleMesh = mesh;
+
+	size_t			  geomTempSize;
+	hiprtDevicePtr	  geomTemp;
+	hiprtBuildOptions options;
+	options.buildFlags = hiprtBuildFlagBitPreferFastBuild;
+	checkHiprt( hiprtGetGeometryBuildTemporaryBufferSize( ctxt, geomInput, options, geomTempSize ) );
+	malloc( reinterpret_cast<uint8_t*&>( geomTemp ), geomTempSize );
+
+	hiprtGeometry geom;
+	checkHiprt( hiprtCreateGeometry( ctxt, geomInput, options, geom ) );
+	checkHiprt( hiprtBuildGeometry( ctxt, hiprtBuildOperationBuild, geomInput, options, geomTemp, 0, geom ) );
+
+	const char* filename = "trace.json";
+	checkHiprt( hiprtExportTrace( ctxt, filename ) );
+	std::ifstream	  file( filename );
+	const std::string json( ( std::istreambuf_iterator<char>( file ) ), std::istreambuf_iterator<char>() );
+	ASSERT_NE( json.find( "\"traceEvents\"" ), std::string::npos );
+	ASSERT_NE( json.find( "\"buildGeometries\"" ), std::string::npos );
+	ASSERT_NE( json.find( "\"Lbvh\"" ), std::string::npos );
+	ASSERT_NE( json.find( "\"ComputeMortonCodes\"" ), std::string::npos );
+	ASSERT_NE( json.find( "\"droppedEvents\": 0" ), std::string::npos );
+
+	// the exported spans are removed, so are the spans of a disabled session
+	auto readTrace = [&]() {
+		checkHiprt( hiprtExportTrace( ctxt, filename ) );
+		std::ifstream file( filename );
+		return std::string( ( std::istreambuf_iterator<char>( file ) ), std::istreambuf_iterator<char>() );
+	};
+	ASSERT_EQ( readTrace().find( "\"buildGeometries\"" ), std::string::npos );
+
+	checkHiprt( hiprtBuildGeometry( ctxt, hiprtBuildOperationBuild, geomInput, options, geomTemp, 0, geom ) );
+	hiprtEnableTracing( ctxt, false );
+	hiprtEnableTracing( ctxt, true );
+	ASSERT_EQ( readTrace().find( "\"buildGeometries\"" ), std::string::npos );
+
+	checkHiprt( hiprtBuildGeometry( ctxt, hiprtBuildOperationBuild, geomInput, options, geomTemp, 0, geom ) );
+	ASSERT_NE( readTrace().find( "\"buildGeometries\"" ), std::string::npos );
+
+	checkHiprt( hiprtDestroyGeometry( ctxt, geom ) );
+	free( geomTemp );
+	free( mesh.triangleIndices );
+	free( mesh.vertices );
+	checkHiprt( hiprtDestroyContext( ctxt ) );
+}
+
+TEST_F( hiprtTest, LogSinks )
+{
+	hiprtContext ctxt;
+	checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+
+	std::vector<std::string> warnings;
+	hiprtSetLogCallback(
+		[]( hiprtLogLevel level, const char* message, void* userData ) {
+			if ( level == hiprtLogLevelWarn ) static_cast<std::vector<std::string>*>( userData )->push_back( message );
+		},
+		&warnings );
+
+	const char* filename = "log.json";
+	std::filesystem::remove( filename );
+	checkHiprt( hiprtSetLogFile( filename, hiprtLogFormatJson ) );
+
+	// the repetitions of the warning within a second are only counted
+	hiprtGeometry geom = reinterpret_cast<hiprtGeometry>( &warnings );
+	for ( uint32_t i = 0; i < 100; ++i )
+		checkHiprt( hiprtDestroyGeometry( ctxt, geom ) );
+	hiprtFlushLog();
+
+	checkHiprt( hiprtSetLogFile( nullptr, hiprtLogFormatText ) );
+	hiprtSetLogCallback( nullptr, nullptr );
+
+	ASSERT_EQ( warnings.size(), 1 );
+	ASSERT_NE( warnings[0].find( "Trying to destroy a geometry not allocated in this context!" ), std::string::npos );
+
+	std::ifstream	  file( filename );
+	const std::string json( ( std::istreambuf_iterator<char>( file ) ), std::istreambuf_iterator<char>() );
+	ASSERT_NE( json.find( "\"level\": \"warn\"" ), std::string::npos );
+	ASSERT_NE( json.find( "\"message\": \"Trying to destroy a geometry not allocated in this context!\"" ), std::string::npos );
+
+	checkHiprt( hiprtDestroyContext( ctxt ) );
+}
+
+TEST_F( hiprtTest, GlobalTrianglePairing )
+{
+	hiprtContext ctxt;
+	checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+
+	// the small grid fits in a batch build, which must not skip the global pairing
+	for ( const uint32_t gridSize : { 64u, 8u } )
+	{
+		// a shuffled grid of quads, so the adjacent triangles are not in the same warp
+		std::vector<float3> vertices;
+		std::vector<uint3>	triangles;
+		for ( uint32_t j = 0; j <= gridSize; ++j )
+			for ( uint32_t i = 0; i <= gridSize; ++i )
+				vertices.push_back( { static_cast<float>( i ), static_cast<float>( j ), 0.0f } );
+		for ( uint32_t j = 0; j < gridSize; ++j )
+		{
+			for ( uint32_t i = 0; i < gridSize; ++i )
+			{
+				const uint32_t v0 = j * ( gridSize + 1 ) + i;
+				const uint32_t v1 = v0 + 1;
+				const uint32_t v2 = v0 + gridSize + 1;
+				const uint32_t v3 = v2 + 1;
+				triangles.push_back( { v0, v1, v3 } );
+				triangles.push_back( { v0, v3, v2 } );
+			}
+		}
+		std::mt19937 rng( 0 );
+		std::shuffle( triangles.begin(), triangles.end(), rng );
+
+		hiprtTriangleMeshPrimitive mesh;
+		mesh.triangleCount	= static_cast<uint32_t>( triangles.size() );
+		mesh.triangleStride = sizeof( uint3 );
+		malloc( reinterpret_cast<uint3*&>( mesh.triangleIndices ), mesh.triangleCount );
+		copyHtoD( reinterpret_cast<uint3*>( mesh.triangleIndices ), triangles.data(), mesh.triangleCount );
+
+		mesh.vertexCount  = static_cast<uint32_t>( vertices.size() );
+		mesh.vertexStride = sizeof( float3 );
+		malloc( reinterpret_cast<float3*&>( mesh.vertices ), mesh.vertexCount );
+		copyHtoD( reinterpret_cast<float3*>( mesh.vertices ), vertices.data(), mesh.vertexCount );
+
+		hiprtGeometryBuildInput geomInput;
+		geomInput.type					 = hiprtPrimitiveTypeTriangleMesh;
+		geomInput.primitive.triangleMesh = mesh;
+
+		float pairedTriangleRatios[2];
+		for ( uint32_t k = 0; k < 2; ++k )
+		{
+			size_t			  geomTempSize;
+			hiprtDevicePtr	  geomTemp;
+			hiprtBuildOptions options;
+			options.buildFlags = hiprtBuildFlagBitPreferFastBuild | ( k == 1 ? hiprtBuildFlagBitGlobalTrianglePairing : 0 );
+
+			options.batchBuildMaxPrimCount = std::min<uint32_t>( mesh.triangleCount, hiprtMaxBatchBuildMaxPrimCount );
+			checkHiprt( hiprtGetGeometryBuildTemporaryBufferSize( ctxt, geomInput, options, geomTempSize ) );
+			malloc( reinterpret_cast<uint8_t*&>( geomTemp ), geomTempSize );
+
+			hiprtGeometry geom;
+			checkHiprt( hiprtCreateGeometry( ctxt, geomInput, options, geom ) );
+			checkHiprt( hiprtBuildGeometry( ctxt, hiprtBuildOperationBuild, geomInput, options, geomTemp, 0, geom ) );
+
+			hiprtBvhStatistics stats;
+			checkHiprt( hiprtGetGeometryStatistics( ctxt, geom, stats ) );
+			ASSERT_EQ( stats.primCount, mesh.triangleCount );
+			pairedTriangleRatios[k] = stats.pairedTriangleRatio;
+
+			free( geomTemp );
+			checkHiprt( hiprtDestroyGeometry( ctxt, geom ) );
+		}
+
+		printf(
+			"Paired triangle ratio (%u triangles): local %f, global %f\n",
+			mesh.triangleCount,
+			pairedTriangleRatios[0],
+			pairedTriangleRatios[1] );
+		ASSERT_GE( pairedTriangleRatios[1], pairedTriangleRatios[0] );
+		ASSERT_GE( pairedTriangleRatios[1], 0.95f );
+
+		free( mesh.triangleIndices );
+		free( mesh.vertices );
+	}
+
+	checkHiprt( hiprtDestroyContext( ctxt ) );
+}
+
+TEST_F( hiprtTest, ConcurrentGeometryBuilds )
+{
+	hiprtContext ctxt;
+	checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+
+	constexpr uint32_t	ThreadCount = 4;
+	constexpr uint32_t	GridSize	= 16;
+	std::vector<float3> vertices;
+	std::vector<uint3>	triangles;
+	for ( uint32_t j = 0; j <= GridSize; ++j )
+		for ( uint32_t i = 0; i <= GridSize; ++i )
+			vertices.push_back( { static_cast<float>( i ), static_cast<float>( j ), 0.0f } );
+	for ( uint32_t j = 0; j < GridSize; ++j )
+	{
+		for ( uint32_t i = 0; i < GridSize; ++i )
+		{
+			const uint32_t v0 = j * ( GridSize + 1 ) + i;
+			triangles.push_back( { v0, v0 + 1, v0 + GridSize + 2 } );
+			triangles.push_back( { v0, v0 + GridSize + 2, v0 + GridSize + 1 } );
+		}
+	}
+
+	hiprtTriangleMeshPrimitive mesh;
+	mesh.triangleCount	= static_cast<uint32_t>( triangles.size() );
+	mesh.triangleStride = sizeof( uint3 );
+	malloc( reinterpret_cast<uint3*&>( mesh.triangleIndices ), mesh.triangleCount );
+	copyHtoD( reinterpret_cast<uint3*>( mesh.triangleIndices ), triangles.data(), mesh.triangleCount );
+
+	mesh.vertexCount  = static_cast<uint32_t>( vertices.size() );
+	mesh.vertexStride = sizeof( float3 );
+	malloc( reinterpret_cast<float3*&>( mesh.vertices ), mesh.vertexCount );
+	copyHtoD( reinterpret_cast<float3*>( mesh.vertices ), vertices.data(), mesh.vertexCount );
+
+	hiprtGeometryBuildInput geomInput;
+	geomInput.type					 = hiprtPrimitiveTypeTriangleMesh;
+	geomInput.primitive.triangleMesh = mesh;
+	geomInput.geomType				 = 0;
+
+	hiprtBuildOptions options;
+	options.buildFlags = hiprtBuildFlagBitPreferFastBuild;
+
+	size_t geomTempSize;
+	checkHiprt( hiprtGetGeometryBuildTemporaryBufferSize( ctxt, geomInput, options, geomTempSize ) );
+
+	// every thread builds on its own stream, the builders share the kernels of the context
+	hiprtDevicePtr			 geomTemps[ThreadCount];
+	oroStream				 streams[ThreadCount];
+	hiprtGeometry			 geoms[ThreadCount];
+	hiprtError				 errors[ThreadCount];
+	std::vector<std::thread> threads;
+	for ( uint32_t i = 0; i < ThreadCount; ++i )
+	{
+		malloc( reinterpret_cast<uint8_t*&>( geomTemps[i] ), geomTempSize );
+		checkOro( oroStreamCreate( &streams[i] ) );
+	}
+	for ( uint32_t i = 0; i < ThreadCount; ++i )
+	{
+		threads.emplace_back( [&, i]() {
+			errors[i] = hiprtCreateGeometry( ctxt, geomInput, options, geoms[i] );
+			for ( uint32_t k = 0; k < 8 && errors[i] == hiprtSuccess; ++k )
+				errors[i] = hiprtBuildGeometry(
+					ctxt, hiprtBuildOperationBuild, geomInput, options, geomTemps[i], streams[i], geoms[i] );
+		} );
+	}
+	for ( std::thread& thread : threads )
+		thread.join();
+
+	for ( uint32_t i = 0; i < ThreadCount; ++i )
+	{
+		ASSERT_EQ( errors[i], hiprtSuccess );
+		checkOro( oroStreamSynchronize( streams[i] ) );
+
+		hiprtBvhStatistics stats;
+		checkHiprt( hiprtGetGeometryStatistics( ctxt, geoms[i], stats ) );
+		ASSERT_EQ( stats.primCount, mesh.triangleCount );
+
+		checkHiprt( hiprtDestroyGeometry( ctxt, geoms[i] ) );
+		checkOro( oroStreamDestroy( streams[i] ) );
+		free( geomTemps[i] );
+	}
+
+	free( mesh.triangleIndices );
+	free( mesh.vertices );
+	checkHiprt( hiprtDestroyContext( ctxt ) );
+}
+
+TEST_F( hiprtTest, DeterministicBuild )
+{
+	hiprtContext ctxt;
+	checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+
+	// a shuffled grid of quads spanning many warps
+	constexpr uint32_t GridSize = 64;
+	std::vector<float3> vertices;
+	std::vector<uint3>	triangles;
+	for ( uint32_t j = 0; j <= GridSize; ++j )
+		for ( uint32_t i = 0; i <= GridSize; ++i )
+			vertices.push_back( { static_cast<float>( i ), static_cast<float>( j ), 0.0f } );
+	for ( uint32_t j = 0; j < GridSize; ++j )
+	{
+		for ( uint32_t i = 0; i < GridSize; ++i )
+		{
+			const uint32_t v0 = j * ( GridSize + 1 ) + i;
+			const uint32_t v1 = v0 + 1;
+			const uint32_t v2 = v0 + GridSize + 1;
+			const uint32_t v3 = v2 + 1;
+			triangles.push_back( { v0, v1, v3 } );
+			triangles.push_back( { v0, v3, v2 } );
+		}
+	}
+	std::mt19937 rng( 0 );
+	std::shuffle( triangles.begin(), triangles.end(), rng );
+
+	hiprtTriangleMeshPrimitive mesh;
+	mesh.triangleCount	= static_cast<uint32_t>( triangles.size() );
+	mesh.triangleStride = sizeof( uint3 );
+	malloc( reinterpret_cast<uint3*&>( mesh.triangleIndices ), mesh.triangleCount );
+	copyHtoD( reinterpret_cast<uint3*>( mesh.triangleIndices ), triangles.data(), mesh.triangleCount );
+
+	mesh.vertexCount  = static_cast<uint32_t>( vertices.size() );
+	mesh.vertexStride = sizeof( float3 );
+	malloc( reinterpret_cast<float3*&>( mesh.vertices ), mesh.vertexCount );
+	copyHtoD( reinterpret_cast<float3*>( mesh.vertices ), vertices.data(), mesh.vertexCount );
+
+	hiprtGeometryBuildInput geomInput;
+	geomInput.type					 = hiprtPrimitiveTypeTriangleMesh;
+	geomInput.primitive.triangleMesh = mesh;
+	geomInput.geomType				 = 0;
+
+	// the sbvh builder has no deterministic variant
+	{
+		hiprtBuildOptions options;
+		options.buildFlags = hiprtBuildFlagBitPreferHighQualityBuild | hiprtBuildFlagBitDeterministic;
+
+		size_t geomTempSize;
+		ASSERT_EQ(
+			hiprtGetGeometryBuildTemporaryBufferSize( ctxt, geomInput, options, geomTempSize ), hiprtErrorInvalidParameter );
+		hiprtGeometry geom;
+		ASSERT_EQ( hiprtCreateGeometry( ctxt, geomInput, options, geom ), hiprtErrorInvalidParameter );
+	}
+
+	const std::filesystem::path filename = std::filesystem::temp_directory_path() / "hiprt_deterministic.bin";
+
+	const hiprtBuildFlags buildFlags[] = { hiprtBuildFlagBitPreferFastBuild, hiprtBuildFlagBitPreferBalancedBuild };
+	for ( const hiprtBuildFlags buildFlag : buildFlags )
+	{
+		hiprtBuildOptions options;
+		options.buildFlags = buildFlag | hiprtBuildFlagBitDeterministic;
+
+		size_t		   geomTempSize;
+		hiprtDevicePtr geomTemp;
+		checkHiprt( hiprtGetGeometryBuildTemporaryBufferSize( ctxt, geomInput, options, geomTempSize ) );
+		malloc( reinterpret_cast<uint8_t*&>( geomTemp ), geomTempSize );
+
+		// the saved hierarchies of repeated builds must be bit-identical
+		std::vector<char> files[2];
+		for ( uint32_t k = 0; k < 2; ++k )
+		{
+			hiprtGeometry geom;
+			checkHiprt( hiprtCreateGeometry( ctxt, geomInput, options, geom ) );
+			checkHiprt( hiprtBuildGeometry( ctxt, hiprtBuildOperationBuild, geomInput, options, geomTemp, 0, geom ) );
+
+			hiprtBvhStatistics stats;
+			checkHiprt( hiprtGetGeometryStatistics( ctxt, geom, stats ) );
+			ASSERT_EQ( stats.primCount, mesh.triangleCount );
+
+			checkHiprt( hiprtSaveGeometry( ctxt, geom, filename.string().c_str() ) );
+			{
+				std::ifstream file( filename, std::ios::in | std::ios::binary );
+				files[k].assign( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+			}
+			std::filesystem::remove( filename );
+
+			checkHiprt( hiprtDestroyGeometry( ctxt, geom ) );
+		}
+		ASSERT_FALSE( files[0].empty() );
+		ASSERT_TRUE( files[0] == files[1] );
+
+		free( geomTemp );
+	}
+
+	free( mesh.triangleIndices );
+	free( mesh.vertices );
+	checkHiprt( hiprtDestroyContext( ctxt ) );
+}
+
+TEST_F( hiprtTest, KernelCachePack )
+{
+	const std::filesystem::path cacheDir = "cache_pack_test";
+	std::filesystem::remove_all( cacheDir );
+
+	// the second context finds the binary compiled by the first one in the pack
+	// even though the source looks newer, the cache is keyed by the content only
+	const std::filesystem::path kernelPath = getRootDir() / "test/kernels/HiprtTestKernel.h";
+	size_t						fileSizes[2];
+	for ( uint32_t k = 0; k < 2; ++k )
+	{
+		hiprtContext ctxt;
+		checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+		hiprtSetCacheDirPath( ctxt, cacheDir.string().c_str() );
+
+		oroFunction func;
+		if constexpr ( UseBitcode )
+			buildTraceKernelFromBitcode( ctxt, kernelPath, "MeshIntersectionKernel", func );
+		else
+			buildTraceKernel( ctxt, kernelPath, "MeshIntersectionKernel", func );
+		ASSERT_TRUE( func != nullptr );
+
+		hiprtCacheStatistics stats;
+		checkHiprt( hiprtGetCacheStatistics( ctxt, stats ) );
+		fileSizes[k] = stats.fileSize;
+
+		checkHiprt( hiprtDestroyContext( ctxt ) );
+		std::filesystem::last_write_time( kernelPath, std::filesystem::file_time_type::clock::now() );
+	}
+	ASSERT_EQ( fileSizes[0], fileSizes[1] );
+
+	ASSERT_TRUE( std::filesystem::exists( cacheDir / "hiprt_kernels.pack" ) );
+	ASSERT_TRUE( std::filesystem::exists( cacheDir / "hiprt_kernels.idx" ) );
+	for ( const auto& file : std::filesystem::directory_iterator( cacheDir ) )
+		ASSERT_NE( file.path().extension(), ".check" );
+
+	std::filesystem::remove_all( cacheDir );
+}
+
+TEST_F( hiprtTest, KernelCacheTrim )
+{
+	const std::filesystem::path cacheDir = "cache_trim_test";
+	std::filesystem::remove_all( cacheDir );
+
+	auto createContext = [&]() {
+		hiprtContext ctxt;
+		checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+		hiprtSetCacheDirPath( ctxt, cacheDir.string().c_str() );
+		return ctxt;
+	};
+
+	auto buildKernel = [&]( hiprtContext ctxt, const char* functionName ) {
+		oroFunction func;
+		if constexpr ( UseBitcode )
+			buildTraceKernelFromBitcode( ctxt, getRootDir() / "test/kernels/HiprtTestKernel.h", functionName, func );
+		else
+			buildTraceKernel( ctxt, getRootDir() / "test/kernels/HiprtTestKernel.h", functionName, func );
+	};
+
+	// the first context stores the binary
+	hiprtContext ctxt = createContext();
+	buildKernel( ctxt, "MeshIntersectionKernel" );
+	checkHiprt( hiprtDestroyContext( ctxt ) );
+
+	// the second one reads it, the access time is pending until the trim
+	ctxt = createContext();
+	buildKernel( ctxt, "MeshIntersectionKernel" );
+
+	hiprtCacheStatistics stats;
+	checkHiprt( hiprtGetCacheStatistics( ctxt, stats ) );
+	ASSERT_GE( stats.entryCount, 1u );
+	ASSERT_EQ( stats.staleEntryCount, 0u );
+	ASSERT_GE( stats.fileSize, stats.size );
+
+	// nothing is stale, pruning keeps every binary
+	checkHiprt( hiprtTrimCache( ctxt, 0 ) );
+	hiprtCacheStatistics prunedStats;
+	checkHiprt( hiprtGetCacheStatistics( ctxt, prunedStats ) );
+	ASSERT_EQ( prunedStats.entryCount, stats.entryCount );
+	ASSERT_EQ( prunedStats.size, stats.size );
+	checkHiprt( hiprtDestroyContext( ctxt ) );
+
+	// a store over the size limit trims with a pending access time as well
+	ctxt = createContext();
+	buildKernel( ctxt, "MeshIntersectionKernel" );
+	const size_t sizeLimit = stats.size + 1;
+	hiprtSetCacheSizeLimit( ctxt, sizeLimit );
+	buildKernel( ctxt, "PairTrianglesKernel" );
+	checkHiprt( hiprtGetCacheStatistics( ctxt, stats ) );
+	ASSERT_LE( stats.entryCount, 1u );
+	ASSERT_LE( stats.size, sizeLimit );
+
+	checkHiprt( hiprtTrimCache( ctxt, 1 ) );
+	checkHiprt( hiprtGetCacheStatistics( ctxt, stats ) );
+	ASSERT_EQ( stats.entryCount, 0u );
+	ASSERT_EQ( stats.size, 0u );
+
+	checkHiprt( hiprtDestroyContext( ctxt ) );
+	std::filesystem::remove_all( cacheDir );
+}
+
+TEST_F( hiprtTest, KernelCacheOffline )
+{
+	const std::filesystem::path cacheDir = "cache_offline_test";
+	std::filesystem::remove_all( cacheDir );
+
+	auto createContext = [&]( bool readOnly ) {
+		hiprtContext ctxt;
+		checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+		hiprtSetCacheDirPath( ctxt, cacheDir.string().c_str() );
+		hiprtSetCacheReadOnly( ctxt, readOnly );
+		return ctxt;
+	};
+
+	const std::filesystem::path kernelPath = getRootDir() / "test/kernels/HiprtTestKernel.h";
+
+	auto buildKernel = [&]( hiprtContext ctxt, oroFunction& func ) {
+		if constexpr ( UseBitcode )
+			return buildTraceKernelFromBitcode( ctxt, kernelPath, "MeshIntersectionKernel", func );
+		else
+			return buildTraceKernel( ctxt, kernelPath, "MeshIntersectionKernel", func );
+	};
+
+	// a read-only cache never compiles
+	oroFunction	 func = nullptr;
+	hiprtContext ctxt = createContext( true );
+	ASSERT_NE( buildKernel( ctxt, func ), hiprtSuccess );
+	checkHiprt( hiprtDestroyContext( ctxt ) );
+
+	if constexpr ( !UseBitcode )
+	{
+		// compiling for the device as a target only stores the binary, under the key of the device
+		oroDeviceProp props;
+		checkOro( oroGetDeviceProperties( &props, m_oroDevice ) );
+		const bool		  nvidia   = std::string( props.name ).find( "NVIDIA" ) != std::string::npos;
+		const std::string archName = nvidia ? "sm_" + std::to_string( props.major ) + std::to_string( props.minor )
+											: std::string( props.gcnArchName );
+
+		hiprtCompileTarget target;
+		target.deviceName = props.name;
+		target.archName	  = archName.c_str();
+
+		ctxt = createContext( false );
+		checkHiprt( hiprtSetCompileTarget( ctxt, &target ) );
+		checkHiprt( buildKernel( ctxt, func ) );
+		ASSERT_EQ( func, nullptr );
+		checkHiprt( hiprtDestroyContext( ctxt ) );
+	}
+	else
+	{
+		ctxt = createContext( false );
+		checkHiprt( buildKernel( ctxt, func ) );
+		checkHiprt( hiprtDestroyContext( ctxt ) );
+	}
+
+	// the device finds the binary in the read-only cache
+	ctxt = createContext( true );
+	checkHiprt( buildKernel( ctxt, func ) );
+	ASSERT_NE( func, nullptr );
+	checkHiprt( hiprtDestroyContext( ctxt ) );
+
+	std::filesystem::remove_all( cacheDir );
+}
+
+TEST_F( hiprtTest, KernelCacheCorruption )
+{
+	const std::filesystem::path cacheDir = "cache_corruption_test";
+	std::filesystem::remove_all( cacheDir );
+
+	// the first context stores the binary, the second one finds it corrupted and compiles it again,
+	// the third one reads the binary stored by the second one
+	const char* sources[] = { "\"source\": \"miss\"", "\"source\": \"miss\"", "\"source\": \"hit\"" };
+	for ( uint32_t k = 0; k < 3; ++k )
+	{
+		hiprtContext ctxt;
+		checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+		hiprtSetCacheDirPath( ctxt, cacheDir.string().c_str() );
+		hiprtEnableCompileTelemetry( ctxt, true );
+
+		const std::filesystem::path kernelPath = getRootDir() / "test/kernels/HiprtTestKernel.h";
+		oroFunction					func	   = nullptr;
+		if constexpr ( UseBitcode )
+			checkHiprt( buildTraceKernelFromBitcode( ctxt, kernelPath, "MeshIntersectionKernel", func ) );
+		else
+			checkHiprt( buildTraceKernel( ctxt, kernelPath, "MeshIntersectionKernel", func ) );
+		ASSERT_NE( func, nullptr );
+
+		const char* filename = "telemetry.json";
+		checkHiprt( hiprtExportCompileTelemetry( ctxt, filename ) );
+		std::ifstream	  file( filename );
+		const std::string json( ( std::istreambuf_iterator<char>( file ) ), std::istreambuf_iterator<char>() );
+		ASSERT_NE( json.find( sources[k] ), std::string::npos );
+
+		checkHiprt( hiprtDestroyContext( ctxt ) );
+
+		if ( k == 0 )
+		{
+			// the last byte of the pack belongs to the binary
+			std::fstream pack( cacheDir / "hiprt_kernels.pack", std::ios::in | std::ios::out | std::ios::binary );
+			pack.seekg( -1, std::ios::end );
+			const char byte = static_cast<char>( pack.get() ^ 0xff );
+			pack.seekp( -1, std::ios::end );
+			pack.put( byte );
+		}
+	}
+
+	std::filesystem::remove_all( cacheDir );
+}
+
+TEST_F( hiprtTest, CompileTelemetry )
+{
+	const std::filesystem::path cacheDir = "cache_telemetry_test";
+	std::filesystem::remove_all( cacheDir );
+
+	// the first context compiles the kernel, the second one reads it from the cache
+	const char* sources[] = { "\"source\": \"miss\"", "\"source\": \"hit\"" };
+	for ( uint32_t k = 0; k < 2; ++k )
+	{
+		hiprtContext ctxt;
+		checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+		hiprtSetCacheDirPath( ctxt, cacheDir.string().c_str() );
+		hiprtEnableCompileTelemetry( ctxt, true );
+
+		const std::filesystem::path kernelPath = getRootDir() / "test/kernels/HiprtTestKernel.h";
+		oroFunction					func;
+		if constexpr ( UseBitcode )
+			buildTraceKernelFromBitcode( ctxt, kernelPath, "MeshIntersectionKernel", func );
+		else
+			buildTraceKernel( ctxt, kernelPath, "MeshIntersectionKernel", func );
+
+		const char* filename = "telemetry.json";
+		checkHiprt( hiprtExportCompileTelemetry( ctxt, filename ) );
+		std::ifstream	  file( filename );
+		const std::string json( ( std::istreambuf_iterator<char>( file ) ), std::istreambuf_iterator<char>() );
+		ASSERT_NE( json.find( "\"MeshIntersectionKernel\"" ), std::string::npos );
+		ASSERT_NE( json.find( sources[k] ), std::string::npos );
+		ASSERT_NE( json.find( "\"compileTime\"" ), std::string::npos );
+
+		checkHiprt( hiprtDestroyContext( ctxt ) );
+	}
+
+	std::filesystem::remove_all( cacheDir );
+}
+
+TEST_F( hiprtTest, SharedCache )
+{
+	const std::filesystem::path cacheDir = "cache_shared_test";
+	std::filesystem::remove_all( cacheDir );
+
+	// builds the kernel in the context and returns the telemetry of the build
+	auto build = [&]( hiprtContext ctxt ) {
+		hiprtSetCacheDirPath( ctxt, cacheDir.string().c_str() );
+		hiprtEnableCompileTelemetry( ctxt, true );
+
+		const std::filesystem::path kernelPath = getRootDir() / "test/kernels/HiprtTestKernel.h";
+		oroFunction					func;
+		if constexpr ( UseBitcode )
+			buildTraceKernelFromBitcode( ctxt, kernelPath, "MeshIntersectionKernel", func );
+		else
+			buildTraceKernel( ctxt, kernelPath, "MeshIntersectionKernel", func );
+
+		const std::filesystem::path filename = std::filesystem::temp_directory_path() / "hiprt_shared_cache.json";
+		checkHiprt( hiprtExportCompileTelemetry( ctxt, filename.string().c_str() ) );
+		std::string json;
+		{
+			std::ifstream file( filename );
+			json.assign( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+		}
+		std::filesystem::remove( filename );
+		return json;
+	};
+
+	// the first context only fills the kernel cache
+	{
+		hiprtContext ctxt;
+		checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+		ASSERT_NE( build( ctxt ).find( "\"source\": \"miss\"" ), std::string::npos );
+		checkHiprt( hiprtDestroyContext( ctxt ) );
+	}
+
+	// the binary is read (and decrypted) by the first context holding it, the others share it
+	hiprtContext ctxts[3];
+	for ( hiprtContext& ctxt : ctxts )
+		checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+
+	const std::string json0 = build( ctxts[0] );
+	ASSERT_NE( json0.find( "\"source\": \"hit\"" ), std::string::npos );
+	ASSERT_NE( json0.find( "\"cacheReadCount\": 1" ), std::string::npos );
+
+	const std::string json1 = build( ctxts[1] );
+	ASSERT_NE( json1.find( "\"source\": \"hit\"" ), std::string::npos );
+	ASSERT_EQ( json1.find( "\"cacheReadCount\": 1" ), std::string::npos );
+	ASSERT_EQ( json1.find( "\"decryptCount\": 1" ), std::string::npos );
+
+	// the entry outlives the context that read it as long as another context holds it
+	checkHiprt( hiprtDestroyContext( ctxts[0] ) );
+	ASSERT_EQ( build( ctxts[2] ).find( "\"cacheReadCount\": 1" ), std::string::npos );
+
+	// and is released with the last context holding it
+	checkHiprt( hiprtDestroyContext( ctxts[1] ) );
+	checkHiprt( hiprtDestroyContext( ctxts[2] ) );
+	{
+		hiprtContext ctxt;
+		checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+		ASSERT_NE( build( ctxt ).find( "\"cacheReadCount\": 1" ), std::string::npos );
+		checkHiprt( hiprtDestroyContext( ctxt ) );
+	}
+
+	std::filesystem::remove_all( cacheDir );
+}
+
+TEST_F( hiprtTest, AsyncTraceKernels )
+{
+	// the bitcode path is covered by the synchronous tests
+	if constexpr ( UseBitcode ) return;
+
+	hiprtContext ctxt;
+	checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+
+	// independent modules compile in parallel, the inputs can be released right after the call
+	constexpr uint32_t		 TaskCount = 2;
+	std::vector<const char*> funcNames = { "MeshIntersectionKernel", "PairTrianglesKernel" };
+	hiprtApiFunction		 functions[TaskCount];
+	hiprtApiModule			 modules[TaskCount];
+	hiprtCompileTask		 tasks[TaskCount];
+
+	for ( uint32_t i = 0; i < TaskCount; ++i )
+	{
+		std::vector<std::filesystem::path> includeNamesData;
+		std::string						   src;
+		readSourceCode( getRootDir() / "test/kernels/HiprtTestKernel.h", src, includeNamesData );
+
+		std::vector<std::string> headersData( includeNamesData.size() );
+		std::vector<std::string> includeNamesStr( includeNamesData.size() );
+		std::vector<const char*> headers;
+		std::vector<const char*> includeNames;
+		for ( size_t j = 0; j < includeNamesData.size(); ++j )
+		{
+			readSourceCode( getRootDir() / includeNamesData[j], headersData[j] );
+			includeNamesStr[j] = includeNamesData[j].string();
+			includeNames.push_back( includeNamesStr[j].c_str() );
+			headers.push_back( headersData[j].c_str() );
+		}
+
+		const std::string moduleName = "AsyncTraceKernels" + std::to_string( i );
+		checkHiprt( hiprtBuildTraceKernelsAsync(
+			ctxt,
+			1,
+			&funcNames[i],
+			src.c_str(),
+			moduleName.c_str(),
+			static_cast<uint32_t>( headers.size() ),
+			headers.data(),
+			includeNames.data(),
+			0,
+			nullptr,
+			0,
+			1,
+			nullptr,
+			&functions[i],
+			&modules[i],
+			false,
+			tasks[i] ) );
+	}
+
+	// the first task is waited for, the second one is polled until it finishes and destroyed
+	bool ready = false;
+	checkHiprt( hiprtQueryCompileTask( ctxt, tasks[0], ready ) );
+	checkHiprt( hiprtWaitCompileTask( ctxt, tasks[0] ) );
+	do
+	{
+		checkHiprt( hiprtQueryCompileTask( ctxt, tasks[1], ready ) );
+	} while ( !ready );
+	checkHiprt( hiprtDestroyCompileTask( ctxt, tasks[1] ) );
+
+	for ( uint32_t i = 0; i < TaskCount; ++i )
+	{
+		ASSERT_TRUE( functions[i] != nullptr );
+		ASSERT_TRUE( modules[i] != nullptr );
+	}
+	ASSERT_NE( modules[0], modules[1] );
+
+	checkHiprt( hiprtDestroyContext( ctxt ) );
+}
+
 TEST_F( hiprtTest, CustomBvhImport )
 {
 	hiprtContext ctxt;
@@ -1003,6 +1911,86 @@ TEST_F( hiprtTest, MeshIntersection )
 	checkHiprt( hiprtDestroyContext( ctxt ) );
 }
 
+TEST_F( hiprtTest, TraversalStatistics )
+{
+	// the statistics mode changes the layout of the traversal objects, so it needs the kernels compiled from source
+	if constexpr ( UseBitcode ) return;
+
+	hiprtContext ctxt;
+	checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+
+	hiprtTriangleMeshPrimitive mesh;
+	mesh.triangleCount	= CornellBoxTriangleCount;
+	mesh.triangleStride = sizeof( uint3 );
+	malloc( reinterpret_cast<uint3*&>( mesh.triangleIndices ), mesh.triangleCount );
+	std::array<uint32_t, 3 * CornellBoxTriangleCount> idx;
+	std::iota( idx.begin(), idx.end(), 0 );
+	copyHtoD( reinterpret_cast<uint3*>( mesh.triangleIndices ), reinterpret_cast<uint3*>( idx.data() ), mesh.triangleCount );
+
+	mesh.vertexCount  = 3 * mesh.triangleCount;
+	mesh.vertexStride = sizeof( float3 );
+	malloc( reinterpret_cast<float3*&>( mesh.vertices ), mesh.vertexCount );
+	copyHtoD( reinterpret_cast<float3*>( mesh.vertices ), const_cast<float3*>( cornellBoxVertices.data() ), mesh.vertexCount );
+
+	hiprtGeometryBuildInput geomInput;
+	geomInput.type					 = hiprtPrimitiveTypeTriangleMesh;
+	geomInput.primitive.triangleMesh = mesh;
+
+	size_t			  geomTempSize;
+	hiprtDevicePtr	  geomTemp;
+	hiprtBuildOptions options;
+	options.buildFlags = hiprtBuildFlagBitPreferFastBuild;
+	checkHiprt( hiprtGetGeometryBuildTemporaryBufferSize( ctxt, geomInput, options, geomTempSize ) );
+	malloc( reinterpret_cast<uint8_t*&>( geomTemp ), geomTempSize );
+
+	hiprtGeometry geom;
+	checkHiprt( hiprtCreateGeometry( ctxt, geomInput, options, geom ) );
+	checkHiprt( hiprtBuildGeometry( ctxt, hiprtBuildOperationBuild, geomInput, options, geomTemp, 0, geom ) );
+
+	std::vector<const char*> opts = { "-DHIPRT_TRAVERSAL_STATISTICS" };
+	oroFunction				 func;
+	buildTraceKernel( ctxt, getRootDir() / "test/kernels/HiprtTestKernel.h", "TraversalStatisticsKernel", func, opts );
+
+	const uint32_t			  rayCount = g_parsedArgs.m_ww * g_parsedArgs.m_wh;
+	hiprtTraversalStatistics* statistics;
+	malloc( statistics, rayCount );
+	uint2 res = { g_parsedArgs.m_ww, g_parsedArgs.m_wh };
+
+	void* args[] = { &geom, &statistics, &res };
+	launchKernel( func, g_parsedArgs.m_ww, g_parsedArgs.m_wh, args );
+	waitForCompletion();
+
+	hiprtTraversalStatisticsSummary summary;
+	checkHiprt( hiprtSummarizeTraversalStatistics( ctxt, rayCount, statistics, summary ) );
+	ASSERT_EQ( summary.rayCount, rayCount );
+	ASSERT_GT( summary.internalNodeCount, 0u );
+	ASSERT_GT( summary.leafNodeCount, 0u );
+	ASSERT_GE( summary.triangleTestCount, summary.leafNodeCount );
+	ASSERT_EQ( summary.customIntersectionCount, 0u );
+	ASSERT_EQ( summary.instanceCount, 0u );
+	ASSERT_EQ( summary.stackOverflowRayCount, 0u );
+	ASSERT_GT( summary.maxStackDepth, 0u );
+	// the kernel uses the private stack with 64 entries
+	ASSERT_LE( summary.maxStackDepth, 64u );
+
+	uint32_t nodeRayCount  = 0;
+	uint32_t stackRayCount = 0;
+	for ( uint32_t i = 0; i < hiprtTraversalHistogramSize; ++i )
+	{
+		nodeRayCount += summary.internalNodeHistogram[i];
+		stackRayCount += summary.stackDepthHistogram[i];
+	}
+	ASSERT_EQ( nodeRayCount, rayCount );
+	ASSERT_EQ( stackRayCount, rayCount );
+
+	free( statistics );
+	free( mesh.triangleIndices );
+	free( mesh.vertices );
+	free( geomTemp );
+	checkHiprt( hiprtDestroyGeometry( ctxt, geom ) );
+	checkHiprt( hiprtDestroyContext( ctxt ) );
+}
+
 TEST_F( hiprtTest, MeshIntersectionNonIndexed )
 {
 	hiprtContext ctxt;
@@ -1295,14 +2283,163 @@ TEST_F( hiprtTest, CustomIntersection )
 	checkHiprt( hiprtCreateFuncTable( ctxt, 1, 1, funcTable ) );
 	checkHiprt( hiprtSetFuncTable( ctxt, funcTable, 0, 0, funcDataSet ) );
 
-	uint8_t* dst;
-	malloc( dst, g_parsedArgs.m_ww * g_parsedArgs.m_wh * 4 );
-	uint2 res = { g_parsedArgs.m_ww, g_parsedArgs.m_wh };
+	uint8_t* dst;
+	malloc( dst, g_parsedArgs.m_ww * g_parsedArgs.m_wh * 4 );
+	uint2 res = { g_parsedArgs.m_ww, g_parsedArgs.m_wh };
+
+	void* args[] = { &geom, &dst, &funcTable, &res };
+	launchKernel( func, g_parsedArgs.m_ww, g_parsedArgs.m_wh, args );
+	validateAndWriteImage( "CustomIntersection.png", dst, "CustomIntersection.png" );
+
+	free( list.aabbs );
+	free( geomTemp );
+	free( centers );
+	free( dst );
+	checkHiprt( hiprtDestroyFuncTable( ctxt, funcTable ) );
+	checkHiprt( hiprtDestroyGeometry( ctxt, geom ) );
+	checkHiprt( hiprtDestroyContext( ctxt ) );
+}
+
+TEST_F( hiprtTest, CustomLeafPrimCount )
+{
+	hiprtContext ctxt;
+	checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+
+	hiprtAABBListPrimitive list;
+	list.aabbCount	= 3;
+	list.aabbStride = 6 * sizeof( float );
+	malloc( reinterpret_cast<float3*&>( list.aabbs ), 6 );
+
+	float3 b[] = {
+		{ 0.15f, 0.40f, 0.0f },
+		{ 0.35f, 0.60f, 0.0f },
+		{ 0.40f, 0.40f, 0.0f },
+		{ 0.60f, 0.60f, 0.0f },
+		{ 0.65f, 0.40f, 0.0f },
+		{ 0.85f, 0.60f, 0.0f } };
+	copyHtoD( reinterpret_cast<float3*>( list.aabbs ), b, 6 );
+
+	hiprtGeometryBuildInput geomInput;
+	geomInput.type				 = hiprtPrimitiveTypeAABBList;
+	geomInput.primitive.aabbList = list;
+	geomInput.geomType			 = 0;
+
+	size_t			  geomTempSize;
+	hiprtDevicePtr	  geomTemp;
+	hiprtBuildOptions options;
+	options.buildFlags			   = hiprtBuildFlagBitPreferFastBuild;
+	options.customLeafMaxPrimCount = hiprtMaxCustomLeafPrimCount;
+	checkHiprt( hiprtGetGeometryBuildTemporaryBufferSize( ctxt, geomInput, options, geomTempSize ) );
+	malloc( reinterpret_cast<uint8_t*&>( geomTemp ), geomTempSize );
+
+	hiprtGeometry geom;
+	checkHiprt( hiprtCreateGeometry( ctxt, geomInput, options, geom ) );
+	checkHiprt( hiprtBuildGeometry( ctxt, hiprtBuildOperationBuild, geomInput, options, geomTemp, 0, geom ) );
+
+	hiprtFuncNameSet funcNameSet;
+	funcNameSet.intersectFuncName			   = "intersectCircle";
+	std::vector<hiprtFuncNameSet> funcNameSets = { funcNameSet };
+
+	oroFunction func;
+	buildTraceKernel(
+		ctxt,
+		getRootDir() / "test/kernels/HiprtTestKernel.h",
+		"CustomIntersectionKernel",
+		func,
+		std::nullopt,
+		funcNameSets,
+		1,
+		1 );
+
+	float* centers;
+	malloc( centers, 3 );
+	float h[] = { 0.25f, 0.5f, 0.75f };
+	copyHtoD( centers, h, 3 );
+
+	hiprtFuncDataSet funcDataSet;
+	funcDataSet.intersectFuncData = centers;
+
+	hiprtFuncTable funcTable;
+	checkHiprt( hiprtCreateFuncTable( ctxt, 1, 1, funcTable ) );
+	checkHiprt( hiprtSetFuncTable( ctxt, funcTable, 0, 0, funcDataSet ) );
+
+	uint8_t* dst;
+	malloc( dst, g_parsedArgs.m_ww * g_parsedArgs.m_wh * 4 );
+	uint2 res = { g_parsedArgs.m_ww, g_parsedArgs.m_wh };
+
+	// the image must match the one with single-primitive leaves
+	void* args[] = { &geom, &dst, &funcTable, &res };
+	launchKernel( func, g_parsedArgs.m_ww, g_parsedArgs.m_wh, args );
+	validateAndWriteImage( "CustomLeafPrimCount.png", dst, "CustomIntersection.png" );
+
+	// a grid of touching boxes is collapsed to multi-primitive leaves
+	constexpr uint32_t GridSize = 32;
+	std::vector<float3> gridBoxes;
+	for ( uint32_t j = 0; j < GridSize; ++j )
+	{
+		for ( uint32_t i = 0; i < GridSize; ++i )
+		{
+			gridBoxes.push_back( { static_cast<float>( i ), static_cast<float>( j ), 0.0f } );
+			gridBoxes.push_back( { static_cast<float>( i + 1 ), static_cast<float>( j + 1 ), 1.0f } );
+		}
+	}
+
+	hiprtAABBListPrimitive gridList;
+	gridList.aabbCount	= GridSize * GridSize;
+	gridList.aabbStride = 6 * sizeof( float );
+	malloc( reinterpret_cast<float3*&>( gridList.aabbs ), gridBoxes.size() );
+	copyHtoD( reinterpret_cast<float3*>( gridList.aabbs ), gridBoxes.data(), gridBoxes.size() );
+
+	hiprtGeometryBuildInput gridInput;
+	gridInput.type				 = hiprtPrimitiveTypeAABBList;
+	gridInput.primitive.aabbList = gridList;
+	gridInput.geomType			 = 0;
+
+	// the sbvh builder has no deterministic variant
+	{
+		hiprtBuildOptions options;
+		options.buildFlags = hiprtBuildFlagBitPreferHighQualityBuild | hiprtBuildFlagBitDeterministic;
+
+		size_t geomTempSize;
+		ASSERT_EQ(
+			hiprtGetGeometryBuildTemporaryBufferSize( ctxt, geomInput, options, geomTempSize ), hiprtErrorInvalidParameter );
+		hiprtGeometry geom;
+		ASSERT_EQ( hiprtCreateGeometry( ctxt, geomInput, options, geom ), hiprtErrorInvalidParameter );
+	}
+
+	const std::filesystem::path filename = std::filesystem::temp_directory_path() / "hiprt_deterministic.bin";
 
-	void* args[] = { &geom, &dst, &funcTable, &res };
-	launchKernel( func, g_parsedArgs.m_ww, g_parsedArgs.m_wh, args );
-	validateAndWriteImage( "CustomIntersection.png", dst, "CustomIntersection.png" );
+	const hiprtBuildFlags buildFlags[] = { hiprtBuildFlagBitPreferFastBuild, hiprtBuildFlagBitPreferBalancedBuild };
+	for ( const hiprtBuildFlags buildFlag : buildFlags )
+	{
+		options.buildFlags = buildFlag;
+
+		size_t		   gridTempSize;
+		hiprtDevicePtr gridTemp;
+		checkHiprt( hiprtGetGeometryBuildTemporaryBufferSize( ctxt, gridInput, options, gridTempSize ) );
+		malloc( reinterpret_cast<uint8_t*&>( gridTemp ), gridTempSize );
+
+		hiprtGeometry gridGeom;
+		checkHiprt( hiprtCreateGeometry( ctxt, gridInput, options, gridGeom ) );
+		checkHiprt( hiprtBuildGeometry( ctxt, hiprtBuildOperationBuild, gridInput, options, gridTemp, 0, gridGeom ) );
+
+		hiprtBvhStatistics stats;
+		checkHiprt( hiprtGetGeometryStatistics( ctxt, gridGeom, stats ) );
+		ASSERT_EQ( stats.primCount, GridSize * GridSize );
+		ASSERT_LT( stats.leafNodeCount, stats.primCount );
+
+		// refit must cover all primitives of a leaf
+		checkHiprt( hiprtBuildGeometry( ctxt, hiprtBuildOperationUpdate, gridInput, options, gridTemp, 0, gridGeom ) );
+		float3 aabbMin, aabbMax;
+		checkHiprt( hiprtExportGeometryAabb( ctxt, gridGeom, aabbMin, aabbMax ) );
+		ASSERT_EQ( aabbMax.x, static_cast<float>( GridSize ) );
+		ASSERT_EQ( aabbMax.y, static_cast<float>( GridSize ) );
+
+		free( gridTemp );
+		checkHiprt( hiprtDestroyGeometry( ctxt, gridGeom ) );
+	}
 
+	free( gridList.aabbs );
 	free( list.aabbs );
 	free( geomTemp );
 	free( centers );
@@ -1312,6 +2449,30 @@ TEST_F( hiprtTest, CustomIntersection )
 	checkHiprt( hiprtDestroyContext( ctxt ) );
 }
 
+TEST_F( hiprtTest, CustomPrimCountLimit )
+{
+	hiprtContext ctxt;
+	checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+
+	// the last bit of a custom primitive index is used by the leaves, the list is rejected before it is read
+	hiprtGeometryBuildInput geomInput;
+	geomInput.type							= hiprtPrimitiveTypeAABBList;
+	geomInput.primitive.aabbList.aabbs		= nullptr;
+	geomInput.primitive.aabbList.aabbCount	= 1u << 31;
+	geomInput.primitive.aabbList.aabbStride = 2 * sizeof( float4 );
+	geomInput.geomType						= 0;
+
+	hiprtBuildOptions options;
+	options.buildFlags = hiprtBuildFlagBitPreferFastBuild;
+
+	size_t		  geomTempSize;
+	hiprtGeometry geom;
+	ASSERT_EQ( hiprtGetGeometryBuildTemporaryBufferSize( ctxt, geomInput, options, geomTempSize ), hiprtErrorInvalidParameter );
+	ASSERT_EQ( hiprtCreateGeometry( ctxt, geomInput, options, geom ), hiprtErrorInvalidParameter );
+
+	checkHiprt( hiprtDestroyContext( ctxt ) );
+}
+
 TEST_F( hiprtTest, SceneIntersectionSingleton )
 {
 	hiprtContext ctxt;
@@ -2090,6 +3251,321 @@ TEST_F( hiprtTest, MotionBlur )
 	checkHiprt( hiprtDestroyContext( ctxt ) );
 }
 
+TEST_F( hiprtTest, MotionBlurTimeSegments )
+{
+	hiprtContext ctxt;
+	checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+
+	hiprtGeometry			   geomTris;
+	hiprtDevicePtr			   geomTempTris;
+	hiprtTriangleMeshPrimitive mesh;
+	{
+		mesh.triangleCount	= 1;
+		mesh.triangleStride = sizeof( uint3 );
+		malloc( reinterpret_cast<uint3*&>( mesh.triangleIndices ), mesh.triangleCount );
+		std::vector<uint32_t> idx( 3 * mesh.triangleCount );
+		std::iota( idx.begin(), idx.end(), 0 );
+		copyHtoD(
+			reinterpret_cast<uint3*>( mesh.triangleIndices ), reinterpret_cast<uint3*>( idx.data() ), mesh.triangleCount );
+
+		mesh.vertexCount  = 3;
+		mesh.vertexStride = sizeof( float3 );
+		malloc( reinterpret_cast<float3*&>( mesh.vertices ), mesh.vertexCount );
+		constexpr float Scale = 0.15f;
+		float3			v[]	  = {
+			   { Scale * sinf( 0.0f ), Scale * cosf( 0.0f ), 0.0f },
+			   { Scale * sinf( hiprt::Pi * 2.0f / 3.0f ), Scale * cosf( hiprt::Pi * 2.0f / 3.0f ), 0.0f },
+			   { Scale * sinf( hiprt::Pi * 4.0f / 3.0f ), Scale * cosf( hiprt::Pi * 4.0f / 3.0f ), 0.0f } };
+		copyHtoD( reinterpret_cast<float3*>( mesh.vertices ), v, mesh.vertexCount );
+
+		hiprtGeometryBuildInput geomInput;
+		geomInput.type					 = hiprtPrimitiveTypeTriangleMesh;
+		geomInput.primitive.triangleMesh = mesh;
+
+		size_t			  geomTempSize;
+		hiprtBuildOptions options;
+		options.buildFlags = hiprtBuildFlagBitPreferFastBuild;
+		checkHiprt( hiprtGetGeometryBuildTemporaryBufferSize( ctxt, geomInput, options, geomTempSize ) );
+		malloc( reinterpret_cast<uint8_t*&>( geomTempTris ), geomTempSize );
+
+		checkHiprt( hiprtCreateGeometry( ctxt, geomInput, options, geomTris ) );
+		checkHiprt( hiprtBuildGeometry( ctxt, hiprtBuildOperationBuild, geomInput, options, geomTempTris, 0, geomTris ) );
+	}
+
+	// the same motion as in the MotionBlur test
+	hiprtSceneBuildInput sceneInput;
+	{
+		hiprtInstance instTris;
+		instTris.type	  = hiprtInstanceTypeGeometry;
+		instTris.geometry = geomTris;
+
+		hiprtInstance instances[] = { instTris, instTris };
+
+		sceneInput.instanceCount = 2;
+		sceneInput.instanceMasks = nullptr;
+		malloc( reinterpret_cast<hiprtInstance*&>( sceneInput.instances ), sceneInput.instanceCount );
+		copyHtoD( reinterpret_cast<hiprtInstance*>( sceneInput.instances ), instances, sceneInput.instanceCount );
+
+		constexpr float Offset = 0.3f;
+		hiprtFrameSRT	frames[5];
+		frames[0].translation = { -0.25f, -Offset, 0.0f };
+		frames[0].scale		  = { 1.0f, 1.0f, 1.0f };
+		frames[0].rotation	  = { 0.0f, 0.0f, 1.0f, 0.0f };
+		frames[0].time		  = 0.0f;
+		frames[1].translation = { 0.0f, -Offset, 0.0f };
+		frames[1].scale		  = { 1.0f, 1.0f, 1.0f };
+		frames[1].rotation	  = { 0.0f, 0.0f, 1.0f, 0.0f };
+		frames[1].time		  = 0.35f;
+		frames[2].translation = { 0.25f, -Offset, 0.0f };
+		frames[2].scale		  = { 1.0f, 1.0f, 1.0f };
+		frames[2].rotation	  = { 0.0f, 0.0f, 1.0f, hiprt::Pi * 0.25f };
+		frames[2].time		  = 1.0f;
+		frames[3].translation = { 0.0f, Offset, 0.0f };
+		frames[3].scale		  = { 1.0f, 1.0f, 1.0f };
+		frames[3].rotation	  = { 0.0f, 0.0f, 1.0f, 0.0f };
+		frames[3].time		  = 0.0f;
+		frames[4].translation = { 0.0f, Offset, 0.0f };
+		frames[4].scale		  = { 1.0f, 1.0f, 1.0f };
+		frames[4].rotation	  = { 0.0f, 0.0f, 1.0f, hiprt::Pi * 0.5f };
+		frames[4].time		  = 1.0f;
+
+		sceneInput.frameCount = 5;
+		malloc( reinterpret_cast<hiprtFrameSRT*&>( sceneInput.instanceFrames ), sceneInput.frameCount );
+		copyHtoD( reinterpret_cast<hiprtFrameSRT*>( sceneInput.instanceFrames ), frames, sceneInput.frameCount );
+
+		hiprtTransformHeader headers[2];
+		headers[0].frameIndex = 0;
+		headers[0].frameCount = 3;
+		headers[1].frameIndex = 3;
+		headers[1].frameCount = 2;
+		malloc( reinterpret_cast<hiprtTransformHeader*&>( sceneInput.instanceTransformHeaders ), sceneInput.instanceCount );
+		copyHtoD(
+			reinterpret_cast<hiprtTransformHeader*>( sceneInput.instanceTransformHeaders ), headers, sceneInput.instanceCount );
+	}
+
+	oroFunction func;
+	buildTraceKernel( ctxt, getRootDir() / "test/kernels/HiprtTestKernel.h", "MotionBlurKernel", func );
+
+	uint8_t* dst;
+	malloc( dst, g_parsedArgs.m_ww * g_parsedArgs.m_wh * 4 );
+	uint2 res = { g_parsedArgs.m_ww, g_parsedArgs.m_wh };
+
+	float3 refAabbMin, refAabbMax;
+	for ( const uint32_t timeSegmentCount : { 1u, 4u } )
+	{
+		hiprtScene		  scene;
+		hiprtDevicePtr	  sceneTemp;
+		size_t			  sceneTempSize;
+		hiprtBuildOptions options;
+		options.buildFlags		 = hiprtBuildFlagBitPreferFastBuild;
+		options.timeSegmentCount = timeSegmentCount;
+		checkHiprt( hiprtGetSceneBuildTemporaryBufferSize( ctxt, sceneInput, options, sceneTempSize ) );
+		malloc( reinterpret_cast<uint8_t*&>( sceneTemp ), sceneTempSize );
+
+		checkHiprt( hiprtCreateScene( ctxt, sceneInput, options, scene ) );
+		checkHiprt( hiprtBuildScene( ctxt, hiprtBuildOperationBuild, sceneInput, options, sceneTemp, 0, scene ) );
+
+		// the segments together bound the whole motion
+		float3 aabbMin, aabbMax;
+		checkHiprt( hiprtExportSceneAabb( ctxt, scene, aabbMin, aabbMax ) );
+		if ( timeSegmentCount == 1 )
+		{
+			refAabbMin = aabbMin;
+			refAabbMax = aabbMax;
+		}
+		else
+		{
+			ASSERT_NEAR( aabbMin.x, refAabbMin.x, 1e-3f );
+			ASSERT_NEAR( aabbMin.y, refAabbMin.y, 1e-3f );
+			ASSERT_NEAR( aabbMax.x, refAabbMax.x, 1e-3f );
+			ASSERT_NEAR( aabbMax.y, refAabbMax.y, 1e-3f );
+		}
+
+		// every segment has a leaf per instance
+		hiprtBvhStatistics stats;
+		checkHiprt( hiprtGetSceneStatistics( ctxt, scene, stats ) );
+		ASSERT_EQ( stats.leafNodeCount, sceneInput.instanceCount * timeSegmentCount );
+		ASSERT_EQ( stats.primCount, sceneInput.instanceCount );
+
+		// the image must match the reference both for the built and the compacted scene (compaction releases the input)
+		for ( bool compact : { false, true } )
+		{
+			if ( compact ) checkHiprt( hiprtCompactScene( ctxt, 0, scene, scene ) );
+
+			memset( dst, 0, g_parsedArgs.m_ww * g_parsedArgs.m_wh * 4 );
+			void* args[] = { &scene, &dst, &res };
+			launchKernel( func, g_parsedArgs.m_ww, g_parsedArgs.m_wh, args );
+			validateAndWriteImage( "MotionBlurTimeSegments.png", dst, "MotionBlur.png" );
+		}
+
+		free( sceneTemp );
+		checkHiprt( hiprtDestroyScene( ctxt, scene ) );
+	}
+
+	free( sceneInput.instances );
+	free( sceneInput.instanceFrames );
+	free( sceneInput.instanceTransformHeaders );
+	free( mesh.vertices );
+	free( mesh.triangleIndices );
+	free( geomTempTris );
+	free( dst );
+	checkHiprt( hiprtDestroyGeometry( ctxt, geomTris ) );
+	checkHiprt( hiprtDestroyContext( ctxt ) );
+}
+
+TEST_F( hiprtTest, SceneCompaction )
+{
+	hiprtContext ctxt;
+	checkHiprt( hiprtCreateContext( HIPRT_API_VERSION, m_ctxtInput, ctxt ) );
+
+	hiprtGeometry			   geomTris;
+	hiprtDevicePtr			   geomTempTris;
+	hiprtTriangleMeshPrimitive mesh;
+	{
+		mesh.triangleCount	= 1;
+		mesh.triangleStride = sizeof( uint3 );
+		malloc( reinterpret_cast<uint3*&>( mesh.triangleIndices ), mesh.triangleCount );
+		std::vector<uint32_t> idx( 3 * mesh.triangleCount );
+		std::iota( idx.begin(), idx.end(), 0 );
+		copyHtoD(
+			reinterpret_cast<uint3*>( mesh.triangleIndices ), reinterpret_cast<uint3*>( idx.data() ), mesh.triangleCount );
+
+		mesh.vertexCount  = 3;
+		mesh.vertexStride = sizeof( float3 );
+		malloc( reinterpret_cast<float3*&>( mesh.vertices ), mesh.vertexCount );
+		constexpr float Scale = 0.15f;
+		float3			v[]	  = {
+			   { Scale * sinf( 0.0f ), Scale * cosf( 0.0f ), 0.0f },
+			   { Scale * sinf( hiprt::Pi * 2.0f / 3.0f ), Scale * cosf( hiprt::Pi * 2.0f / 3.0f ), 0.0f },
+			   { Scale * sinf( hiprt::Pi * 4.0f / 3.0f ), Scale * cosf( hiprt::Pi * 4.0f / 3.0f ), 0.0f } };
+		copyHtoD( reinterpret_cast<float3*>( mesh.vertices ), v, mesh.vertexCount );
+
+		hiprtGeometryBuildInput geomInput;
+		geomInput.type					 = hiprtPrimitiveTypeTriangleMesh;
+		geomInput.primitive.triangleMesh = mesh;
+
+		size_t			  geomTempSize;
+		hiprtBuildOptions options;
+		options.buildFlags = hiprtBuildFlagBitPreferFastBuild;
+		checkHiprt( hiprtGetGeometryBuildTemporaryBufferSize( ctxt, geomInput, options, geomTempSize ) );
+		malloc( reinterpret_cast<uint8_t*&>( geomTempTris ), geomTempSize );
+
+		checkHiprt( hiprtCreateGeometry( ctxt, geomInput, options, geomTris ) );
+		checkHiprt( hiprtBuildGeometry( ctxt, hiprtBuildOperationBuild, geomInput, options, geomTempTris, 0, geomTris ) );
+	}
+
+	// the same motion as in the MotionBlur test (more frames than instances)
+	hiprtSceneBuildInput sceneInput;
+	{
+		hiprtInstance instTris;
+		instTris.type	  = hiprtInstanceTypeGeometry;
+		instTris.geometry = geomTris;
+
+		hiprtInstance instances[] = { instTris, instTris };
+
+		sceneInput.instanceCount = 2;
+		sceneInput.instanceMasks = nullptr;
+		malloc( reinterpret_cast<hiprtInstance*&>( sceneInput.instances ), sceneInput.instanceCount );
+		copyHtoD( reinterpret_cast<hiprtInstance*>( sceneInput.instances ), instances, sceneInput.instanceCount );
+
+		constexpr float Offset = 0.3f;
+		hiprtFrameSRT	frames[5];
+		frames[0].translation = { -0.25f, -Offset, 0.0f };
+		frames[0].scale		  = { 1.0f, 1.0f, 1.0f };
+		frames[0].rotation	  = { 0.0f, 0.0f, 1.0f, 0.0f };
+		frames[0].time		  = 0.0f;
+		frames[1].translation = { 0.0f, -Offset, 0.0f };
+		frames[1].scale		  = { 1.0f, 1.0f, 1.0f };
+		frames[1].rotation	  = { 0.0f, 0.0f, 1.0f, 0.0f };
+		frames[1].time		  = 0.35f;
+		frames[2].translation = { 0.25f, -Offset, 0.0f };
+		frames[2].scale		  = { 1.0f, 1.0f, 1.0f };
+		frames[2].rotation	  = { 0.0f, 0.0f, 1.0f, hiprt::Pi * 0.25f };
+		frames[2].time		  = 1.0f;
+		frames[3].translation = { 0.0f, Offset, 0.0f };
+		frames[3].scale		  = { 1.0f, 1.0f, 1.0f };
+		frames[3].rotation	  = { 0.0f, 0.0f, 1.0f, 0.0f };
+		frames[3].time		  = 0.0f;
+		frames[4].translation = { 0.0f, Offset, 0.0f };
+		frames[4].scale		  = { 1.0f, 1.0f, 1.0f };
+		frames[4].rotation	  = { 0.0f, 0.0f, 1.0f, hiprt::Pi * 0.5f };
+		frames[4].time		  = 1.0f;
+
+		sceneInput.frameCount = 5;
+		malloc( reinterpret_cast<hiprtFrameSRT*&>( sceneInput.instanceFrames ), sceneInput.frameCount );
+		copyHtoD( reinterpret_cast<hiprtFrameSRT*>( sceneInput.instanceFrames ), frames, sceneInput.frameCount );
+
+		hiprtTransformHeader headers[2];
+		headers[0].frameIndex = 0;
+		headers[0].frameCount = 3;
+		headers[1].frameIndex = 3;
+		headers[1].frameCount = 2;
+		malloc( reinterpret_cast<hiprtTransformHeader*&>( sceneInput.instanceTransformHeaders ), sceneInput.instanceCount );
+		copyHtoD(
+			reinterpret_cast<hiprtTransformHeader*>( sceneInput.instanceTransformHeaders ), headers, sceneInput.instanceCount );
+	}
+
+	// two pooled scenes compacted into new handles; both the instances and all the frames must survive the compaction
+	constexpr uint32_t SceneCount = 2;
+
+	hiprtSceneBuildInput sceneInputs[] = { sceneInput, sceneInput };
+	hiprtScene			 scenes[SceneCount];
+	hiprtScene*			 scenePtrs[]   = { &scenes[0], &scenes[1] };
+	hiprtDevicePtr		 sceneTemp;
+	size_t				 sceneTempSize;
+	hiprtBuildOptions	 options;
+	options.buildFlags = hiprtBuildFlagBitPreferFastBuild;
+	checkHiprt( hiprtGetScenesBuildTemporaryBufferSize( ctxt, SceneCount, sceneInputs, options, sceneTempSize ) );
+	malloc( reinterpret_cast<uint8_t*&>( sceneTemp ), sceneTempSize );
+
+	checkHiprt( hiprtCreateScenes( ctxt, SceneCount, sceneInputs, options, scenePtrs ) );
+	checkHiprt( hiprtBuildScenes( ctxt, hiprtBuildOperationBuild, SceneCount, sceneInputs, options, sceneTemp, 0, scenes ) );
+
+	float3 refAabbMin[SceneCount], refAabbMax[SceneCount];
+	for ( uint32_t i = 0; i < SceneCount; ++i )
+		checkHiprt( hiprtExportSceneAabb( ctxt, scenes[i], refAabbMin[i], refAabbMax[i] ) );
+
+	hiprtScene	compactedScenes[SceneCount];
+	hiprtScene* compactedScenePtrs[] = { &compactedScenes[0], &compactedScenes[1] };
+	checkHiprt( hiprtCompactScenes( ctxt, SceneCount, 0, scenes, compactedScenePtrs ) );
+
+	oroFunction func;
+	buildTraceKernel( ctxt, getRootDir() / "test/kernels/HiprtTestKernel.h", "MotionBlurKernel", func );
+
+	uint8_t* dst;
+	malloc( dst, g_parsedArgs.m_ww * g_parsedArgs.m_wh * 4 );
+	uint2 res = { g_parsedArgs.m_ww, g_parsedArgs.m_wh };
+
+	for ( uint32_t i = 0; i < SceneCount; ++i )
+	{
+		float3 aabbMin, aabbMax;
+		checkHiprt( hiprtExportSceneAabb( ctxt, compactedScenes[i], aabbMin, aabbMax ) );
+		ASSERT_NEAR( aabbMin.x, refAabbMin[i].x, 1e-3f );
+		ASSERT_NEAR( aabbMin.y, refAabbMin[i].y, 1e-3f );
+		ASSERT_NEAR( aabbMax.x, refAabbMax[i].x, 1e-3f );
+		ASSERT_NEAR( aabbMax.y, refAabbMax[i].y, 1e-3f );
+
+		memset( dst, 0, g_parsedArgs.m_ww * g_parsedArgs.m_wh * 4 );
+		void* args[] = { &compactedScenes[i], &dst, &res };
+		launchKernel( func, g_parsedArgs.m_ww, g_parsedArgs.m_wh, args );
+		validateAndWriteImage( "SceneCompaction.png", dst, "MotionBlur.png" );
+	}
+
+	// the compaction released the input pool, the compacted pool is still owned by the context
+	checkHiprt( hiprtDestroyScenes( ctxt, SceneCount, compactedScenes ) );
+
+	free( sceneTemp );
+	free( sceneInput.instances );
+	free( sceneInput.instanceFrames );
+	free( sceneInput.instanceTransformHeaders );
+	free( mesh.vertices );
+	free( mesh.triangleIndices );
+	free( geomTempTris );
+	free( dst );
+	checkHiprt( hiprtDestroyGeometry( ctxt, geomTris ) );
+	checkHiprt( hiprtDestroyContext( ctxt ) );
+}
+
 TEST_F( hiprtTest, MotionBlurMatrix )
 {
 	hiprtContext ctxt;
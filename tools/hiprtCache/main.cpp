@@ -0,0 +1,166 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <hiprt/hiprt.h>
+#include <hiprt/hiprt_libpath.h>
+#include <Orochi/Orochi.h>
+#include <contrib/argparse/argparse.h>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Command line manager of a kernel cache directory, e.g.
+//   hiprtcache -c cache                 prints the statistics
+//   hiprtcache -c cache -p              removes the stale binaries of the device
+//   hiprtcache -c cache -t 512M         removes the stale binaries and evicts the least recently used ones
+
+namespace
+{
+bool parseSize( const std::string& str, size_t& size )
+{
+	size_t pos = 0;
+	try
+	{
+		size = std::stoull( str, &pos );
+	}
+	catch ( std::exception& )
+	{
+		return false;
+	}
+
+	const std::string suffix = str.substr( pos );
+	if ( suffix == "K" || suffix == "k" )
+		size <<= 10u;
+	else if ( suffix == "M" || suffix == "m" )
+		size <<= 20u;
+	else if ( suffix == "G" || suffix == "g" )
+		size <<= 30u;
+	else if ( !suffix.empty() )
+		return false;
+	return true;
+}
+
+void printStatistics( const hiprtCacheStatistics& stats )
+{
+	std::cout << "binaries:       " << stats.entryCount << " (" << stats.size << " bytes)" << std::endl;
+	std::cout << "stale binaries: " << stats.staleEntryCount << " (" << stats.staleSize << " bytes)" << std::endl;
+	std::cout << "files:          " << stats.fileSize << " bytes" << std::endl;
+}
+} // namespace
+
+int main( int argc, const char* argv[] )
+{
+	using namespace argparse;
+	ArgumentParser parser( "hiprtcache", "HIPRT kernel cache manager" );
+	parser.add_argument().names( { "-c", "--cache" } ).description( "cache directory" ).required( true );
+	parser.add_argument().names( { "-d", "--device" } ).description( "device index" ).required( false );
+	parser.add_argument()
+		.names( { "-p", "--prune" } )
+		.description( "remove the binaries of the device built for another HIPRT or driver version" )
+		.count( 0 )
+		.required( false );
+	parser.add_argument()
+		.names( { "-t", "--trim" } )
+		.description( "prune and evict the least recently used binaries to fit into the size (e.g. 512M)" )
+		.required( false );
+
+	ArgumentParser::Result result = parser.parse( argc, argv );
+	if ( result )
+	{
+		std::cerr << result.what() << std::endl;
+		parser.print_help();
+		return EXIT_FAILURE;
+	}
+
+	const std::string cacheDir	= parser.get<std::string>( "c" );
+	const uint32_t	  deviceIdx = parser.exists( "d" ) ? parser.get<uint32_t>( "d" ) : 0u;
+
+	size_t maxSize = 0u;
+	if ( parser.exists( "t" ) && !parseSize( parser.get<std::string>( "t" ), maxSize ) )
+	{
+		std::cerr << "Invalid size '" << parser.get<std::string>( "t" ) << "'" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// the driver version of the device tells which binaries are stale
+	oroInitialize( (oroApi)( ORO_API_HIP | ORO_API_CUDA ), 0, g_hip_paths, g_hiprtc_paths );
+	oroDevice oroDevice;
+	oroCtx	  oroCtx;
+	if ( oroInit( 0 ) != oroSuccess || oroDeviceGet( &oroDevice, deviceIdx ) != oroSuccess ||
+		 oroCtxCreate( &oroCtx, 0, oroDevice ) != oroSuccess )
+	{
+		std::cerr << "Unable to create a context on device " << deviceIdx << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	oroDeviceProp props;
+	oroGetDeviceProperties( &props, oroDevice );
+
+	hiprtContextCreationInput ctxtInput;
+	ctxtInput.deviceType =
+		std::string( props.name ).find( "NVIDIA" ) != std::string::npos ? hiprtDeviceNVIDIA : hiprtDeviceAMD;
+	ctxtInput.ctxt	 = oroGetRawCtx( oroCtx );
+	ctxtInput.device = oroGetRawDevice( oroDevice );
+
+	hiprtContext ctxt;
+	if ( hiprtCreateContext( HIPRT_API_VERSION, ctxtInput, ctxt ) != hiprtSuccess )
+	{
+		std::cerr << "Unable to create a HIPRT context" << std::endl;
+		oroCtxDestroy( oroCtx );
+		return EXIT_FAILURE;
+	}
+	hiprtSetCacheDirPath( ctxt, cacheDir.c_str() );
+
+	int					 exitCode = EXIT_SUCCESS;
+	hiprtCacheStatistics stats;
+	if ( hiprtGetCacheStatistics( ctxt, stats ) != hiprtSuccess )
+	{
+		std::cerr << "Unable to read the cache '" << cacheDir << "'" << std::endl;
+		exitCode = EXIT_FAILURE;
+	}
+	else
+	{
+		std::cout << "Cache '" << cacheDir << "' for '" << props.name << "'" << std::endl;
+		printStatistics( stats );
+
+		if ( parser.exists( "p" ) || parser.exists( "t" ) )
+		{
+			if ( hiprtTrimCache( ctxt, maxSize ) != hiprtSuccess || hiprtGetCacheStatistics( ctxt, stats ) != hiprtSuccess )
+			{
+				std::cerr << "Unable to trim the cache '" << cacheDir << "'" << std::endl;
+				exitCode = EXIT_FAILURE;
+			}
+			else
+			{
+				std::cout << "after trimming:" << std::endl;
+				printStatistics( stats );
+			}
+		}
+	}
+
+	hiprtDestroyContext( ctxt );
+	oroCtxDestroy( oroCtx );
+	return exitCode;
+}
@@ -0,0 +1,445 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+#include <hiprt/hiprt.h>
+#include <hiprt/hiprt_libpath.h>
+#include <Orochi/Orochi.h>
+#include <contrib/argparse/argparse.h>
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <contrib/stbi/stbi_image_write.h>
+#define TINYOBJLOADER_IMPLEMENTATION
+#include <test/common/tiny_obj_loader.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Renders the traversal cost of a mesh as a heatmap, e.g.
+//   hiprtheatmap -i foliage.obj -o foliage.png                  box nodes visited per pixel
+//   hiprtheatmap -g foliage.bvh -o foliage.png -m prims         primitives tested per pixel
+//   hiprtheatmap -i hair.obj -o hair.png --yaw 90 --pitch 30    orbits the camera around the mesh
+//
+// The primary rays are traced on the device by a kernel compiled with HIPRT_TRAVERSAL_STATISTICS,
+// the per-ray counters are colored from blue (cheap) to red (the most expensive pixel) and
+// summarized in a report.
+
+namespace
+{
+constexpr uint32_t BlockWidth  = 8u;
+constexpr uint32_t BlockHeight = 8u;
+
+// the camera is passed by value, the layout matches the kernel side
+struct HeatmapCamera
+{
+	hiprtFloat3 eye;
+	hiprtFloat3 u;
+	hiprtFloat3 v;
+	hiprtFloat3 w;
+};
+
+constexpr const char* HeatmapKernelSource = R"(
+#include <hiprt/hiprt_device.h>
+
+struct HeatmapCamera
+{
+	float3 eye;
+	float3 u;
+	float3 v;
+	float3 w;
+};
+
+extern "C" __global__ void
+HeatmapKernel( hiprtGeometry geom, HeatmapCamera camera, uint2 resolution, hiprtTraversalStatistics* statistics )
+{
+	const uint32_t x = blockIdx.x * blockDim.x + threadIdx.x;
+	const uint32_t y = blockIdx.y * blockDim.y + threadIdx.y;
+	if ( x >= resolution.x || y >= resolution.y ) return;
+
+	const float sx = 2.0f * ( x + 0.5f ) / resolution.x - 1.0f;
+	const float sy = 1.0f - 2.0f * ( y + 0.5f ) / resolution.y;
+
+	hiprtRay ray;
+	ray.origin		= camera.eye;
+	ray.direction.x = camera.w.x + sx * camera.u.x + sy * camera.v.x;
+	ray.direction.y = camera.w.y + sx * camera.u.y + sy * camera.v.y;
+	ray.direction.z = camera.w.z + sx * camera.u.z + sy * camera.v.z;
+
+	hiprtGeomTraversalClosest tr( geom, ray );
+	tr.getNextHit();
+	statistics[x + y * resolution.x] = tr.getStatistics();
+}
+)";
+
+hiprtFloat3 operator+( const hiprtFloat3& a, const hiprtFloat3& b ) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+
+hiprtFloat3 operator-( const hiprtFloat3& a, const hiprtFloat3& b ) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+
+hiprtFloat3 operator*( const hiprtFloat3& a, float c ) { return { a.x * c, a.y * c, a.z * c }; }
+
+hiprtFloat3 cross( const hiprtFloat3& a, const hiprtFloat3& b )
+{
+	return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+
+hiprtFloat3 normalize( const hiprtFloat3& a )
+{
+	const float length = std::sqrt( a.x * a.x + a.y * a.y + a.z * a.z );
+	return length > 0.0f ? a * ( 1.0f / length ) : a;
+}
+
+bool loadObj( const std::filesystem::path& path, std::vector<hiprtFloat3>& vertices, std::vector<uint32_t>& indices )
+{
+	tinyobj::attrib_t				 attrib;
+	std::vector<tinyobj::shape_t>	 shapes;
+	std::vector<tinyobj::material_t> materials;
+	std::string						 warning;
+	std::string						 err;
+	if ( !tinyobj::LoadObj(
+			 &attrib, &shapes, &materials, &warning, &err, path.string().c_str(), path.parent_path().string().c_str() ) )
+	{
+		std::cerr << "Unable to load '" << path.string() << "': " << err << std::endl;
+		return false;
+	}
+
+	// the shapes are merged into one mesh, tinyobj triangulates the faces
+	for ( size_t i = 0; i + 2 < attrib.vertices.size(); i += 3 )
+		vertices.push_back( { attrib.vertices[i], attrib.vertices[i + 1], attrib.vertices[i + 2] } );
+	for ( const tinyobj::shape_t& shape : shapes )
+		for ( const tinyobj::index_t& index : shape.mesh.indices )
+			indices.push_back( static_cast<uint32_t>( index.vertex_index ) );
+
+	if ( indices.empty() )
+	{
+		std::cerr << "No triangles in '" << path.string() << "'" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+hiprtError buildGeometry(
+	hiprtContext					ctxt,
+	const std::vector<hiprtFloat3>& vertices,
+	const std::vector<uint32_t>&	indices,
+	hiprtBuildFlags					buildFlags,
+	hiprtGeometry&					geomOut )
+{
+	hiprtTriangleMeshPrimitive mesh;
+	mesh.triangleCount	= static_cast<uint32_t>( indices.size() / 3 );
+	mesh.triangleStride = 3 * sizeof( uint32_t );
+	mesh.vertexCount	= static_cast<uint32_t>( vertices.size() );
+	mesh.vertexStride	= sizeof( hiprtFloat3 );
+	oroMalloc( reinterpret_cast<oroDeviceptr*>( &mesh.triangleIndices ), indices.size() * sizeof( uint32_t ) );
+	oroMalloc( reinterpret_cast<oroDeviceptr*>( &mesh.vertices ), vertices.size() * sizeof( hiprtFloat3 ) );
+	oroMemcpyHtoD(
+		reinterpret_cast<oroDeviceptr>( mesh.triangleIndices ),
+		const_cast<uint32_t*>( indices.data() ),
+		indices.size() * sizeof( uint32_t ) );
+	oroMemcpyHtoD(
+		reinterpret_cast<oroDeviceptr>( mesh.vertices ),
+		const_cast<hiprtFloat3*>( vertices.data() ),
+		vertices.size() * sizeof( hiprtFloat3 ) );
+
+	hiprtGeometryBuildInput geomInput;
+	geomInput.type					 = hiprtPrimitiveTypeTriangleMesh;
+	geomInput.primitive.triangleMesh = mesh;
+
+	hiprtBuildOptions options;
+	options.buildFlags = buildFlags;
+
+	size_t		   geomTempSize;
+	hiprtDevicePtr geomTemp = nullptr;
+	hiprtError	   error	= hiprtGetGeometryBuildTemporaryBufferSize( ctxt, geomInput, options, geomTempSize );
+	if ( error == hiprtSuccess )
+	{
+		oroMalloc( reinterpret_cast<oroDeviceptr*>( &geomTemp ), geomTempSize );
+		error = hiprtCreateGeometry( ctxt, geomInput, options, geomOut );
+	}
+	if ( error == hiprtSuccess )
+		error = hiprtBuildGeometry( ctxt, hiprtBuildOperationBuild, geomInput, options, geomTemp, 0, geomOut );
+	oroDeviceSynchronize();
+
+	oroFree( reinterpret_cast<oroDeviceptr>( geomTemp ) );
+	oroFree( reinterpret_cast<oroDeviceptr>( mesh.triangleIndices ) );
+	oroFree( reinterpret_cast<oroDeviceptr>( mesh.vertices ) );
+	return error;
+}
+
+// frames the bounding box, the camera orbits its center
+HeatmapCamera
+createCamera( const hiprtFloat3& aabbMin, const hiprtFloat3& aabbMax, float yaw, float pitch, float fov, float aspect )
+{
+	const float		  Pi	 = 3.14159265358979f;
+	const hiprtFloat3 center = ( aabbMin + aabbMax ) * 0.5f;
+	const hiprtFloat3 extent = aabbMax - aabbMin;
+	const float radius = 0.5f * std::sqrt( extent.x * extent.x + extent.y * extent.y + extent.z * extent.z );
+	const float tanFov = std::tan( 0.5f * fov * Pi / 180.0f );
+
+	const float		  yawRad   = yaw * Pi / 180.0f;
+	const float		  pitchRad = pitch * Pi / 180.0f;
+	const hiprtFloat3 forward  = {
+		 -std::sin( yawRad ) * std::cos( pitchRad ), -std::sin( pitchRad ), -std::cos( yawRad ) * std::cos( pitchRad ) };
+	const hiprtFloat3 right = normalize( cross( forward, { 0.0f, 1.0f, 0.0f } ) );
+	const hiprtFloat3 up	= cross( right, forward );
+
+	HeatmapCamera camera;
+	camera.eye = center - forward * ( radius / std::min( tanFov, tanFov * aspect ) + radius );
+	camera.w   = forward;
+	camera.u   = right * ( tanFov * aspect );
+	camera.v   = up * tanFov;
+	return camera;
+}
+
+// blue, cyan, green, yellow, red
+void heatColor( float t, uint8_t* rgba )
+{
+	constexpr float Colors[5][3] = {
+		{ 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 1.0f }, { 0.0f, 1.0f, 0.0f }, { 1.0f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f } };
+	const float	   x = std::clamp( t, 0.0f, 1.0f ) * 4.0f;
+	const uint32_t i = std::min( static_cast<uint32_t>( x ), 3u );
+	const float	   f = x - i;
+	for ( uint32_t c = 0; c < 3; ++c )
+		rgba[c] = static_cast<uint8_t>( 255.0f * ( Colors[i][c] * ( 1.0f - f ) + Colors[i + 1][c] * f ) );
+	rgba[3] = 255;
+}
+
+void printReport( const hiprtTraversalStatisticsSummary& summary, uint32_t hottestValue, uint32_t hottestX, uint32_t hottestY )
+{
+	const double rayCount = std::max( summary.rayCount, 1u );
+	std::cout << std::fixed << std::setprecision( 2 );
+	std::cout << "Rays:                       " << summary.rayCount << std::endl;
+	std::cout << "Box nodes per ray:          " << summary.internalNodeCount / rayCount << " (max "
+			  << summary.maxInternalNodeCount << ")" << std::endl;
+	std::cout << "Leaves per ray:             " << summary.leafNodeCount / rayCount << std::endl;
+	std::cout << "Triangle tests per ray:     " << summary.triangleTestCount / rayCount << std::endl;
+	std::cout << "Max stack depth:            " << summary.maxStackDepth << std::endl;
+	std::cout << "Rays with stack overflow:   " << summary.stackOverflowRayCount << std::endl;
+	std::cout << "Hottest pixel:              (" << hottestX << ", " << hottestY << ") with " << hottestValue << std::endl;
+
+	std::cout << "Box nodes per ray histogram:" << std::endl;
+	for ( uint32_t i = 0; i < hiprtTraversalHistogramSize; ++i )
+	{
+		if ( summary.internalNodeHistogram[i] == 0 ) continue;
+		// bucket i holds the counts in [2^(i-1), 2^i), the first one the rays without any box node
+		const uint32_t low	= i == 0 ? 0u : 1u << ( i - 1 );
+		const uint32_t high = i == 0 ? 1u : low * 2;
+		std::cout << "  [" << std::setw( 6 ) << low << ", " << std::setw( 6 ) << high << "): " << std::setw( 6 )
+				  << 100.0 * summary.internalNodeHistogram[i] / rayCount << "%" << std::endl;
+	}
+}
+} // namespace
+
+int main( int argc, const char* argv[] )
+{
+	using namespace argparse;
+	ArgumentParser parser( "hiprtheatmap", "HIPRT traversal cost heatmap" );
+	parser.add_argument().names( { "-i", "--obj" } ).description( "OBJ file to build the geometry from" ).required( false );
+	parser.add_argument()
+		.names( { "-g", "--geometry" } )
+		.description( "geometry saved with hiprtSaveGeometry" )
+		.required( false );
+	parser.add_argument().names( { "-o", "--output" } ).description( "output PNG file" ).required( true );
+	parser.add_argument()
+		.names( { "-m", "--metric" } )
+		.description( "'nodes' for the box nodes visited, 'prims' for the primitives tested" )
+		.required( false );
+	parser.add_argument()
+		.names( { "-b", "--build" } )
+		.description( "'fast', 'balanced' or 'high' quality build of an OBJ" )
+		.required( false );
+	parser.add_argument().names( { "--width" } ).description( "image width" ).required( false );
+	parser.add_argument().names( { "--height" } ).description( "image height" ).required( false );
+	parser.add_argument().names( { "--yaw" } ).description( "camera yaw in degrees" ).required( false );
+	parser.add_argument().names( { "--pitch" } ).description( "camera pitch in degrees" ).required( false );
+	parser.add_argument().names( { "--fov" } ).description( "vertical field of view in degrees" ).required( false );
+	parser.add_argument().names( { "-d", "--device" } ).description( "device index" ).required( false );
+
+	ArgumentParser::Result result = parser.parse( argc, argv );
+	if ( result || parser.exists( "i" ) == parser.exists( "g" ) )
+	{
+		if ( result ) std::cerr << result.what() << std::endl;
+		std::cerr << "Either an OBJ file or a saved geometry is needed" << std::endl;
+		parser.print_help();
+		return EXIT_FAILURE;
+	}
+
+	const std::string metric	= parser.exists( "m" ) ? parser.get<std::string>( "m" ) : "nodes";
+	const std::string build		= parser.exists( "b" ) ? parser.get<std::string>( "b" ) : "balanced";
+	const uint32_t	  width		= parser.exists( "width" ) ? parser.get<uint32_t>( "width" ) : 1024u;
+	const uint32_t	  height	= parser.exists( "height" ) ? parser.get<uint32_t>( "height" ) : 768u;
+	const float		  yaw		= parser.exists( "yaw" ) ? parser.get<float>( "yaw" ) : 0.0f;
+	const float		  pitch		= parser.exists( "pitch" ) ? parser.get<float>( "pitch" ) : 0.0f;
+	const float		  fov		= parser.exists( "fov" ) ? parser.get<float>( "fov" ) : 45.0f;
+	const int		  deviceIdx = parser.exists( "d" ) ? parser.get<int>( "d" ) : 0;
+	if ( metric != "nodes" && metric != "prims" )
+	{
+		std::cerr << "Unknown metric '" << metric << "'" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	hiprtBuildFlags buildFlags = hiprtBuildFlagBitPreferBalancedBuild;
+	if ( build == "fast" )
+		buildFlags = hiprtBuildFlagBitPreferFastBuild;
+	else if ( build == "high" )
+		buildFlags = hiprtBuildFlagBitPreferHighQualityBuild;
+	else if ( build != "balanced" )
+	{
+		std::cerr << "Unknown build '" << build << "'" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::vector<hiprtFloat3> vertices;
+	std::vector<uint32_t>	 indices;
+	if ( parser.exists( "i" ) && !loadObj( parser.get<std::string>( "i" ), vertices, indices ) ) return EXIT_FAILURE;
+
+	oroInitialize( (oroApi)( ORO_API_HIP | ORO_API_CUDA ), 0, g_hip_paths, g_hiprtc_paths );
+	oroDevice oroDevice;
+	oroCtx	  oroCtx;
+	if ( oroInit( 0 ) != oroSuccess || oroDeviceGet( &oroDevice, deviceIdx ) != oroSuccess ||
+		 oroCtxCreate( &oroCtx, 0, oroDevice ) != oroSuccess )
+	{
+		std::cerr << "Unable to create a context on device " << deviceIdx << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	oroDeviceProp props;
+	oroGetDeviceProperties( &props, oroDevice );
+	const std::string deviceName = props.name;
+
+	hiprtContextCreationInput ctxtInput;
+	ctxtInput.deviceType = deviceName.find( "NVIDIA" ) != std::string::npos ? hiprtDeviceNVIDIA : hiprtDeviceAMD;
+	ctxtInput.ctxt		 = oroGetRawCtx( oroCtx );
+	ctxtInput.device	 = oroGetRawDevice( oroDevice );
+
+	hiprtContext ctxt;
+	if ( hiprtCreateContext( HIPRT_API_VERSION, ctxtInput, ctxt ) != hiprtSuccess )
+	{
+		std::cerr << "Unable to create the HIPRT context" << std::endl;
+		oroCtxDestroy( oroCtx );
+		return EXIT_FAILURE;
+	}
+
+	int			  exitCode = EXIT_FAILURE;
+	hiprtGeometry geom	   = nullptr;
+	hiprtError	  error	   = parser.exists( "g" ) ? hiprtLoadGeometry( ctxt, geom, parser.get<std::string>( "g" ).c_str() )
+												  : buildGeometry( ctxt, vertices, indices, buildFlags, geom );
+
+	hiprtFloat3 aabbMin;
+	hiprtFloat3 aabbMax;
+	if ( error == hiprtSuccess ) error = hiprtExportGeometryAabb( ctxt, geom, aabbMin, aabbMax );
+
+	const char*		 functionName = "HeatmapKernel";
+	const char*		 options[]	  = { "-DHIPRT_TRAVERSAL_STATISTICS" };
+	hiprtApiFunction function	  = nullptr;
+	if ( error == hiprtSuccess )
+		error = hiprtBuildTraceKernels(
+			ctxt,
+			1,
+			&functionName,
+			HeatmapKernelSource,
+			"HeatmapKernel",
+			0,
+			nullptr,
+			nullptr,
+			1,
+			options,
+			0,
+			1,
+			nullptr,
+			&function,
+			nullptr,
+			true );
+
+	const uint32_t			  rayCount	 = width * height;
+	hiprtTraversalStatistics* statistics = nullptr;
+	if ( error == hiprtSuccess )
+	{
+		HeatmapCamera camera = createCamera( aabbMin, aabbMax, yaw, pitch, fov, static_cast<float>( width ) / height );
+		hiprtInt2	  resolution = { static_cast<int>( width ), static_cast<int>( height ) };
+		void*		  args[]	 = { &geom, &camera, &resolution, &statistics };
+
+		oroMalloc( reinterpret_cast<oroDeviceptr*>( &statistics ), rayCount * sizeof( hiprtTraversalStatistics ) );
+		const oroError launchError = oroModuleLaunchKernel(
+			reinterpret_cast<oroFunction>( function ),
+			( width + BlockWidth - 1 ) / BlockWidth,
+			( height + BlockHeight - 1 ) / BlockHeight,
+			1,
+			BlockWidth,
+			BlockHeight,
+			1,
+			0,
+			0,
+			args,
+			0 );
+		if ( launchError != oroSuccess || oroDeviceSynchronize() != oroSuccess ) error = hiprtErrorInternal;
+	}
+
+	hiprtTraversalStatisticsSummary		  summary;
+	std::vector<hiprtTraversalStatistics> rayStats( rayCount );
+	if ( error == hiprtSuccess ) error = hiprtSummarizeTraversalStatistics( ctxt, rayCount, statistics, summary );
+	if ( error == hiprtSuccess && oroMemcpyDtoH(
+									  rayStats.data(),
+									  reinterpret_cast<oroDeviceptr>( statistics ),
+									  rayCount * sizeof( hiprtTraversalStatistics ) ) != oroSuccess )
+		error = hiprtErrorInternal;
+
+	if ( error == hiprtSuccess )
+	{
+		std::vector<uint32_t> values( rayCount );
+		for ( uint32_t i = 0; i < rayCount; ++i )
+			values[i] = metric == "nodes" ? rayStats[i].internalNodeCount
+										  : rayStats[i].triangleTestCount + rayStats[i].customIntersectionCount;
+
+		const uint32_t hottest = static_cast<uint32_t>( std::max_element( values.begin(), values.end() ) - values.begin() );
+		const float	   scale   = values[hottest] > 0 ? 1.0f / values[hottest] : 0.0f;
+
+		std::vector<uint8_t> image( 4 * rayCount );
+		for ( uint32_t i = 0; i < rayCount; ++i )
+			heatColor( values[i] * scale, &image[4 * i] );
+
+		const std::string output = parser.get<std::string>( "o" );
+		if ( stbi_write_png( output.c_str(), width, height, 4, image.data(), width * 4 ) != 0 )
+		{
+			printReport( summary, values[hottest], hottest % width, hottest / width );
+			exitCode = EXIT_SUCCESS;
+		}
+		else
+		{
+			std::cerr << "Unable to write '" << output << "'" << std::endl;
+		}
+	}
+	else
+	{
+		std::cerr << "Failed with error " << error << std::endl;
+	}
+
+	oroFree( reinterpret_cast<oroDeviceptr>( statistics ) );
+	if ( geom != nullptr ) hiprtDestroyGeometry( ctxt, geom );
+	hiprtDestroyContext( ctxt );
+	oroCtxDestroy( oroCtx );
+	return exitCode;
+}
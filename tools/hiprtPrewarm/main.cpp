@@ -0,0 +1,541 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <hiprt/hiprt.h>
+#include <hiprt/hiprt_libpath.h>
+#include <Orochi/Orochi.h>
+#include <contrib/argparse/argparse.h>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Ahead-of-time filling of a kernel cache directory, e.g.
+//   hiprtprewarm -m kernels.manifest -c cache                          every GPU architecture of the machine
+//   hiprtprewarm -m kernels.manifest -c cache -t "gfx1100=AMD Radeon RX 7900 XTX"   offline for a device
+//   hiprtprewarm -m kernels.manifest -c cache -v                       checks the binaries without compiling
+//
+// The manifest lists the modules as the application builds them, the cache keys only match
+// if the sources, module names, function names and options are identical:
+//   [module MyKernels]                    module name passed to hiprtBuildTraceKernels
+//   source = kernels/MyKernels.h          source file, relative to the manifest
+//   header = hiprt/foo.h include/foo.h    include name and optional file of a header
+//   functions = TraceKernel ShadeKernel   kernels to compile
+//   geomTypes = 2                         number of geometry types
+//   rayTypes = 1                          number of ray types
+//   funcNameSet = intersectFunc -         intersection and filter functions of a geometry and ray type,
+//                                         one line per combination, '-' for none
+//   options = -DFOO=1 -O3                 compiler options, one compilation per line
+//   bitcode = kernels/MyKernels.bc        user bitcode linked instead of a source
+//
+// and optionally the devices to compile for offline, instead of the devices of the machine:
+//   [target Navi31]
+//   device = AMD Radeon RX 7900 XTX       device name as reported by the driver
+//   arch = gfx1100                        architecture
+//   driver = 60140092                     driver version of the target machine, the local one by default
+
+namespace
+{
+struct Target
+{
+	std::string name;
+	std::string deviceName;
+	std::string archName;
+	std::string driverVersion;
+};
+
+struct Module
+{
+	std::string							  name;
+	std::filesystem::path				  source;
+	std::filesystem::path				  bitcode;
+	std::vector<std::string>			  includeNames;
+	std::vector<std::filesystem::path>	  headers;
+	std::vector<std::string>			  functions;
+	std::vector<std::vector<std::string>> optionSets;
+	std::vector<std::string>			  funcNames;
+	uint32_t							  numGeomTypes = 0u;
+	uint32_t							  numRayTypes  = 1u;
+};
+
+std::vector<std::string> split( const std::string& str )
+{
+	std::vector<std::string> tokens;
+	std::istringstream		 stream( str );
+	std::string				 token;
+	while ( stream >> token )
+		tokens.push_back( token );
+	return tokens;
+}
+
+std::string trim( const std::string& str )
+{
+	const size_t begin = str.find_first_not_of( " \t\r" );
+	const size_t end   = str.find_last_not_of( " \t\r" );
+	return begin == std::string::npos ? std::string() : str.substr( begin, end - begin + 1 );
+}
+
+bool readFile( const std::filesystem::path& path, std::string& data )
+{
+	std::ifstream file( path, std::ios::binary | std::ios::in );
+	if ( !file.is_open() ) return false;
+	data.assign( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+	return true;
+}
+
+bool parseManifest( const std::filesystem::path& path, std::vector<Module>& modules, std::vector<Target>& targets )
+{
+	std::ifstream file( path );
+	if ( !file.is_open() )
+	{
+		std::cerr << "Unable to open the manifest '" << path.string() << "'" << std::endl;
+		return false;
+	}
+
+	const std::filesystem::path root = path.parent_path();
+
+	std::string line;
+	uint32_t	lineIdx	 = 0u;
+	bool		inTarget = false;
+	while ( std::getline( file, line ) )
+	{
+		++lineIdx;
+		line = trim( line.substr( 0, line.find( '#' ) ) );
+		if ( line.empty() ) continue;
+
+		if ( line.front() == '[' )
+		{
+			const std::vector<std::string> tokens = split( line.substr( 1, line.size() - 2 ) );
+			if ( line.back() != ']' || tokens.size() != 2 || ( tokens[0] != "module" && tokens[0] != "target" ) )
+			{
+				std::cerr << path.string() << ":" << lineIdx << ": expected '[module <name>]' or '[target <name>]'"
+						  << std::endl;
+				return false;
+			}
+			inTarget = tokens[0] == "target";
+			if ( inTarget )
+				targets.emplace_back().name = tokens[1];
+			else
+				modules.emplace_back().name = tokens[1];
+			continue;
+		}
+
+		const size_t separator = line.find( '=' );
+		if ( ( !inTarget && modules.empty() ) || separator == std::string::npos )
+		{
+			std::cerr << path.string() << ":" << lineIdx << ": expected '<key> = <values>' in a module or a target"
+					  << std::endl;
+			return false;
+		}
+
+		const std::string			   key	  = trim( line.substr( 0, separator ) );
+		const std::vector<std::string> values = split( line.substr( separator + 1 ) );
+		if ( values.empty() )
+		{
+			std::cerr << path.string() << ":" << lineIdx << ": missing value of '" << key << "'" << std::endl;
+			return false;
+		}
+
+		if ( inTarget )
+		{
+			// device names contain spaces
+			Target& target = targets.back();
+			if ( key == "device" )
+				target.deviceName = trim( line.substr( separator + 1 ) );
+			else if ( key == "arch" )
+				target.archName = values[0];
+			else if ( key == "driver" )
+				target.driverVersion = values[0];
+			else
+			{
+				std::cerr << path.string() << ":" << lineIdx << ": unknown key '" << key << "'" << std::endl;
+				return false;
+			}
+			continue;
+		}
+
+		Module& module = modules.back();
+		if ( key == "source" )
+		{
+			module.source = root / values[0];
+		}
+		else if ( key == "bitcode" )
+		{
+			module.bitcode = root / values[0];
+		}
+		else if ( key == "header" )
+		{
+			module.includeNames.push_back( values[0] );
+			module.headers.push_back( root / values.back() );
+		}
+		else if ( key == "functions" )
+		{
+			module.functions.insert( module.functions.end(), values.begin(), values.end() );
+		}
+		else if ( key == "options" )
+		{
+			module.optionSets.push_back( values );
+		}
+		else if ( key == "geomTypes" )
+		{
+			module.numGeomTypes = static_cast<uint32_t>( std::stoul( values[0] ) );
+		}
+		else if ( key == "rayTypes" )
+		{
+			module.numRayTypes = static_cast<uint32_t>( std::stoul( values[0] ) );
+		}
+		else if ( key == "funcNameSet" )
+		{
+			module.funcNames.push_back( values[0] );
+			module.funcNames.push_back( values.size() > 1 ? values[1] : "-" );
+		}
+		else
+		{
+			std::cerr << path.string() << ":" << lineIdx << ": unknown key '" << key << "'" << std::endl;
+			return false;
+		}
+	}
+
+	for ( const Target& target : targets )
+	{
+		if ( target.deviceName.empty() || target.archName.empty() )
+		{
+			std::cerr << "Target '" << target.name << "' needs a device and an arch" << std::endl;
+			return false;
+		}
+	}
+
+	for ( Module& module : modules )
+	{
+		if ( module.source.empty() == module.bitcode.empty() || module.functions.empty() )
+		{
+			std::cerr << "Module '" << module.name << "' needs functions and either a source or a bitcode" << std::endl;
+			return false;
+		}
+		if ( !module.funcNames.empty() && module.funcNames.size() != 2u * module.numGeomTypes * module.numRayTypes )
+		{
+			std::cerr << "Module '" << module.name << "' needs a function name set per geometry and ray type" << std::endl;
+			return false;
+		}
+		if ( module.optionSets.empty() ) module.optionSets.emplace_back();
+	}
+	return true;
+}
+
+// builds the module with the cache enabled, a fresh context never reuses a loaded module; with a target the
+// binary is only stored, when verifying it is only read, which checks its checksum
+hiprtError buildModule(
+	const hiprtContextCreationInput& ctxtInput,
+	const hiprtCompileTarget*		 target,
+	const std::string&				 cacheDir,
+	const Module&					 module,
+	const std::vector<std::string>&	 options,
+	bool							 verify,
+	bool&							 cachedOut )
+{
+	std::vector<const char*> functions;
+	for ( const std::string& function : module.functions )
+		functions.push_back( function.c_str() );
+
+	std::vector<hiprtFuncNameSet> funcNameSets;
+	for ( size_t i = 0; i < module.funcNames.size(); i += 2 )
+	{
+		hiprtFuncNameSet funcNameSet;
+		funcNameSet.intersectFuncName = module.funcNames[i] != "-" ? module.funcNames[i].c_str() : nullptr;
+		funcNameSet.filterFuncName	  = module.funcNames[i + 1] != "-" ? module.funcNames[i + 1].c_str() : nullptr;
+		funcNameSets.push_back( funcNameSet );
+	}
+
+	std::vector<const char*> opts;
+	for ( const std::string& option : options )
+		opts.push_back( option.c_str() );
+
+	std::string				 source;
+	std::string				 bitcode;
+	std::vector<std::string> headerData( module.headers.size() );
+	std::vector<const char*> headers;
+	std::vector<const char*> includeNames;
+
+	bool read = module.bitcode.empty() ? readFile( module.source, source ) : readFile( module.bitcode, bitcode );
+	for ( size_t i = 0; i < module.headers.size(); ++i )
+	{
+		read = read && readFile( module.headers[i], headerData[i] );
+		headers.push_back( headerData[i].c_str() );
+		includeNames.push_back( module.includeNames[i].c_str() );
+	}
+	if ( !read )
+	{
+		std::cerr << "Unable to read the sources of '" << module.name << "'" << std::endl;
+		return hiprtErrorInvalidParameter;
+	}
+
+	hiprtContext ctxt;
+	hiprtError	 error = hiprtCreateContext( HIPRT_API_VERSION, ctxtInput, ctxt );
+	if ( error != hiprtSuccess ) return error;
+	hiprtSetCacheDirPath( ctxt, cacheDir.c_str() );
+	hiprtSetCacheReadOnly( ctxt, verify );
+	if ( target != nullptr ) error = hiprtSetCompileTarget( ctxt, target );
+
+	hiprtCacheStatistics before{};
+	hiprtCacheStatistics after{};
+	if ( error == hiprtSuccess ) error = hiprtGetCacheStatistics( ctxt, before );
+
+	std::vector<hiprtApiFunction> functionsOut( functions.size() );
+	if ( error == hiprtSuccess && !module.bitcode.empty() )
+	{
+		error = hiprtBuildTraceKernelsFromBitcode(
+			ctxt,
+			static_cast<uint32_t>( functions.size() ),
+			functions.data(),
+			module.name.c_str(),
+			bitcode.data(),
+			bitcode.size(),
+			module.numGeomTypes,
+			module.numRayTypes,
+			funcNameSets.empty() ? nullptr : funcNameSets.data(),
+			functionsOut.data(),
+			true );
+	}
+	else if ( error == hiprtSuccess )
+	{
+		error = hiprtBuildTraceKernels(
+			ctxt,
+			static_cast<uint32_t>( functions.size() ),
+			functions.data(),
+			source.c_str(),
+			module.name.c_str(),
+			static_cast<uint32_t>( headers.size() ),
+			headers.empty() ? nullptr : headers.data(),
+			includeNames.empty() ? nullptr : includeNames.data(),
+			static_cast<uint32_t>( opts.size() ),
+			opts.empty() ? nullptr : opts.data(),
+			module.numGeomTypes,
+			module.numRayTypes,
+			funcNameSets.empty() ? nullptr : funcNameSets.data(),
+			functionsOut.data(),
+			nullptr,
+			true );
+	}
+
+	// a binary read from the cache passed its checksum, a compiled one was appended to the cache
+	if ( error == hiprtSuccess ) error = hiprtGetCacheStatistics( ctxt, after );
+	cachedOut = verify ? error == hiprtSuccess : after.entryCount == before.entryCount;
+	if ( verify ) error = hiprtSuccess;
+
+	hiprtDestroyContext( ctxt );
+	return error;
+}
+bool buildModules(
+	const hiprtContextCreationInput& ctxtInput,
+	const hiprtCompileTarget*		 target,
+	const std::string&				 cacheDir,
+	const std::vector<Module>&		 modules,
+	bool							 verify )
+{
+	bool success = true;
+	for ( const Module& module : modules )
+	{
+		for ( size_t i = 0; i < module.optionSets.size(); ++i )
+		{
+			bool			 cached = false;
+			const hiprtError error =
+				buildModule( ctxtInput, target, cacheDir, module, module.optionSets[i], verify, cached );
+
+			std::cout << "  " << module.name << " (option set " << i << "): ";
+			if ( error != hiprtSuccess )
+			{
+				std::cout << "failed with error " << error << std::endl;
+				success = false;
+			}
+			else if ( verify )
+			{
+				std::cout << ( cached ? "valid" : "missing or corrupted" ) << std::endl;
+				success = success && cached;
+			}
+			else
+			{
+				std::cout << ( cached ? "cached" : "compiled" ) << std::endl;
+			}
+		}
+	}
+	return success;
+}
+
+// parses '<arch>=<device name>'
+bool parseTarget( const std::string& str, Target& target )
+{
+	const size_t separator = str.find( '=' );
+	if ( separator == std::string::npos ) return false;
+	target.name		  = str;
+	target.archName	  = trim( str.substr( 0, separator ) );
+	target.deviceName = trim( str.substr( separator + 1 ) );
+	return !target.archName.empty() && !target.deviceName.empty();
+}
+} // namespace
+
+int main( int argc, const char* argv[] )
+{
+	using namespace argparse;
+	ArgumentParser parser( "hiprtprewarm", "HIPRT kernel cache prewarming" );
+	parser.add_argument().names( { "-m", "--manifest" } ).description( "manifest of the modules" ).required( true );
+	parser.add_argument().names( { "-c", "--cache" } ).description( "cache directory" ).required( true );
+	parser.add_argument()
+		.names( { "-d", "--device" } )
+		.description( "device index, one device of every architecture by default" )
+		.required( false );
+	parser.add_argument()
+		.names( { "-t", "--target" } )
+		.description( "'<arch>=<device name>' to compile for offline, replaces the targets of the manifest" )
+		.required( false );
+	parser.add_argument()
+		.names( { "--driver" } )
+		.description( "driver version of the command line targets, the local one by default" )
+		.required( false );
+	parser.add_argument()
+		.names( { "-v", "--verify" } )
+		.description( "only check that every binary is cached and matches its checksum" )
+		.count( 0 )
+		.required( false );
+
+	ArgumentParser::Result result = parser.parse( argc, argv );
+	if ( result )
+	{
+		std::cerr << result.what() << std::endl;
+		parser.print_help();
+		return EXIT_FAILURE;
+	}
+
+	std::vector<Module> modules;
+	std::vector<Target> targets;
+	if ( !parseManifest( parser.get<std::string>( "m" ), modules, targets ) ) return EXIT_FAILURE;
+
+	if ( parser.exists( "t" ) )
+	{
+		targets.clear();
+		for ( const std::string& str : parser.get<std::vector<std::string>>( "t" ) )
+		{
+			Target& target = targets.emplace_back();
+			if ( !parseTarget( str, target ) )
+			{
+				std::cerr << "Expected '<arch>=<device name>' instead of '" << str << "'" << std::endl;
+				return EXIT_FAILURE;
+			}
+			if ( parser.exists( "driver" ) ) target.driverVersion = parser.get<std::string>( "driver" );
+		}
+	}
+
+	const std::string cacheDir = parser.get<std::string>( "c" );
+	const bool		  verify   = parser.exists( "v" );
+
+	if ( oroInitialize( (oroApi)( ORO_API_HIP | ORO_API_CUDA ), 0, g_hip_paths, g_hiprtc_paths ) != 0 )
+	{
+		std::cerr << "Unable to load the runtime" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	int deviceCount = 0;
+	if ( oroInit( 0 ) != oroSuccess || oroGetDeviceCount( &deviceCount ) != oroSuccess ) deviceCount = 0;
+
+	int exitCode = EXIT_SUCCESS;
+
+	// offline targets only need the runtime compiler, no device
+	if ( !targets.empty() )
+	{
+		for ( const Target& target : targets )
+		{
+			std::cout << "Target " << target.name << ": " << target.deviceName << " " << target.archName << std::endl;
+
+			hiprtCompileTarget compileTarget;
+			compileTarget.deviceName	= target.deviceName.c_str();
+			compileTarget.archName		= target.archName.c_str();
+			compileTarget.driverVersion = target.driverVersion.empty() ? nullptr : target.driverVersion.c_str();
+
+			hiprtContextCreationInput ctxtInput;
+			ctxtInput.deviceType =
+				target.deviceName.find( "NVIDIA" ) != std::string::npos ? hiprtDeviceNVIDIA : hiprtDeviceAMD;
+			ctxtInput.ctxt	 = nullptr;
+			ctxtInput.device = 0;
+
+			if ( !buildModules( ctxtInput, &compileTarget, cacheDir, modules, verify ) ) exitCode = EXIT_FAILURE;
+		}
+		return exitCode;
+	}
+
+	if ( deviceCount == 0 )
+	{
+		std::cerr << "No device found, targets can be given to compile offline" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::vector<int> deviceIndices;
+	if ( parser.exists( "d" ) )
+	{
+		deviceIndices.push_back( parser.get<int>( "d" ) );
+	}
+	else
+	{
+		for ( int i = 0; i < deviceCount; ++i )
+			deviceIndices.push_back( i );
+	}
+
+	std::set<std::string> architectures;
+	for ( const int deviceIdx : deviceIndices )
+	{
+		oroDevice oroDevice;
+		oroCtx	  oroCtx;
+		if ( oroDeviceGet( &oroDevice, deviceIdx ) != oroSuccess || oroCtxCreate( &oroCtx, 0, oroDevice ) != oroSuccess )
+		{
+			std::cerr << "Unable to create a context on device " << deviceIdx << std::endl;
+			exitCode = EXIT_FAILURE;
+			continue;
+		}
+
+		// the binaries are shared by the devices of the same architecture
+		oroDeviceProp props;
+		oroGetDeviceProperties( &props, oroDevice );
+		const std::string architecture = std::string( props.name ) + " " + props.gcnArchName;
+		if ( !architectures.insert( architecture ).second )
+		{
+			oroCtxDestroy( oroCtx );
+			continue;
+		}
+		std::cout << "Device " << deviceIdx << ": " << architecture << std::endl;
+
+		hiprtContextCreationInput ctxtInput;
+		ctxtInput.deviceType = architecture.find( "NVIDIA" ) != std::string::npos ? hiprtDeviceNVIDIA : hiprtDeviceAMD;
+		ctxtInput.ctxt		 = oroGetRawCtx( oroCtx );
+		ctxtInput.device	 = oroGetRawDevice( oroDevice );
+
+		if ( !buildModules( ctxtInput, nullptr, cacheDir, modules, verify ) ) exitCode = EXIT_FAILURE;
+
+		oroCtxDestroy( oroCtx );
+	}
+
+	return exitCode;
+}